@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 
@@ -10,6 +11,7 @@
 #include "audio_core/sink/sink.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -18,8 +20,15 @@ MICROPROFILE_DEFINE(Audio_Renderer, "Audio", "DSP_AudioRenderer", MP_RGB(60, 19,
 
 namespace AudioCore::ADSP::AudioRenderer {
 
+namespace {
+/// Voice chain workers, on top of the renderer thread which also processes chains
+size_t GetVoiceWorkerCount() {
+    return std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 3);
+}
+} // Anonymous namespace
+
 AudioRenderer::AudioRenderer(Core::System& system_, Sink::Sink& sink_)
-    : system{system_}, sink{sink_} {}
+    : system{system_}, sink{sink_}, voice_chain_processor{GetVoiceWorkerCount()} {}
 
 AudioRenderer::~AudioRenderer() {
     Stop();
@@ -119,6 +128,10 @@ u64 AudioRenderer::GetRenderingStartTick(s32 session_id) const noexcept {
     return (1000 * command_buffers[session_id].render_time_taken_us) + signalled_tick;
 }
 
+const Renderer::MeasuredCommandCosts& AudioRenderer::GetMeasuredCommandCosts() const noexcept {
+    return measured_command_costs;
+}
+
 void AudioRenderer::CreateSinkStreams() {
     u32 channels{sink.GetDeviceChannels()};
     for (u32 i = 0; i < MaxRendererSessions; i++) {
@@ -196,6 +209,10 @@ void AudioRenderer::Main(std::stop_token stop_token) {
 
                     max_time = std::min(command_buffer.time_limit, max_time);
                     command_list_processor.SetProcessTimeMax(max_time);
+                    command_list_processor.command_costs =
+                        Settings::values.audio_measured_voice_drop.GetValue()
+                            ? &measured_command_costs
+                            : nullptr;
 
                     if (index == 0) {
                         streams[index]->WaitFreeSpace(stop_token);
@@ -205,7 +222,8 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                     {
                         MICROPROFILE_SCOPE(Audio_Renderer);
                         render_times_taken[index] =
-                            command_list_processor.Process(index) - start_time;
+                            command_list_processor.Process(index, &voice_chain_processor) -
+                            start_time;
                     }
 
                     const auto end_time{system.CoreTiming().GetGlobalTimeUs().count()};
@@ -9,7 +9,9 @@
 
 #include "audio_core/adsp/apps/audio_renderer/command_buffer.h"
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_chain_processor.h"
 #include "audio_core/adsp/mailbox.h"
+#include "audio_core/renderer/command/measured_command_costs.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
 #include "common/reader_writer_queue.h"
@@ -79,6 +81,14 @@ public:
     void ClearRemainCommandCount(s32 session_id) noexcept;
     u64 GetRenderingStartTick(s32 session_id) const noexcept;
 
+    /**
+     * Get the command costs measured on the host, filled in while measured voice dropping is
+     * enabled.
+     *
+     * @return The measured command costs.
+     */
+    const Renderer::MeasuredCommandCosts& GetMeasuredCommandCosts() const noexcept;
+
 private:
     /**
      * Main AudioRenderer thread, responsible for processing the command lists.
@@ -106,6 +116,10 @@ private:
     std::array<CommandBuffer, MaxRendererSessions> command_buffers{};
     /// The command lists to process
     std::array<CommandListProcessor, MaxRendererSessions> command_list_processors{};
+    /// Runs the voice commands of the command lists in parallel
+    VoiceChainProcessor voice_chain_processor;
+    /// Host costs of the processed commands, shared by every session
+    Renderer::MeasuredCommandCosts measured_command_costs{};
     /// The streams which will receive the processed samples
     std::array<Sink::SinkStream*, MaxRendererSessions> streams{};
     /// CPU Tick when the DSP was signalled to process, uses time rather than tick
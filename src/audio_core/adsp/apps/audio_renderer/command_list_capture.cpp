@@ -0,0 +1,613 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_capture.h"
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/commands.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/logging/log.h"
+#include "core/memory.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+namespace {
+
+constexpr u32 CaptureMagic{Common::MakeMagic('A', 'C', 'A', 'P')};
+constexpr u32 CaptureVersion{2};
+constexpr u32 ListMagic{Common::MakeMagic('L', 'I', 'S', 'T')};
+/// Granularity the workbuffer changes are recorded at
+constexpr u64 BlockSize{0x100};
+
+struct CaptureHeader {
+    u32 magic;
+    u32 version;
+    CpuAddr workbuffer_base;
+    u64 workbuffer_size;
+};
+
+struct ListHeader {
+    u32 magic;
+    u32 block_count;
+    u32 region_count;
+    u32 relocation_count;
+    u64 header_offset;
+    u64 commands_buffer_size;
+};
+
+struct RegionHeader {
+    CpuAddr address;
+    u64 size;
+};
+
+/**
+ * Rebuild a captured command in place, so it can be called in this process. The captured virtual
+ * table pointer belongs to the process the capture was made in, so a new command is constructed
+ * over it, and the captured fields following the pointer are copied back in.
+ *
+ * @tparam T   - Type of the command.
+ * @param data - Captured command.
+ * @param size - Captured size of the command.
+ * @return True if the command was rebuilt, false if its size does not match.
+ */
+template <typename T>
+bool MakeCallable(u8* data, s16 size) {
+    if (static_cast<size_t>(size) != sizeof(T)) {
+        return false;
+    }
+    std::array<u8, sizeof(T)> fields;
+    std::memcpy(fields.data(), data, sizeof(T));
+    std::construct_at(reinterpret_cast<T*>(data));
+    std::memcpy(data + sizeof(void*), fields.data() + sizeof(void*), sizeof(T) - sizeof(void*));
+    return true;
+}
+
+/**
+ * Rebuild a captured command in place, if it can be replayed.
+ *
+ * @param data - Captured command.
+ * @param type - Type of the command.
+ * @param size - Captured size of the command.
+ * @return True if the command can be replayed, otherwise false.
+ */
+bool MakeCallable(u8* data, Renderer::CommandId type, s16 size) {
+    using namespace Renderer;
+    switch (type) {
+    case CommandId::DataSourcePcmInt16Version1:
+        return MakeCallable<PcmInt16DataSourceVersion1Command>(data, size);
+    case CommandId::DataSourcePcmInt16Version2:
+        return MakeCallable<PcmInt16DataSourceVersion2Command>(data, size);
+    case CommandId::DataSourcePcmFloatVersion1:
+        return MakeCallable<PcmFloatDataSourceVersion1Command>(data, size);
+    case CommandId::DataSourcePcmFloatVersion2:
+        return MakeCallable<PcmFloatDataSourceVersion2Command>(data, size);
+    case CommandId::DataSourceAdpcmVersion1:
+        return MakeCallable<AdpcmDataSourceVersion1Command>(data, size);
+    case CommandId::DataSourceAdpcmVersion2:
+        return MakeCallable<AdpcmDataSourceVersion2Command>(data, size);
+    case CommandId::Volume:
+        return MakeCallable<VolumeCommand>(data, size);
+    case CommandId::VolumeRamp:
+        return MakeCallable<VolumeRampCommand>(data, size);
+    case CommandId::BiquadFilter:
+        return MakeCallable<BiquadFilterCommand>(data, size);
+    case CommandId::Mix:
+        return MakeCallable<MixCommand>(data, size);
+    case CommandId::MixRamp:
+        return MakeCallable<MixRampCommand>(data, size);
+    case CommandId::MixRampGrouped:
+        return MakeCallable<MixRampGroupedCommand>(data, size);
+    case CommandId::DepopPrepare:
+        return MakeCallable<DepopPrepareCommand>(data, size);
+    case CommandId::DepopForMixBuffers:
+        return MakeCallable<DepopForMixBuffersCommand>(data, size);
+    case CommandId::Upsample:
+        return MakeCallable<UpsampleCommand>(data, size);
+    case CommandId::DownMix6chTo2ch:
+        return MakeCallable<DownMix6chTo2chCommand>(data, size);
+    case CommandId::ClearMixBuffer:
+        return MakeCallable<ClearMixBufferCommand>(data, size);
+    case CommandId::CopyMixBuffer:
+        return MakeCallable<CopyMixBufferCommand>(data, size);
+    case CommandId::MultiTapBiquadFilter:
+        return MakeCallable<MultiTapBiquadFilterCommand>(data, size);
+    case CommandId::Compressor:
+        return MakeCallable<CompressorCommand>(data, size);
+    default:
+        return false;
+    }
+}
+
+/**
+ * Call a function with each field of a replayable command which holds an address. Data source
+ * wave buffer and coefficient addresses are guest addresses, read through CaptureMemory, and are
+ * not listed.
+ *
+ * @param command - Command to list the address fields of.
+ * @param func    - Function to call with a reference to each field.
+ */
+template <typename Func>
+void ForEachAddressField(const Renderer::ICommand& command, Func&& func) {
+    using namespace Renderer;
+    switch (command.type) {
+    case CommandId::DataSourcePcmInt16Version1:
+        func(static_cast<const PcmInt16DataSourceVersion1Command&>(command).voice_state);
+        break;
+    case CommandId::DataSourcePcmInt16Version2:
+        func(static_cast<const PcmInt16DataSourceVersion2Command&>(command).voice_state);
+        break;
+    case CommandId::DataSourcePcmFloatVersion1:
+        func(static_cast<const PcmFloatDataSourceVersion1Command&>(command).voice_state);
+        break;
+    case CommandId::DataSourcePcmFloatVersion2:
+        func(static_cast<const PcmFloatDataSourceVersion2Command&>(command).voice_state);
+        break;
+    case CommandId::DataSourceAdpcmVersion1:
+        func(static_cast<const AdpcmDataSourceVersion1Command&>(command).voice_state);
+        break;
+    case CommandId::DataSourceAdpcmVersion2:
+        func(static_cast<const AdpcmDataSourceVersion2Command&>(command).voice_state);
+        break;
+    case CommandId::BiquadFilter:
+        func(static_cast<const BiquadFilterCommand&>(command).state);
+        break;
+    case CommandId::MixRamp:
+        func(static_cast<const MixRampCommand&>(command).previous_sample);
+        break;
+    case CommandId::MixRampGrouped:
+        func(static_cast<const MixRampGroupedCommand&>(command).previous_samples);
+        break;
+    case CommandId::DepopPrepare: {
+        const auto& depop{static_cast<const DepopPrepareCommand&>(command)};
+        func(depop.previous_samples);
+        func(depop.depop_buffer);
+        break;
+    }
+    case CommandId::DepopForMixBuffers:
+        func(static_cast<const DepopForMixBuffersCommand&>(command).depop_buffer);
+        break;
+    case CommandId::Upsample: {
+        const auto& upsample{static_cast<const UpsampleCommand&>(command)};
+        func(upsample.samples_buffer);
+        func(upsample.inputs);
+        func(upsample.upsampler_info);
+        break;
+    }
+    case CommandId::MultiTapBiquadFilter:
+        for (const auto& state : static_cast<const MultiTapBiquadFilterCommand&>(command).states) {
+            func(state);
+        }
+        break;
+    case CommandId::Compressor: {
+        const auto& compressor{static_cast<const CompressorCommand&>(command)};
+        func(compressor.state);
+        func(compressor.workbuffer);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+} // Anonymous namespace
+
+void CaptureMemory::SetRegion(CpuAddr address, std::vector<u8>&& data) {
+    regions.insert_or_assign(address, std::move(data));
+}
+
+u8* CaptureMemory::GetSpan(CpuAddr address, u64 size) {
+    auto it{regions.upper_bound(address)};
+    if (it == regions.begin()) {
+        return nullptr;
+    }
+    --it;
+    const auto offset{address - it->first};
+    if (offset + size > it->second.size()) {
+        return nullptr;
+    }
+    return it->second.data() + offset;
+}
+
+void CaptureMemory::ReadBlockUnsafe(CpuAddr address, void* dest, u64 size) {
+    auto* const output{static_cast<u8*>(dest)};
+    std::memset(output, 0, size);
+
+    auto it{regions.upper_bound(address)};
+    if (it != regions.begin()) {
+        --it;
+    }
+    for (; it != regions.end() && it->first < address + size; ++it) {
+        const auto region_end{it->first + it->second.size()};
+        if (region_end <= address) {
+            continue;
+        }
+        const auto start{std::max(address, it->first)};
+        const auto end{std::min(address + size, region_end)};
+        std::memcpy(output + (start - address), it->second.data() + (start - it->first),
+                    end - start);
+    }
+}
+
+CommandListCaptureWriter::CommandListCaptureWriter(const std::filesystem::path& path,
+                                                   std::span<const u8> workbuffer_)
+    : file{path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile},
+      workbuffer{workbuffer_}, last_workbuffer(workbuffer_.size(), 0) {
+    const CaptureHeader header{
+        .magic = CaptureMagic,
+        .version = CaptureVersion,
+        .workbuffer_base = CpuAddr(workbuffer.data()),
+        .workbuffer_size = workbuffer.size(),
+    };
+    if (!file.IsOpen() || !file.WriteObject(header)) {
+        LOG_ERROR(Service_Audio, "Failed to create audio command capture {}",
+                  Common::FS::PathToUTF8String(path));
+        file.Close();
+        return;
+    }
+    LOG_INFO(Service_Audio, "Capturing audio commands to {}", Common::FS::PathToUTF8String(path));
+}
+
+CommandListCaptureWriter::~CommandListCaptureWriter() = default;
+
+bool CommandListCaptureWriter::IsCapturing(std::span<const u8> workbuffer_) const {
+    return workbuffer.data() == workbuffer_.data() && workbuffer.size() == workbuffer_.size();
+}
+
+void CommandListCaptureWriter::Record(const CommandListProcessor& processor) {
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    const auto header_address{CpuAddr(processor.header)};
+    const auto workbuffer_base{CpuAddr(workbuffer.data())};
+    const auto workbuffer_end{workbuffer_base + workbuffer.size()};
+    if (header_address < workbuffer_base ||
+        header_address + sizeof(Renderer::CommandListHeader) > workbuffer_end) {
+        LOG_ERROR(Service_Audio, "Command list is outside of the captured workbuffer");
+        return;
+    }
+
+    std::vector<u32> changed_blocks;
+    for (u64 offset = 0; offset < workbuffer.size(); offset += BlockSize) {
+        const auto size{std::min(BlockSize, workbuffer.size() - offset)};
+        if (std::memcmp(&workbuffer[offset], &last_workbuffer[offset], size) != 0) {
+            std::memcpy(&last_workbuffer[offset], &workbuffer[offset], size);
+            changed_blocks.push_back(static_cast<u32>(offset / BlockSize));
+        }
+    }
+
+    pending_regions.clear();
+    relocations.clear();
+    u64 offset{0};
+    for (u32 index = 0; index < processor.command_count; index++) {
+        const auto& command{
+            *reinterpret_cast<const Renderer::ICommand*>(processor.commands + offset)};
+        if (command.magic != Renderer::CommandMagic || command.size <= 0 ||
+            offset + command.size > processor.commands_buffer_size) {
+            break;
+        }
+        offset += command.size;
+
+        if (!command.enabled) {
+            continue;
+        }
+
+        // Record the workbuffer offset of each field pointing into the workbuffer, so the replay
+        // moves exactly those over to its own workbuffer
+        ForEachAddressField(command, [&](const CpuAddr& field) {
+            const auto field_address{CpuAddr(&field)};
+            if (field >= workbuffer_base && field < workbuffer_end &&
+                field_address >= workbuffer_base &&
+                field_address + sizeof(CpuAddr) <= workbuffer_end) {
+                relocations.push_back(static_cast<u32>(field_address - workbuffer_base));
+            }
+        });
+
+        if (processor.capture_memory != nullptr) {
+            RecordDataSource(*processor.capture_memory, command);
+        } else {
+            RecordDataSource(*processor.memory, command);
+        }
+    }
+
+    const ListHeader list_header{
+        .magic = ListMagic,
+        .block_count = static_cast<u32>(changed_blocks.size()),
+        .region_count = static_cast<u32>(pending_regions.size()),
+        .relocation_count = static_cast<u32>(relocations.size()),
+        .header_offset = header_address - workbuffer_base,
+        .commands_buffer_size = processor.commands_buffer_size,
+    };
+    bool written{file.WriteObject(list_header)};
+    for (const auto block_index : changed_blocks) {
+        const auto block_offset{block_index * BlockSize};
+        const auto size{std::min(BlockSize, workbuffer.size() - block_offset)};
+        written &= file.WriteObject(block_index);
+        written &= file.WriteSpan(workbuffer.subspan(block_offset, size)) == size;
+    }
+    for (const auto& [address, data] : pending_regions) {
+        written &= file.WriteObject(RegionHeader{address, data.size()});
+        written &= file.WriteSpan(std::span<const u8>(data)) == data.size();
+    }
+    written &= file.WriteSpan(std::span<const u32>(relocations)) == relocations.size();
+
+    if (!written) {
+        LOG_ERROR(Service_Audio, "Failed to write audio command capture, stopping the capture");
+        file.Close();
+    }
+}
+
+template <typename Memory>
+void CommandListCaptureWriter::RecordDataSource(Memory& memory, const Renderer::ICommand& command) {
+    using namespace Renderer;
+    switch (command.type) {
+    case CommandId::DataSourcePcmInt16Version1:
+        RecordWaveBuffers(memory, static_cast<const PcmInt16DataSourceVersion1Command&>(command));
+        break;
+    case CommandId::DataSourcePcmInt16Version2:
+        RecordWaveBuffers(memory, static_cast<const PcmInt16DataSourceVersion2Command&>(command));
+        break;
+    case CommandId::DataSourcePcmFloatVersion1:
+        RecordWaveBuffers(memory, static_cast<const PcmFloatDataSourceVersion1Command&>(command));
+        break;
+    case CommandId::DataSourcePcmFloatVersion2:
+        RecordWaveBuffers(memory, static_cast<const PcmFloatDataSourceVersion2Command&>(command));
+        break;
+    case CommandId::DataSourceAdpcmVersion1:
+        RecordWaveBuffers(memory, static_cast<const AdpcmDataSourceVersion1Command&>(command));
+        break;
+    case CommandId::DataSourceAdpcmVersion2:
+        RecordWaveBuffers(memory, static_cast<const AdpcmDataSourceVersion2Command&>(command));
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename Memory, typename T>
+void CommandListCaptureWriter::RecordWaveBuffers(Memory& memory, const T& command) {
+    if (command.voice_state == 0) {
+        return;
+    }
+
+    const auto& voice_state{*reinterpret_cast<const Renderer::VoiceState*>(command.voice_state)};
+    for (size_t i = 0; i < command.wave_buffers.size(); i++) {
+        if (!voice_state.wave_buffer_valid[i]) {
+            continue;
+        }
+        const auto& wave_buffer{command.wave_buffers[i]};
+        RecordRegion(memory, wave_buffer.buffer, wave_buffer.buffer_size);
+        RecordRegion(memory, wave_buffer.context, wave_buffer.context_size);
+    }
+
+    if constexpr (requires { command.data_address; }) {
+        RecordRegion(memory, command.data_address, command.data_size);
+    }
+}
+
+template <typename Memory>
+void CommandListCaptureWriter::RecordRegion(Memory& memory, CpuAddr address, u64 size) {
+    if (address == 0 || size == 0) {
+        return;
+    }
+
+    region_buffer.resize(size);
+    memory.ReadBlockUnsafe(address, region_buffer.data(), size);
+    const auto hash{
+        Common::CityHash64(reinterpret_cast<const char*>(region_buffer.data()), size)};
+
+    const auto [it, inserted]{region_hashes.try_emplace({address, size}, hash)};
+    if (!inserted) {
+        if (it->second == hash) {
+            return;
+        }
+        it->second = hash;
+    }
+    pending_regions.emplace_back(address, region_buffer);
+}
+
+CommandListReplay::CommandListReplay(const std::filesystem::path& path)
+    : file{path, Common::FS::FileAccessMode::Read, Common::FS::FileType::BinaryFile} {
+    CaptureHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header)) {
+        LOG_ERROR(Service_Audio, "Failed to open audio command capture {}",
+                  Common::FS::PathToUTF8String(path));
+        file.Close();
+        return;
+    }
+    if (header.magic != CaptureMagic || header.version != CaptureVersion) {
+        LOG_ERROR(Service_Audio, "Audio command capture {} has an unsupported format",
+                  Common::FS::PathToUTF8String(path));
+        file.Close();
+        return;
+    }
+
+    capture_base = header.workbuffer_base;
+    image.resize(header.workbuffer_size);
+    workbuffer.resize(header.workbuffer_size);
+}
+
+CommandListReplay::~CommandListReplay() = default;
+
+bool CommandListReplay::IsOpen() const {
+    return file.IsOpen();
+}
+
+bool CommandListReplay::ProcessNext() {
+    ListHeader list_header{};
+    if (!file.IsOpen() || !file.ReadObject(list_header)) {
+        return false;
+    }
+    if (list_header.magic != ListMagic ||
+        list_header.header_offset + sizeof(Renderer::CommandListHeader) > image.size()) {
+        LOG_ERROR(Service_Audio, "Audio command capture is corrupt");
+        return false;
+    }
+
+    for (u32 i = 0; i < list_header.block_count; i++) {
+        u32 block_index{};
+        if (!file.ReadObject(block_index) || block_index * BlockSize >= image.size()) {
+            LOG_ERROR(Service_Audio, "Audio command capture is corrupt");
+            return false;
+        }
+        const auto block_offset{block_index * BlockSize};
+        const auto size{std::min(BlockSize, image.size() - block_offset)};
+        if (file.ReadSpan(std::span(image).subspan(block_offset, size)) != size) {
+            LOG_ERROR(Service_Audio, "Audio command capture is truncated");
+            return false;
+        }
+    }
+
+    for (u32 i = 0; i < list_header.region_count; i++) {
+        RegionHeader region{};
+        if (!file.ReadObject(region)) {
+            LOG_ERROR(Service_Audio, "Audio command capture is truncated");
+            return false;
+        }
+        std::vector<u8> data(region.size);
+        if (file.ReadSpan(std::span(data)) != data.size()) {
+            LOG_ERROR(Service_Audio, "Audio command capture is truncated");
+            return false;
+        }
+        memory.SetRegion(region.address, std::move(data));
+    }
+
+    relocations.resize(list_header.relocation_count);
+    if (file.ReadSpan(std::span(relocations)) != relocations.size()) {
+        LOG_ERROR(Service_Audio, "Audio command capture is truncated");
+        return false;
+    }
+
+    std::ranges::copy(image, workbuffer.begin());
+    for (const auto relocation : relocations) {
+        if (relocation + sizeof(CpuAddr) > workbuffer.size()) {
+            LOG_ERROR(Service_Audio, "Audio command capture is corrupt");
+            return false;
+        }
+        CpuAddr address;
+        std::memcpy(&address, &workbuffer[relocation], sizeof(address));
+        address = Relocate(address);
+        std::memcpy(&workbuffer[relocation], &address, sizeof(address));
+    }
+
+    auto* const header_data{workbuffer.data() + list_header.header_offset};
+    auto& header{*reinterpret_cast<Renderer::CommandListHeader*>(header_data)};
+    header.samples_buffer = {
+        reinterpret_cast<s32*>(Relocate(CpuAddr(header.samples_buffer.data()))),
+        header.samples_buffer.size()};
+    header.workbuffer = {reinterpret_cast<u8*>(Relocate(CpuAddr(header.workbuffer.data()))),
+                         header.workbuffer.size()};
+
+    CommandListProcessor processor{};
+    processor.capture_memory = &memory;
+    processor.header = reinterpret_cast<Renderer::CommandListHeader*>(header_data);
+    processor.commands = header_data + sizeof(Renderer::CommandListHeader);
+    processor.commands_buffer_size = std::min<u64>(
+        list_header.commands_buffer_size,
+        workbuffer.size() - list_header.header_offset - sizeof(Renderer::CommandListHeader));
+    processor.command_count = header.command_count;
+    processor.sample_count = header.sample_count;
+    processor.target_sample_rate = header.sample_rate;
+    processor.mix_buffers = header.samples_buffer;
+    processor.buffer_count = header.buffer_count;
+
+    u64 offset{0};
+    for (u32 index = 0; index < processor.command_count; index++) {
+        if (offset + sizeof(Renderer::ICommand) > processor.commands_buffer_size) {
+            break;
+        }
+        auto* const command_data{processor.commands + offset};
+        auto& command{*reinterpret_cast<Renderer::ICommand*>(command_data)};
+        if (command.magic != Renderer::CommandMagic || command.size <= 0 ||
+            offset + command.size > processor.commands_buffer_size ||
+            static_cast<size_t>(command.type) >= Renderer::CommandIdCount) {
+            LOG_ERROR(Service_Audio, "Captured command {} is invalid", index);
+            break;
+        }
+        offset += command.size;
+
+        if (!command.enabled) {
+            continue;
+        }
+
+        const auto type{static_cast<size_t>(command.type)};
+        if (!MakeCallable(command_data, command.type, command.size)) {
+            stats.skipped_counts[type]++;
+            continue;
+        }
+
+        if (!command.Verify(processor)) {
+            break;
+        }
+
+        const auto start_time{std::chrono::steady_clock::now()};
+        command.Process(processor);
+        const auto end_time{std::chrono::steady_clock::now()};
+        stats.process_times[type] += static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+        stats.command_counts[type]++;
+    }
+
+    stats.checksum = Common::CityHash64WithSeed(
+        reinterpret_cast<const char*>(processor.mix_buffers.data()),
+        processor.mix_buffers.size_bytes(), stats.checksum);
+    stats.list_count++;
+    return true;
+}
+
+const CommandListReplayStats& CommandListReplay::GetStats() const {
+    return stats;
+}
+
+std::string_view CommandListReplay::GetCommandName(Renderer::CommandId type) {
+    static constexpr std::array<std::string_view, Renderer::CommandIdCount> Names{
+        "Invalid",
+        "DataSourcePcmInt16Version1",
+        "DataSourcePcmInt16Version2",
+        "DataSourcePcmFloatVersion1",
+        "DataSourcePcmFloatVersion2",
+        "DataSourceAdpcmVersion1",
+        "DataSourceAdpcmVersion2",
+        "Volume",
+        "VolumeRamp",
+        "BiquadFilter",
+        "Mix",
+        "MixRamp",
+        "MixRampGrouped",
+        "DepopPrepare",
+        "DepopForMixBuffers",
+        "Delay",
+        "Upsample",
+        "DownMix6chTo2ch",
+        "Aux",
+        "DeviceSink",
+        "CircularBufferSink",
+        "Reverb",
+        "I3dl2Reverb",
+        "Performance",
+        "ClearMixBuffer",
+        "CopyMixBuffer",
+        "LightLimiterVersion1",
+        "LightLimiterVersion2",
+        "MultiTapBiquadFilter",
+        "Capture",
+        "Compressor",
+    };
+    const auto index{static_cast<size_t>(type)};
+    return index < Names.size() ? Names[index] : "Unknown";
+}
+
+CpuAddr CommandListReplay::Relocate(CpuAddr address) const {
+    if (address < capture_base || address >= capture_base + image.size()) {
+        return address;
+    }
+    return address - capture_base + CpuAddr(workbuffer.data());
+}
+
+} // namespace AudioCore::ADSP::AudioRenderer
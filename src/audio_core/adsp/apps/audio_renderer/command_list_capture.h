@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "audio_core/common/common.h"
+#include "audio_core/renderer/command/icommand.h"
+#include "common/common_types.h"
+#include "common/fs/file.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+class CommandListProcessor;
+
+/**
+ * Guest memory recorded in a command list capture, read by the data source commands in place of
+ * core memory when replaying it.
+ */
+class CaptureMemory {
+public:
+    static constexpr bool HAS_FLUSH_INVALIDATION = false;
+
+    /**
+     * Set the contents of a guest memory region, replacing any earlier contents at its address.
+     *
+     * @param address - Guest address of the region.
+     * @param data    - Contents of the region.
+     */
+    void SetRegion(CpuAddr address, std::vector<u8>&& data);
+
+    /**
+     * Get a pointer to guest memory, if a single recorded region holds all of it.
+     *
+     * @param address - Guest address to get.
+     * @param size    - Number of bytes needed.
+     * @return Pointer to the memory, or nullptr if it was not recorded in one region.
+     */
+    u8* GetSpan(CpuAddr address, u64 size);
+
+    /**
+     * Read guest memory. Bytes outside of the recorded regions are read as zero.
+     *
+     * @param address - Guest address to read from.
+     * @param dest    - Buffer to receive the bytes.
+     * @param size    - Number of bytes to read.
+     */
+    void ReadBlockUnsafe(CpuAddr address, void* dest, u64 size);
+
+private:
+    /// Recorded regions, by guest address
+    std::map<CpuAddr, std::vector<u8>> regions;
+};
+
+/**
+ * Records the command lists processed for one renderer session to a capture file, so the DSP work
+ * of a game can be replayed and timed without running it.
+ *
+ * Commands point into the renderer workbuffer for their voice, mix and effect state, and into
+ * guest memory for their samples. For each command list, the blocks of the workbuffer which
+ * changed since the last list are recorded, along with the sample memory of every data source
+ * command which is new or has changed since it was last recorded, and the location of every
+ * command field which points into the workbuffer.
+ */
+class CommandListCaptureWriter {
+public:
+    /**
+     * Create a capture file, overwriting any existing file.
+     *
+     * @param path       - Path of the capture file.
+     * @param workbuffer - Renderer workbuffer the command lists are generated in.
+     */
+    explicit CommandListCaptureWriter(const std::filesystem::path& path,
+                                      std::span<const u8> workbuffer);
+    ~CommandListCaptureWriter();
+
+    /**
+     * Check if this writer is capturing command lists generated in the given workbuffer.
+     *
+     * @param workbuffer - Renderer workbuffer to check.
+     * @return True if the workbuffer is the one being captured, otherwise false.
+     */
+    bool IsCapturing(std::span<const u8> workbuffer) const;
+
+    /**
+     * Record a command list, must be called before any of it is processed.
+     *
+     * @param processor - Processor holding the command list.
+     */
+    void Record(const CommandListProcessor& processor);
+
+private:
+    /**
+     * Record the sample memory read by a command, if it is a data source command.
+     *
+     * @param memory  - Core or captured memory to read from.
+     * @param command - Command to record the samples of.
+     */
+    template <typename Memory>
+    void RecordDataSource(Memory& memory, const Renderer::ICommand& command);
+
+    /**
+     * Record the sample memory read by a data source command.
+     *
+     * @param memory  - Core or captured memory to read from.
+     * @param command - Data source command to record the samples of.
+     */
+    template <typename Memory, typename T>
+    void RecordWaveBuffers(Memory& memory, const T& command);
+
+    /**
+     * Record a guest memory region, if it is new or has changed since it was last recorded.
+     *
+     * @param memory  - Core or captured memory to read from.
+     * @param address - Guest address of the region.
+     * @param size    - Size of the region.
+     */
+    template <typename Memory>
+    void RecordRegion(Memory& memory, CpuAddr address, u64 size);
+
+    /// Capture file
+    Common::FS::IOFile file;
+    /// Renderer workbuffer being captured
+    std::span<const u8> workbuffer;
+    /// Workbuffer contents as of the last recorded command list
+    std::vector<u8> last_workbuffer;
+    /// Hash of each recorded region's contents, by address and size
+    std::map<std::pair<CpuAddr, u64>, u64> region_hashes;
+    /// Regions to be written for the current command list
+    std::vector<std::pair<CpuAddr, std::vector<u8>>> pending_regions;
+    /// Workbuffer offsets of the address fields of the current command list
+    std::vector<u32> relocations;
+    /// Scratch buffer for reading regions
+    std::vector<u8> region_buffer;
+};
+
+/// Statistics gathered while replaying a capture
+struct CommandListReplayStats {
+    /// Number of command lists replayed
+    u64 list_count;
+    /// Number of commands processed, by type
+    std::array<u64, Renderer::CommandIdCount> command_counts;
+    /// Host time taken to process the commands, by type, in nanoseconds
+    std::array<u64, Renderer::CommandIdCount> process_times;
+    /// Number of commands skipped because they cannot be replayed, by type
+    std::array<u64, Renderer::CommandIdCount> skipped_counts;
+    /// Checksum of the mix buffers after each replayed command list
+    u64 checksum;
+};
+
+/**
+ * Replays a capture written by CommandListCaptureWriter, processing each command list without a
+ * game, core memory or an output sink.
+ *
+ * Each command list is replayed from the workbuffer state it was captured with, so every list is
+ * processed from the same inputs as when it was captured. Commands which talk to the game or host
+ * (aux, capture and circular buffer sends, device sinks, performance markers), and effects whose
+ * state owns host allocations (delay, reverb, I3DL2 reverb, light limiter), are skipped.
+ */
+class CommandListReplay {
+public:
+    /**
+     * Open a capture file.
+     *
+     * @param path - Path of the capture file.
+     */
+    explicit CommandListReplay(const std::filesystem::path& path);
+    ~CommandListReplay();
+
+    /**
+     * Check if the capture was opened and is valid.
+     *
+     * @return True if the capture can be replayed, otherwise false.
+     */
+    bool IsOpen() const;
+
+    /**
+     * Replay the next command list in the capture.
+     *
+     * @return True if a command list was replayed, false at the end of the capture or on error.
+     */
+    bool ProcessNext();
+
+    /**
+     * Get the statistics for the command lists replayed so far.
+     *
+     * @return The replay statistics.
+     */
+    const CommandListReplayStats& GetStats() const;
+
+    /**
+     * Get the name of a command type, for reporting the replay statistics.
+     *
+     * @param type - Command type.
+     * @return The name of the command type.
+     */
+    static std::string_view GetCommandName(Renderer::CommandId type);
+
+private:
+    /**
+     * Move an address in the captured workbuffer over to the replay workbuffer.
+     *
+     * @param address - Address to relocate.
+     * @return The relocated address, or the address itself if it is outside the workbuffer.
+     */
+    CpuAddr Relocate(CpuAddr address) const;
+
+    /// Capture file
+    Common::FS::IOFile file;
+    /// Address of the workbuffer when it was captured
+    CpuAddr capture_base{};
+    /// Workbuffer contents as captured
+    std::vector<u8> image;
+    /// Workbuffer being replayed, the captured contents with the commands made callable
+    std::vector<u8> workbuffer;
+    /// Guest memory read by the data source commands
+    CaptureMemory memory;
+    /// Workbuffer offsets of the address fields of the current command list
+    std::vector<u32> relocations;
+    /// Statistics for the command lists replayed so far
+    CommandListReplayStats stats{};
+};
+
+} // namespace AudioCore::ADSP::AudioRenderer
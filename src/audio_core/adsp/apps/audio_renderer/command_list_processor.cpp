@@ -1,11 +1,16 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <string>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_chain_processor.h"
 #include "audio_core/renderer/command/command_list_header.h"
 #include "audio_core/renderer/command/commands.h"
+#include "audio_core/renderer/command/measured_command_costs.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -13,6 +18,27 @@
 #include "core/memory.h"
 
 namespace AudioCore::ADSP::AudioRenderer {
+namespace {
+
+/// Number of command lists between processing time reports, about 5 seconds of audio
+constexpr u32 ReportListCount{1000};
+
+/**
+ * Get the path to capture a session's command lists to, creating its directory if needed.
+ *
+ * @param session_id - Session ID of the command lists.
+ * @return Path of the capture file.
+ */
+std::filesystem::path GetCapturePath(u32 session_id) {
+    const auto dump_dir{Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir)};
+    const auto capture_dir{dump_dir / "audio"};
+    if (!Common::FS::CreateDir(dump_dir) || !Common::FS::CreateDir(capture_dir)) {
+        LOG_ERROR(Common_Filesystem, "Failed to create audio capture directories");
+    }
+    return capture_dir / fmt::format("session_{}.bin", session_id);
+}
+
+} // Anonymous namespace
 
 void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& process,
                                       CpuAddr buffer, u64 size, Sink::SinkStream* stream_) {
@@ -42,7 +68,7 @@ Sink::SinkStream* CommandListProcessor::GetOutputSinkStream() const {
     return stream;
 }
 
-u64 CommandListProcessor::Process(u32 session_id) {
+u64 CommandListProcessor::Process(u32 session_id, VoiceChainProcessor* voice_chain_processor) {
     const auto start_time_{system->CoreTiming().GetGlobalTimeUs().count()};
     const auto command_base{CpuAddr(commands)};
 
@@ -53,8 +79,26 @@ u64 CommandListProcessor::Process(u32 session_id) {
         current_processing_time = 0;
     }
 
+    if (!Settings::values.capture_audio_commands) {
+        capture_writer.reset();
+    } else if (processed_command_count == 0) {
+        if (!capture_writer || !capture_writer->IsCapturing(header->workbuffer)) {
+            capture_writer = std::make_unique<CommandListCaptureWriter>(
+                GetCapturePath(session_id), header->workbuffer);
+        }
+        capture_writer->Record(*this);
+    }
+
     std::string dump{fmt::format("\nSession {}\n", session_id)};
 
+    // Voice chains can only run ahead when the whole list is processed in one go
+    const bool process_voice_chains{voice_chain_processor != nullptr &&
+                                    processed_command_count == 0};
+    if (process_voice_chains) {
+        voice_chain_processor->Process(*this);
+    }
+    u64 estimated_time{0};
+
     for (u32 index = 0; index < command_count; index++) {
         auto& command{*reinterpret_cast<Renderer::ICommand*>(commands)};
 
@@ -83,7 +127,19 @@ u64 CommandListProcessor::Process(u32 session_id) {
         }
 
         if (command.enabled) {
-            command.Process(*this);
+            if (!process_voice_chains || !voice_chain_processor->Commit(*this, index)) {
+                if (command_costs != nullptr) {
+                    const auto command_start{std::chrono::steady_clock::now()};
+                    command.Process(*this);
+                    const auto command_time{std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - command_start)};
+                    command_costs->Record(command.type, command.estimated_process_time,
+                                          static_cast<u64>(command_time.count()));
+                } else {
+                    command.Process(*this);
+                }
+            }
+            estimated_time += command.estimated_process_time;
         } else {
             dump += fmt::format("\tDisabled!\n");
         }
@@ -98,6 +154,34 @@ u64 CommandListProcessor::Process(u32 session_id) {
     }
 
     end_time = system->CoreTiming().GetGlobalTimeUs().count();
+
+    reported_list_count++;
+    reported_process_time += end_time - start_time_;
+    reported_estimated_time += estimated_time;
+    if (target_sample_rate != 0) {
+        reported_budget_time += u64{sample_count} * 1'000'000 / target_sample_rate;
+    }
+    if (process_voice_chains) {
+        reported_chain_count += voice_chain_processor->GetChainCount();
+    }
+    if (reported_list_count >= ReportListCount) {
+        const auto budget_percent = [&](u64 time, u64 budget) {
+            return budget == 0 ? 0.0 : static_cast<f64>(time) * 100.0 / static_cast<f64>(budget);
+        };
+        LOG_DEBUG(Service_Audio,
+                  "Session {} used {:.1f}% of its frame time budget, {:.1f}% was estimated, "
+                  "{:.1f} voice chains per frame ran in parallel",
+                  session_id, budget_percent(reported_process_time, reported_budget_time),
+                  budget_percent(reported_estimated_time,
+                                 u64{Renderer::DspCyclesPerFrame} * reported_list_count),
+                  static_cast<f64>(reported_chain_count) / reported_list_count);
+        reported_list_count = 0;
+        reported_process_time = 0;
+        reported_estimated_time = 0;
+        reported_budget_time = 0;
+        reported_chain_count = 0;
+    }
+
     return end_time - start_time_;
 }
 
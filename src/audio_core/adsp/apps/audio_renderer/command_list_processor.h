@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <memory>
 #include <span>
 
+#include "audio_core/adsp/apps/audio_renderer/command_list_capture.h"
 #include "audio_core/common/common.h"
 #include "audio_core/renderer/command/command_list_header.h"
 #include "common/common_types.h"
@@ -27,9 +29,11 @@ class SinkStream;
 
 namespace Renderer {
 struct CommandListHeader;
-}
+class MeasuredCommandCosts;
+} // namespace Renderer
 
 namespace ADSP::AudioRenderer {
+class VoiceChainProcessor;
 
 /**
  * A processor for command lists given to the AudioRenderer.
@@ -71,18 +75,24 @@ public:
     /**
      * Process the command list.
      *
-     * @param session_id - Session ID for the commands being processed.
+     * @param session_id            - Session ID for the commands being processed.
+     * @param voice_chain_processor - Processor for running the voice commands in parallel, or
+     *                                nullptr to process every command in order.
      *
      * @return The time taken to process.
      */
-    u64 Process(u32 session_id);
+    u64 Process(u32 session_id, VoiceChainProcessor* voice_chain_processor);
 
     /// Core system
     Core::System* system{};
     /// Core memory
     Core::Memory::Memory* memory{};
+    /// Captured guest memory, read in place of core memory when replaying a capture
+    CaptureMemory* capture_memory{};
     /// Stream for the processed samples
     Sink::SinkStream* stream{};
+    /// Host costs to time the processed commands into, or nullptr when they are not measured
+    Renderer::MeasuredCommandCosts* command_costs{};
     /// Header info for this command list
     Renderer::CommandListHeader* header{};
     /// The command buffer
@@ -111,6 +121,18 @@ public:
     u64 end_time{};
     /// Last command list string generated, used for dumping audio commands to console
     std::string last_dump{};
+    /// Writer recording the command lists to a capture file, while capturing audio commands
+    std::unique_ptr<CommandListCaptureWriter> capture_writer{};
+    /// Number of command lists processed since the processing time was last reported
+    u32 reported_list_count{};
+    /// Host time taken to process the lists since the last report, in microseconds
+    u64 reported_process_time{};
+    /// Estimated DSP time for the lists since the last report, in DSP cycles
+    u64 reported_estimated_time{};
+    /// Frame time budget for the lists since the last report, in microseconds
+    u64 reported_budget_time{};
+    /// Number of voice chains processed in parallel since the last report
+    u64 reported_chain_count{};
 };
 
 } // namespace ADSP::AudioRenderer
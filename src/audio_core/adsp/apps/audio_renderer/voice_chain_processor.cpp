@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_chain_processor.h"
+#include "audio_core/renderer/command/commands.h"
+#include "audio_core/renderer/command/measured_command_costs.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+namespace {
+
+/// Below this many chains, handing them to the workers costs more than it saves
+constexpr size_t MinParallelChains{4};
+
+/**
+ * Get the voice mix buffer a data source command decodes into.
+ *
+ * @param command - Command to check.
+ * @return The output mix buffer index, or -1 if the command is not a data source.
+ */
+s16 GetDataSourceOutput(const Renderer::ICommand& command) {
+    switch (command.type) {
+    case Renderer::CommandId::DataSourcePcmInt16Version1:
+        return static_cast<const Renderer::PcmInt16DataSourceVersion1Command&>(command)
+            .output_index;
+    case Renderer::CommandId::DataSourcePcmInt16Version2:
+        return static_cast<const Renderer::PcmInt16DataSourceVersion2Command&>(command)
+            .output_index;
+    case Renderer::CommandId::DataSourcePcmFloatVersion1:
+        return static_cast<const Renderer::PcmFloatDataSourceVersion1Command&>(command)
+            .output_index;
+    case Renderer::CommandId::DataSourcePcmFloatVersion2:
+        return static_cast<const Renderer::PcmFloatDataSourceVersion2Command&>(command)
+            .output_index;
+    case Renderer::CommandId::DataSourceAdpcmVersion1:
+        return static_cast<const Renderer::AdpcmDataSourceVersion1Command&>(command).output_index;
+    case Renderer::CommandId::DataSourceAdpcmVersion2:
+        return static_cast<const Renderer::AdpcmDataSourceVersion2Command&>(command).output_index;
+    default:
+        return -1;
+    }
+}
+
+/**
+ * Check if a command only reads and writes the given mix buffer, so it can continue a voice chain.
+ *
+ * @param command      - Command to check.
+ * @param buffer_index - Mix buffer of the voice chain.
+ * @return True if the command works in place on the buffer, otherwise false.
+ */
+bool IsInPlaceOn(const Renderer::ICommand& command, s16 buffer_index) {
+    switch (command.type) {
+    case Renderer::CommandId::Volume: {
+        const auto& volume{static_cast<const Renderer::VolumeCommand&>(command)};
+        return volume.input_index == buffer_index && volume.output_index == buffer_index;
+    }
+    case Renderer::CommandId::VolumeRamp: {
+        const auto& volume{static_cast<const Renderer::VolumeRampCommand&>(command)};
+        return volume.input_index == buffer_index && volume.output_index == buffer_index;
+    }
+    case Renderer::CommandId::BiquadFilter: {
+        const auto& biquad{static_cast<const Renderer::BiquadFilterCommand&>(command)};
+        return biquad.input == buffer_index && biquad.output == buffer_index;
+    }
+    case Renderer::CommandId::MultiTapBiquadFilter: {
+        const auto& biquad{static_cast<const Renderer::MultiTapBiquadFilterCommand&>(command)};
+        return biquad.input == buffer_index && biquad.output == buffer_index;
+    }
+    default:
+        return false;
+    }
+}
+
+/**
+ * Check if a command can be reordered around a voice chain. These commands never touch the mix
+ * buffers, they stay in order but do not end the chain.
+ *
+ * @param command - Command to check.
+ * @return True if the command does not end a voice chain.
+ */
+bool IsChainNeutral(const Renderer::ICommand& command) {
+    return command.type == Renderer::CommandId::Performance ||
+           command.type == Renderer::CommandId::DepopPrepare;
+}
+
+} // Anonymous namespace
+
+VoiceChainProcessor::VoiceChainProcessor(size_t num_workers_)
+    : workers{num_workers_, "DSP_AudioRenderer_Voice", [] { return std::vector<s32>{}; }},
+      num_workers{num_workers_} {}
+
+VoiceChainProcessor::~VoiceChainProcessor() = default;
+
+void VoiceChainProcessor::FindChains(const CommandListProcessor& processor) {
+    chains.clear();
+    chain_commands.clear();
+    command_chains.assign(processor.command_count, -1);
+
+    const auto max_buffer_index{processor.sample_count == 0
+                                    ? 0
+                                    : processor.mix_buffers.size() / processor.sample_count};
+    const auto close_chain = [&](s32& chain_index) {
+        if (chain_index < 0) {
+            return;
+        }
+        auto& chain{chains[static_cast<size_t>(chain_index)]};
+        chain.command_count = static_cast<u32>(chain_commands.size()) - chain.first_command;
+        chain_index = -1;
+    };
+
+    s32 open_chain{-1};
+    u64 offset{0};
+    for (u32 index = 0; index < processor.command_count; index++) {
+        auto& command{*reinterpret_cast<Renderer::ICommand*>(processor.commands + offset)};
+
+        // Invalid commands stop processing, nothing after them may run early
+        if (command.magic != Renderer::CommandMagic || command.size <= 0 ||
+            offset + command.size > processor.commands_buffer_size ||
+            !command.Verify(processor)) {
+            break;
+        }
+        offset += command.size;
+
+        if (!command.enabled || IsChainNeutral(command)) {
+            continue;
+        }
+
+        if (open_chain >= 0) {
+            auto& chain{chains[static_cast<size_t>(open_chain)]};
+            if (command.node_id == chain.node_id && IsInPlaceOn(command, chain.buffer_index)) {
+                chain_commands.push_back(&command);
+                chain.last_command_index = index;
+                command_chains[index] = open_chain;
+                continue;
+            }
+        }
+        close_chain(open_chain);
+
+        const auto buffer_index{GetDataSourceOutput(command)};
+        if (buffer_index < 0 || static_cast<size_t>(buffer_index) >= max_buffer_index) {
+            continue;
+        }
+
+        open_chain = static_cast<s32>(chains.size());
+        chains.push_back({
+            .node_id = command.node_id,
+            .buffer_index = buffer_index,
+            .first_command = static_cast<u32>(chain_commands.size()),
+            .command_count = 0,
+            .last_command_index = index,
+        });
+        chain_commands.push_back(&command);
+        command_chains[index] = open_chain;
+    }
+    close_chain(open_chain);
+}
+
+void VoiceChainProcessor::Process(const CommandListProcessor& processor) {
+    FindChains(processor);
+    if (chains.size() < MinParallelChains) {
+        chains.clear();
+        command_chains.clear();
+        return;
+    }
+
+    results.resize(chains.size() * processor.sample_count);
+    if (processor.command_costs != nullptr) {
+        chain_command_times.resize(chain_commands.size());
+    }
+    next_chain = 0;
+    for (size_t i = 0; i < num_workers; i++) {
+        workers.QueueWork(
+            [this, &processor](std::vector<s32>* state) { ProcessChains(processor, *state); });
+    }
+    ProcessChains(processor, buffer);
+    workers.WaitForRequests();
+
+    // Costs are only recorded from this thread, each chain's times were written by one worker
+    if (processor.command_costs != nullptr) {
+        for (size_t i = 0; i < chain_commands.size(); i++) {
+            processor.command_costs->Record(chain_commands[i]->type,
+                                            chain_commands[i]->estimated_process_time,
+                                            chain_command_times[i]);
+        }
+    }
+}
+
+void VoiceChainProcessor::ProcessChains(const CommandListProcessor& processor,
+                                        std::vector<s32>& chain_buffer) {
+    chain_buffer.resize(processor.mix_buffers.size());
+
+    CommandListProcessor chain_processor{};
+    chain_processor.system = processor.system;
+    chain_processor.memory = processor.memory;
+    chain_processor.capture_memory = processor.capture_memory;
+    chain_processor.sample_count = processor.sample_count;
+    chain_processor.target_sample_rate = processor.target_sample_rate;
+    chain_processor.mix_buffers = chain_buffer;
+    chain_processor.buffer_count = processor.buffer_count;
+
+    for (size_t index = next_chain++; index < chains.size(); index = next_chain++) {
+        const auto& chain{chains[index]};
+        auto samples{chain_processor.mix_buffers.subspan(
+            chain.buffer_index * processor.sample_count, processor.sample_count)};
+        std::ranges::fill(samples, 0);
+
+        for (u32 i = chain.first_command; i < chain.first_command + chain.command_count; i++) {
+            if (processor.command_costs != nullptr) {
+                const auto command_start{std::chrono::steady_clock::now()};
+                chain_commands[i]->Process(chain_processor);
+                const auto command_time{std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - command_start)};
+                chain_command_times[i] = static_cast<u64>(command_time.count());
+            } else {
+                chain_commands[i]->Process(chain_processor);
+            }
+        }
+        std::ranges::copy(samples, results.begin() + index * processor.sample_count);
+    }
+}
+
+bool VoiceChainProcessor::Commit(const CommandListProcessor& processor, u32 command_index) {
+    if (command_index >= command_chains.size() || command_chains[command_index] < 0) {
+        return false;
+    }
+
+    const auto chain_index{static_cast<size_t>(command_chains[command_index])};
+    const auto& chain{chains[chain_index]};
+    if (chain.last_command_index == command_index) {
+        const auto result{std::span<const s32>(results).subspan(
+            chain_index * processor.sample_count, processor.sample_count)};
+        std::ranges::copy(result, processor.mix_buffers.begin() +
+                                      chain.buffer_index * processor.sample_count);
+    }
+    return true;
+}
+
+u32 VoiceChainProcessor::GetChainCount() const {
+    return static_cast<u32>(chains.size());
+}
+
+} // namespace AudioCore::ADSP::AudioRenderer
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+
+namespace AudioCore::Renderer {
+struct ICommand;
+}
+
+namespace AudioCore::ADSP::AudioRenderer {
+class CommandListProcessor;
+
+/**
+ * Processes the voice-local commands of a command list on a pool of worker threads.
+ *
+ * Each voice channel decodes into a voice mix buffer, then filters and ramps it in place, before
+ * it is mixed into the shared mix buffers. That chain of commands only depends on its own voice,
+ * so the chains of different voices can run in parallel, each in a private buffer. The rest of
+ * the command list is still processed in order, and each chain's result is copied into the voice
+ * mix buffer at the point the chain ended, so the mix stage sees the same samples.
+ *
+ * Voice mix buffers are shared between voices, and are normally left holding the previous voice's
+ * samples. A chain always starts from silence, so a starving voice leaves silence in the samples
+ * it did not decode, rather than another voice's samples.
+ */
+class VoiceChainProcessor {
+public:
+    explicit VoiceChainProcessor(size_t num_workers);
+    ~VoiceChainProcessor();
+
+    /**
+     * Find the voice chains of a command list, and process them on the worker threads.
+     * Must be called before the command list is processed. If the processor measures command
+     * costs, the chain commands are timed and recorded into them once every chain is done.
+     *
+     * @param processor - The command list to process.
+     */
+    void Process(const CommandListProcessor& processor);
+
+    /**
+     * Check if a command was already processed as part of a voice chain. If it was the last
+     * command of its chain, the chain's result is copied into the processor's mix buffers.
+     *
+     * @param processor     - The command list being processed.
+     * @param command_index - Index of the command in the list.
+     * @return True if the command was already processed, otherwise false.
+     */
+    bool Commit(const CommandListProcessor& processor, u32 command_index);
+
+    /**
+     * Get the number of voice chains processed in parallel for the current command list.
+     *
+     * @return The number of voice chains.
+     */
+    u32 GetChainCount() const;
+
+private:
+    struct VoiceChain {
+        /// Node id of the voice this chain was generated from
+        u32 node_id;
+        /// Index of the voice mix buffer processed by this chain
+        s16 buffer_index;
+        /// Offset of the first command of this chain in chain_commands
+        u32 first_command;
+        /// Number of commands in this chain
+        u32 command_count;
+        /// Index of the last command of this chain in the command list
+        u32 last_command_index;
+    };
+
+    /**
+     * Find the voice chains of a command list.
+     *
+     * @param processor - The command list to search.
+     */
+    void FindChains(const CommandListProcessor& processor);
+
+    /**
+     * Process voice chains until none are left, called on every worker and the renderer thread.
+     *
+     * @param processor - The command list being processed.
+     * @param buffer    - Private mix buffers for the calling thread.
+     */
+    void ProcessChains(const CommandListProcessor& processor, std::vector<s32>& buffer);
+
+    /// Worker threads, each with their own private mix buffers
+    Common::StatefulThreadWorker<std::vector<s32>> workers;
+    /// Number of worker threads
+    size_t num_workers;
+    /// Voice chains found in the current command list
+    std::vector<VoiceChain> chains;
+    /// Commands of all voice chains, in order
+    std::vector<Renderer::ICommand*> chain_commands;
+    /// Host time taken by each command in chain_commands, in nanoseconds, when measuring costs
+    std::vector<u64> chain_command_times;
+    /// Chain index of each command in the list, or -1 if it is processed in order
+    std::vector<s32> command_chains;
+    /// Processed samples of each voice chain
+    std::vector<s32> results;
+    /// Private mix buffers for the renderer thread
+    std::vector<s32> buffer;
+    /// Next voice chain to be picked up by a thread
+    std::atomic<size_t> next_chain{};
+};
+
+} // namespace AudioCore::ADSP::AudioRenderer
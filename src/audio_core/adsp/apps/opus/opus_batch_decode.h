@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+#include <span>
+
+#include <opus.h>
+
+#include "audio_core/adsp/apps/opus/shared_memory.h"
+#include "common/common_types.h"
+
+namespace AudioCore::ADSP::OpusDecoder {
+
+/**
+ * Decode a batch of packets in order with one decode object, giving the same results as sending
+ * each packet in its own DecodeInterleaved message. Decoding stops after the first packet which
+ * fails, as the decoder state past it is undefined.
+ *
+ * @param decoder_object - Decode object to decode with, at the start of its workbuffer.
+ * @param packets        - Packets to decode.
+ * @param results        - Receives the result of each packet, must be as large as packets.
+ * @param reset          - Reset the decoder before the first packet.
+ * @param state_size     - Size of the decode object state, copied to a packet's state_data.
+ * @param get_time       - Returns the current time in microseconds, used to time each packet.
+ * @return The number of packets processed, including a failed one.
+ */
+template <typename DecodeObject, typename GetTime>
+u32 DecodeBatch(DecodeObject& decoder_object, std::span<const DecodeBatchPacket> packets,
+                std::span<DecodeBatchResult> results, bool reset, u64 state_size,
+                GetTime&& get_time) {
+    u32 processed{0};
+    for (const auto& packet : packets) {
+        const auto start_time{get_time()};
+        auto& result{results[processed++]};
+
+        s32 error_code{OPUS_OK};
+        if (reset && processed == 1) {
+            error_code = decoder_object.ResetDecoder();
+        }
+
+        u32 decoded_samples{0};
+        if (error_code == OPUS_OK) {
+            error_code =
+                decoder_object.Decode(decoded_samples, packet.output_data, packet.output_data_size,
+                                      packet.input_data, packet.input_data_size);
+        }
+
+        if (error_code == OPUS_OK) {
+            if (packet.final_range && decoder_object.GetFinalRange() != packet.final_range) {
+                error_code = OPUS_INVALID_PACKET;
+            }
+        }
+
+        result.error_code = error_code;
+        result.decoded_samples = decoded_samples;
+        result.time_taken = static_cast<u64>(get_time() - start_time);
+        if (error_code != OPUS_OK) {
+            break;
+        }
+
+        if (packet.state_data != 0) {
+            std::memcpy(reinterpret_cast<void*>(packet.state_data), &decoder_object, state_size);
+        }
+    }
+    return processed;
+}
+
+} // namespace AudioCore::ADSP::OpusDecoder
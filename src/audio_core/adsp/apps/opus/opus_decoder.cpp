@@ -4,6 +4,7 @@
 #include <array>
 #include <chrono>
 
+#include "audio_core/adsp/apps/opus/opus_batch_decode.h"
 #include "audio_core/adsp/apps/opus/opus_decode_object.h"
 #include "audio_core/adsp/apps/opus/opus_multistream_decode_object.h"
 #include "audio_core/adsp/apps/opus/shared_memory.h"
@@ -259,6 +260,33 @@ void OpusDecoder::Main(std::stop_token stop_token) {
             Send(Direction::Host, Message::DecodeInterleavedForMultiStreamOK);
         } break;
 
+        case DecodeInterleavedBatch: {
+            auto buffer = shared_memory->host_send_data[0];
+            auto packet_count = shared_memory->host_send_data[1];
+            auto multistream = shared_memory->host_send_data[2];
+            auto reset_requested = shared_memory->host_send_data[3] != 0;
+            auto state_size = shared_memory->host_send_data[4];
+
+            ASSERT(packet_count > 0 && packet_count <= MaxBatchedPackets);
+
+            const auto packets{
+                std::span(shared_memory->batch_packets).first(static_cast<size_t>(packet_count))};
+            const auto get_time = [this] { return system.CoreTiming().GetGlobalTimeUs().count(); };
+            u32 processed{};
+            if (multistream) {
+                auto& decoder_object = OpusMultiStreamDecodeObject::Initialize(buffer, buffer);
+                processed = DecodeBatch(decoder_object, packets, shared_memory->batch_results,
+                                        reset_requested, state_size, get_time);
+            } else {
+                auto& decoder_object = OpusDecodeObject::Initialize(buffer, buffer);
+                processed = DecodeBatch(decoder_object, packets, shared_memory->batch_results,
+                                        reset_requested, state_size, get_time);
+            }
+
+            shared_memory->dsp_return_data[0] = processed;
+            Send(Direction::Host, Message::DecodeInterleavedBatchOK);
+        } break;
+
         default:
             LOG_ERROR(Service_Audio, "Invalid OpusDecoder command {}", msg);
             continue;
@@ -32,6 +32,7 @@ enum Message : u32 {
     InitializeMultiStreamDecodeObject = 28,
     ShutdownMultiStreamDecodeObject = 29,
     DecodeInterleavedForMultiStream = 30,
+    DecodeInterleavedBatch = 31,
 
     GetWorkBufferSizeOK = 41,
     InitializeDecodeObjectOK = 42,
@@ -43,6 +44,7 @@ enum Message : u32 {
     InitializeMultiStreamDecodeObjectOK = 48,
     ShutdownMultiStreamDecodeObjectOK = 49,
     DecodeInterleavedForMultiStreamOK = 50,
+    DecodeInterleavedBatchOK = 51,
 };
 
 /**
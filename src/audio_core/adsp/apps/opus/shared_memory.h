@@ -3,15 +3,41 @@
 
 #pragma once
 
+#include <array>
+
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 
 namespace AudioCore::ADSP::OpusDecoder {
 
+/// Maximum number of packets decoded by one DecodeInterleavedBatch message
+constexpr size_t MaxBatchedPackets = 4;
+
+/// A packet to decode as part of a DecodeInterleavedBatch message
+struct DecodeBatchPacket {
+    u64 input_data;
+    u64 input_data_size;
+    u64 output_data;
+    u64 output_data_size;
+    u32 final_range;
+    /// Where to save the decode object state once this packet is decoded, or 0 to not save it
+    u64 state_data;
+};
+
+/// The result of decoding one packet of a DecodeInterleavedBatch message
+struct DecodeBatchResult {
+    s32 error_code;
+    u32 decoded_samples;
+    /// Time taken to decode the packet, in microseconds
+    u64 time_taken;
+};
+
 struct SharedMemory {
     std::array<u8, 0x100> channel_mapping{};
     std::array<u64, 16> host_send_data{};
     std::array<u64, 16> dsp_return_data{};
+    std::array<DecodeBatchPacket, MaxBatchedPackets> batch_packets{};
+    std::array<DecodeBatchResult, MaxBatchedPackets> batch_results{};
 };
 
 } // namespace AudioCore::ADSP::OpusDecoder
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+// Allows SSE4.1 or AVX2 intrinsics in a function without building the whole target for them.
+// MSVC accepts the intrinsics without it.
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define AUDIO_CORE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define AUDIO_CORE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AUDIO_CORE_TARGET_SSE41
+#define AUDIO_CORE_TARGET_AVX2
+#endif
+
+namespace AudioCore {
+
+/**
+ * Check if the host can run the SSE4.1 DSP kernels.
+ *
+ * @return True if SSE4.1 is supported, always false on non-x86 hosts.
+ */
+inline bool HasSse41() {
+#if defined(ARCHITECTURE_x86_64)
+    static const bool has_sse41{Common::GetCPUCaps().sse4_1};
+    return has_sse41;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Check if the host can run the AVX2 DSP kernels.
+ *
+ * @return True if AVX2 is supported, always false on non-x86 hosts.
+ */
+inline bool HasAvx2() {
+#if defined(ARCHITECTURE_x86_64)
+    static const bool has_avx2{Common::GetCPUCaps().avx2};
+    return has_avx2;
+#else
+    return false;
+#endif
+}
+
+} // namespace AudioCore
@@ -1,6 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
+
+#include "audio_core/adsp/apps/opus/opus_decode_object.h"
+#include "audio_core/adsp/apps/opus/opus_multistream_decode_object.h"
 #include "audio_core/opus/decoder.h"
 #include "audio_core/opus/hardware_opus.h"
 #include "audio_core/opus/parameters.h"
@@ -11,6 +16,10 @@
 namespace AudioCore::OpusDecoder {
 using namespace Service::Audio;
 namespace {
+/// Decode object states larger than this are not copied to decode ahead, it would cost more than
+/// the requests it saves
+constexpr u64 MaxReadAheadStateSize = 0x10000;
+
 OpusPacketHeader ReverseHeader(OpusPacketHeader header) {
     OpusPacketHeader out;
     out.size = Common::swap32(header.size);
@@ -23,8 +32,14 @@ OpusDecoder::OpusDecoder(Core::System& system_, HardwareOpus& hardware_opus_)
     : system{system_}, hardware_opus{hardware_opus_} {}
 
 OpusDecoder::~OpusDecoder() {
-    if (decode_object_initialized) {
+    if (!decode_object_initialized) {
+        return;
+    }
+    if (is_multistream) {
         hardware_opus.ShutdownDecodeObject(shared_buffer.get(), shared_buffer_size);
+    } else {
+        hardware_opus.ReleaseDecoderState(std::move(shared_buffer), shared_buffer_size,
+                                          sample_rate, channel_count);
     }
 }
 
@@ -32,7 +47,14 @@ Result OpusDecoder::Initialize(const OpusParametersEx& params,
                                Kernel::KTransferMemory* transfer_memory, u64 transfer_memory_size) {
     auto frame_size{params.use_large_frame_size ? 5760 : 1920};
     shared_buffer_size = transfer_memory_size;
-    shared_buffer = std::make_unique<u8[]>(shared_buffer_size);
+    // Reuse the decode object of a closed session with the same parameters if there is one,
+    // it only needs a reset rather than a full initialization
+    shared_buffer = hardware_opus.AcquireDecoderState(shared_buffer_size, params.sample_rate,
+                                                      params.channel_count);
+    const bool reused_state{shared_buffer != nullptr};
+    if (!reused_state) {
+        shared_buffer = std::make_unique<u8[]>(shared_buffer_size);
+    }
     shared_memory_mapped = true;
 
     buffer_size =
@@ -49,9 +71,13 @@ Result OpusDecoder::Initialize(const OpusParametersEx& params,
         }
     };
 
-    R_TRY(hardware_opus.InitializeDecodeObject(params.sample_rate, params.channel_count,
-                                               shared_buffer.get(), shared_buffer_size));
+    if (!reused_state) {
+        R_TRY(hardware_opus.InitializeDecodeObject(params.sample_rate, params.channel_count,
+                                                   shared_buffer.get(), shared_buffer_size));
+    }
 
+    state_size = ADSP::OpusDecoder::OpusDecodeObject::GetWorkBufferSize(params.channel_count);
+    needs_reset = reused_state;
     sample_rate = params.sample_rate;
     channel_count = params.channel_count;
     use_large_frame_size = params.use_large_frame_size;
@@ -85,6 +111,9 @@ Result OpusDecoder::Initialize(const OpusMultiStreamParametersEx& params,
         params.stereo_stream_count, params.mappings.data(), shared_buffer.get(),
         shared_buffer_size));
 
+    state_size = ADSP::OpusDecoder::OpusMultiStreamDecodeObject::GetWorkBufferSize(
+        params.total_stream_count, params.stereo_stream_count);
+    is_multistream = true;
     sample_rate = params.sample_rate;
     channel_count = params.channel_count;
     total_stream_count = params.total_stream_count;
@@ -97,37 +126,8 @@ Result OpusDecoder::Initialize(const OpusMultiStreamParametersEx& params,
 Result OpusDecoder::DecodeInterleaved(u32* out_data_size, u64* out_time_taken,
                                       u32* out_sample_count, std::span<const u8> input_data,
                                       std::span<u8> output_data, bool reset) {
-    u32 out_samples;
-    u64 time_taken{};
-
-    R_UNLESS(input_data.size_bytes() > sizeof(OpusPacketHeader), ResultInputDataTooSmall);
-
-    auto* header_p{reinterpret_cast<const OpusPacketHeader*>(input_data.data())};
-    OpusPacketHeader header{ReverseHeader(*header_p)};
-
-    R_UNLESS(in_data.size_bytes() >= header.size &&
-                 header.size + sizeof(OpusPacketHeader) <= input_data.size_bytes(),
-             ResultBufferTooSmall);
-
-    if (!shared_memory_mapped) {
-        R_TRY(hardware_opus.MapMemory(shared_buffer.get(), shared_buffer_size));
-        shared_memory_mapped = true;
-    }
-
-    std::memcpy(in_data.data(), input_data.data() + sizeof(OpusPacketHeader), header.size);
-
-    R_TRY(hardware_opus.DecodeInterleaved(out_samples, out_data.data(), out_data.size_bytes(),
-                                          channel_count, in_data.data(), header.size,
-                                          shared_buffer.get(), time_taken, reset));
-
-    std::memcpy(output_data.data(), out_data.data(), out_samples * channel_count * sizeof(s16));
-
-    *out_data_size = header.size + sizeof(OpusPacketHeader);
-    *out_sample_count = out_samples;
-    if (out_time_taken) {
-        *out_time_taken = time_taken / 1000;
-    }
-    R_SUCCEED();
+    R_RETURN(DecodePacket(out_data_size, out_time_taken, out_sample_count, input_data,
+                          output_data, reset));
 }
 
 Result OpusDecoder::SetContext([[maybe_unused]] std::span<const u8> context) {
@@ -140,9 +140,13 @@ Result OpusDecoder::DecodeInterleavedForMultiStream(u32* out_data_size, u64* out
                                                     u32* out_sample_count,
                                                     std::span<const u8> input_data,
                                                     std::span<u8> output_data, bool reset) {
-    u32 out_samples;
-    u64 time_taken{};
+    R_RETURN(DecodePacket(out_data_size, out_time_taken, out_sample_count, input_data,
+                          output_data, reset));
+}
 
+Result OpusDecoder::DecodePacket(u32* out_data_size, u64* out_time_taken, u32* out_sample_count,
+                                 std::span<const u8> input_data, std::span<u8> output_data,
+                                 bool reset) {
     R_UNLESS(input_data.size_bytes() > sizeof(OpusPacketHeader), ResultInputDataTooSmall);
 
     auto* header_p{reinterpret_cast<const OpusPacketHeader*>(input_data.data())};
@@ -160,20 +164,127 @@ Result OpusDecoder::DecodeInterleavedForMultiStream(u32* out_data_size, u64* out
         shared_memory_mapped = true;
     }
 
-    std::memcpy(in_data.data(), input_data.data() + sizeof(OpusPacketHeader), header.size);
-
-    R_TRY(hardware_opus.DecodeInterleavedForMultiStream(
-        out_samples, out_data.data(), out_data.size_bytes(), channel_count, in_data.data(),
-        header.size, shared_buffer.get(), time_taken, reset));
+    const auto packet_size{header.size + sizeof(OpusPacketHeader)};
+    ADSP::OpusDecoder::DecodeBatchResult result{};
+    const u8* samples{};
+    if (!reset && !needs_reset && MatchesReadAhead(input_data.first(packet_size))) {
+        samples = read_ahead_output.data() + read_ahead_next * buffer_size;
+        result = read_ahead[read_ahead_next++].result;
+    } else {
+        DiscardReadAhead();
+        R_TRY(DecodeWithReadAhead(result, input_data, packet_size, reset || needs_reset));
+        needs_reset = false;
+        samples = out_data.data();
+    }
+    R_TRY(HardwareOpus::ResultFromLibOpusErrorCode(result.error_code));
 
-    std::memcpy(output_data.data(), out_data.data(), out_samples * channel_count * sizeof(s16));
+    std::memcpy(output_data.data(), samples,
+                result.decoded_samples * channel_count * sizeof(s16));
 
-    *out_data_size = header.size + sizeof(OpusPacketHeader);
-    *out_sample_count = out_samples;
+    *out_data_size = static_cast<u32>(packet_size);
+    *out_sample_count = result.decoded_samples;
     if (out_time_taken) {
-        *out_time_taken = time_taken / 1000;
+        *out_time_taken = result.time_taken;
     }
     R_SUCCEED();
 }
 
+Result OpusDecoder::DecodeWithReadAhead(ADSP::OpusDecoder::DecodeBatchResult& out_result,
+                                        std::span<const u8> input_data, size_t packet_size,
+                                        bool reset) {
+    using ADSP::OpusDecoder::MaxBatchedPackets;
+
+    // The first packet is decoded from the workbuffer, as it always has been
+    std::array<ADSP::OpusDecoder::DecodeBatchPacket, MaxBatchedPackets> packets{};
+    std::memcpy(in_data.data(), input_data.data() + sizeof(OpusPacketHeader),
+                packet_size - sizeof(OpusPacketHeader));
+    packets[0] = {
+        .input_data = reinterpret_cast<u64>(in_data.data()),
+        .input_data_size = packet_size - sizeof(OpusPacketHeader),
+        .output_data = reinterpret_cast<u64>(out_data.data()),
+        .output_data_size = out_data.size_bytes(),
+        .final_range = 0,
+        .state_data = 0,
+    };
+
+    // Games hand over their whole stream buffer, so the packets after this one are usually the
+    // ones asked for next. Decode those too, saving the decoder state between each so it can be
+    // put back if the guest asks for something else.
+    const auto input_slot_size{sizeof(OpusPacketHeader) + in_data.size_bytes()};
+    if (state_size != 0 && state_size <= MaxReadAheadStateSize && read_ahead_states.empty()) {
+        read_ahead_input.resize(MaxBatchedPackets * input_slot_size);
+        read_ahead_output.resize(MaxBatchedPackets * buffer_size);
+        read_ahead_states.resize(MaxBatchedPackets * state_size);
+    }
+
+    size_t count{1};
+    size_t offset{packet_size};
+    while (!read_ahead_states.empty() && count < MaxBatchedPackets) {
+        const auto remaining{input_data.subspan(offset)};
+        if (remaining.size_bytes() <= sizeof(OpusPacketHeader)) {
+            break;
+        }
+        const auto header{
+            ReverseHeader(*reinterpret_cast<const OpusPacketHeader*>(remaining.data()))};
+        if (header.size > in_data.size_bytes() ||
+            header.size + sizeof(OpusPacketHeader) > remaining.size_bytes()) {
+            break;
+        }
+
+        const auto next_size{header.size + sizeof(OpusPacketHeader)};
+        auto* const input{read_ahead_input.data() + count * input_slot_size};
+        std::memcpy(input, remaining.data(), next_size);
+        packets[count] = {
+            .input_data = reinterpret_cast<u64>(input + sizeof(OpusPacketHeader)),
+            .input_data_size = header.size,
+            .output_data = reinterpret_cast<u64>(read_ahead_output.data() + count * buffer_size),
+            .output_data_size = buffer_size,
+            .final_range = 0,
+            .state_data = 0,
+        };
+        packets[count - 1].state_data =
+            reinterpret_cast<u64>(read_ahead_states.data() + (count - 1) * state_size);
+        read_ahead[count] = {
+            .input_offset = count * input_slot_size,
+            .packet_size = next_size,
+            .result = {},
+        };
+        offset += next_size;
+        count++;
+    }
+
+    std::array<ADSP::OpusDecoder::DecodeBatchResult, MaxBatchedPackets> results{};
+    u32 processed{};
+    R_TRY(hardware_opus.DecodeInterleavedBatch(processed, std::span(packets).first(count), results,
+                                               shared_buffer.get(), state_size, is_multistream,
+                                               reset));
+
+    for (u32 i = 1; i < processed; i++) {
+        read_ahead[i].result = results[i];
+    }
+    read_ahead_count = processed;
+    read_ahead_next = 1;
+    out_result = results[0];
+    R_SUCCEED();
+}
+
+bool OpusDecoder::MatchesReadAhead(std::span<const u8> packet) const {
+    if (read_ahead_next >= read_ahead_count) {
+        return false;
+    }
+    const auto& next{read_ahead[read_ahead_next]};
+    return next.packet_size == packet.size_bytes() &&
+           std::memcmp(read_ahead_input.data() + next.input_offset, packet.data(),
+                       packet.size_bytes()) == 0;
+}
+
+void OpusDecoder::DiscardReadAhead() {
+    if (read_ahead_next < read_ahead_count) {
+        std::memcpy(shared_buffer.get(),
+                    read_ahead_states.data() + (read_ahead_next - 1) * state_size, state_size);
+    }
+    read_ahead_count = 0;
+    read_ahead_next = 0;
+}
+
 } // namespace AudioCore::OpusDecoder
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <span>
+#include <vector>
 
+#include "audio_core/adsp/apps/opus/shared_memory.h"
 #include "audio_core/opus/parameters.h"
 #include "common/common_types.h"
 #include "core/hle/kernel/k_transfer_memory.h"
@@ -34,6 +37,58 @@ public:
                                            std::span<u8> output_data, bool reset);
 
 private:
+    /// A packet the DSP decoded ahead of the guest asking for it
+    struct ReadAheadPacket {
+        /// Offset of the packet's header and data in read_ahead_input
+        size_t input_offset;
+        /// Size of the packet's header and data
+        size_t packet_size;
+        /// Result of decoding the packet
+        ADSP::OpusDecoder::DecodeBatchResult result;
+    };
+
+    /**
+     * Decode the packet at the start of the input data. The packets following it are decoded in
+     * the same request to the DSP, and returned from there if the guest asks for them next.
+     *
+     * @param out_data_size    - Receives the number of input bytes consumed.
+     * @param out_time_taken   - Receives the time taken to decode, may be nullptr.
+     * @param out_sample_count - Receives the number of samples per channel decoded.
+     * @param input_data       - Packets to decode, starting with a packet header.
+     * @param output_data      - Receives the decoded samples.
+     * @param reset            - Reset the decoder before decoding.
+     * @return Result of the decode.
+     */
+    Result DecodePacket(u32* out_data_size, u64* out_time_taken, u32* out_sample_count,
+                        std::span<const u8> input_data, std::span<u8> output_data, bool reset);
+
+    /**
+     * Send the packet at the start of the input data to the DSP, along with as many of the
+     * packets following it as fit in one request.
+     *
+     * @param out_result  - Receives the result of the first packet.
+     * @param input_data  - Packets to decode, starting with a packet header.
+     * @param packet_size - Size of the first packet, including its header.
+     * @param reset       - Reset the decoder before the first packet.
+     * @return Result of the request.
+     */
+    Result DecodeWithReadAhead(ADSP::OpusDecoder::DecodeBatchResult& out_result,
+                               std::span<const u8> input_data, size_t packet_size, bool reset);
+
+    /**
+     * Check if the next packet decoded ahead is the given packet.
+     *
+     * @param packet - Packet header and data to check.
+     * @return True if the packet was decoded ahead, otherwise false.
+     */
+    bool MatchesReadAhead(std::span<const u8> packet) const;
+
+    /**
+     * Drop the packets decoded ahead, and put back the decoder state from just after the last
+     * packet returned to the guest.
+     */
+    void DiscardReadAhead();
+
     Core::System& system;
     HardwareOpus& hardware_opus;
     std::unique_ptr<u8[]> shared_buffer{};
@@ -48,6 +103,23 @@ private:
     s32 stereo_stream_count{};
     bool shared_memory_mapped{false};
     bool decode_object_initialized{false};
+    bool is_multistream{false};
+    /// Set when the decode object came from the pool, and must be reset before the first decode
+    bool needs_reset{false};
+    /// Size of the decode object state at the start of the workbuffer, 0 to not decode ahead
+    u64 state_size{};
+    /// Copies of the packets decoded ahead, each slot holding a header and up to in_data's size
+    std::vector<u8> read_ahead_input{};
+    /// Samples of the packets decoded ahead, in slots of buffer_size
+    std::vector<u8> read_ahead_output{};
+    /// Decode object state after each packet decoded ahead, in slots of state_size
+    std::vector<u8> read_ahead_states{};
+    /// Packets of the last request to the DSP, the first was returned straight away
+    std::array<ReadAheadPacket, ADSP::OpusDecoder::MaxBatchedPackets> read_ahead{};
+    /// Number of packets in read_ahead
+    u32 read_ahead_count{};
+    /// Index of the next packet in read_ahead to return
+    u32 read_ahead_next{};
 };
 
 } // namespace AudioCore::OpusDecoder
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 
 #include "audio_core/audio_core.h"
@@ -11,6 +12,9 @@ namespace AudioCore::OpusDecoder {
 namespace {
 using namespace Service::Audio;
 
+/// Maximum number of closed sessions' decode objects kept for reuse
+constexpr size_t MaxPooledDecoderStates = 8;
+
 static constexpr Result ResultCodeFromLibOpusErrorCode(u64 error_code) {
     s32 error{static_cast<s32>(error_code)};
     ASSERT(error <= OPUS_OK);
@@ -209,6 +213,68 @@ Result HardwareOpus::DecodeInterleavedForMultiStream(u32& out_sample_count, void
     R_RETURN(ResultCodeFromLibOpusErrorCode(error_code));
 }
 
+Result HardwareOpus::DecodeInterleavedBatch(
+    u32& out_processed, std::span<const ADSP::OpusDecoder::DecodeBatchPacket> packets,
+    std::span<ADSP::OpusDecoder::DecodeBatchResult> results, void* buffer, u64 state_size,
+    bool multistream, bool reset) {
+    ASSERT(!packets.empty() && packets.size() <= ADSP::OpusDecoder::MaxBatchedPackets);
+    ASSERT(results.size() >= packets.size());
+
+    std::scoped_lock l{mutex};
+    std::ranges::copy(packets, shared_memory.batch_packets.begin());
+    shared_memory.host_send_data[0] = (u64)buffer;
+    shared_memory.host_send_data[1] = packets.size();
+    shared_memory.host_send_data[2] = multistream;
+    shared_memory.host_send_data[3] = reset;
+    shared_memory.host_send_data[4] = state_size;
+
+    opus_decoder.Send(ADSP::Direction::DSP, ADSP::OpusDecoder::Message::DecodeInterleavedBatch);
+    auto msg = opus_decoder.Receive(ADSP::Direction::Host);
+    if (msg != ADSP::OpusDecoder::Message::DecodeInterleavedBatchOK) {
+        LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
+                  ADSP::OpusDecoder::Message::DecodeInterleavedBatchOK, msg);
+        R_THROW(ResultInvalidOpusDSPReturnCode);
+    }
+
+    out_processed = static_cast<u32>(shared_memory.dsp_return_data[0]);
+    std::copy_n(shared_memory.batch_results.begin(), out_processed, results.begin());
+    R_SUCCEED();
+}
+
+std::unique_ptr<u8[]> HardwareOpus::AcquireDecoderState(u64 buffer_size, u32 sample_rate,
+                                                        u32 channel_count) {
+    std::scoped_lock l{pool_mutex};
+    const auto it = std::ranges::find_if(decoder_state_pool, [&](const PooledDecoderState& state) {
+        return state.buffer_size == buffer_size && state.sample_rate == sample_rate &&
+               state.channel_count == channel_count;
+    });
+    if (it == decoder_state_pool.end()) {
+        return nullptr;
+    }
+    auto buffer{std::move(it->buffer)};
+    decoder_state_pool.erase(it);
+    return buffer;
+}
+
+void HardwareOpus::ReleaseDecoderState(std::unique_ptr<u8[]> buffer, u64 buffer_size,
+                                       u32 sample_rate, u32 channel_count) {
+    std::scoped_lock l{pool_mutex};
+    // The decode objects live entirely in host memory, so an evicted one can just be freed
+    if (decoder_state_pool.size() >= MaxPooledDecoderStates) {
+        decoder_state_pool.erase(decoder_state_pool.begin());
+    }
+    decoder_state_pool.push_back({
+        .buffer = std::move(buffer),
+        .buffer_size = buffer_size,
+        .sample_rate = sample_rate,
+        .channel_count = channel_count,
+    });
+}
+
+Result HardwareOpus::ResultFromLibOpusErrorCode(s32 error_code) {
+    R_RETURN(ResultCodeFromLibOpusErrorCode(static_cast<u64>(error_code)));
+}
+
 Result HardwareOpus::MapMemory(void* buffer, u64 buffer_size) {
     std::scoped_lock l{mutex};
     shared_memory.host_send_data[0] = (u64)buffer;
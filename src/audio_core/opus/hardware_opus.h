@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
+#include <span>
+#include <vector>
 #include <opus.h>
 
 #include "audio_core/adsp/apps/opus/opus_decoder.h"
@@ -36,10 +39,70 @@ public:
     Result MapMemory(void* buffer, u64 buffer_size);
     Result UnmapMemory(void* buffer, u64 buffer_size);
 
+    /**
+     * Decode several packets in order in one request to the DSP.
+     *
+     * @param out_processed - Receives the number of packets processed, decoding stops after the
+     *                        first packet which fails.
+     * @param packets       - Packets to decode, at most MaxBatchedPackets.
+     * @param results       - Receives the result of each processed packet.
+     * @param buffer        - Workbuffer of the decode object.
+     * @param state_size    - Size of the decode object state, saved after packets which ask.
+     * @param multistream   - Whether the decode object is a multistream one.
+     * @param reset         - Reset the decoder before the first packet.
+     * @return Result of the request, the result of each packet is in results.
+     */
+    Result DecodeInterleavedBatch(u32& out_processed,
+                                  std::span<const ADSP::OpusDecoder::DecodeBatchPacket> packets,
+                                  std::span<ADSP::OpusDecoder::DecodeBatchResult> results,
+                                  void* buffer, u64 state_size, bool multistream, bool reset);
+
+    /**
+     * Take a workbuffer holding an initialized decode object from a closed session, if one
+     * matching the parameters is pooled. Its decoder must be reset before the first decode.
+     *
+     * @param buffer_size   - Size of the workbuffer.
+     * @param sample_rate   - Sample rate of the decoder.
+     * @param channel_count - Channel count of the decoder.
+     * @return The workbuffer, or nullptr if none was pooled.
+     */
+    std::unique_ptr<u8[]> AcquireDecoderState(u64 buffer_size, u32 sample_rate,
+                                              u32 channel_count);
+
+    /**
+     * Return the workbuffer of a closing session to the pool, with its decode object still
+     * initialized, so a later session with the same parameters can skip initialization.
+     *
+     * @param buffer        - Workbuffer of the decode object.
+     * @param buffer_size   - Size of the workbuffer.
+     * @param sample_rate   - Sample rate of the decoder.
+     * @param channel_count - Channel count of the decoder.
+     */
+    void ReleaseDecoderState(std::unique_ptr<u8[]> buffer, u64 buffer_size, u32 sample_rate,
+                             u32 channel_count);
+
+    /**
+     * Get the result matching an error code returned by libopus on the DSP.
+     *
+     * @param error_code - libopus error code.
+     * @return The matching result.
+     */
+    static Result ResultFromLibOpusErrorCode(s32 error_code);
+
 private:
+    /// An initialized decode object from a closed session, waiting to be reused
+    struct PooledDecoderState {
+        std::unique_ptr<u8[]> buffer;
+        u64 buffer_size;
+        u32 sample_rate;
+        u32 channel_count;
+    };
+
     Core::System& system;
     std::mutex mutex;
     ADSP::OpusDecoder::OpusDecoder& opus_decoder;
     ADSP::OpusDecoder::SharedMemory shared_memory;
+    std::mutex pool_mutex;
+    std::vector<PooledDecoderState> decoder_state_pool;
 };
 } // namespace AudioCore::OpusDecoder
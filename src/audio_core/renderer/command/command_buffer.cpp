@@ -5,6 +5,7 @@
 #include "audio_core/renderer/command/command_buffer.h"
 #include "audio_core/renderer/command/command_list_header.h"
 #include "audio_core/renderer/command/command_processing_time_estimator.h"
+#include "audio_core/renderer/command/measured_command_costs.h"
 #include "audio_core/renderer/effect/biquad_filter.h"
 #include "audio_core/renderer/effect/delay.h"
 #include "audio_core/renderer/effect/reverb.h"
@@ -41,7 +42,10 @@ T& CommandBuffer::GenerateStart(const s32 node_id) {
 template <typename T>
 void CommandBuffer::GenerateEnd(T& cmd) {
     cmd.estimated_process_time = time_estimator->Estimate(cmd);
-    estimated_process_time += cmd.estimated_process_time;
+    // The command keeps the console estimate, which identifies its variant in the measured costs
+    estimated_process_time += measured_costs != nullptr
+                                  ? measured_costs->Estimate(cmd.type, cmd.estimated_process_time)
+                                  : cmd.estimated_process_time;
     size += sizeof(T);
     count++;
 }
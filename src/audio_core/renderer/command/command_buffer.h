@@ -15,6 +15,7 @@ struct UpsamplerInfo;
 struct VoiceState;
 class EffectInfoBase;
 class ICommandProcessingTimeEstimator;
+class MeasuredCommandCosts;
 class MixInfo;
 class MemoryPoolInfo;
 class SinkInfoBase;
@@ -455,6 +456,8 @@ public:
     MemoryPoolInfo* memory_pool{};
     /// Used for estimating command process times
     ICommandProcessingTimeEstimator* time_estimator{};
+    /// Host costs to total the estimated processing time from, or nullptr to use the estimates
+    const MeasuredCommandCosts* measured_costs{};
     /// Used to check which rendering features are currently enabled
     BehaviorInfo* behavior{};
 
@@ -17,6 +17,7 @@ struct CommandListHeader {
     s16 buffer_count;
     u32 sample_count;
     u32 sample_rate;
+    std::span<u8> workbuffer;
 };
 
 } // namespace AudioCore::Renderer
@@ -4,6 +4,8 @@
 #include <array>
 #include <vector>
 
+#include "audio_core/adsp/apps/audio_renderer/command_list_capture.h"
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/data_source/decode.h"
 #include "audio_core/renderer/command/resample/resample.h"
 #include "common/fixed_point.h"
@@ -21,14 +23,14 @@ constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
  * Decode PCM data. Only s16 or f32 is supported.
  *
  * @tparam T         - Type to decode. Only s16 and f32 are supported.
+ * @tparam Memory    - Type of memory to read samples from, core or captured memory.
  * @param memory     - Core memory for reading samples.
  * @param out_buffer - Output mix buffer to receive the samples.
  * @param req        - Information for how to decode.
  * @return Number of samples decoded.
  */
-template <typename T>
-static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
-                     const DecodeArg& req) {
+template <typename T, typename Memory>
+static u32 DecodePcm(Memory& memory, std::span<s16> out_buffer, const DecodeArg& req) {
     constexpr s32 min{std::numeric_limits<s16>::min()};
     constexpr s32 max{std::numeric_limits<s16>::max()};
 
@@ -50,7 +52,7 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
                            (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
         const u64 size{channel_count * samples_to_decode};
 
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
+        Core::Memory::GuestMemory<Memory, T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
             memory, source, size);
         if constexpr (std::is_floating_point_v<T>) {
             for (u32 i = 0; i < samples_to_decode; i++) {
@@ -73,7 +75,7 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         }
 
         const VAddr source{req.buffer + ((req.start_offset + req.offset) * sizeof(T))};
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
+        Core::Memory::GuestMemory<Memory, T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
             memory, source, samples_to_decode);
 
         if constexpr (std::is_floating_point_v<T>) {
@@ -91,17 +93,39 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
     return samples_to_decode;
 }
 
+void DecodeAdpcmFrame(std::span<s16, AdpcmSamplesPerFrame> output,
+                      std::span<const u8, AdpcmSamplesPerFrame / 2> data, u8 scale, s32 coeff0,
+                      s32 coeff1, s16& yn0, s16& yn1) {
+    // Sign extend each nibble and apply the scale, this part has no dependency between samples
+    std::array<s32, AdpcmSamplesPerFrame> scaled;
+    for (u32 i = 0; i < AdpcmSamplesPerFrame; i++) {
+        const u8 nibble{static_cast<u8>((i & 1) != 0 ? data[i / 2] & 0xF : data[i / 2] >> 4)};
+        const s32 code{static_cast<s8>(nibble << 4) >> 4};
+        const s32 xn{code * (1 << scale)};
+        scaled[i] = (xn << 11) + 0x400;
+    }
+
+    for (u32 i = 0; i < AdpcmSamplesPerFrame; i++) {
+        const s32 prediction{coeff0 * yn0 + coeff1 * yn1};
+        const s32 sample{(scaled[i] + prediction) >> 11};
+        yn1 = yn0;
+        yn0 = static_cast<s16>(std::clamp<s32>(sample, -0x8000, 0x7FFF));
+        output[i] = yn0;
+    }
+}
+
 /**
  * Decode ADPCM data.
  *
+ * @tparam Memory    - Type of memory to read samples from, core or captured memory.
  * @param memory     - Core memory for reading samples.
  * @param out_buffer - Output mix buffer to receive the samples.
  * @param req        - Information for how to decode.
  * @return Number of samples decoded.
  */
-static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
-                       const DecodeArg& req) {
-    constexpr u32 SamplesPerFrame{14};
+template <typename Memory>
+static u32 DecodeAdpcm(Memory& memory, std::span<s16> out_buffer, const DecodeArg& req) {
+    constexpr u32 SamplesPerFrame{AdpcmSamplesPerFrame};
     constexpr u32 NibblesPerFrame{16};
 
     if (req.buffer == 0 || req.buffer_size == 0) {
@@ -140,7 +164,7 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
     }
 
     const auto size{std::max((samples_to_process / 8U) * SamplesPerFrame, 8U)};
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> wavebuffer(
+    Core::Memory::GuestMemory<Memory, u8, Core::Memory::GuestMemoryFlags::UnsafeRead> wavebuffer(
         memory, req.buffer + position_in_frame / 2, size);
 
     auto context{req.adpcm_context};
@@ -183,14 +207,12 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
             // Can we consume all of this frame's samples?
             if (samples_to_read >= SamplesPerFrame) {
                 // Can grab all samples until the next header
-                for (u32 i = 0; i < SamplesPerFrame / 2; i++) {
-                    auto code0{Steps[(wavebuffer[read_index] >> 4) & 0xF]};
-                    auto code1{Steps[wavebuffer[read_index] & 0xF]};
-                    read_index++;
-
-                    out_buffer[write_index++] = decode_sample(code0);
-                    out_buffer[write_index++] = decode_sample(code1);
-                }
+                DecodeAdpcmFrame(out_buffer.subspan(write_index).first<SamplesPerFrame>(),
+                                 std::span<const u8, SamplesPerFrame / 2>{
+                                     wavebuffer.data() + read_index, SamplesPerFrame / 2},
+                                 scale, coeff0, coeff1, yn0, yn1);
+                read_index += SamplesPerFrame / 2;
+                write_index += SamplesPerFrame;
 
                 position_in_frame += SamplesPerFrame;
                 samples_to_read -= SamplesPerFrame;
@@ -224,10 +246,12 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
  * Decode implementation.
  * Decode wavebuffers according to the given args.
  *
- * @param memory - Core memory to read data from.
- * @param args   - The wavebuffer data, and information for how to decode it.
+ * @tparam Memory - Type of memory to read samples from, core or captured memory.
+ * @param memory  - Core memory to read data from.
+ * @param args    - The wavebuffer data, and information for how to decode it.
  */
-void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuffersArgs& args) {
+template <typename Memory>
+static void DecodeFromWaveBuffersImpl(Memory& memory, const DecodeFromWaveBuffersArgs& args) {
     static constexpr auto EndWaveBuffer = [](auto& voice_state, auto& wavebuffer, auto& index,
                                              auto& played_samples, auto& consumed) -> void {
         voice_state.wave_buffer_valid[index] = false;
@@ -426,4 +450,13 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
     voice_state.fraction = fraction;
 }
 
+void DecodeFromWaveBuffers(const AudioRenderer::CommandListProcessor& processor,
+                           const DecodeFromWaveBuffersArgs& args) {
+    if (processor.capture_memory != nullptr) {
+        DecodeFromWaveBuffersImpl(*processor.capture_memory, args);
+    } else {
+        DecodeFromWaveBuffersImpl(*processor.memory, args);
+    }
+}
+
 } // namespace AudioCore::Renderer
@@ -11,11 +11,15 @@
 #include "audio_core/renderer/voice/voice_state.h"
 #include "common/common_types.h"
 
-namespace Core::Memory {
-class Memory;
+namespace AudioCore::ADSP::AudioRenderer {
+class CommandListProcessor;
 }
 
 namespace AudioCore::Renderer {
+using namespace ::AudioCore::ADSP;
+
+/// Number of samples in an ADPCM frame, following its one byte header.
+constexpr u32 AdpcmSamplesPerFrame = 14;
 
 struct DecodeFromWaveBuffersArgs {
     SampleFormat sample_format;
@@ -48,12 +52,32 @@ struct DecodeArg {
     u32 samples_to_read;
 };
 
+/**
+ * Decode all the samples of an ADPCM frame.
+ * The nibbles are expanded and scaled up front, leaving only the prediction filter in the
+ * serial part of the decode.
+ *
+ * @param output - Output buffer to receive the samples.
+ * @param data   - Frame data following the header byte, two samples per byte.
+ * @param scale  - Scale from the frame header.
+ * @param coeff0 - First prediction coefficient selected by the frame header.
+ * @param coeff1 - Second prediction coefficient selected by the frame header.
+ * @param yn0    - Last decoded sample, updated with the last sample of this frame.
+ * @param yn1    - Sample before yn0, updated with the second to last sample of this frame.
+ */
+void DecodeAdpcmFrame(std::span<s16, AdpcmSamplesPerFrame> output,
+                      std::span<const u8, AdpcmSamplesPerFrame / 2> data, u8 scale, s32 coeff0,
+                      s32 coeff1, s16& yn0, s16& yn1);
+
 /**
  * Decode wavebuffers according to the given args.
+ * Samples are read from the processor's captured memory when replaying a capture, otherwise
+ * from core memory.
  *
- * @param memory - Core memory to read data from.
- * @param args - The wavebuffer data, and information for how to decode it.
+ * @param processor - The CommandListProcessor processing the data source command.
+ * @param args      - The wavebuffer data, and information for how to decode it.
  */
-void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuffersArgs& args);
+void DecodeFromWaveBuffers(const AudioRenderer::CommandListProcessor& processor,
+                           const DecodeFromWaveBuffersArgs& args);
 
 } // namespace AudioCore::Renderer
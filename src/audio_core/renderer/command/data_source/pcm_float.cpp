@@ -45,7 +45,7 @@ void PcmFloatDataSourceVersion1Command::Process(
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
 
-    DecodeFromWaveBuffers(*processor.memory, args);
+    DecodeFromWaveBuffers(processor, args);
 }
 
 bool PcmFloatDataSourceVersion1Command::Verify(
@@ -85,7 +85,7 @@ void PcmFloatDataSourceVersion2Command::Process(
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
 
-    DecodeFromWaveBuffers(*processor.memory, args);
+    DecodeFromWaveBuffers(processor, args);
 }
 
 bool PcmFloatDataSourceVersion2Command::Verify(
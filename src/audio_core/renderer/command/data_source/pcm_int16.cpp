@@ -47,7 +47,7 @@ void PcmInt16DataSourceVersion1Command::Process(
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
 
-    DecodeFromWaveBuffers(*processor.memory, args);
+    DecodeFromWaveBuffers(processor, args);
 }
 
 bool PcmInt16DataSourceVersion1Command::Verify(
@@ -86,7 +86,7 @@ void PcmInt16DataSourceVersion2Command::Process(
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
 
-    DecodeFromWaveBuffers(*processor.memory, args);
+    DecodeFromWaveBuffers(processor, args);
 }
 
 bool PcmInt16DataSourceVersion2Command::Verify(
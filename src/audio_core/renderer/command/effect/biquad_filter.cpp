@@ -7,6 +7,62 @@
 #include "common/bit_cast.h"
 
 namespace AudioCore::Renderer {
+namespace {
+
+/// Float biquad filter, with its coefficients and state converted to f64 for one buffer
+class FloatBiquadFilter {
+public:
+    explicit FloatBiquadFilter(const std::array<s16, 3>& b_, const std::array<s16, 2>& a_,
+                               const VoiceState::BiquadFilterState& state)
+        : b{Common::FixedPoint<50, 14>::from_base(b_[0]).to_double(),
+            Common::FixedPoint<50, 14>::from_base(b_[1]).to_double(),
+            Common::FixedPoint<50, 14>::from_base(b_[2]).to_double()},
+          a{Common::FixedPoint<50, 14>::from_base(a_[0]).to_double(),
+            Common::FixedPoint<50, 14>::from_base(a_[1]).to_double()},
+          s{Common::BitCast<f64>(state.s0), Common::BitCast<f64>(state.s1),
+            Common::BitCast<f64>(state.s2), Common::BitCast<f64>(state.s3)} {}
+
+    /**
+     * Filter one sample.
+     *
+     * @param input - Sample to filter.
+     * @return The filtered sample.
+     */
+    s32 Process(const s32 input) {
+        constexpr f64 min{std::numeric_limits<s32>::min()};
+        constexpr f64 max{std::numeric_limits<s32>::max()};
+
+        f64 in_sample{static_cast<f64>(input)};
+        auto sample{in_sample * b[0] + s[0] * b[1] + s[1] * b[2] + s[2] * a[0] + s[3] * a[1]};
+
+        s[1] = s[0];
+        s[0] = in_sample;
+        s[3] = s[2];
+        s[2] = sample;
+
+        return static_cast<s32>(std::clamp(sample, min, max));
+    }
+
+    /**
+     * Save the filter state.
+     *
+     * @param state - State to save into.
+     */
+    void Save(VoiceState::BiquadFilterState& state) const {
+        state.s0 = Common::BitCast<s64>(s[0]);
+        state.s1 = Common::BitCast<s64>(s[1]);
+        state.s2 = Common::BitCast<s64>(s[2]);
+        state.s3 = Common::BitCast<s64>(s[3]);
+    }
+
+private:
+    std::array<f64, 3> b;
+    std::array<f64, 2> a;
+    std::array<f64, 4> s;
+};
+
+} // Anonymous namespace
+
 /**
  * Biquad filter float implementation.
  *
@@ -18,34 +74,38 @@ namespace AudioCore::Renderer {
  * @param sample_count - Number of samples to process.
  */
 void ApplyBiquadFilterFloat(std::span<s32> output, std::span<const s32> input,
-                            std::array<s16, 3>& b_, std::array<s16, 2>& a_,
+                            std::array<s16, 3>& b, std::array<s16, 2>& a,
                             VoiceState::BiquadFilterState& state, const u32 sample_count) {
-    constexpr f64 min{std::numeric_limits<s32>::min()};
-    constexpr f64 max{std::numeric_limits<s32>::max()};
-    std::array<f64, 3> b{Common::FixedPoint<50, 14>::from_base(b_[0]).to_double(),
-                         Common::FixedPoint<50, 14>::from_base(b_[1]).to_double(),
-                         Common::FixedPoint<50, 14>::from_base(b_[2]).to_double()};
-    std::array<f64, 2> a{Common::FixedPoint<50, 14>::from_base(a_[0]).to_double(),
-                         Common::FixedPoint<50, 14>::from_base(a_[1]).to_double()};
-    std::array<f64, 4> s{Common::BitCast<f64>(state.s0), Common::BitCast<f64>(state.s1),
-                         Common::BitCast<f64>(state.s2), Common::BitCast<f64>(state.s3)};
-
+    FloatBiquadFilter filter{b, a, state};
     for (u32 i = 0; i < sample_count; i++) {
-        f64 in_sample{static_cast<f64>(input[i])};
-        auto sample{in_sample * b[0] + s[0] * b[1] + s[1] * b[2] + s[2] * a[0] + s[3] * a[1]};
-
-        output[i] = static_cast<s32>(std::clamp(sample, min, max));
+        output[i] = filter.Process(input[i]);
+    }
+    filter.Save(state);
+}
 
-        s[1] = s[0];
-        s[0] = in_sample;
-        s[3] = s[2];
-        s[2] = sample;
+void ApplyBiquadFilterFloat2(std::span<s32> output, std::span<const s32> input,
+                             const VoiceInfo::BiquadFilterParameter& first,
+                             VoiceState::BiquadFilterState& first_state,
+                             const VoiceInfo::BiquadFilterParameter& second,
+                             VoiceState::BiquadFilterState& second_state, const u32 sample_count) {
+    FloatBiquadFilter first_filter{first.b, first.a, first_state};
+    FloatBiquadFilter second_filter{second.b, second.a, second_state};
+
+    // Both filters run in the same loop, so the second filter's dependency chain can overlap the
+    // first's, rather than each waiting on its own previous sample for a whole pass.
+    if (input.data() == output.data()) {
+        for (u32 i = 0; i < sample_count; i++) {
+            output[i] = second_filter.Process(first_filter.Process(input[i]));
+        }
+    } else {
+        for (u32 i = 0; i < sample_count; i++) {
+            first_filter.Process(input[i]);
+            output[i] = second_filter.Process(input[i]);
+        }
     }
 
-    state.s0 = Common::BitCast<s64>(s[0]);
-    state.s1 = Common::BitCast<s64>(s[1]);
-    state.s2 = Common::BitCast<s64>(s[2]);
-    state.s3 = Common::BitCast<s64>(s[3]);
+    first_filter.Save(first_state);
+    second_filter.Save(second_state);
 }
 
 /**
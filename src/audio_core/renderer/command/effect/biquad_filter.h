@@ -72,4 +72,23 @@ void ApplyBiquadFilterFloat(std::span<s32> output, std::span<const s32> input,
                             std::array<s16, 3>& b, std::array<s16, 2>& a,
                             VoiceState::BiquadFilterState& state, const u32 sample_count);
 
+/**
+ * Apply two float biquad filters in one pass. Matches applying the first filter and then the
+ * second with ApplyBiquadFilterFloat, if the input and output are the same buffer the second
+ * filter reads the first's output, otherwise both filter the input.
+ *
+ * @param output       - Output container for filtered samples.
+ * @param input        - Input container for samples to be filtered.
+ * @param first        - Parameters of the first filter.
+ * @param first_state  - State of the first filter.
+ * @param second       - Parameters of the second filter.
+ * @param second_state - State of the second filter.
+ * @param sample_count - Number of samples to process.
+ */
+void ApplyBiquadFilterFloat2(std::span<s32> output, std::span<const s32> input,
+                             const VoiceInfo::BiquadFilterParameter& first,
+                             VoiceState::BiquadFilterState& first_state,
+                             const VoiceInfo::BiquadFilterParameter& second,
+                             VoiceState::BiquadFilterState& second_state, const u32 sample_count);
+
 } // namespace AudioCore::Renderer
@@ -25,6 +25,20 @@ void MultiTapBiquadFilterCommand::Process(const AudioRenderer::CommandListProces
     auto output_buffer{
         processor.mix_buffers.subspan(output * processor.sample_count, processor.sample_count)};
 
+    if (filter_tap_count == MaxBiquadFilters) {
+        std::array<VoiceState::BiquadFilterState*, MaxBiquadFilters> states_{};
+        for (u32 i = 0; i < MaxBiquadFilters; i++) {
+            states_[i] = reinterpret_cast<VoiceState::BiquadFilterState*>(states[i]);
+            if (needs_init[i]) {
+                *states_[i] = {};
+            }
+        }
+
+        ApplyBiquadFilterFloat2(output_buffer, input_buffer, biquads[0], *states_[0], biquads[1],
+                                *states_[1], processor.sample_count);
+        return;
+    }
+
     // TODO: Fix this, currently just applies the filter to the input twice,
     // and doesn't chain the biquads together at all.
     for (u32 i = 0; i < filter_tap_count; i++) {
@@ -216,6 +216,29 @@ static void ApplyReverbEffectBypass(std::span<std::span<const s32>> inputs,
     }
 }
 
+/**
+ * Scale an input sample by a Q14 gain. Equal to converting the sample to a FixedPoint and
+ * multiplying, the sample's fraction is zero so the product needs no 128-bit intermediate.
+ *
+ * @param sample - Sample to scale.
+ * @param gain   - Raw Q14 gain.
+ * @return The scaled sample.
+ */
+static Common::FixedPoint<50, 14> ScaleSample(const s32 sample, const s32 gain) {
+    return Common::FixedPoint<50, 14>::from_base(static_cast<s64>(sample) * gain);
+}
+
+/**
+ * Divide a sample by 64. Equal to FixedPoint division by 64, both truncate towards zero, without
+ * the 128-bit division and remainder it does.
+ *
+ * @param sample - Sample to divide.
+ * @return The divided sample.
+ */
+static Common::FixedPoint<50, 14> DivideBy64(const Common::FixedPoint<50, 14> sample) {
+    return Common::FixedPoint<50, 14>::from_base(sample.to_raw() / 64);
+}
+
 /**
  * Tick the delay lines, reading and returning their current output, and writing a new decaying
  * sample (mix).
@@ -276,6 +299,14 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         tap_indexes = OutTapIndexes6Ch;
     }
 
+    // The gains are the same for every sample, convert them once rather than in the loop
+    const auto base_gain{Common::FixedPoint<50, 14>::from_base(params.base_gain)};
+    const auto late_gain{Common::FixedPoint<50, 14>::from_base(params.late_gain)};
+    const auto dry_gain{params.dry_gain};
+    const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
+    const Common::FixedPoint<50, 14> lfe_gain{0.2f};
+    const Common::FixedPoint<50, 14> center_gain{0.5f};
+
     for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
         std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
 
@@ -289,7 +320,7 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         }
 
         if constexpr (NumChannels == 6) {
-            output_samples[static_cast<u32>(Channels::LFE)] *= 0.2f;
+            output_samples[static_cast<u32>(Channels::LFE)] *= lfe_gain;
         }
 
         Common::FixedPoint<50, 14> input_sample{};
@@ -298,7 +329,7 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         }
 
         input_sample *= 64;
-        input_sample *= Common::FixedPoint<50, 14>::from_base(params.base_gain);
+        input_sample *= base_gain;
         state.pre_delay_line.Write(input_sample);
 
         for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
@@ -308,8 +339,7 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         }
 
         Common::FixedPoint<50, 14> pre_delay_sample{
-            state.pre_delay_line.TapOut(state.pre_delay_time) *
-            Common::FixedPoint<50, 14>::from_base(params.late_gain)};
+            state.pre_delay_line.TapOut(state.pre_delay_time) * late_gain};
 
         std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> mix_matrix{
             state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
@@ -324,9 +354,6 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
                                                   state.fdn_delay_lines[i], mix_matrix[i]);
         }
 
-        const auto dry_gain{Common::FixedPoint<50, 14>::from_base(params.dry_gain)};
-        const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
-
         if constexpr (NumChannels == 6) {
             const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
                 allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
@@ -334,23 +361,23 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
             };
 
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
+                auto in_sample{ScaleSample(inputs[channel][sample_index], dry_gain)};
 
                 Common::FixedPoint<50, 14> allpass{};
                 if (channel == static_cast<u32>(Channels::Center)) {
-                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
+                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * center_gain);
                 } else {
                     allpass = allpass_outputs[channel];
                 }
 
-                auto out_sample{((output_samples[channel] + allpass) * wet_gain) / 64};
+                auto out_sample{DivideBy64((output_samples[channel] + allpass) * wet_gain)};
                 outputs[channel][sample_index] = (in_sample + out_sample).to_int();
             }
         } else {
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
-                auto out_sample{((output_samples[channel] + allpass_samples[channel]) * wet_gain) /
-                                64};
+                auto in_sample{ScaleSample(inputs[channel][sample_index], dry_gain)};
+                auto out_sample{
+                    DivideBy64((output_samples[channel] + allpass_samples[channel]) * wet_gain)};
                 outputs[channel][sample_index] = (in_sample + out_sample).to_int();
             }
         }
@@ -49,6 +49,12 @@ enum class CommandId : u8 {
     /* 0x1E */ Compressor,
 };
 
+/// Number of command types
+constexpr size_t CommandIdCount{static_cast<size_t>(CommandId::Compressor) + 1};
+
+/// DSP cycles available to render one 5ms frame, the budget command times are estimated against
+constexpr u32 DspCyclesPerFrame{2'880'000};
+
 constexpr u32 CommandMagic{0xCAFEBABE};
 
 /**
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "audio_core/renderer/command/measured_command_costs.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+/// Host time of one 5ms frame, in nanoseconds
+constexpr f32 FrameTimeNs{5'000'000.0f};
+
+} // Anonymous namespace
+
+void MeasuredCommandCosts::Record(CommandId type, u32 estimate, u64 time_ns) {
+    const auto type_index{static_cast<size_t>(type)};
+    if (type_index >= CommandIdCount || estimate == std::numeric_limits<u32>::max()) {
+        return;
+    }
+
+    // Find this variant's slot, or claim a free one. Once every slot is taken, new variants keep
+    // using the console estimate.
+    const auto key{estimate + 1};
+    Variant* variant{nullptr};
+    for (auto& slot : variants[type_index]) {
+        const auto slot_key{slot.key.load(std::memory_order_relaxed)};
+        if (slot_key == key) {
+            variant = &slot;
+            break;
+        }
+        if (slot_key == 0) {
+            slot.average = 0.0f;
+            slot.sample_count = 0;
+            slot.cost.store(0, std::memory_order_relaxed);
+            slot.key.store(key, std::memory_order_release);
+            variant = &slot;
+            break;
+        }
+    }
+    if (variant == nullptr) {
+        return;
+    }
+
+    auto sample{ToDspCycles(time_ns)};
+    if (variant->sample_count == 0) {
+        variant->average = sample;
+    } else {
+        if (variant->sample_count >= MinSamples) {
+            sample = std::min(sample, variant->average * MaxSampleRatio);
+        }
+        variant->average += (sample - variant->average) * AverageWeight;
+    }
+    variant->sample_count = std::min(variant->sample_count + 1, MinSamples);
+
+    if (variant->sample_count >= MinSamples) {
+        // Published costs stay non-zero, 0 marks a variant which is still being measured
+        const auto cost{std::max(static_cast<u32>(std::lround(variant->average)), 1U)};
+        variant->cost.store(cost, std::memory_order_relaxed);
+    }
+}
+
+u32 MeasuredCommandCosts::Estimate(CommandId type, u32 estimate) const {
+    const auto type_index{static_cast<size_t>(type)};
+    if (type_index >= CommandIdCount || estimate == std::numeric_limits<u32>::max()) {
+        return estimate;
+    }
+
+    const auto key{estimate + 1};
+    for (const auto& slot : variants[type_index]) {
+        const auto slot_key{slot.key.load(std::memory_order_acquire)};
+        if (slot_key == key) {
+            const auto cost{slot.cost.load(std::memory_order_relaxed)};
+            return cost != 0 ? cost : estimate;
+        }
+        if (slot_key == 0) {
+            break;
+        }
+    }
+    return estimate;
+}
+
+f32 MeasuredCommandCosts::ToDspCycles(u64 time_ns) {
+    return static_cast<f32>(time_ns) * (static_cast<f32>(DspCyclesPerFrame) / FrameTimeNs);
+}
+
+} // namespace AudioCore::Renderer
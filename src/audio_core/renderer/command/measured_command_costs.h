@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "audio_core/renderer/command/icommand.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Processing costs of commands measured on the host, used in place of the console's estimates
+ * when deciding which voices to drop.
+ *
+ * The console estimates depend only on a command's type and the parameters which change its
+ * cost (sample count, channel count, enabled taps and so on), so the estimate itself identifies
+ * which variant of a command was run. Each type keeps a moving average of the host time taken by
+ * each of its variants, converted to the DSP cycles the estimates are measured in, so a measured
+ * cost compares against the same frame budget.
+ *
+ * Costs are recorded by the AudioRenderer thread only, and read by the renderer system when it
+ * generates the next command list.
+ */
+class MeasuredCommandCosts {
+public:
+    /// Parameter variants tracked for each command type
+    static constexpr size_t MaxVariants{16};
+    /// Samples averaged before a variant's measured cost is used
+    static constexpr u32 MinSamples{16};
+    /// Weight of each new sample in the moving average, about the last 32 frames
+    static constexpr f32 AverageWeight{1.0f / 32.0f};
+    /// Once averaged, a sample is capped to this multiple of the average, so a thread being
+    /// preempted does not cause a burst of dropped voices
+    static constexpr f32 MaxSampleRatio{4.0f};
+
+    /**
+     * Add a host processing time to a command's moving average.
+     *
+     * @param type     - Type of the processed command.
+     * @param estimate - Console estimate of the command, identifying its parameters.
+     * @param time_ns  - Host time taken to process the command, in nanoseconds.
+     */
+    void Record(CommandId type, u32 estimate, u64 time_ns);
+
+    /**
+     * Get the measured cost of a command, if enough of its kind have been processed.
+     *
+     * @param type     - Type of the command.
+     * @param estimate - Console estimate of the command, identifying its parameters.
+     * @return The measured cost in DSP cycles, or the console estimate if it is not yet known.
+     */
+    u32 Estimate(CommandId type, u32 estimate) const;
+
+    /**
+     * Convert a host processing time to DSP cycles, relative to a 5ms frame.
+     *
+     * @param time_ns - Host time in nanoseconds.
+     * @return The time in DSP cycles.
+     */
+    static f32 ToDspCycles(u64 time_ns);
+
+private:
+    struct Variant {
+        /// Console estimate identifying this variant plus 1, 0 if the slot is free
+        std::atomic<u32> key;
+        /// Published average cost in DSP cycles, 0 until MinSamples have been recorded
+        std::atomic<u32> cost;
+        /// Moving average cost in DSP cycles, only touched by the recording thread
+        f32 average;
+        /// Samples recorded, saturating at MinSamples, only touched by the recording thread
+        u32 sample_count;
+    };
+
+    /// Measured variants of each command type
+    std::array<std::array<Variant, MaxVariants>, CommandIdCount> variants{};
+};
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <limits>
+
+#include "audio_core/common/simd.h"
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+/**
+ * Check if every gain applied over the samples fits in 32 bits. The vector kernels rely on
+ * 32x32 -> 64 bit multiplies, anything larger goes through the scalar path.
+ */
+bool GainFitsS32(s64 gain, s64 ramp, u32 sample_count) {
+    constexpr s64 min{std::numeric_limits<s32>::min()};
+    constexpr s64 max{std::numeric_limits<s32>::max()};
+    if (gain < min || gain > max) {
+        return false;
+    }
+    if (sample_count <= 1 || ramp == 0) {
+        return true;
+    }
+    if (ramp < min - max || ramp > max - min) {
+        return false;
+    }
+    // The gain is linear, so only the last one needs to be checked
+    const s64 steps{static_cast<s64>(sample_count) - 1};
+    const s64 headroom{ramp > 0 ? max - gain : gain - min};
+    const s64 magnitude{ramp > 0 ? ramp : -ramp};
+    return magnitude <= headroom / steps;
+}
+
+#if defined(ARCHITECTURE_x86_64)
+template <size_t Q>
+AUDIO_CORE_TARGET_AVX2 __m256i RoundFixedPointAvx2(__m256i value, __m256i fractional_mask) {
+    const __m256i half{_mm256_srli_epi64(_mm256_and_si256(value, fractional_mask), 1)};
+    // Only the low 32 bits of each lane are kept, and Q + 32 < 64, so a logical shift gives
+    // the same bits as an arithmetic one.
+    return _mm256_srli_epi64(_mm256_add_epi64(value, half), Q);
+}
+
+template <size_t Q, bool Accumulate>
+AUDIO_CORE_TARGET_AVX2 u32 ApplyFixedPointGainAvx2(s32* output, const s32* input, s64 gain,
+                                                   s64 ramp, u32 sample_count) {
+    const u32 vector_count{sample_count & ~7U};
+    const __m256i fractional_mask{_mm256_set1_epi64x((s64{1} << Q) - 1)};
+    const __m256i step{_mm256_set1_epi64x(ramp * 8)};
+    __m256i gain_even{_mm256_set_epi64x(gain + ramp * 6, gain + ramp * 4, gain + ramp * 2, gain)};
+    __m256i gain_odd{_mm256_add_epi64(gain_even, _mm256_set1_epi64x(ramp))};
+
+    for (u32 i = 0; i < vector_count; i += 8) {
+        const __m256i samples{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i))};
+        const __m256i even{
+            RoundFixedPointAvx2<Q>(_mm256_mul_epi32(samples, gain_even), fractional_mask)};
+        const __m256i odd{RoundFixedPointAvx2<Q>(
+            _mm256_mul_epi32(_mm256_srli_epi64(samples, 32), gain_odd), fractional_mask)};
+        __m256i result{_mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b10101010)};
+        if constexpr (Accumulate) {
+            result = _mm256_add_epi32(
+                result, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), result);
+        gain_even = _mm256_add_epi64(gain_even, step);
+        gain_odd = _mm256_add_epi64(gain_odd, step);
+    }
+    return vector_count;
+}
+#elif defined(ARCHITECTURE_arm64)
+template <size_t Q>
+int64x2_t RoundFixedPointNeon(int64x2_t value, int64x2_t fractional_mask) {
+    const uint64x2_t fraction{vreinterpretq_u64_s64(vandq_s64(value, fractional_mask))};
+    const int64x2_t half{vreinterpretq_s64_u64(vshrq_n_u64(fraction, 1))};
+    return vshrq_n_s64(vaddq_s64(value, half), Q);
+}
+
+template <size_t Q, bool Accumulate>
+u32 ApplyFixedPointGainNeon(s32* output, const s32* input, s64 gain, s64 ramp, u32 sample_count) {
+    const u32 vector_count{sample_count & ~3U};
+    const int64x2_t fractional_mask{vdupq_n_s64((s64{1} << Q) - 1)};
+    // Every gain used fits in 32 bits, so wrapping 32-bit increments still land on exact values
+    const std::array<s32, 4> initial_gains{
+        static_cast<s32>(gain),
+        static_cast<s32>(gain + ramp),
+        static_cast<s32>(gain + ramp * 2),
+        static_cast<s32>(gain + ramp * 3),
+    };
+    const int32x4_t step{vdupq_n_s32(static_cast<s32>(ramp * 4))};
+    int32x4_t gains{vld1q_s32(initial_gains.data())};
+
+    for (u32 i = 0; i < vector_count; i += 4) {
+        const int32x4_t samples{vld1q_s32(input + i)};
+        const int64x2_t low{RoundFixedPointNeon<Q>(
+            vmull_s32(vget_low_s32(samples), vget_low_s32(gains)), fractional_mask)};
+        const int64x2_t high{
+            RoundFixedPointNeon<Q>(vmull_high_s32(samples, gains), fractional_mask)};
+        int32x4_t result{vcombine_s32(vmovn_s64(low), vmovn_s64(high))};
+        if constexpr (Accumulate) {
+            result = vaddq_s32(result, vld1q_s32(output + i));
+        }
+        vst1q_s32(output + i, result);
+        gains = vaddq_s32(gains, step);
+    }
+    return vector_count;
+}
+#endif
+
+} // Anonymous namespace
+
+template <size_t Q, bool Accumulate>
+void ApplyFixedPointGainScalar(std::span<s32> output, std::span<const s32> input, s64 gain,
+                               s64 ramp, u32 sample_count) {
+    for (u32 i = 0; i < sample_count; i++) {
+        const s32 sample{RoundFixedPoint<Q>(MultiplyFixedPoint(input[i], gain))};
+        if constexpr (Accumulate) {
+            output[i] = static_cast<s32>(static_cast<u32>(output[i]) + static_cast<u32>(sample));
+        } else {
+            output[i] = sample;
+        }
+        gain = static_cast<s64>(static_cast<u64>(gain) + static_cast<u64>(ramp));
+    }
+}
+
+template <size_t Q, bool Accumulate>
+void ApplyFixedPointGain(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+                         u32 sample_count) {
+    u32 processed{0};
+    if (GainFitsS32(gain, ramp, sample_count)) {
+#if defined(ARCHITECTURE_x86_64)
+        if (HasAvx2()) {
+            processed = ApplyFixedPointGainAvx2<Q, Accumulate>(output.data(), input.data(), gain,
+                                                               ramp, sample_count);
+        }
+#elif defined(ARCHITECTURE_arm64)
+        processed = ApplyFixedPointGainNeon<Q, Accumulate>(output.data(), input.data(), gain, ramp,
+                                                           sample_count);
+#endif
+    }
+
+    if (processed < sample_count) {
+        ApplyFixedPointGainScalar<Q, Accumulate>(output.subspan(processed),
+                                                 input.subspan(processed),
+                                                 gain + ramp * static_cast<s64>(processed), ramp,
+                                                 sample_count - processed);
+    }
+}
+
+template void ApplyFixedPointGain<15, false>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template void ApplyFixedPointGain<15, true>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template void ApplyFixedPointGain<23, false>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+template void ApplyFixedPointGain<23, true>(std::span<s32>, std::span<const s32>, s64, s64, u32);
+
+template void ApplyFixedPointGainScalar<15, false>(std::span<s32>, std::span<const s32>, s64, s64,
+                                                   u32);
+template void ApplyFixedPointGainScalar<15, true>(std::span<s32>, std::span<const s32>, s64, s64,
+                                                  u32);
+template void ApplyFixedPointGainScalar<23, false>(std::span<s32>, std::span<const s32>, s64, s64,
+                                                   u32);
+template void ApplyFixedPointGainScalar<23, true>(std::span<s32>, std::span<const s32>, s64, s64,
+                                                  u32);
+
+} // namespace AudioCore::Renderer
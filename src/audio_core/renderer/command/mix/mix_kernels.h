@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Multiply a sample by a raw fixed point gain, matching the wrapping 64-bit multiply of
+ * Common::FixedPoint<64 - Q, Q>.
+ *
+ * @param sample - Sample to multiply.
+ * @param gain   - Raw fixed point gain.
+ * @return The raw fixed point product.
+ */
+constexpr s64 MultiplyFixedPoint(s32 sample, s64 gain) {
+    return static_cast<s64>(static_cast<u64>(static_cast<s64>(sample)) * static_cast<u64>(gain));
+}
+
+/**
+ * Round a raw fixed point value to an integer, matching Common::FixedPoint::to_int.
+ *
+ * @tparam Q    - Number of bits for fixed point operations.
+ * @param value - Raw fixed point value.
+ * @return The rounded integer part, truncated to 32 bits.
+ */
+template <size_t Q>
+constexpr s32 RoundFixedPoint(s64 value) {
+    constexpr u64 fractional_mask{(u64{1} << Q) - 1};
+    const u64 raw{static_cast<u64>(value)};
+    const u64 rounded{raw + ((raw & fractional_mask) >> 1)};
+    return static_cast<s32>(static_cast<s64>(rounded) >> Q);
+}
+
+/**
+ * Multiply each input sample by a raw fixed point gain, and either store the rounded result to
+ * the output, or add it to the output. The gain is incremented by the ramp after every sample.
+ * Results are bit-exact with the equivalent Common::FixedPoint<64 - Q, Q> arithmetic, and use
+ * AVX2 or NEON when the host supports it.
+ *
+ * @tparam Q          - Number of bits for fixed point operations.
+ * @tparam Accumulate - If true the result is added to the output, otherwise it is stored.
+ * @param output       - Output mix buffer.
+ * @param input        - Input mix buffer, may be the same as the output.
+ * @param gain         - Raw fixed point gain applied to the first sample.
+ * @param ramp         - Raw fixed point value added to the gain after every sample.
+ * @param sample_count - Number of samples to process.
+ */
+template <size_t Q, bool Accumulate>
+void ApplyFixedPointGain(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+                         u32 sample_count);
+
+/**
+ * Reference implementation of ApplyFixedPointGain, processing one sample at a time.
+ * See ApplyFixedPointGain for the parameters.
+ */
+template <size_t Q, bool Accumulate>
+void ApplyFixedPointGainScalar(std::span<s32> output, std::span<const s32> input, s64 gain,
+                               s64 ramp, u32 sample_count);
+
+} // namespace AudioCore::Renderer
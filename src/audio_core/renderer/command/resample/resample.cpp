@@ -1,10 +1,136 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "audio_core/common/simd.h"
 #include "audio_core/renderer/command/resample/resample.h"
 
 namespace AudioCore::Renderer {
 
+#if defined(ARCHITECTURE_x86_64)
+using FilterVector = __m128i;
+
+/**
+ * Multiply 4 input samples by 4 filter taps, returning the products as raw FixedPoint<56, 8>
+ * values. The s16 * f32 product is rounded to f32 and then truncated, exactly like the FixedPoint
+ * constructor does, and always fits in 32 bits.
+ */
+AUDIO_CORE_TARGET_SSE41 static __m128i FilterFourTaps(__m128i samples, const f32* lut) {
+    const __m128 scale{_mm_set1_ps(static_cast<f32>(Common::FixedPoint<56, 8>::one))};
+    const __m128 products{_mm_mul_ps(_mm_cvtepi32_ps(samples), _mm_loadu_ps(lut))};
+    return _mm_cvttps_epi32(_mm_mul_ps(products, scale));
+}
+
+template <size_t Taps>
+AUDIO_CORE_TARGET_SSE41 static FilterVector FilterTaps(const s16* input, const f32* lut) {
+    if constexpr (Taps == 4) {
+        const __m128i samples{_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input))};
+        return FilterFourTaps(_mm_cvtepi16_epi32(samples), lut);
+    } else {
+        const __m128i samples{_mm_loadu_si128(reinterpret_cast<const __m128i*>(input))};
+        return _mm_add_epi32(
+            FilterFourTaps(_mm_cvtepi16_epi32(samples), lut),
+            FilterFourTaps(_mm_cvtepi16_epi32(_mm_srli_si128(samples, 8)), lut + 4));
+    }
+}
+
+/// Sum the products of 4 output samples and store their integer parts.
+AUDIO_CORE_TARGET_SSE41 static void StoreFiltered(s32* output, __m128i products0,
+                                                  __m128i products1, __m128i products2,
+                                                  __m128i products3) {
+    const __m128i sums{_mm_hadd_epi32(_mm_hadd_epi32(products0, products1),
+                                      _mm_hadd_epi32(products2, products3))};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_srai_epi32(sums, 8));
+}
+#elif defined(ARCHITECTURE_arm64)
+using FilterVector = int32x4_t;
+
+static int32x4_t FilterFourTaps(int16x4_t samples, const f32* lut) {
+    const f32 scale{static_cast<f32>(Common::FixedPoint<56, 8>::one)};
+    const float32x4_t products{vmulq_f32(vcvtq_f32_s32(vmovl_s16(samples)), vld1q_f32(lut))};
+    return vcvtq_s32_f32(vmulq_n_f32(products, scale));
+}
+
+template <size_t Taps>
+static FilterVector FilterTaps(const s16* input, const f32* lut) {
+    if constexpr (Taps == 4) {
+        return FilterFourTaps(vld1_s16(input), lut);
+    } else {
+        return vaddq_s32(FilterFourTaps(vld1_s16(input), lut),
+                         FilterFourTaps(vld1_s16(input + 4), lut + 4));
+    }
+}
+
+static void StoreFiltered(s32* output, int32x4_t products0, int32x4_t products1,
+                          int32x4_t products2, int32x4_t products3) {
+    const int32x4_t sums{
+        vpaddq_s32(vpaddq_s32(products0, products1), vpaddq_s32(products2, products3))};
+    vst1q_s32(output, vshrq_n_s32(sums, 8));
+}
+#endif
+
+/// Check if the host can run the vectorised filters.
+static bool HasVectorisedFilter() {
+#if defined(ARCHITECTURE_x86_64)
+    return HasSse41();
+#elif defined(ARCHITECTURE_arm64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+/// Filter the input for the next output sample, and advance the read position past it.
+template <size_t Taps>
+AUDIO_CORE_TARGET_SSE41 static FilterVector
+FilterNextSample(std::span<const s16> input, std::span<const f32> lut,
+                 const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                 Common::FixedPoint<49, 15>& fraction, u32& read_index) {
+    const auto lut_index{(fraction.get_frac() >> 8) * Taps};
+    const FilterVector products{FilterTaps<Taps>(&input[read_index], &lut[lut_index])};
+    fraction += sample_rate_ratio;
+    read_index += static_cast<u32>(fraction.to_int_floor());
+    fraction.clear_int();
+    return products;
+}
+
+/**
+ * Apply a Taps-wide polyphase filter to 4 output samples at a time, advancing the fraction and
+ * read index the same way the scalar loops do. Integer addition is associative, so summing the
+ * taps in a different order still gives the same FixedPoint<56, 8> result.
+ *
+ * @return Number of samples written, the remainder must go through the scalar loop.
+ */
+template <size_t Taps>
+AUDIO_CORE_TARGET_SSE41 static u32
+ResampleFilterVectorised(std::span<s32> output, std::span<const s16> input,
+                         std::span<const f32> lut,
+                         const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                         Common::FixedPoint<49, 15>& fraction, u32& read_index,
+                         const u32 samples_to_write) {
+    const u32 vector_count{samples_to_write & ~3U};
+    for (u32 i = 0; i < vector_count; i += 4) {
+        const auto products0{
+            FilterNextSample<Taps>(input, lut, sample_rate_ratio, fraction, read_index)};
+        const auto products1{
+            FilterNextSample<Taps>(input, lut, sample_rate_ratio, fraction, read_index)};
+        const auto products2{
+            FilterNextSample<Taps>(input, lut, sample_rate_ratio, fraction, read_index)};
+        const auto products3{
+            FilterNextSample<Taps>(input, lut, sample_rate_ratio, fraction, read_index)};
+        StoreFiltered(&output[i], products0, products1, products2, products3);
+    }
+    return vector_count;
+}
+#else
+template <size_t Taps>
+static u32 ResampleFilterVectorised(std::span<s32>, std::span<const s16>, std::span<const f32>,
+                                    const Common::FixedPoint<49, 15>&,
+                                    Common::FixedPoint<49, 15>&, u32&, const u32) {
+    return 0;
+}
+#endif
+
 static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input,
                                const Common::FixedPoint<49, 15>& sample_rate_ratio,
                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
@@ -25,8 +151,8 @@ static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input
 
 static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> input,
                                   const Common::FixedPoint<49, 15>& sample_rate_ratio,
-                                  Common::FixedPoint<49, 15>& fraction,
-                                  const u32 samples_to_write) {
+                                  Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+                                  const bool vectorise) {
     static constexpr std::array<f32, 512> lut0 = {
         0.20141602f, 0.59283447f, 0.20513916f, 0.00009155f, 0.19772339f, 0.59277344f, 0.20889282f,
         0.00027466f, 0.19406128f, 0.59262085f, 0.21264648f, 0.00045776f, 0.19039917f, 0.59240723f,
@@ -294,7 +420,12 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
 
     auto lut{get_lut()};
     u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
+    u32 i{0};
+    if (vectorise && HasVectorisedFilter()) {
+        i = ResampleFilterVectorised<4>(output, input, lut, sample_rate_ratio, fraction,
+                                         read_index, samples_to_write);
+    }
+    for (; i < samples_to_write; i++) {
         const auto lut_index{(fraction.get_frac() >> 8) * 4};
         const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
         const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
@@ -309,7 +440,8 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
 
 static void ResampleHighQuality(std::span<s32> output, std::span<const s16> input,
                                 const Common::FixedPoint<49, 15>& sample_rate_ratio,
-                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
+                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+                                const bool vectorise) {
     static constexpr std::array<f32, 1024> lut0 = {
         -0.01776123f, -0.00070190f, 0.26672363f,  0.50006104f,  0.26956177f,  0.00024414f,
         -0.01800537f, 0.00000000f,  -0.01748657f, -0.00164795f, 0.26388550f,  0.50003052f,
@@ -844,7 +976,12 @@ static void ResampleHighQuality(std::span<s32> output, std::span<const s16> inpu
 
     auto lut{get_lut()};
     u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
+    u32 i{0};
+    if (vectorise && HasVectorisedFilter()) {
+        i = ResampleFilterVectorised<8>(output, input, lut, sample_rate_ratio, fraction,
+                                         read_index, samples_to_write);
+    }
+    for (; i < samples_to_write; i++) {
         const auto lut_index{(fraction.get_frac() >> 8) * 8};
         const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
         const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
@@ -862,22 +999,37 @@ static void ResampleHighQuality(std::span<s32> output, std::span<const s16> inpu
     }
 }
 
-void Resample(std::span<s32> output, std::span<const s16> input,
-              const Common::FixedPoint<49, 15>& sample_rate_ratio,
-              Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
-              const SrcQuality src_quality) {
-
+static void ResampleImpl(std::span<s32> output, std::span<const s16> input,
+                         const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                         Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+                         const SrcQuality src_quality, const bool vectorise) {
     switch (src_quality) {
     case SrcQuality::Low:
         ResampleLowQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
         break;
     case SrcQuality::Medium:
-        ResampleNormalQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
+        ResampleNormalQuality(output, input, sample_rate_ratio, fraction, samples_to_write,
+                              vectorise);
         break;
     case SrcQuality::High:
-        ResampleHighQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
+        ResampleHighQuality(output, input, sample_rate_ratio, fraction, samples_to_write,
+                            vectorise);
         break;
     }
 }
 
+void Resample(std::span<s32> output, std::span<const s16> input,
+              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+              Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+              const SrcQuality src_quality) {
+    ResampleImpl(output, input, sample_rate_ratio, fraction, samples_to_write, src_quality, true);
+}
+
+void ResampleScalar(std::span<s32> output, std::span<const s16> input,
+                    const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                    Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+                    const SrcQuality src_quality) {
+    ResampleImpl(output, input, sample_rate_ratio, fraction, samples_to_write, src_quality, false);
+}
+
 } // namespace AudioCore::Renderer
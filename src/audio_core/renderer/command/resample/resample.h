@@ -12,6 +12,7 @@
 namespace AudioCore::Renderer {
 /**
  * Resample an input buffer into an output buffer, according to the sample_rate_ratio.
+ * The medium and high quality filters use SSE4.1 or NEON, and are bit-exact with ResampleScalar.
  *
  * @param output            - Output buffer.
  * @param input             - Input buffer.
@@ -26,4 +27,13 @@ void Resample(std::span<s32> output, std::span<const s16> input,
               const Common::FixedPoint<49, 15>& sample_rate_ratio,
               Common::FixedPoint<49, 15>& fraction, u32 samples_to_write, SrcQuality src_quality);
 
+/**
+ * Reference implementation of Resample, filtering one sample at a time.
+ * See Resample for the parameters.
+ */
+void ResampleScalar(std::span<s32> output, std::span<const s16> input,
+                    const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                    Common::FixedPoint<49, 15>& fraction, u32 samples_to_write,
+                    SrcQuality src_quality);
+
 } // namespace AudioCore::Renderer
@@ -20,9 +20,6 @@ void DeviceSinkCommand::Dump([[maybe_unused]] const AudioRenderer::CommandListPr
 }
 
 void DeviceSinkCommand::Process(const AudioRenderer::CommandListProcessor& processor) {
-    constexpr s32 min = std::numeric_limits<s16>::min();
-    constexpr s32 max = std::numeric_limits<s16>::max();
-
     auto stream{processor.GetOutputSinkStream()};
     stream->SetSystemChannels(input_count);
 
@@ -33,18 +30,14 @@ void DeviceSinkCommand::Process(const AudioRenderer::CommandListProcessor& proce
         .consumed{false},
     };
 
-    std::array<s16, TargetSampleCount * MaxChannels> samples{};
+    std::array<std::span<const s32>, MaxChannels> channels{};
     for (u32 channel = 0; channel < input_count; channel++) {
-        const auto offset{inputs[channel] * out_buffer.frames};
-
-        for (u32 index = 0; index < out_buffer.frames; index++) {
-            samples[index * input_count + channel] =
-                static_cast<s16>(std::clamp(sample_buffer[offset + index], min, max));
-        }
+        channels[channel] =
+            sample_buffer.subspan(inputs[channel] * out_buffer.frames, out_buffer.frames);
     }
 
-    out_buffer.tag = reinterpret_cast<u64>(samples.data());
-    stream->AppendBuffer(out_buffer, {samples.data(), out_buffer.frames * input_count});
+    out_buffer.tag = reinterpret_cast<u64>(sample_buffer.data());
+    stream->AppendMixBuffers(out_buffer, std::span(channels).first(input_count));
 
     if (stream->IsPaused()) {
         stream->Start();
@@ -60,7 +60,9 @@ public:
 
         void Write(const Common::FixedPoint<50, 14> value) {
             buffer[buffer_pos] = value;
-            buffer_pos = static_cast<u32>((buffer_pos + 1) % buffer.size());
+            if (++buffer_pos == buffer.size()) {
+                buffer_pos = 0;
+            }
         }
 
         s32 sample_count_max{};
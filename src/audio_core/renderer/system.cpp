@@ -15,6 +15,7 @@
 #include "audio_core/renderer/command/command_buffer.h"
 #include "audio_core/renderer/command/command_generator.h"
 #include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/measured_command_costs.h"
 #include "audio_core/renderer/effect/effect_info_base.h"
 #include "audio_core/renderer/effect/effect_result_state.h"
 #include "audio_core/renderer/memory/memory_pool_info.h"
@@ -29,6 +30,7 @@
 #include "audio_core/renderer/voice/voice_info.h"
 #include "audio_core/renderer/voice/voice_state.h"
 #include "common/alignment.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_event.h"
@@ -641,6 +643,7 @@ u64 System::GenerateCommand(std::span<u8> in_command_buffer,
     command_list_header->sample_count = sample_count;
     command_list_header->sample_rate = sample_rate;
     command_list_header->samples_buffer = samples_workbuffer;
+    command_list_header->workbuffer = {workbuffer.get(), workbuffer_size};
 
     const auto performance_initialized{performance_manager.IsInitialized()};
     if (performance_initialized) {
@@ -666,6 +669,11 @@ u64 System::GenerateCommand(std::span<u8> in_command_buffer,
         .memory_pool_info{&memory_pool_info},
     };
 
+    const MeasuredCommandCosts* measured_costs{nullptr};
+    if (Settings::values.audio_measured_voice_drop.GetValue()) {
+        measured_costs = &audio_renderer.GetMeasuredCommandCosts();
+    }
+
     CommandBuffer command_buffer{
         .command_list{in_command_buffer},
         .sample_count{sample_count},
@@ -675,6 +683,7 @@ u64 System::GenerateCommand(std::span<u8> in_command_buffer,
         .estimated_process_time{0},
         .memory_pool{&memory_pool_info},
         .time_estimator{command_processing_time_estimator.get()},
+        .measured_costs{measured_costs},
         .behavior{&behavior},
     };
 
@@ -807,8 +816,13 @@ u32 System::DropVoices(CommandBuffer& command_buffer, u32 estimated_process_time
                 cmd->enabled = true;
             } else if (cmd->enabled && cmd->type != CommandId::Performance) {
                 cmd->enabled = false;
-                estimated_process_time -= static_cast<u32>(
-                    drop_voice_param * static_cast<f32>(cmd->estimated_process_time));
+                const auto process_time{
+                    command_buffer.measured_costs != nullptr
+                        ? command_buffer.measured_costs->Estimate(cmd->type,
+                                                                  cmd->estimated_process_time)
+                        : cmd->estimated_process_time};
+                estimated_process_time -=
+                    static_cast<u32>(drop_voice_param * static_cast<f32>(process_time));
             }
             command_list += cmd->size;
             cmd = reinterpret_cast<ICommand*>(command_list);
@@ -258,6 +258,7 @@ SinkStream* CubebSink::AcquireSinkStream(Core::System& system, u32 system_channe
     system_channels = system_channels_;
     SinkStreamPtr& stream = sink_streams.emplace_back(std::make_unique<CubebSinkStream>(
         ctx, device_channels, system_channels, output_device, input_device, name, type, system));
+    stream->SetStatistics(statistics);
 
     return stream.get();
 }
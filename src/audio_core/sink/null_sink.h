@@ -21,6 +21,7 @@ public:
         : SinkStream{system_, type_} {}
     ~NullSinkStreamImpl() override {}
     void AppendBuffer(SinkBuffer&, std::span<s16>) override {}
+    void AppendMixBuffers(SinkBuffer&, std::span<const std::span<const s32>>) override {}
     std::vector<s16> ReleaseBuffer(u64) override {
         return {};
     }
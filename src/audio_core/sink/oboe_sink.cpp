@@ -192,6 +192,7 @@ SinkStream* OboeSink::AcquireSinkStream(Core::System& system, u32 system_channel
                                         const std::string& name, StreamType type) {
     SinkStreamPtr& stream = sink_streams.emplace_back(
         std::make_unique<OboeSinkStream>(system, type, name, system_channels));
+    stream->SetStatistics(statistics);
 
     return stream.get();
 }
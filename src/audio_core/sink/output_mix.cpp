@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "audio_core/common/common.h"
+#include "audio_core/common/simd.h"
+#include "audio_core/sink/output_mix.h"
+
+namespace AudioCore::Sink {
+namespace {
+
+constexpr s32 Min{std::numeric_limits<s16>::min()};
+constexpr s32 Max{std::numeric_limits<s16>::max()};
+
+// Front = 1.0
+// Center = 0.596
+// LFE = 0.354
+// Back = 0.707
+constexpr std::array<f32, 4> DownMixCoeff{1.0f, 0.596f, 0.354f, 0.707f};
+
+constexpr u32 FrontLeft{static_cast<u32>(Channels::FrontLeft)};
+constexpr u32 FrontRight{static_cast<u32>(Channels::FrontRight)};
+constexpr u32 Center{static_cast<u32>(Channels::Center)};
+constexpr u32 LFE{static_cast<u32>(Channels::LFE)};
+constexpr u32 BackLeft{static_cast<u32>(Channels::BackLeft)};
+constexpr u32 BackRight{static_cast<u32>(Channels::BackRight)};
+
+f32 ReadSample(std::span<const s32> channel, u32 index) {
+    return static_cast<f32>(std::clamp(channel[index], Min, Max));
+}
+
+s16 ToPcm16(f32 sample) {
+    return static_cast<s16>(std::clamp(static_cast<s32>(sample), Min, Max));
+}
+
+/**
+ * Convert frames [first_frame, frame_count) one at a time, writing them at their frame index in
+ * the output.
+ */
+void MixFramesScalar(std::span<s16> output, std::span<const std::span<const s32>> inputs,
+                     u32 device_channels, f32 volume, u32 first_frame, u32 frame_count) {
+    const auto input_channels{static_cast<u32>(inputs.size())};
+    const auto output_channels{GetOutputChannels(input_channels, device_channels)};
+
+    if (input_channels == 6 && output_channels == 2) {
+        for (u32 frame = first_frame; frame < frame_count; frame++) {
+            const auto fl{ReadSample(inputs[FrontLeft], frame)};
+            const auto fr{ReadSample(inputs[FrontRight], frame)};
+            const auto c{ReadSample(inputs[Center], frame)};
+            const auto lfe{ReadSample(inputs[LFE], frame)};
+            const auto bl{ReadSample(inputs[BackLeft], frame)};
+            const auto br{ReadSample(inputs[BackRight], frame)};
+
+            output[frame * 2 + FrontLeft] =
+                ToPcm16((fl * DownMixCoeff[0] + c * DownMixCoeff[1] + lfe * DownMixCoeff[2] +
+                         bl * DownMixCoeff[3]) *
+                        volume);
+            output[frame * 2 + FrontRight] =
+                ToPcm16((fr * DownMixCoeff[0] + c * DownMixCoeff[1] + lfe * DownMixCoeff[2] +
+                         br * DownMixCoeff[3]) *
+                        volume);
+        }
+        return;
+    }
+
+    if (input_channels == 2 && output_channels == 6) {
+        // TODO: Implement some upmixing here. Currently just passthrough, with other
+        // channels left as silence.
+        for (u32 frame = first_frame; frame < frame_count; frame++) {
+            auto* const out{&output[frame * 6]};
+            std::fill_n(out, 6, s16{0});
+            out[FrontLeft] = ToPcm16(ReadSample(inputs[FrontLeft], frame) * volume);
+            out[FrontRight] = ToPcm16(ReadSample(inputs[FrontRight], frame) * volume);
+        }
+        return;
+    }
+
+    for (u32 frame = first_frame; frame < frame_count; frame++) {
+        for (u32 channel = 0; channel < input_channels; channel++) {
+            output[frame * input_channels + channel] =
+                ToPcm16(ReadSample(inputs[channel], frame) * volume);
+        }
+    }
+}
+
+#if defined(ARCHITECTURE_x86_64)
+AUDIO_CORE_TARGET_SSE41 __m128 LoadClampedSse41(std::span<const s32> channel, u32 index) {
+    const __m128i samples{_mm_loadu_si128(reinterpret_cast<const __m128i*>(&channel[index]))};
+    return _mm_cvtepi32_ps(
+        _mm_max_epi32(_mm_min_epi32(samples, _mm_set1_epi32(Max)), _mm_set1_epi32(Min)));
+}
+
+template <bool Downmix>
+AUDIO_CORE_TARGET_SSE41 u32 MixToStereoSse41(s16* output,
+                                             std::span<const std::span<const s32>> inputs,
+                                             f32 volume, u32 frame_count) {
+    const u32 vector_count{frame_count & ~3U};
+    const __m128 gain{_mm_set1_ps(volume)};
+
+    for (u32 frame = 0; frame < vector_count; frame += 4) {
+        __m128 left{LoadClampedSse41(inputs[FrontLeft], frame)};
+        __m128 right{LoadClampedSse41(inputs[FrontRight], frame)};
+        if constexpr (Downmix) {
+            // Same order of operations as the scalar loop, so the results match
+            const __m128 center{
+                _mm_mul_ps(LoadClampedSse41(inputs[Center], frame), _mm_set1_ps(DownMixCoeff[1]))};
+            const __m128 lfe{
+                _mm_mul_ps(LoadClampedSse41(inputs[LFE], frame), _mm_set1_ps(DownMixCoeff[2]))};
+            const __m128 back{_mm_set1_ps(DownMixCoeff[3])};
+            left = _mm_add_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(left, _mm_set1_ps(DownMixCoeff[0])), center),
+                           lfe),
+                _mm_mul_ps(LoadClampedSse41(inputs[BackLeft], frame), back));
+            right = _mm_add_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(right, _mm_set1_ps(DownMixCoeff[0])), center),
+                           lfe),
+                _mm_mul_ps(LoadClampedSse41(inputs[BackRight], frame), back));
+        }
+
+        // Truncate like static_cast, then saturate to PCM16 like the scalar clamp
+        const __m128i left_samples{_mm_cvttps_epi32(_mm_mul_ps(left, gain))};
+        const __m128i right_samples{_mm_cvttps_epi32(_mm_mul_ps(right, gain))};
+        const __m128i interleaved{
+            _mm_unpacklo_epi16(_mm_packs_epi32(left_samples, left_samples),
+                               _mm_packs_epi32(right_samples, right_samples))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + frame * 2), interleaved);
+    }
+    return vector_count;
+}
+#elif defined(ARCHITECTURE_arm64)
+float32x4_t LoadClampedNeon(std::span<const s32> channel, u32 index) {
+    const int32x4_t samples{vld1q_s32(&channel[index])};
+    return vcvtq_f32_s32(vmaxq_s32(vminq_s32(samples, vdupq_n_s32(Max)), vdupq_n_s32(Min)));
+}
+
+template <bool Downmix>
+u32 MixToStereoNeon(s16* output, std::span<const std::span<const s32>> inputs, f32 volume,
+                    u32 frame_count) {
+    const u32 vector_count{frame_count & ~3U};
+
+    for (u32 frame = 0; frame < vector_count; frame += 4) {
+        float32x4_t left{LoadClampedNeon(inputs[FrontLeft], frame)};
+        float32x4_t right{LoadClampedNeon(inputs[FrontRight], frame)};
+        if constexpr (Downmix) {
+            const float32x4_t center{
+                vmulq_n_f32(LoadClampedNeon(inputs[Center], frame), DownMixCoeff[1])};
+            const float32x4_t lfe{
+                vmulq_n_f32(LoadClampedNeon(inputs[LFE], frame), DownMixCoeff[2])};
+            left = vaddq_f32(
+                vaddq_f32(vaddq_f32(vmulq_n_f32(left, DownMixCoeff[0]), center), lfe),
+                vmulq_n_f32(LoadClampedNeon(inputs[BackLeft], frame), DownMixCoeff[3]));
+            right = vaddq_f32(
+                vaddq_f32(vaddq_f32(vmulq_n_f32(right, DownMixCoeff[0]), center), lfe),
+                vmulq_n_f32(LoadClampedNeon(inputs[BackRight], frame), DownMixCoeff[3]));
+        }
+
+        // vcvtq truncates like static_cast, vqmovn saturates to PCM16 like the scalar clamp
+        const int16x4x2_t interleaved{{
+            vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(left, volume))),
+            vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(right, volume))),
+        }};
+        vst2_s16(output + frame * 2, interleaved);
+    }
+    return vector_count;
+}
+#endif
+
+} // Anonymous namespace
+
+u32 MixToDevice(std::span<s16> output, std::span<const std::span<const s32>> inputs,
+                u32 device_channels, f32 volume, u32 frame_count) {
+    const auto input_channels{static_cast<u32>(inputs.size())};
+    const auto output_channels{GetOutputChannels(input_channels, device_channels)};
+
+    u32 processed{0};
+    if (output_channels == 2 && (input_channels == 2 || input_channels == 6)) {
+        const bool downmix{input_channels == 6};
+#if defined(ARCHITECTURE_x86_64)
+        if (HasSse41()) {
+            processed = downmix ? MixToStereoSse41<true>(output.data(), inputs, volume, frame_count)
+                                : MixToStereoSse41<false>(output.data(), inputs, volume,
+                                                          frame_count);
+        }
+#elif defined(ARCHITECTURE_arm64)
+        processed = downmix ? MixToStereoNeon<true>(output.data(), inputs, volume, frame_count)
+                            : MixToStereoNeon<false>(output.data(), inputs, volume, frame_count);
+#endif
+    }
+
+    if (processed < frame_count) {
+        MixFramesScalar(output, inputs, device_channels, volume, processed, frame_count);
+    }
+    return frame_count * output_channels;
+}
+
+u32 MixToDeviceScalar(std::span<s16> output, std::span<const std::span<const s32>> inputs,
+                      u32 device_channels, f32 volume, u32 frame_count) {
+    MixFramesScalar(output, inputs, device_channels, volume, 0, frame_count);
+    return frame_count * GetOutputChannels(static_cast<u32>(inputs.size()), device_channels);
+}
+
+} // namespace AudioCore::Sink
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace AudioCore::Sink {
+
+/**
+ * Get the number of channels MixToDevice outputs for the given channel counts. 6 channels are
+ * downmixed to a stereo device, stereo is widened with silence for a 6 channel device, and
+ * anything else is passed through with its own channel count.
+ *
+ * @param input_channels  - Number of channels mixed by the game.
+ * @param device_channels - Number of channels the output device plays.
+ * @return The number of interleaved channels written.
+ */
+constexpr u32 GetOutputChannels(u32 input_channels, u32 device_channels) {
+    if (input_channels == 6 && device_channels == 2) {
+        return 2;
+    }
+    if (input_channels == 2 && device_channels == 6) {
+        return 6;
+    }
+    return input_channels;
+}
+
+/**
+ * Convert the final mix into interleaved PCM16 for the output device in one pass. Each input
+ * channel is clamped to PCM16, downmixed or widened for the device (see GetOutputChannels),
+ * scaled by the output volume, clamped again and interleaved into the output. Uses SSE4.1 or
+ * NEON for stereo output when the host supports it.
+ *
+ * @param output          - Output samples, must hold frame_count * GetOutputChannels samples.
+ * @param inputs          - Mix buffer of each input channel, each holding frame_count samples.
+ * @param device_channels - Number of channels the output device plays.
+ * @param volume          - Output volume to apply.
+ * @param frame_count     - Number of frames to convert.
+ * @return The number of samples written to the output.
+ */
+u32 MixToDevice(std::span<s16> output, std::span<const std::span<const s32>> inputs,
+                u32 device_channels, f32 volume, u32 frame_count);
+
+/**
+ * Reference implementation of MixToDevice, processing one frame at a time.
+ * See MixToDevice for the parameters.
+ */
+u32 MixToDeviceScalar(std::span<s16> output, std::span<const std::span<const s32>> inputs,
+                      u32 device_channels, f32 volume, u32 frame_count);
+
+} // namespace AudioCore::Sink
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -95,7 +96,36 @@ public:
         return system_channels;
     }
 
+    /**
+     * Get the number of times this sink's streams ran out of queued audio since the last call.
+     *
+     * @return Number of underruns.
+     */
+    u64 GetAndResetUnderruns() {
+        return statistics.underruns.exchange(0);
+    }
+
+    /**
+     * Get the number of times this sink's streams dropped samples since the last call.
+     *
+     * @return Number of overruns.
+     */
+    u64 GetAndResetOverruns() {
+        return statistics.overruns.exchange(0);
+    }
+
+    /**
+     * Get the estimated output latency, from the most recent stream callback.
+     *
+     * @return Output latency.
+     */
+    std::chrono::microseconds GetLatency() const {
+        return std::chrono::microseconds{statistics.latency_us.load()};
+    }
+
 protected:
+    /// Output statistics of the streams of this sink
+    SinkStatistics statistics{};
     /// Number of device channels supported by the hardware
     u32 device_channels{2};
     /// Number of channels the game is sending
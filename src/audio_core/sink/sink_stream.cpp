@@ -9,8 +9,11 @@
 
 #include "audio_core/audio_core.h"
 #include "audio_core/common/common.h"
+#include "audio_core/sink/output_mix.h"
 #include "audio_core/sink/sink_stream.h"
+#include "common/assert.h"
 #include "common/common_types.h"
+#include "common/div_ceil.h"
 #include "common/fixed_point.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
@@ -18,11 +21,23 @@
 #include "core/core_timing.h"
 
 namespace AudioCore::Sink {
+namespace {
+
+/// Smallest queue depth WaitFreeSpace will wait for
+constexpr u32 MinQueueSize{2};
+/// Buffers which may be queued past the target depth before WaitFreeSpace blocks without a timeout
+constexpr u32 MaxExtraQueuedBuffers{3};
+/// Callback intervals longer than this are from a pause or a stall, not jitter, and are ignored
+constexpr std::chrono::milliseconds MaxCallbackInterval{250};
+/// Slowest tempo the time stretcher plays at when the queue runs low
+constexpr f64 MinStretchTempo{0.25};
+
+} // Anonymous namespace
 
 void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
     SCOPE_EXIT {
         queue.enqueue(buffer);
-        ++queued_buffers;
+        ++appended_buffers;
     };
 
     if (type == StreamType::In) {
@@ -32,11 +47,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
     constexpr s32 min{std::numeric_limits<s16>::min()};
     constexpr s32 max{std::numeric_limits<s16>::max()};
 
-    auto yuzu_volume{Settings::Volume()};
-    if (yuzu_volume > 1.0f) {
-        yuzu_volume = 0.6f + 20 * std::log10(yuzu_volume);
-    }
-    auto volume{system_volume * device_volume * yuzu_volume};
+    const auto volume{GetOutputVolume()};
 
     if (system_channels == 6 && device_channels == 2) {
         // We're given 6 channels, but our device only outputs 2, so downmix.
@@ -77,7 +88,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
                 static_cast<s16>(std::clamp(right_sample, min, max));
         }
 
-        samples_buffer.Push(samples.subspan(0, samples.size() / system_channels * device_channels));
+        PushSamples(samples.subspan(0, samples.size() / system_channels * device_channels));
         return;
     }
 
@@ -106,7 +117,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
             new_samples[write_index + static_cast<u32>(Channels::FrontRight)] = right_sample;
         }
 
-        samples_buffer.Push(new_samples);
+        PushSamples(new_samples);
         return;
     }
 
@@ -117,7 +128,42 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
         }
     }
 
-    samples_buffer.Push(samples);
+    PushSamples(samples);
+}
+
+void SinkStream::AppendMixBuffers(SinkBuffer& buffer,
+                                  std::span<const std::span<const s32>> inputs) {
+    SCOPE_EXIT {
+        queue.enqueue(buffer);
+        ++appended_buffers;
+    };
+
+    if (type == StreamType::In) {
+        return;
+    }
+
+    ASSERT(buffer.frames <= TargetSampleCount && inputs.size() <= MaxChannels);
+
+    std::array<s16, TargetSampleCount * MaxChannels> samples;
+    const auto sample_count{MixToDevice(samples, inputs, device_channels, GetOutputVolume(),
+                                        static_cast<u32>(buffer.frames))};
+    PushSamples(std::span(samples).first(sample_count));
+}
+
+f32 SinkStream::GetOutputVolume() const {
+    auto yuzu_volume{Settings::Volume()};
+    if (yuzu_volume > 1.0f) {
+        yuzu_volume = 0.6f + 20 * std::log10(yuzu_volume);
+    }
+    return system_volume * device_volume * yuzu_volume;
+}
+
+void SinkStream::PushSamples(std::span<const s16> samples) {
+    const auto pushed{samples_buffer.Push(samples)};
+    pushed_samples += pushed;
+    if (pushed < samples.size() && statistics != nullptr) {
+        ++statistics->overruns;
+    }
 }
 
 std::vector<s16> SinkStream::ReleaseBuffer(u64 num_samples) {
@@ -144,12 +190,45 @@ std::vector<s16> SinkStream::ReleaseBuffer(u64 num_samples) {
 }
 
 void SinkStream::ClearQueue() {
-    samples_buffer.Pop();
-    while (queue.pop()) {
+    // The callback owns the consuming side of the queue, so record how much was appended and let
+    // it drop everything up to here. Audio in samples are consumed by this thread and can go now.
+    if (type == StreamType::In) {
+        samples_buffer.Discard();
+    } else {
+        cleared_samples = pushed_samples;
+    }
+    cleared_buffers = appended_buffers.load();
+}
+
+void SinkStream::ApplyPendingClear() {
+    const auto cleared{cleared_buffers.load()};
+    if (cleared == applied_clear) {
+        return;
+    }
+    applied_clear = cleared;
+
+    // The playing buffer was queued before the clear if fewer buffers had been released by then
+    auto released{released_buffers.load(std::memory_order_relaxed)};
+    if (released <= cleared) {
+        playing_buffer = {};
+        playing_buffer.consumed = true;
     }
-    queued_buffers = 0;
-    playing_buffer = {};
-    playing_buffer.consumed = true;
+
+    SinkBuffer dropped{};
+    while (released < cleared && queue.try_dequeue(dropped)) {
+        released++;
+    }
+    released_buffers = released;
+
+    if (type != StreamType::In) {
+        const auto samples_to_drop{cleared_samples.load()};
+        if (popped_samples < samples_to_drop) {
+            popped_samples += samples_buffer.Discard(samples_to_drop - popped_samples);
+        }
+        // Also restart the time stretcher, it holds audio from before the clear
+        stretching = false;
+    }
+    SignalFreeSpace();
 }
 
 void SinkStream::ProcessAudioIn(std::span<const s16> input_buffer, std::size_t num_frames) {
@@ -164,6 +243,8 @@ void SinkStream::ProcessAudioIn(std::span<const s16> input_buffer, std::size_t n
         return;
     }
 
+    ApplyPendingClear();
+
     while (frames_written < num_frames) {
         // If the playing buffer has been consumed or has no frames, we need a new one
         if (playing_buffer.consumed || playing_buffer.frames == 0) {
@@ -176,7 +257,7 @@ void SinkStream::ProcessAudioIn(std::span<const s16> input_buffer, std::size_t n
                 continue;
             }
             // Successfully dequeued a new buffer.
-            queued_buffers--;
+            ++released_buffers;
         }
 
         // Get the minimum frames available between the currently playing buffer, and the
@@ -204,33 +285,67 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
     const std::size_t num_channels = GetDeviceChannels();
     const std::size_t frame_size = num_channels;
     const std::size_t frame_size_bytes = frame_size * sizeof(s16);
-    size_t frames_written{0};
-    size_t actual_frames_written{0};
 
     // If we're paused or going to shut down, we don't want to consume buffers as coretiming is
     // paused and we'll desync, so just play silence.
     if (system.IsPaused() || system.IsShuttingDown()) {
         if (system.IsShuttingDown()) {
-            {
-                std::scoped_lock lk{release_mutex};
-                queued_buffers.store(0);
-            }
-            release_cv.notify_one();
+            SignalFreeSpace();
         }
 
+        // Don't count the time spent paused as callback jitter
+        last_callback_time = {};
+
         static constexpr std::array<s16, 6> silence{};
-        for (size_t i = frames_written; i < num_frames; i++) {
+        for (size_t i = 0; i < num_frames; i++) {
             std::memcpy(&output_buffer[i * frame_size], &silence[0], frame_size_bytes);
         }
         return;
     }
 
+    ApplyPendingClear();
+
+    // Switching the time stretcher off drops the audio it holds, switching it back on restarts it
+    const bool stretch{Settings::values.audio_time_stretch.GetValue()};
+    if (!stretch) {
+        stretching = false;
+    }
+    UpdateQueueTarget(num_frames);
+
+    const auto actual_frames_written{stretch ? StretchQueuedFrames(output_buffer, num_frames)
+                                             : PopQueuedFrames(output_buffer, num_frames)};
+
+    std::memcpy(&last_frame[0], &output_buffer[(num_frames - 1) * frame_size], frame_size_bytes);
+
+    if (statistics != nullptr) {
+        // Samples waiting in the ring play after the ones just handed to the backend
+        auto latency_frames{samples_buffer.Size() / frame_size + num_frames};
+        if (stretching) {
+            latency_frames += stretcher.GetBufferedFrames();
+        }
+        statistics->latency_us = latency_frames * 1'000'000 / TargetSampleRate;
+    }
+
+    UpdatePlayedSampleCount(actual_frames_written);
+}
+
+size_t SinkStream::PopQueuedFrames(std::span<s16> output_buffer, std::size_t num_frames) {
+    const std::size_t frame_size = GetDeviceChannels();
+    const std::size_t frame_size_bytes = frame_size * sizeof(s16);
+    size_t frames_written{0};
+    size_t actual_frames_written{0};
+
     while (frames_written < num_frames) {
         // If the playing buffer has been consumed or has no frames, we need a new one
         if (playing_buffer.consumed || playing_buffer.frames == 0) {
             if (!queue.try_dequeue(playing_buffer)) {
                 // If no buffer was available we've underrun, fill the remaining buffer with
-                // the last written frame and continue.
+                // the last written frame and continue. Only count the first callback to run
+                // dry, a stream with nothing to play is not underrunning each time.
+                if (!starved && statistics != nullptr) {
+                    ++statistics->underruns;
+                }
+                starved = true;
                 for (size_t i = frames_written; i < num_frames; i++) {
                     std::memcpy(&output_buffer[i * frame_size], &last_frame[0], frame_size_bytes);
                 }
@@ -238,11 +353,12 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
                 continue;
             }
             // Successfully dequeued a new buffer.
-            queued_buffers--;
-
-            { std::unique_lock lk{release_mutex}; }
-
-            release_cv.notify_one();
+            ++released_buffers;
+            starved = false;
+            if (playing_buffer.frames != 0) {
+                last_buffer_frames = playing_buffer.frames;
+            }
+            SignalFreeSpace();
         }
 
         // Get the minimum frames available between the currently playing buffer, and the
@@ -250,8 +366,8 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         size_t frames_available{std::min<u64>(playing_buffer.frames - playing_buffer.frames_played,
                                               num_frames - frames_written)};
 
-        samples_buffer.Pop(&output_buffer[frames_written * frame_size],
-                           frames_available * frame_size);
+        popped_samples += samples_buffer.Pop(&output_buffer[frames_written * frame_size],
+                                             frames_available * frame_size);
 
         frames_written += frames_available;
         actual_frames_written += frames_available;
@@ -263,45 +379,161 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
             playing_buffer.consumed = true;
         }
     }
+    return actual_frames_written;
+}
 
-    std::memcpy(&last_frame[0], &output_buffer[(frames_written - 1) * frame_size],
-                frame_size_bytes);
+size_t SinkStream::StretchQueuedFrames(std::span<s16> output_buffer, std::size_t num_frames) {
+    const auto frame_size{GetDeviceChannels()};
+    if (!stretching || stretcher.GetChannels() != frame_size) {
+        stretcher.Reset(frame_size);
+        tempo = 1.0;
+        stretching = true;
+    }
 
-    {
-        std::scoped_lock lk{sample_count_lock};
-        last_sample_count_update_time = system.CoreTiming().GetGlobalTimeNs();
-        min_played_sample_count = max_played_sample_count;
-        max_played_sample_count += actual_frames_written;
+    // The stretcher holds a bounded amount of output, larger buffers are filled in parts
+    size_t frames_played{0};
+    for (size_t frames_written = 0; frames_written < num_frames;) {
+        const auto frames{std::min(num_frames - frames_written, TimeStretcher::MaxPopFrames)};
+        while (stretcher.GetOutputFrames() < frames) {
+            const auto frames_needed{stretcher.GetInputFramesNeeded()};
+            if (frames_needed > 0) {
+                const std::span input{std::span(stretch_input).first(frames_needed * frame_size)};
+                frames_played += PopQueuedFrames(input, frames_needed);
+                stretcher.PushInput(input);
+            }
+
+            // The next sequence pulls about tempo * FramesPerSequence frames from the queue.
+            // Slow down as soon as the queue can not cover that, and speed back up gradually.
+            const auto queued_frames{samples_buffer.Size() / frame_size};
+            const auto target_tempo{
+                std::clamp(static_cast<f64>(queued_frames) /
+                               static_cast<f64>(TimeStretcher::FramesPerSequence),
+                           MinStretchTempo, 1.0)};
+            tempo = target_tempo < tempo ? target_tempo : tempo + (target_tempo - tempo) / 4;
+            stretcher.Process(tempo);
+        }
+        stretcher.PopOutput(output_buffer.subspan(frames_written * frame_size), frames);
+        frames_written += frames;
     }
+    return frames_played;
+}
+
+void SinkStream::UpdateQueueTarget(std::size_t num_frames) {
+    const auto now{std::chrono::steady_clock::now()};
+    const auto interval{now - last_callback_time};
+    last_callback_time = now;
+    if (interval > MaxCallbackInterval) {
+        return;
+    }
+
+    // Track the recent worst deviation from the expected callback period, decaying it slowly so
+    // one late callback keeps the queue deeper for a while
+    const auto interval_ns{std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count()};
+    const auto expected_ns{static_cast<s64>(num_frames) * 1'000'000'000 / TargetSampleRate};
+    const auto deviation_ns{std::abs(interval_ns - expected_ns)};
+    callback_jitter_ns = std::max(deviation_ns, callback_jitter_ns - callback_jitter_ns / 64);
+
+    // Keep enough buffered to cover this callback and a late next one, plus the playing buffer
+    const auto jitter_frames{static_cast<u64>(callback_jitter_ns) * TargetSampleRate /
+                             1'000'000'000};
+    // The time stretcher also needs a whole sequence of input queued whenever it starts one
+    const u64 stretch_frames{stretching ? TimeStretcher::RequiredInputFrames : 0};
+    const auto stretch_buffers{
+        static_cast<u32>(Common::DivCeil(stretch_frames, last_buffer_frames))};
+    const auto needed_frames{static_cast<u64>(num_frames) + 2 * jitter_frames + stretch_frames};
+    const auto needed_buffers{Common::DivCeil(needed_frames, last_buffer_frames) + 1};
+    const auto max_target{std::max(max_queue_size.load(), MinQueueSize) + MaxExtraQueuedBuffers +
+                          stretch_buffers};
+    target_queue_size = static_cast<u32>(std::clamp<u64>(needed_buffers, MinQueueSize, max_target));
+}
+
+void SinkStream::UpdatePlayedSampleCount(u64 frames_played) {
+    // Only the callback writes the counts, readers retry if the sequence changes under them
+    const auto sequence{sample_count_sequence.load(std::memory_order_relaxed)};
+    sample_count_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const auto max_played{max_played_sample_count.load(std::memory_order_relaxed)};
+    last_sample_count_update_time.store(system.CoreTiming().GetGlobalTimeNs().count(),
+                                        std::memory_order_relaxed);
+    min_played_sample_count.store(max_played, std::memory_order_relaxed);
+    max_played_sample_count.store(max_played + frames_played, std::memory_order_relaxed);
+
+    sample_count_sequence.store(sequence + 2, std::memory_order_release);
 }
 
 u64 SinkStream::GetExpectedPlayedSampleCount() {
-    std::scoped_lock lk{sample_count_lock};
+    u32 sequence{};
+    u64 min_played{};
+    u64 max_played{};
+    std::chrono::nanoseconds update_time{};
+    do {
+        sequence = sample_count_sequence.load(std::memory_order_acquire);
+        min_played = min_played_sample_count.load(std::memory_order_relaxed);
+        max_played = max_played_sample_count.load(std::memory_order_relaxed);
+        update_time = std::chrono::nanoseconds{
+            last_sample_count_update_time.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 ||
+             sequence != sample_count_sequence.load(std::memory_order_relaxed));
+
     auto cur_time{system.CoreTiming().GetGlobalTimeNs()};
-    auto time_delta{cur_time - last_sample_count_update_time};
-    auto exp_played_sample_count{min_played_sample_count +
+    auto time_delta{cur_time - update_time};
+    auto exp_played_sample_count{min_played +
                                  (TargetSampleRate * time_delta) / std::chrono::seconds{1}};
 
     // Add 15ms of latency in sample reporting to allow for some leeway in scheduler timings
-    return std::min<u64>(exp_played_sample_count, max_played_sample_count) + TargetSampleCount * 3;
+    return std::min<u64>(exp_played_sample_count, max_played) + TargetSampleCount * 3;
+}
+
+u32 SinkStream::GetTargetQueueSize() const {
+    const auto target{target_queue_size.load()};
+    return target != 0 ? target : max_queue_size.load();
 }
 
 void SinkStream::WaitFreeSpace(std::stop_token stop_token) {
-    std::unique_lock lk{release_mutex};
-    release_cv.wait_for(lk, std::chrono::milliseconds(5),
-                        [this]() { return paused || queued_buffers < max_queue_size; });
-    if (queued_buffers > max_queue_size + 3) {
-        Common::CondvarWait(release_cv, lk, stop_token,
-                            [this] { return paused || queued_buffers < max_queue_size; });
+    std::stop_callback wake_on_stop(stop_token, [this] { SignalFreeSpace(); });
+    const auto soft_deadline{std::chrono::steady_clock::now() + std::chrono::milliseconds(5)};
+
+    // Wait up to 5ms for the queue to drop below the target depth. After that, only keep waiting
+    // if the queue has grown past the extra buffers allowed for a late callback.
+    bool hard_wait{false};
+    while (!stop_token.stop_requested()) {
+        const auto target{GetTargetQueueSize()};
+        waiting_for_space = true;
+        if (paused || system.IsShuttingDown() || GetQueueSize() < target) {
+            break;
+        }
+
+        if (hard_wait) {
+            free_space_sema.wait();
+            continue;
+        }
+
+        const auto remaining{std::chrono::duration_cast<std::chrono::microseconds>(
+            soft_deadline - std::chrono::steady_clock::now())};
+        if (remaining.count() > 0) {
+            free_space_sema.wait(remaining.count());
+            continue;
+        }
+
+        if (GetQueueSize() <= target + MaxExtraQueuedBuffers) {
+            break;
+        }
+        hard_wait = true;
     }
+    waiting_for_space = false;
 }
 
 void SinkStream::SignalPause() {
-    {
-        std::scoped_lock lk{release_mutex};
-        paused = true;
+    paused = true;
+    SignalFreeSpace();
+}
+
+void SinkStream::SignalFreeSpace() {
+    if (waiting_for_space.exchange(false)) {
+        free_space_sema.signal();
     }
-    release_cv.notify_one();
 }
 
 } // namespace AudioCore::Sink
@@ -3,15 +3,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <memory>
-#include <mutex>
 #include <span>
 #include <vector>
 
 #include "audio_core/common/common.h"
+#include "audio_core/sink/time_stretch.h"
+#include "common/atomic_helpers.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
 #include "common/reader_writer_queue.h"
@@ -37,6 +39,19 @@ struct SinkBuffer {
     bool consumed;
 };
 
+/**
+ * Output statistics for the streams of a sink. Updated by the stream callbacks without locking,
+ * and read by the perf stats.
+ */
+struct SinkStatistics {
+    /// Number of times a playing stream ran out of queued buffers
+    std::atomic<u64> underruns{};
+    /// Number of times samples were dropped because a stream's sample ring was full
+    std::atomic<u64> overruns{};
+    /// Estimated output latency as of the last stream callback, in microseconds
+    std::atomic<u64> latency_us{};
+};
+
 /**
  * Contains a real backend stream for outputting samples to hardware,
  * created only via a Sink (See Sink::AcquireSinkStream).
@@ -52,6 +67,10 @@ struct SinkBuffer {
  *
  * If the buffers appear to be stuck, you can stop and re-open an IAudioIn/IAudioOut service (this
  * is what games do), or call ClearQueue to flush all of the buffers without a full restart.
+ *
+ * The buffer queue and sample ring are single producer, single consumer. The backend callback
+ * never takes a lock, it only touches atomics, and wakes a thread blocked in WaitFreeSpace through
+ * a lightweight semaphore which is only signalled while that thread is waiting.
  */
 class SinkStream {
 public:
@@ -154,7 +173,9 @@ public:
      * @return The number of queued buffers.
      */
     u32 GetQueueSize() const {
-        return queued_buffers.load();
+        const auto appended{appended_buffers.load()};
+        const auto finished{std::max(released_buffers.load(), cleared_buffers.load())};
+        return static_cast<u32>(appended - std::min(appended, finished));
     }
 
     /**
@@ -164,6 +185,15 @@ public:
         max_queue_size = ring_size;
     }
 
+    /**
+     * Set the statistics this stream reports its underruns, overruns and latency to.
+     *
+     * @param statistics_ - Statistics of the sink owning this stream.
+     */
+    void SetStatistics(SinkStatistics& statistics_) {
+        statistics = &statistics_;
+    }
+
     /**
      * Append a new buffer and its samples to a waiting queue to play.
      *
@@ -172,6 +202,16 @@ public:
      */
     virtual void AppendBuffer(SinkBuffer& buffer, std::span<s16> samples);
 
+    /**
+     * Append a new buffer from the final mix of the AudioRenderer. The mix buffers are clamped,
+     * downmixed for the device, scaled by the output volume and interleaved in a single pass
+     * (see MixToDevice), rather than being converted to PCM16 first and passed to AppendBuffer.
+     *
+     * @param buffer - Audio buffer information to be queued, at most TargetSampleCount frames.
+     * @param inputs - Mix buffer of each system channel, each holding buffer.frames samples.
+     */
+    virtual void AppendMixBuffers(SinkBuffer& buffer, std::span<const std::span<const s32>> inputs);
+
     /**
      * Release a buffer. Audio In only, will fill a buffer with recorded samples.
      *
@@ -209,7 +249,8 @@ public:
     u64 GetExpectedPlayedSampleCount();
 
     /**
-     * Waits for free space in the sample ring buffer
+     * Waits for free space in the sample ring buffer.
+     * The queue depth waited for adapts to the measured jitter of the backend callback.
      */
     void WaitFreeSpace(std::stop_token stop_token);
 
@@ -219,6 +260,74 @@ protected:
      */
     void SignalPause();
 
+private:
+    /**
+     * Get the volume applied to output samples, combining the system, device and yuzu volumes.
+     *
+     * @return The output volume.
+     */
+    f32 GetOutputVolume() const;
+
+    /**
+     * Push samples to be played into the sample ring, counting an overrun if it is full.
+     *
+     * @param samples - Samples to push.
+     */
+    void PushSamples(std::span<const s16> samples);
+
+    /**
+     * Pop queued frames into an output buffer, releasing the buffers they belong to. If the queue
+     * runs dry, the rest of the output is filled with the last frame played.
+     *
+     * @param output_buffer - Output buffer to be filled with samples.
+     * @param num_frames    - Number of frames to be filled.
+     * @return The number of frames popped from the queue.
+     */
+    size_t PopQueuedFrames(std::span<s16> output_buffer, std::size_t num_frames);
+
+    /**
+     * Fill an output buffer through the time stretcher, slowing the tempo when the queue runs low
+     * so that emulation slowdowns stretch the audio rather than underrunning.
+     *
+     * @param output_buffer - Output buffer to be filled with samples.
+     * @param num_frames    - Number of frames to be filled.
+     * @return The number of frames popped from the queue.
+     */
+    size_t StretchQueuedFrames(std::span<s16> output_buffer, std::size_t num_frames);
+
+    /**
+     * Drop the buffers and samples flushed by ClearQueue. Called by the backend callback, as the
+     * consumer of the buffer queue.
+     */
+    void ApplyPendingClear();
+
+    /**
+     * Measure the jitter of the backend callback, and update the queue depth WaitFreeSpace waits
+     * for so that a late callback does not underrun.
+     *
+     * @param num_frames - Number of frames requested by this callback.
+     */
+    void UpdateQueueTarget(std::size_t num_frames);
+
+    /**
+     * Update the played sample counts read by GetExpectedPlayedSampleCount.
+     *
+     * @param frames_played - Number of frames played by this callback.
+     */
+    void UpdatePlayedSampleCount(u64 frames_played);
+
+    /**
+     * Get the number of queued buffers WaitFreeSpace waits to drop below.
+     *
+     * @return The target queue depth.
+     */
+    u32 GetTargetQueueSize() const;
+
+    /**
+     * Wake the thread waiting in WaitFreeSpace, if there is one.
+     */
+    void SignalFreeSpace();
+
 protected:
     /// Core system
     Core::System& system;
@@ -242,25 +351,59 @@ private:
     SinkBuffer playing_buffer{};
     /// The last played (or received) frame of audio, used when the callback underruns
     std::array<s16, MaxChannels> last_frame{};
-    /// Number of buffers waiting to be played
-    std::atomic<u32> queued_buffers{};
+    /// Total number of buffers appended
+    std::atomic<u64> appended_buffers{};
+    /// Total number of buffers taken from the queue by the callback
+    std::atomic<u64> released_buffers{};
+    /// Number of buffers appended as of the last ClearQueue, these are dropped by the callback
+    std::atomic<u64> cleared_buffers{};
+    /// Number of samples pushed as of the last ClearQueue, these are dropped by the callback
+    std::atomic<u64> cleared_samples{};
+    /// Total number of samples pushed to the sample ring, only used by the producer
+    u64 pushed_samples{};
+    /// Total number of samples popped from the sample ring, only used by the callback
+    u64 popped_samples{};
+    /// Value of cleared_buffers last handled by the callback
+    u64 applied_clear{};
+    /// Whether the callback has run out of buffers since it last played one
+    bool starved{true};
     /// The ring size for audio out buffers (usually 4, rarely 2 or 8)
-    u32 max_queue_size{};
-    /// Locks access to sample count tracking info
-    std::mutex sample_count_lock;
+    std::atomic<u32> max_queue_size{};
+    /// Queue depth WaitFreeSpace waits for, from the measured callback jitter. 0 until measured
+    std::atomic<u32> target_queue_size{};
+    /// Frame count of the last buffer played, used to convert the callback timing into buffers
+    u64 last_buffer_frames{TargetSampleCount};
+    /// Host time of the last callback
+    std::chrono::steady_clock::time_point last_callback_time{};
+    /// Recent worst deviation of the callback interval from its expected period, in nanoseconds
+    s64 callback_jitter_ns{};
+    /// Sequence count of the played sample counts below, odd while the callback updates them
+    std::atomic<u32> sample_count_sequence{};
     /// Minimum number of total samples that have been played since the last callback
-    u64 min_played_sample_count{};
+    std::atomic<u64> min_played_sample_count{};
     /// Maximum number of total samples that can be played since the last callback
-    u64 max_played_sample_count{};
-    /// The time the two above tracking variables were last written to
-    std::chrono::nanoseconds last_sample_count_update_time{};
+    std::atomic<u64> max_played_sample_count{};
+    /// The time the two above tracking variables were last written to, in nanoseconds
+    std::atomic<s64> last_sample_count_update_time{};
     /// Set by the audio render/in/out system which uses this stream
     f32 system_volume{1.0f};
     /// Set via IAudioDevice service calls
     f32 device_volume{1.0f};
-    /// Signalled when ring buffer entries are consumed
-    std::condition_variable_any release_cv;
-    std::mutex release_mutex;
+    /// Set while a thread is blocked in WaitFreeSpace and wants to be signalled
+    std::atomic<bool> waiting_for_space{};
+    /// Signalled when queued buffers are consumed, or the stream is paused or stopped
+    Common::spsc_sema::LightweightSemaphore free_space_sema;
+    /// Statistics of the sink owning this stream, if any
+    SinkStatistics* statistics{};
+    /// Stretches the output when the queue runs low, only used by the callback
+    TimeStretcher stretcher;
+    /// Queued frames popped for the time stretcher
+    std::array<s16, TimeStretcher::RequiredInputFrames * TimeStretcher::MaxChannels>
+        stretch_input{};
+    /// Tempo the time stretcher plays at
+    f64 tempo{1.0};
+    /// Whether the callback is playing through the time stretcher
+    bool stretching{};
 };
 
 using SinkStreamPtr = std::unique_ptr<SinkStream>;
@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "audio_core/common/simd.h"
+#include "audio_core/sink/time_stretch.h"
+#include "common/assert.h"
+
+namespace AudioCore::Sink {
+namespace {
+
+/// Frames between the offsets compared by the first pass of the overlap search
+constexpr size_t CoarseSeekStep{4};
+
+struct Correlation {
+    f32 dot;
+    f32 norm;
+};
+
+/**
+ * Correlate a candidate with a reference, also giving the energy of the candidate to normalise
+ * the correlation with.
+ */
+Correlation Correlate(const f32* reference, const f32* candidate, size_t count) {
+    Correlation result{0.0f, 0.0f};
+    size_t i{0};
+#if defined(ARCHITECTURE_x86_64)
+    __m128 dot{_mm_setzero_ps()};
+    __m128 norm{_mm_setzero_ps()};
+    for (; i + 4 <= count; i += 4) {
+        const __m128 samples{_mm_loadu_ps(candidate + i)};
+        dot = _mm_add_ps(dot, _mm_mul_ps(_mm_loadu_ps(reference + i), samples));
+        norm = _mm_add_ps(norm, _mm_mul_ps(samples, samples));
+    }
+    alignas(16) std::array<f32, 4> dot_lanes;
+    alignas(16) std::array<f32, 4> norm_lanes;
+    _mm_store_ps(dot_lanes.data(), dot);
+    _mm_store_ps(norm_lanes.data(), norm);
+    result.dot = (dot_lanes[0] + dot_lanes[1]) + (dot_lanes[2] + dot_lanes[3]);
+    result.norm = (norm_lanes[0] + norm_lanes[1]) + (norm_lanes[2] + norm_lanes[3]);
+#elif defined(ARCHITECTURE_arm64)
+    float32x4_t dot{vdupq_n_f32(0.0f)};
+    float32x4_t norm{vdupq_n_f32(0.0f)};
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t samples{vld1q_f32(candidate + i)};
+        dot = vmlaq_f32(dot, vld1q_f32(reference + i), samples);
+        norm = vmlaq_f32(norm, samples, samples);
+    }
+    result.dot = vaddvq_f32(dot);
+    result.norm = vaddvq_f32(norm);
+#endif
+    for (; i < count; i++) {
+        result.dot += reference[i] * candidate[i];
+        result.norm += candidate[i] * candidate[i];
+    }
+    return result;
+}
+
+s16 ToPcm16(f32 sample) {
+    constexpr f32 min{std::numeric_limits<s16>::min()};
+    constexpr f32 max{std::numeric_limits<s16>::max()};
+    return static_cast<s16>(std::clamp(std::round(sample), min, max));
+}
+
+} // Anonymous namespace
+
+TimeStretcher::TimeStretcher()
+    : input(RequiredInputFrames * MaxChannels), overlap(OverlapFrames * MaxChannels),
+      output((MaxPopFrames + FramesPerSequence) * MaxChannels) {}
+
+void TimeStretcher::Reset(u32 channels) {
+    ASSERT(channels > 0 && channels <= MaxChannels);
+    channel_count = channels;
+    input_frames = 0;
+    output_position = 0;
+    output_end = 0;
+    skip_fraction = 0.0;
+    primed = false;
+}
+
+size_t TimeStretcher::GetInputFramesNeeded() const {
+    return RequiredInputFrames - input_frames;
+}
+
+void TimeStretcher::PushInput(std::span<const s16> samples) {
+    const auto frames{samples.size() / channel_count};
+    ASSERT(frames <= GetInputFramesNeeded());
+    std::ranges::transform(samples.first(frames * channel_count),
+                           input.begin() + input_frames * channel_count,
+                           [](s16 sample) { return static_cast<f32>(sample); });
+    input_frames += frames;
+}
+
+size_t TimeStretcher::Process(f64 tempo) {
+    if (input_frames < RequiredInputFrames || GetOutputFrames() >= MaxPopFrames) {
+        return 0;
+    }
+
+    // Move the output still to be popped to the front, the sequence is written after it
+    if (output_position > 0) {
+        std::copy(output.begin() + output_position, output.begin() + output_end, output.begin());
+        output_end -= output_position;
+        output_position = 0;
+    }
+
+    const auto offset{primed ? FindBestOffset() : 0};
+    const auto* const sequence{&input[offset * channel_count]};
+    auto* const out{&output[output_end]};
+    output_end += FramesPerSequence * channel_count;
+
+    size_t sample{0};
+    if (primed) {
+        // Crossfade from the tail of the previous sequence into this one
+        for (size_t frame = 0; frame < OverlapFrames; frame++) {
+            const auto weight{static_cast<f32>(frame) / static_cast<f32>(OverlapFrames)};
+            for (u32 channel = 0; channel < channel_count; channel++, sample++) {
+                out[sample] =
+                    ToPcm16(overlap[sample] * (1.0f - weight) + sequence[sample] * weight);
+            }
+        }
+    }
+    for (; sample < FramesPerSequence * channel_count; sample++) {
+        out[sample] = ToPcm16(sequence[sample]);
+    }
+    std::copy_n(&sequence[FramesPerSequence * channel_count], OverlapFrames * channel_count,
+                overlap.begin());
+    primed = true;
+
+    // Advance the nominal position by the tempo, the best offset is searched for from there
+    const auto skip{tempo * static_cast<f64>(FramesPerSequence) + skip_fraction};
+    const auto skip_frames{std::min(static_cast<size_t>(skip), input_frames)};
+    skip_fraction = skip - static_cast<f64>(skip_frames);
+    std::copy(input.begin() + skip_frames * channel_count,
+              input.begin() + input_frames * channel_count, input.begin());
+    input_frames -= skip_frames;
+
+    return FramesPerSequence;
+}
+
+size_t TimeStretcher::PopOutput(std::span<s16> out_samples, size_t max_frames) {
+    const auto frames{std::min(GetOutputFrames(), max_frames)};
+    const auto count{frames * channel_count};
+    std::copy_n(output.begin() + output_position, count, out_samples.begin());
+    output_position += count;
+    return frames;
+}
+
+size_t TimeStretcher::FindBestOffset() const {
+    size_t best_offset{0};
+    f32 best_similarity{GetSimilarity(0)};
+    for (size_t offset = CoarseSeekStep; offset < SeekFrames; offset += CoarseSeekStep) {
+        const auto similarity{GetSimilarity(offset)};
+        if (similarity > best_similarity) {
+            best_similarity = similarity;
+            best_offset = offset;
+        }
+    }
+
+    const auto coarse_offset{best_offset};
+    const auto first{coarse_offset > CoarseSeekStep ? coarse_offset - CoarseSeekStep + 1 : 0};
+    const auto last{std::min(coarse_offset + CoarseSeekStep - 1, SeekFrames - 1)};
+    for (size_t offset = first; offset <= last; offset++) {
+        if (offset == coarse_offset) {
+            continue;
+        }
+        const auto similarity{GetSimilarity(offset)};
+        if (similarity > best_similarity) {
+            best_similarity = similarity;
+            best_offset = offset;
+        }
+    }
+    return best_offset;
+}
+
+f32 TimeStretcher::GetSimilarity(size_t offset) const {
+    const auto correlation{Correlate(overlap.data(), &input[offset * channel_count],
+                                     OverlapFrames * channel_count)};
+    // Normalise by the candidate's energy so louder candidates are not favoured
+    return correlation.dot / std::sqrt(correlation.norm + 1.0f);
+}
+
+} // namespace AudioCore::Sink
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace AudioCore::Sink {
+
+/**
+ * Changes the tempo of a stream of interleaved PCM16 samples without changing its pitch, using
+ * WSOLA (waveform similarity overlap-add). Input is cut into overlapping sequences, and each
+ * sequence starts where it best lines up with the end of the previous one, within a small seek
+ * window around where the tempo places it. A tempo below 1 produces more output than input,
+ * stretching the audio out.
+ *
+ * Not thread-safe, a stream's backend callback owns its stretcher. All buffers are allocated on
+ * construction, so a callback can Reset and run the stretcher without allocating.
+ */
+class TimeStretcher {
+public:
+    TimeStretcher();
+
+    /// Frames in each sequence, 40ms at 48KHz
+    static constexpr size_t SequenceFrames{1920};
+    /// Frames crossfaded between sequences, 8ms at 48KHz
+    static constexpr size_t OverlapFrames{384};
+    /// Frames after the nominal position searched for the best overlap, 15ms at 48KHz
+    static constexpr size_t SeekFrames{720};
+    /// Input frames needed to produce a sequence
+    static constexpr size_t RequiredInputFrames{SeekFrames + SequenceFrames};
+    /// Output frames produced by each sequence
+    static constexpr size_t FramesPerSequence{SequenceFrames - OverlapFrames};
+    /// Most interleaved channels a stream can have
+    static constexpr u32 MaxChannels{6};
+    /// Most frames to request at once, Process stops producing output beyond this many frames
+    static constexpr size_t MaxPopFrames{2 * FramesPerSequence};
+
+    /**
+     * Drop all buffered samples and set the channel count of the stream.
+     *
+     * @param channels - Number of interleaved channels in the stream, at most MaxChannels.
+     */
+    void Reset(u32 channels);
+
+    /**
+     * Get the channel count set by the last Reset.
+     *
+     * @return The number of interleaved channels.
+     */
+    u32 GetChannels() const {
+        return channel_count;
+    }
+
+    /**
+     * Get the number of input frames to push before Process can produce another sequence.
+     *
+     * @return The number of frames missing, 0 if Process can run.
+     */
+    size_t GetInputFramesNeeded() const;
+
+    /**
+     * Queue input samples, at most GetInputFramesNeeded frames worth.
+     *
+     * @param samples - Interleaved samples to queue.
+     */
+    void PushInput(std::span<const s16> samples);
+
+    /**
+     * Produce one sequence of output from the queued input if there is enough of it, and fewer
+     * than MaxPopFrames of output are waiting to be popped.
+     *
+     * @param tempo - Input frames consumed per output frame, 1.0 plays at normal speed.
+     * @return The number of output frames produced.
+     */
+    size_t Process(f64 tempo);
+
+    /**
+     * Get the number of output frames ready to be popped.
+     *
+     * @return The number of ready frames.
+     */
+    size_t GetOutputFrames() const {
+        return (output_end - output_position) / channel_count;
+    }
+
+    /**
+     * Pop produced frames.
+     *
+     * @param out_samples - Receives the interleaved output samples.
+     * @param max_frames  - Maximum number of frames to pop.
+     * @return The number of frames popped.
+     */
+    size_t PopOutput(std::span<s16> out_samples, size_t max_frames);
+
+    /**
+     * Get the number of frames held by the stretcher, which play after everything queued before
+     * it.
+     *
+     * @return The number of buffered input and output frames.
+     */
+    size_t GetBufferedFrames() const {
+        return input_frames + GetOutputFrames() + (primed ? OverlapFrames : 0);
+    }
+
+private:
+    /**
+     * Find the offset into the input where a sequence best continues the previous one, searching
+     * every few frames of the seek window first, then around the best match.
+     *
+     * @return The offset in frames.
+     */
+    size_t FindBestOffset() const;
+
+    /**
+     * Compare the overlap of the previous sequence with the input at an offset.
+     *
+     * @param offset - Offset in frames into the input.
+     * @return The similarity, larger is better.
+     */
+    f32 GetSimilarity(size_t offset) const;
+
+    /// Number of interleaved channels
+    u32 channel_count{2};
+    /// Queued input samples, sized for MaxChannels
+    std::vector<f32> input;
+    /// Number of frames in the input
+    size_t input_frames{};
+    /// Tail of the previous sequence, crossfaded into the start of the next one
+    std::vector<f32> overlap;
+    /// Produced output samples, sized for MaxChannels
+    std::vector<s16> output;
+    /// Index of the next sample to pop from the output
+    size_t output_position{};
+    /// Index one past the last produced sample in the output
+    size_t output_end{};
+    /// Fraction of a frame the input has been advanced past, carried between sequences
+    f64 skip_fraction{};
+    /// Has a sequence been produced since the last Reset, so the overlap holds audio
+    bool primed{};
+};
+
+} // namespace AudioCore::Sink
@@ -29,3 +29,4 @@
 // yuzu-specific files
 
 #define LOG_FILE "yuzu_log.txt"
+#define BINARY_LOG_FILE "yuzu_log.bin"
@@ -1,10 +1,17 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <climits>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <thread>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -21,6 +28,8 @@
 #include "common/thread.h"
 
 #include "common/logging/backend.h"
+#include "common/logging/binary_log.h"
+#include "common/logging/binary_log_file.h"
 #include "common/logging/log.h"
 #include "common/logging/log_entry.h"
 #include "common/logging/text_formatter.h"
@@ -75,6 +84,10 @@ public:
         enabled = enabled_;
     }
 
+    bool IsEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
 private:
     std::atomic_bool enabled{false};
 };
@@ -135,6 +148,72 @@ private:
     std::size_t bytes_written = 0;
 };
 
+/**
+ * Backend that writes captured records to a binary log file, turned into text by the log decoder
+ */
+class BinaryFileBackend {
+public:
+    explicit BinaryFileBackend(const std::filesystem::path& filename) {
+        auto old_filename = filename;
+        old_filename += ".old.bin";
+
+        static_cast<void>(FS::RemoveFile(old_filename));
+        static_cast<void>(FS::RenameFile(filename, old_filename));
+
+        file = std::make_unique<FS::IOFile>(filename, FS::FileAccessMode::Write,
+                                            FS::FileType::BinaryFile);
+        encoder.WriteHeader(buffer);
+    }
+
+    void Write(const RecordHeader& header, std::span<const u8> args,
+               std::chrono::microseconds timestamp) {
+        if (enabled) {
+            encoder.WriteRecord(buffer, header, args, timestamp);
+            Written(header.log_level);
+        }
+    }
+
+    void Write(const Entry& entry) {
+        if (enabled) {
+            encoder.WriteEntry(buffer, entry);
+            Written(entry.log_level);
+        }
+    }
+
+    /// Hands the encoded records to the file, done whenever the backend runs out of records
+    void WriteBuffered() {
+        bytes_written += file->WriteSpan(std::span<const u8>{buffer});
+        buffer.clear();
+    }
+
+    void Flush() {
+        WriteBuffered();
+        file->Flush();
+    }
+
+private:
+    void Written(Level log_level) {
+        using namespace Common::Literals;
+        // Same limits as the text log, which is several times larger for the same messages
+        const auto write_limit = Settings::values.extended_logging.GetValue() ? 1_GiB : 100_MiB;
+        const bool write_limit_exceeded = bytes_written + buffer.size() > write_limit;
+        if (log_level >= Level::Error || write_limit_exceeded) {
+            if (write_limit_exceeded) {
+                enabled = false;
+            }
+            Flush();
+        } else if (buffer.size() >= 64_KiB) {
+            WriteBuffered();
+        }
+    }
+
+    std::unique_ptr<FS::IOFile> file;
+    BinaryLogEncoder encoder;
+    std::vector<u8> buffer;
+    bool enabled = true;
+    std::size_t bytes_written = 0;
+};
+
 /**
  * Backend that writes to Visual Studio's output window
  */
@@ -175,6 +254,122 @@ public:
 };
 #endif
 
+/**
+ * A thread's ring of captured records, written only by that thread and read only by the backend
+ * thread. Records are kept contiguous: one which does not fit before the end of the ring goes at
+ * its start, behind a padding marker.
+ */
+class RecordRing {
+public:
+    static constexpr size_t Capacity{128 * 1024};
+    /// Larger records are formatted at the call site and queued instead
+    static constexpr size_t MaxRecordSize{Capacity / 4};
+
+    /**
+     * Reserve space for a record. Only called by the owning thread.
+     *
+     * @param size - Size of the record.
+     * @return Pointer to write the record to, or nullptr if the ring is too full.
+     */
+    u8* Reserve(size_t size) {
+        const u64 write{write_pos.load(std::memory_order_relaxed)};
+        const u64 read{read_pos.load(std::memory_order_acquire)};
+        const auto offset{static_cast<size_t>(write % Capacity)};
+        const size_t padding{offset + size > Capacity ? Capacity - offset : 0};
+        if (Capacity - (write - read) < padding + size) {
+            return nullptr;
+        }
+        if (padding != 0) {
+            std::memcpy(data.get() + offset, &PaddingMarker, sizeof(PaddingMarker));
+        }
+        reserved_pos = write + padding;
+        return data.get() + reserved_pos % Capacity;
+    }
+
+    /**
+     * Publish the reserved record. Only called by the owning thread.
+     *
+     * @param size - Size of the record.
+     * @return True if the ring is over half full.
+     */
+    bool Commit(size_t size) {
+        const u64 write{reserved_pos + size};
+        write_pos.store(write, std::memory_order_release);
+        return write - read_pos.load(std::memory_order_relaxed) > Capacity / 2;
+    }
+
+    /// Position after the last published record, for the backend thread to read up to
+    u64 WritePosition() const {
+        return write_pos.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Read the next record before a write position. Only called by the backend thread.
+     *
+     * @param limit  - Write position to stop at.
+     * @param header - Receives the header of the record.
+     * @param args   - Receives the arguments of the record.
+     * @return True if there was a record.
+     */
+    bool Peek(u64 limit, RecordHeader& header, std::span<const u8>& args) {
+        while (read_local < limit) {
+            const auto offset{static_cast<size_t>(read_local % Capacity)};
+            u32 size;
+            std::memcpy(&size, data.get() + offset, sizeof(size));
+            if (size == PaddingMarker) {
+                read_local += Capacity - offset;
+                continue;
+            }
+            std::memcpy(&header, data.get() + offset, sizeof(header));
+            args = {data.get() + offset + sizeof(header), size - sizeof(header)};
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Release the record returned by the last Peek. Only called by the backend thread.
+     *
+     * @param header - Header of the record.
+     */
+    void Pop(const RecordHeader& header) {
+        read_local += header.size;
+        read_pos.store(read_local, std::memory_order_release);
+    }
+
+    /// Marks the ring as no longer written to, set when its thread exits
+    std::atomic_bool abandoned{};
+
+private:
+    static constexpr u32 PaddingMarker{0xFFFFFFFF};
+
+    std::unique_ptr<u8[]> data{std::make_unique<u8[]>(Capacity)};
+    alignas(128) std::atomic<u64> write_pos{};
+    /// Position of the record being written, owned by the writing thread
+    u64 reserved_pos{};
+    alignas(128) std::atomic<u64> read_pos{};
+    /// Position of the next record to read, owned by the backend thread
+    u64 read_local{};
+};
+
+/**
+ * The record ring of the calling thread, created on its first captured message and left for the
+ * backend thread to finish reading when the thread exits.
+ */
+struct LocalRing {
+    ~LocalRing() {
+        if (ring) {
+            ring->abandoned.store(true, std::memory_order_release);
+        }
+    }
+
+    std::shared_ptr<RecordRing> ring;
+    /// Whether the backend thread should be woken once the record being written is published
+    bool wake{};
+};
+
+thread_local LocalRing local_ring;
+
 bool initialization_in_progress_suppress_logging = true;
 
 /**
@@ -199,8 +394,7 @@ public:
         void(CreateDir(log_dir));
         Filter filter;
         filter.ParseFilterString(Settings::values.log_filter.GetValue());
-        instance = std::unique_ptr<Impl, decltype(&Deleter)>(new Impl(log_dir / LOG_FILE, filter),
-                                                             Deleter);
+        instance = std::unique_ptr<Impl, decltype(&Deleter)>(new Impl(log_dir, filter), Deleter);
         initialization_in_progress_suppress_logging = false;
     }
 
@@ -226,24 +420,88 @@ public:
         color_console_backend.SetEnabled(enabled);
     }
 
+    bool CheckMessage(Class log_class, Level log_level) const {
+        return filter.CheckMessage(log_class, log_level);
+    }
+
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, std::string&& message) {
-        if (!filter.CheckMessage(log_class, log_level)) {
-            return;
+        if (binary_logging) {
+            // Kept in the thread's ring with its captured messages, so they stay in order
+            const std::string_view file{filename};
+            const std::string_view func{function};
+            const auto size{CapturedRecordSize(file, func, message)};
+            if (u8* const record{BeginRecord(log_level, size)}) {
+                CapturePreformatted(record, size, log_class, log_level, line_num, file, func,
+                                    message);
+                EndRecord(size);
+                return;
+            }
         }
         message_queue.EmplaceWait(
             CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
     }
 
+    /**
+     * Reserve space for a record in the calling thread's ring, waiting for the backend thread to
+     * make room if it is full. Nothing reads the rings while the backend thread is not running, so
+     * records are queued as formatted entries instead.
+     *
+     * @return Pointer to write the record to, or nullptr if it should be queued instead.
+     */
+    u8* BeginRecord(Level log_level, size_t size) {
+        if (!binary_logging || size > RecordRing::MaxRecordSize ||
+            !backend_running.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        if (!local_ring.ring) {
+            local_ring.ring = std::make_shared<RecordRing>();
+            std::scoped_lock lock{rings_mutex};
+            rings.push_back(local_ring.ring);
+        }
+        local_ring.wake = log_level >= Level::Error;
+        while (true) {
+            if (u8* const record{local_ring.ring->Reserve(size)}) {
+                return record;
+            }
+            // The backend thread may have stopped while we waited for room
+            if (!backend_running.load(std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            WakeBackend();
+            std::this_thread::yield();
+        }
+    }
+
+    void EndRecord(size_t size) {
+        if (local_ring.ring->Commit(size) || local_ring.wake) {
+            WakeBackend();
+        }
+    }
+
 private:
-    Impl(const std::filesystem::path& file_backend_filename, const Filter& filter_)
-        : filter{filter_}, file_backend{file_backend_filename} {}
+    /// How long the backend thread sleeps between reading the record rings
+    static constexpr std::chrono::milliseconds RingPollInterval{5};
+
+    Impl(const std::filesystem::path& log_dir, const Filter& filter_)
+        : filter{filter_}, binary_logging{Settings::values.binary_logging.GetValue()} {
+        if (binary_logging) {
+            binary_file_backend.emplace(log_dir / BINARY_LOG_FILE);
+        } else {
+            file_backend.emplace(log_dir / LOG_FILE);
+        }
+    }
 
     ~Impl() = default;
 
     void StartBackendThread() {
+        backend_running = true;
         backend_thread = std::jthread([this](std::stop_token stop_token) {
             Common::SetCurrentThreadName("Logger");
+            if (binary_logging) {
+                RunBinaryBackend(stop_token);
+                return;
+            }
             Entry entry;
             const auto write_logs = [this, &entry]() {
                 ForEachBackend([&entry](Backend& backend) { backend.Write(entry); });
@@ -264,12 +522,147 @@ private:
     }
 
     void StopBackendThread() {
+        // Cleared first so new records are queued, the backend thread drains what was reserved
+        backend_running = false;
         backend_thread.request_stop();
         if (backend_thread.joinable()) {
             backend_thread.join();
         }
+        if (binary_logging) {
+            // Pick up records committed after the backend thread's final drain
+            DrainRings();
+        }
 
         ForEachBackend([](Backend& backend) { backend.Flush(); });
+        if (binary_file_backend) {
+            binary_file_backend->Flush();
+        }
+    }
+
+    void RunBinaryBackend(std::stop_token stop_token) {
+        Entry entry;
+        while (!stop_token.stop_requested()) {
+            DrainRings();
+            while (message_queue.TryPop(entry)) {
+                WriteEntry(entry);
+            }
+            binary_file_backend->WriteBuffered();
+            ring_event.WaitFor(RingPollInterval);
+        }
+        // The rings are bounded, drain them fully. Limit the queue like the text backend does.
+        DrainRings();
+        int max_logs_to_write = filter.IsDebug() ? INT_MAX : 100;
+        while (max_logs_to_write-- && message_queue.TryPop(entry)) {
+            WriteEntry(entry);
+        }
+    }
+
+    /**
+     * Write every record published so far, oldest first across the rings, and forget the rings of
+     * threads which have exited once they are read.
+     */
+    void DrainRings() {
+        wake_requested.store(false, std::memory_order_relaxed);
+        {
+            std::scoped_lock lock{rings_mutex};
+            draining_rings = rings;
+        }
+        // Stop at the records published before the drain, so busy threads cannot hold it up
+        drain_limits.clear();
+        drain_abandoned.clear();
+        for (const auto& ring : draining_rings) {
+            drain_abandoned.push_back(ring->abandoned.load(std::memory_order_acquire));
+            drain_limits.push_back(ring->WritePosition());
+        }
+        while (true) {
+            RecordRing* oldest_ring{};
+            RecordHeader oldest{};
+            std::span<const u8> oldest_args;
+            for (size_t i = 0; i < draining_rings.size(); ++i) {
+                RecordHeader header;
+                std::span<const u8> args;
+                if (draining_rings[i]->Peek(drain_limits[i], header, args) &&
+                    (!oldest_ring || header.timestamp < oldest.timestamp)) {
+                    oldest_ring = draining_rings[i].get();
+                    oldest = header;
+                    oldest_args = args;
+                }
+            }
+            if (!oldest_ring) {
+                break;
+            }
+            WriteRecord(oldest, oldest_args);
+            oldest_ring->Pop(oldest);
+        }
+        if (std::ranges::find(drain_abandoned, true) != drain_abandoned.end()) {
+            std::scoped_lock lock{rings_mutex};
+            for (size_t i = 0; i < draining_rings.size(); ++i) {
+                if (drain_abandoned[i]) {
+                    std::erase(rings, draining_rings[i]);
+                }
+            }
+        }
+        draining_rings.clear();
+    }
+
+    void WriteRecord(const RecordHeader& header, std::span<const u8> args) {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        using std::chrono::steady_clock;
+
+        const steady_clock::time_point time{steady_clock::duration{header.timestamp}};
+        const auto timestamp{duration_cast<microseconds>(time - time_origin)};
+        binary_file_backend->Write(header, args, timestamp);
+        if (!HasTextBackends()) {
+            return;
+        }
+
+        std::string filename;
+        std::string_view function;
+        std::string message;
+        if ((header.flags & RecordFlags::Preformatted) != 0) {
+            std::string_view file;
+            std::string_view preformatted;
+            if (!ReadPreformatted(args, file, function, preformatted)) {
+                return;
+            }
+            filename = file;
+            message = preformatted;
+        } else {
+            filename = header.filename;
+            function = header.function;
+            message = FormatCapturedMessage({header.format, header.format_size}, args);
+        }
+        const Entry entry{
+            .timestamp = timestamp,
+            .log_class = header.log_class,
+            .log_level = header.log_level,
+            .filename = filename.c_str(),
+            .line_num = header.line_num,
+            .function = std::string{function},
+            .message = std::move(message),
+        };
+        ForEachBackend([&entry](Backend& backend) { backend.Write(entry); });
+    }
+
+    void WriteEntry(const Entry& entry) {
+        binary_file_backend->Write(entry);
+        ForEachBackend([&entry](Backend& backend) { backend.Write(entry); });
+    }
+
+    /// Whether messages captured for the binary log need formatting for another backend
+    bool HasTextBackends() const {
+#if defined(_WIN32) || defined(ANDROID)
+        return true;
+#else
+        return color_console_backend.IsEnabled();
+#endif
+    }
+
+    void WakeBackend() {
+        if (!wake_requested.exchange(true, std::memory_order_relaxed)) {
+            ring_event.Set();
+        }
     }
 
     Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
@@ -292,7 +685,9 @@ private:
     void ForEachBackend(auto lambda) {
         lambda(static_cast<Backend&>(debugger_backend));
         lambda(static_cast<Backend&>(color_console_backend));
-        lambda(static_cast<Backend&>(file_backend));
+        if (file_backend) {
+            lambda(static_cast<Backend&>(*file_backend));
+        }
 #ifdef ANDROID
         lambda(static_cast<Backend&>(lc_backend));
 #endif
@@ -305,9 +700,11 @@ private:
     static inline std::unique_ptr<Impl, decltype(&Deleter)> instance{nullptr, Deleter};
 
     Filter filter;
+    bool binary_logging;
     DebuggerBackend debugger_backend{};
     ColorConsoleBackend color_console_backend{};
-    FileBackend file_backend;
+    std::optional<FileBackend> file_backend;
+    std::optional<BinaryFileBackend> binary_file_backend;
 #ifdef ANDROID
     LogcatBackend lc_backend{};
 #endif
@@ -315,6 +712,16 @@ private:
     MPSCQueue<Entry> message_queue{};
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
     std::jthread backend_thread;
+    std::atomic_bool backend_running{};
+
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<RecordRing>> rings;
+    Common::Event ring_event;
+    std::atomic_bool wake_requested{};
+    /// State of DrainRings, kept to reuse its memory
+    std::vector<std::shared_ptr<RecordRing>> draining_rings;
+    std::vector<u64> drain_limits;
+    std::vector<bool> drain_abandoned;
 };
 } // namespace
 
@@ -345,9 +752,28 @@ void SetColorConsoleBackendEnabled(bool enabled) {
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, fmt::string_view format,
                        const fmt::format_args& args) {
-    if (!initialization_in_progress_suppress_logging) {
-        Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function,
-                                   fmt::vformat(format, args));
+    if (initialization_in_progress_suppress_logging) {
+        return;
+    }
+    auto& instance = Impl::Instance();
+    // Filtered out messages are not formatted at all
+    if (instance.CheckMessage(log_class, log_level)) {
+        instance.PushEntry(log_class, log_level, filename, line_num, function,
+                           fmt::vformat(format, args));
+    }
+}
+
+u8* BeginCapturedRecord(Class log_class, Level log_level, size_t size, bool& filtered) {
+    if (initialization_in_progress_suppress_logging) {
+        filtered = true;
+        return nullptr;
     }
+    auto& instance = Impl::Instance();
+    filtered = !instance.CheckMessage(log_class, log_level);
+    return filtered ? nullptr : instance.BeginRecord(log_level, size);
+}
+
+void EndCapturedRecord(size_t size) {
+    Impl::Instance().EndRecord(size);
 }
 } // namespace Common::Log
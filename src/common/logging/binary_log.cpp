@@ -0,0 +1,322 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/logging/binary_log_file.h"
+#include "common/logging/text_formatter.h"
+
+namespace Common::Log {
+
+namespace {
+
+/**
+ * A binary log file is the magic and version, followed by chunks each starting with its kind.
+ *
+ * A string chunk defines a call site string: its id, length and bytes. A message chunk is a
+ * MessageChunk followed by the captured arguments, with the ids of its strings, which are
+ * defined before the first message using them. Id 0 is no string, used by preformatted messages.
+ */
+constexpr std::array<char, 4> FileMagic{'Y', 'Z', 'L', 'G'};
+constexpr u32 FileVersion{1};
+
+enum class ChunkKind : u8 {
+    String = 1,
+    Message = 2,
+};
+
+struct MessageChunk {
+    Class log_class;
+    Level log_level;
+    u16 flags;
+    u32 line_num;
+    /// Microseconds since logging started
+    s64 timestamp;
+    u32 filename_id;
+    u32 function_id;
+    u32 format_id;
+    u32 args_size;
+};
+static_assert(sizeof(MessageChunk) == 32);
+
+template <typename T>
+void Append(std::vector<u8>& out, const T& value) {
+    const auto* const bytes{reinterpret_cast<const u8*>(&value)};
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void AppendBytes(std::vector<u8>& out, const void* data, size_t size) {
+    const auto* const bytes{static_cast<const u8*>(data)};
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+/// Reads values from a buffer, failing once it runs out of data
+class Reader {
+public:
+    explicit Reader(std::span<const u8> data_) : data{data_} {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (data.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));
+        data = data.subspan(sizeof(T));
+        return true;
+    }
+
+    bool ReadBytes(std::span<const u8>& bytes, size_t size) {
+        if (data.size() < size) {
+            return false;
+        }
+        bytes = data.first(size);
+        data = data.subspan(size);
+        return true;
+    }
+
+private:
+    std::span<const u8> data;
+};
+
+std::string_view AsString(std::span<const u8> bytes) {
+    return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+using ArgStore = fmt::dynamic_format_arg_store<fmt::format_context>;
+
+template <typename T>
+bool PushValue(Reader& reader, ArgStore& store) {
+    T value;
+    if (!reader.Read(value)) {
+        return false;
+    }
+    store.push_back(value);
+    return true;
+}
+
+/**
+ * Read a captured argument and add it to the arguments to format.
+ *
+ * @return False if the argument is invalid or truncated.
+ */
+bool PushArg(Reader& reader, ArgTag tag, ArgStore& store) {
+    switch (tag) {
+    case ArgTag::Bool: {
+        u8 value;
+        if (!reader.Read(value)) {
+            return false;
+        }
+        store.push_back(value != 0);
+        return true;
+    }
+    case ArgTag::Char:
+        return PushValue<char>(reader, store);
+    case ArgTag::Signed:
+        return PushValue<s64>(reader, store);
+    case ArgTag::Unsigned:
+        return PushValue<u64>(reader, store);
+    case ArgTag::Float:
+        return PushValue<f32>(reader, store);
+    case ArgTag::Double:
+        return PushValue<f64>(reader, store);
+    case ArgTag::Pointer: {
+        u64 value;
+        if (!reader.Read(value)) {
+            return false;
+        }
+        store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(value)));
+        return true;
+    }
+    case ArgTag::String: {
+        u32 length;
+        std::span<const u8> bytes;
+        if (!reader.Read(length) || !reader.ReadBytes(bytes, length)) {
+            return false;
+        }
+        store.push_back(AsString(bytes));
+        return true;
+    }
+    }
+    return false;
+}
+
+} // Anonymous namespace
+
+void BinaryLogEncoder::WriteHeader(std::vector<u8>& out) {
+    AppendBytes(out, FileMagic.data(), FileMagic.size());
+    Append(out, FileVersion);
+}
+
+void BinaryLogEncoder::WriteRecord(std::vector<u8>& out, const RecordHeader& header,
+                                   std::span<const u8> args, std::chrono::microseconds timestamp) {
+    const bool preformatted{(header.flags & RecordFlags::Preformatted) != 0};
+    const MessageChunk chunk{
+        .log_class = header.log_class,
+        .log_level = header.log_level,
+        .flags = header.flags,
+        .line_num = header.line_num,
+        .timestamp = timestamp.count(),
+        .filename_id = preformatted ? 0 : Intern(out, header.filename, 0),
+        .function_id = preformatted ? 0 : Intern(out, header.function, 0),
+        .format_id = preformatted ? 0 : Intern(out, header.format, header.format_size),
+        .args_size = static_cast<u32>(args.size()),
+    };
+    Append(out, ChunkKind::Message);
+    Append(out, chunk);
+    AppendBytes(out, args.data(), args.size());
+}
+
+void BinaryLogEncoder::WriteEntry(std::vector<u8>& out, const Entry& entry) {
+    const std::string_view filename{entry.filename};
+    const auto size{CapturedRecordSize(filename, entry.function, entry.message)};
+    std::vector<u8> record(size);
+    CapturePreformatted(record.data(), size, entry.log_class, entry.log_level, entry.line_num,
+                        filename, entry.function, entry.message);
+
+    RecordHeader header;
+    std::memcpy(&header, record.data(), sizeof(header));
+    const auto args{std::span<const u8>{record}.subspan(sizeof(header))};
+    WriteRecord(out, header, args, entry.timestamp);
+}
+
+u32 BinaryLogEncoder::Intern(std::vector<u8>& out, const char* string, size_t size) {
+    const auto [it, inserted] =
+        string_ids.try_emplace(string, static_cast<u32>(string_ids.size() + 1));
+    if (inserted) {
+        // Strings other than the format string are null terminated
+        const auto length{static_cast<u32>(size != 0 ? size : std::strlen(string))};
+        Append(out, ChunkKind::String);
+        Append(out, it->second);
+        Append(out, length);
+        AppendBytes(out, string, length);
+    }
+    return it->second;
+}
+
+void CapturePreformatted(u8* out, size_t size, Class log_class, Level log_level,
+                         unsigned int line_num, std::string_view filename,
+                         std::string_view function, std::string_view message) {
+    CaptureRecord(out, size, log_class, log_level, nullptr, line_num, nullptr, {}, filename,
+                  function, message);
+    constexpr u16 flags{RecordFlags::Preformatted};
+    std::memcpy(out + offsetof(RecordHeader, flags), &flags, sizeof(flags));
+}
+
+bool ReadPreformatted(std::span<const u8> args, std::string_view& filename,
+                      std::string_view& function, std::string_view& message) {
+    Reader reader{args};
+    for (std::string_view* const string : {&filename, &function, &message}) {
+        ArgTag tag;
+        u32 length;
+        std::span<const u8> bytes;
+        if (!reader.Read(tag) || tag != ArgTag::String || !reader.Read(length) ||
+            !reader.ReadBytes(bytes, length)) {
+            return false;
+        }
+        *string = AsString(bytes);
+    }
+    return true;
+}
+
+std::string FormatCapturedMessage(std::string_view format, std::span<const u8> args) {
+    ArgStore store;
+    Reader reader{args};
+    ArgTag tag;
+    // Records are padded with zeroes, which are not a valid tag
+    while (reader.Read(tag) && PushArg(reader, tag, store)) {
+    }
+    try {
+        return fmt::vformat(fmt::string_view{format.data(), format.size()}, store);
+    } catch (const fmt::format_error& e) {
+        return fmt::format("{} (format error: {})", format, e.what());
+    }
+}
+
+bool DecodeBinaryLog(const std::filesystem::path& path, std::string& out) {
+    const auto contents{FS::ReadStringFromFile(path, FS::FileType::BinaryFile)};
+    return DecodeBinaryLog(
+        std::span{reinterpret_cast<const u8*>(contents.data()), contents.size()}, out);
+}
+
+bool DecodeBinaryLog(std::span<const u8> data, std::string& out) {
+    Reader reader{data};
+    std::array<char, 4> magic;
+    u32 version;
+    if (!reader.Read(magic) || magic != FileMagic || !reader.Read(version) ||
+        version != FileVersion) {
+        return false;
+    }
+    // Call site strings by id, id 0 being no string
+    std::vector<std::string> strings{""};
+    const auto lookup = [&strings](u32 id) -> std::optional<std::string_view> {
+        if (id >= strings.size()) {
+            return std::nullopt;
+        }
+        return strings[id];
+    };
+
+    ChunkKind kind;
+    while (reader.Read(kind)) {
+        if (kind == ChunkKind::String) {
+            u32 id;
+            u32 length;
+            std::span<const u8> bytes;
+            if (!reader.Read(id) || !reader.Read(length) || !reader.ReadBytes(bytes, length) ||
+                id != strings.size()) {
+                return false;
+            }
+            strings.emplace_back(AsString(bytes));
+            continue;
+        }
+        MessageChunk chunk;
+        std::span<const u8> args;
+        if (kind != ChunkKind::Message || !reader.Read(chunk) ||
+            !reader.ReadBytes(args, chunk.args_size)) {
+            return false;
+        }
+
+        std::string filename;
+        std::string_view function;
+        std::string message;
+        if ((chunk.flags & RecordFlags::Preformatted) != 0) {
+            std::string_view file;
+            std::string_view preformatted;
+            if (!ReadPreformatted(args, file, function, preformatted)) {
+                return false;
+            }
+            filename = file;
+            message = preformatted;
+        } else {
+            const auto file{lookup(chunk.filename_id)};
+            const auto function_name{lookup(chunk.function_id)};
+            const auto format{lookup(chunk.format_id)};
+            if (!file || !function_name || !format) {
+                return false;
+            }
+            filename = *file;
+            function = *function_name;
+            message = FormatCapturedMessage(*format, args);
+        }
+        const Entry entry{
+            .timestamp = std::chrono::microseconds{chunk.timestamp},
+            .log_class = chunk.log_class,
+            .log_level = chunk.log_level,
+            .filename = filename.c_str(),
+            .line_num = chunk.line_num,
+            .function = std::string{function},
+            .message = std::move(message),
+        };
+        out += FormatLogMessage(entry);
+        out += '\n';
+    }
+    return true;
+}
+
+} // namespace Common::Log
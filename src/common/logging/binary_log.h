@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "common/common_types.h"
+#include "common/logging/formatter.h"
+#include "common/logging/types.h"
+
+namespace Common::Log {
+
+/**
+ * Binary logging.
+ *
+ * With binary logging enabled, a logging call site does not format its message. It copies the
+ * raw bytes of its arguments, each behind a tag giving its type, into a ring owned by the calling
+ * thread, together with the addresses of its format string, file name and function name, which
+ * are string literals and so identify the call site. The backend thread drains the rings, writing
+ * the records to a binary log file as they are, and formats them only for the text backends which
+ * are enabled. The binary log file is turned into the usual text log offline, by the log decoder.
+ *
+ * Calls with an argument which cannot be captured this way, such as a type with its own
+ * formatter, are formatted at the call site and stored as a preformatted record, keeping every
+ * thread's messages in order.
+ *
+ * The records are read by BinaryLogEncoder and the log decoder, see binary_log_file.h.
+ */
+
+/// Tags stored before each captured argument, giving its type
+enum class ArgTag : u8 {
+    Bool = 'b',
+    Char = 'c',
+    Signed = 'i',
+    Unsigned = 'u',
+    Float = 'f',
+    Double = 'd',
+    Pointer = 'p',
+    String = 's',
+};
+
+enum RecordFlags : u16 {
+    /// The record holds the file name, function name and message as string arguments
+    Preformatted = 1 << 0,
+};
+
+/// Header of a captured message, followed by its arguments
+struct RecordHeader {
+    /// Size of the record including this header, a multiple of RecordAlignment
+    u32 size;
+    Class log_class;
+    Level log_level;
+    u16 flags;
+    u32 line_num;
+    /// Length of the format string, which need not be null terminated
+    u32 format_size;
+    /// Steady clock time of the call, in the clock's own ticks
+    s64 timestamp;
+    /// String literals of the call site, nullptr for preformatted records
+    const char* filename;
+    const char* function;
+    const char* format;
+};
+
+constexpr size_t RecordAlignment{8};
+
+template <typename T>
+concept StringArg =
+    std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, std::nullptr_t>;
+
+/// Enums are captured as integers only if they use the generic enum formatter
+template <typename T>
+concept GenericEnumArg =
+    std::is_enum_v<T> && requires { fmt::formatter<T>::is_generic_enum_formatter; };
+
+template <typename T>
+concept CapturableArg = std::is_arithmetic_v<T> || GenericEnumArg<T> || StringArg<T> ||
+                        std::is_same_v<T, const void*> || std::is_same_v<T, void*>;
+
+template <typename T>
+constexpr bool IsCapturable = CapturableArg<T> && !std::is_same_v<T, long double> &&
+                              (!std::is_integral_v<T> || sizeof(T) <= sizeof(u64));
+
+/**
+ * Get the number of bytes an argument takes in a record, including its tag.
+ */
+template <typename T>
+size_t CapturedSize(const T& arg) {
+    if constexpr (std::is_enum_v<T>) {
+        return CapturedSize(static_cast<std::underlying_type_t<T>>(arg));
+    } else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>) {
+        return 2;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return 1 + sizeof(f32);
+    } else if constexpr (StringArg<T>) {
+        return 1 + sizeof(u32) + std::string_view{arg}.size();
+    } else {
+        return 1 + sizeof(u64);
+    }
+}
+
+/**
+ * Write an argument into a record.
+ *
+ * @return Pointer past the written bytes.
+ */
+template <typename T>
+u8* CaptureArg(u8* out, const T& arg) {
+    const auto put = [&out](ArgTag tag, const auto& value) {
+        *out++ = static_cast<u8>(tag);
+        std::memcpy(out, &value, sizeof(value));
+        out += sizeof(value);
+    };
+    if constexpr (std::is_enum_v<T>) {
+        out = CaptureArg(out, static_cast<std::underlying_type_t<T>>(arg));
+    } else if constexpr (std::is_same_v<T, bool>) {
+        put(ArgTag::Bool, static_cast<u8>(arg));
+    } else if constexpr (std::is_same_v<T, char>) {
+        put(ArgTag::Char, arg);
+    } else if constexpr (std::is_same_v<T, float>) {
+        put(ArgTag::Float, arg);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        put(ArgTag::Double, static_cast<f64>(arg));
+    } else if constexpr (std::is_same_v<T, const void*> || std::is_same_v<T, void*>) {
+        put(ArgTag::Pointer, static_cast<u64>(reinterpret_cast<uintptr_t>(arg)));
+    } else if constexpr (StringArg<T>) {
+        const std::string_view string{arg};
+        put(ArgTag::String, static_cast<u32>(string.size()));
+        std::memcpy(out, string.data(), string.size());
+        out += string.size();
+    } else if constexpr (std::is_signed_v<T>) {
+        put(ArgTag::Signed, static_cast<s64>(arg));
+    } else {
+        put(ArgTag::Unsigned, static_cast<u64>(arg));
+    }
+    return out;
+}
+
+template <typename... Args>
+size_t CapturedRecordSize(const Args&... args) {
+    const auto size{sizeof(RecordHeader) + (CapturedSize(args) + ... + 0)};
+    return (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+}
+
+/**
+ * Write a whole record for a call site.
+ *
+ * @param out  - Record to write, CapturedRecordSize bytes long.
+ * @param size - Size of the record.
+ */
+template <typename... Args>
+void CaptureRecord(u8* out, size_t size, Class log_class, Level log_level, const char* filename,
+                   unsigned int line_num, const char* function, std::string_view format,
+                   const Args&... args) {
+    const RecordHeader header{
+        .size = static_cast<u32>(size),
+        .log_class = log_class,
+        .log_level = log_level,
+        .flags = 0,
+        .line_num = line_num,
+        .format_size = static_cast<u32>(format.size()),
+        .timestamp = std::chrono::steady_clock::now().time_since_epoch().count(),
+        .filename = filename,
+        .function = function,
+        .format = format.data(),
+    };
+    u8* const end{out + size};
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    ((out = CaptureArg(out, args)), ...);
+    // Zeroes are not a valid tag, ending the arguments
+    std::memset(out, 0, static_cast<size_t>(end - out));
+}
+
+/**
+ * Reserve space for a record in the calling thread's log ring.
+ *
+ * @param log_class - Class of the message.
+ * @param log_level - Level of the message.
+ * @param size      - Size of the record.
+ * @param filtered  - Set to true if the message is filtered out and should be dropped.
+ * @return Pointer to write the record to, or nullptr if the message is filtered out or cannot be
+ *         captured, in which case it is formatted at the call site.
+ */
+u8* BeginCapturedRecord(Class log_class, Level log_level, size_t size, bool& filtered);
+
+/**
+ * Publish the record written after the last BeginCapturedRecord on this thread.
+ *
+ * @param size - Size of the record.
+ */
+void EndCapturedRecord(size_t size);
+
+} // namespace Common::Log
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/logging/binary_log.h"
+#include "common/logging/log_entry.h"
+
+namespace Common::Log {
+
+/**
+ * Encodes records into the binary log file format, defining each call site string the first time
+ * it is used.
+ */
+class BinaryLogEncoder {
+public:
+    /**
+     * Append the file header.
+     *
+     * @param out - Buffer to append to.
+     */
+    void WriteHeader(std::vector<u8>& out);
+
+    /**
+     * Append a captured record.
+     *
+     * @param out       - Buffer to append to.
+     * @param header    - Header of the record.
+     * @param args      - Captured arguments of the record.
+     * @param timestamp - Time of the message since logging started.
+     */
+    void WriteRecord(std::vector<u8>& out, const RecordHeader& header, std::span<const u8> args,
+                     std::chrono::microseconds timestamp);
+
+    /**
+     * Append a message formatted at its call site.
+     *
+     * @param out   - Buffer to append to.
+     * @param entry - The message.
+     */
+    void WriteEntry(std::vector<u8>& out, const Entry& entry);
+
+private:
+    u32 Intern(std::vector<u8>& out, const char* string, size_t size);
+
+    std::unordered_map<const char*, u32> string_ids;
+};
+
+/**
+ * Write a record of a message formatted at its call site.
+ *
+ * @param out  - Record to write, CapturedRecordSize(filename, function, message) bytes long.
+ * @param size - Size of the record.
+ */
+void CapturePreformatted(u8* out, size_t size, Class log_class, Level log_level,
+                         unsigned int line_num, std::string_view filename,
+                         std::string_view function, std::string_view message);
+
+/**
+ * Read the file name, function name and message of a preformatted record.
+ *
+ * @return True if the arguments held the three strings.
+ */
+bool ReadPreformatted(std::span<const u8> args, std::string_view& filename,
+                      std::string_view& function, std::string_view& message);
+
+/**
+ * Format a message from its format string and captured arguments.
+ *
+ * @param format - Format string of the call site.
+ * @param args   - Captured arguments.
+ * @return The formatted message.
+ */
+std::string FormatCapturedMessage(std::string_view format, std::span<const u8> args);
+
+/**
+ * Decode a binary log file into text, formatted the same way as the text log.
+ *
+ * @param path - Path of the binary log.
+ * @param out  - Receives the log lines.
+ * @return True if the whole file was decoded, false if it is not a binary log or is truncated.
+ */
+bool DecodeBinaryLog(const std::filesystem::path& path, std::string& out);
+
+/**
+ * Decode a binary log from memory into text.
+ *
+ * @param data - Contents of the binary log.
+ * @param out  - Receives the log lines.
+ * @return True if all of the data was decoded, false if it is not a binary log or is truncated.
+ */
+bool DecodeBinaryLog(std::span<const u8> data, std::string& out);
+
+} // namespace Common::Log
@@ -13,6 +13,9 @@
 template <typename T>
 struct fmt::formatter<T, std::enable_if_t<std::is_enum_v<T>, char>>
     : formatter<std::underlying_type_t<T>> {
+    /// Lets binary logging capture these enums as integers, see binary_log.h
+    static constexpr bool is_generic_enum_formatter = true;
+
     template <typename FormatContext>
     auto format(const T& value, FormatContext& ctx) -> decltype(ctx.out()) {
         return fmt::formatter<std::underlying_type_t<T>>::format(
@@ -8,6 +8,7 @@
 
 #include <fmt/format.h>
 
+#include "common/logging/binary_log.h"
 #include "common/logging/formatter.h"
 #include "common/logging/types.h"
 
@@ -27,9 +28,28 @@ void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, fmt::string_view format,
                        const fmt::format_args& args);
 
+/**
+ * Logs a message to the global logger. With binary logging enabled, messages whose arguments can
+ * all be captured are stored unformatted, see binary_log.h. The format string, file name and
+ * function name must be string literals, as they are used after the call returns.
+ */
 template <typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, fmt::format_string<Args...> format, const Args&... args) {
+    if constexpr ((IsCapturable<Args> && ...)) {
+        const auto size{CapturedRecordSize(args...)};
+        bool filtered;
+        if (u8* const record{BeginCapturedRecord(log_class, log_level, size, filtered)}) {
+            const fmt::string_view format_string{format};
+            CaptureRecord(record, size, log_class, log_level, filename, line_num, function,
+                          {format_string.data(), format_string.size()}, args...);
+            EndCapturedRecord(size);
+            return;
+        }
+        if (filtered) {
+            return;
+        }
+    }
     FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
                       fmt::make_format_args(args...));
 }
@@ -21,4 +21,36 @@ typedef void* HANDLE;
 
 #include <microprofile.h>
 
+#include "common/tracing.h"
+
 #define MP_RGB(r, g, b) ((r) << 16 | (g) << 8 | (b) << 0)
+
+#if MICROPROFILE_ENABLED
+namespace Common {
+
+/// MicroProfileScopeHandler which also records the scope in traces, see common/tracing.h
+class ProfileScope {
+public:
+    explicit ProfileScope(MicroProfileToken token_)
+        : token{token_}, tick{MicroProfileEnter(token_)}, trace_begin{Tracing::BeginScope()} {}
+
+    ~ProfileScope() {
+        Tracing::EndScope(token, trace_begin);
+        MicroProfileLeave(token, tick);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    MicroProfileToken token;
+    u64 tick;
+    s64 trace_begin;
+};
+
+} // namespace Common
+
+#undef MICROPROFILE_SCOPE
+#define MICROPROFILE_SCOPE(var)                                                                    \
+    ::Common::ProfileScope MICROPROFILE_TOKEN_PASTE(foo, __LINE__)(g_mp_##var)
+#endif
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+
+namespace Common {
+
+/**
+ * Holds a value written by one thread at a time and read by any number of threads without locking.
+ *
+ * Writing never waits for readers. Reading copies the value, and copies it again in the rare case
+ * it was being written meanwhile. The value is stored as atomic words so that copies racing with a
+ * write are well defined, and are then discarded.
+ */
+template <typename T>
+    requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class SeqLock {
+public:
+    SeqLock() {
+        StoreWords(T{});
+    }
+
+    explicit SeqLock(const T& value) {
+        StoreWords(value);
+    }
+
+    /**
+     * Publishes a new value. Writers must not run concurrently with each other.
+     *
+     * @param value - Value to publish.
+     */
+    void Write(const T& value) {
+        const u64 current = sequence.load(std::memory_order_relaxed);
+        // An odd sequence tells readers the value is being written
+        sequence.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        StoreWords(value);
+        sequence.store(current + 2, std::memory_order_release);
+    }
+
+    /// Returns the last published value
+    [[nodiscard]] T Read() const {
+        std::array<u64, NumWords> buffer;
+        u64 before;
+        u64 after;
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < NumWords; ++i) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while (before != after || (before & 1) != 0);
+
+        T value;
+        std::memcpy(static_cast<void*>(&value), buffer.data(), sizeof(T));
+        return value;
+    }
+
+    /// Returns the number of values published since construction
+    [[nodiscard]] u64 WriteCount() const {
+        return sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr size_t NumWords = DivCeil(sizeof(T), sizeof(u64));
+
+    void StoreWords(const T& value) {
+        std::array<u64, NumWords> buffer{};
+        std::memcpy(buffer.data(), &value, sizeof(T));
+        for (size_t i = 0; i < NumWords; ++i) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::array<std::atomic<u64>, NumWords> words{};
+    std::atomic<u64> sequence{};
+};
+
+} // namespace Common
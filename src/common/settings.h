@@ -187,8 +187,14 @@ struct Values {
                                        true};
     Setting<bool, false> audio_muted{
         linkage, false, "audio_muted", Category::Audio, Specialization::Default, true, true};
+    SwitchableSetting<bool> audio_time_stretch{linkage, false, "audio_time_stretch",
+                                               Category::Audio};
+    SwitchableSetting<bool> audio_measured_voice_drop{linkage, false, "audio_measured_voice_drop",
+                                                      Category::Audio};
     Setting<bool, false> dump_audio_commands{
         linkage, false, "dump_audio_commands", Category::Audio, Specialization::Default, false};
+    Setting<bool, false> capture_audio_commands{
+        linkage, false, "capture_audio_commands", Category::Audio, Specialization::Default, false};
 
     // Core
     SwitchableSetting<bool> use_multi_core{linkage, true, "use_multi_core", Category::Core};
@@ -593,6 +599,7 @@ struct Values {
                                     Category::DebuggingGraphics};
     Setting<bool> extended_logging{
         linkage, false, "extended_logging", Category::Debugging, Specialization::Default, false};
+    Setting<bool> binary_logging{linkage, false, "binary_logging", Category::Debugging};
     Setting<bool> use_debug_asserts{linkage, false, "use_debug_asserts", Category::Debugging};
     Setting<bool> use_auto_stub{
         linkage, false, "use_auto_stub", Category::Debugging, Specialization::Default, false};
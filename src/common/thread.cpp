@@ -7,6 +7,7 @@
 #include "common/error.h"
 #include "common/logging/log.h"
 #include "common/thread.h"
+#include "common/tracing.h"
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined(_WIN32)
@@ -85,6 +86,7 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
 // Sets the debugger-visible name of the current thread.
 void SetCurrentThreadName(const char* name) {
     SetThreadDescription(GetCurrentThread(), UTF8ToUTF16W(name).data());
+    Tracing::SetThreadName(name);
 }
 
 #else // !MSVC_VER, so must be POSIX threads
@@ -109,12 +111,14 @@ void SetCurrentThreadName(const char* name) {
 #else
     pthread_setname_np(pthread_self(), name);
 #endif
+    Tracing::SetThreadName(name);
 }
 #endif
 
 #if defined(_WIN32)
 void SetCurrentThreadName(const char* name) {
-    // Do Nothing on MingW
+    // Only name the thread in traces on MingW
+    Tracing::SetThreadName(name);
 }
 #endif
 
@@ -3,22 +3,45 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <type_traits>
 #include <vector>
-#include <queue>
 
+#include "common/common_types.h"
 #include "common/polyfill_thread.h"
 #include "common/thread.h"
 #include "common/unique_function.h"
+#include "common/work_stealing_deque.h"
 
 namespace Common {
 
+enum class TaskPriority : u32 {
+    High,
+    Normal,
+};
+
+/**
+ * A pool of worker threads running queued tasks, each worker optionally owning a state object
+ * its tasks are given.
+ *
+ * Every worker has a work-stealing deque per priority. Tasks queued from outside the pool are
+ * spread round-robin over small per-worker inboxes, which a worker moves onto its deque once it
+ * runs out of work; tasks queued from a worker go straight onto its own deque. An idle worker
+ * takes work from its own deque first, and otherwise steals from the others, so a burst of tasks
+ * does not make every worker contend on one lock. High priority tasks are taken before any normal
+ * priority task, from any worker.
+ *
+ * A pool with a single worker runs the tasks of each priority in the order they were queued,
+ * including tasks queued by its own tasks. Larger pools give no ordering guarantee.
+ */
 template <class StateType = void>
 class StatefulThreadWorker {
     static constexpr bool with_state = !std::is_same_v<StateType, void>;
@@ -33,42 +56,70 @@ class StatefulThreadWorker {
         std::conditional_t<with_state, UniqueFunction<void, StateType*>, UniqueFunction<void>>;
     using StateMaker = std::conditional_t<with_state, std::function<StateType()>, DummyCallable>;
 
+    static constexpr size_t NumPriorities{2};
+    /// Rounds of looking for work while tasks are pending, before a worker goes to sleep
+    static constexpr u32 SearchRounds{64};
+
+    struct Worker {
+        /// Tasks this worker runs next, stolen from by the other workers
+        std::array<WorkStealingDeque<Task*>, NumPriorities> deques;
+        /// Protects the inboxes
+        std::mutex inbox_mutex;
+        /// Tasks queued to this worker from outside the pool, oldest first
+        std::array<std::deque<Task*>, NumPriorities> inboxes;
+        /// Number of tasks in each inbox, checked before taking the inbox lock
+        std::array<std::atomic<size_t>, NumPriorities> inbox_sizes{};
+    };
+
 public:
     explicit StatefulThreadWorker(size_t num_workers, std::string name, StateMaker func = {})
         : workers_queued{num_workers}, thread_name{std::move(name)} {
-        const auto lambda = [this, func](std::stop_token stop_token) {
+        workers.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        const auto lambda = [this, func](std::stop_token stop_token, size_t index) {
             Common::SetCurrentThreadName(thread_name.c_str());
+            current_pool = this;
+            current_worker = index;
             {
                 [[maybe_unused]] std::conditional_t<with_state, StateType, int> state{func()};
                 while (!stop_token.stop_requested()) {
-                    Task task;
-                    {
-                        std::unique_lock lock{queue_mutex};
-                        if (requests.empty()) {
-                            wait_condition.notify_all();
-                        }
-                        Common::CondvarWait(condition, lock, stop_token,
-                                            [this] { return !requests.empty(); });
-                        if (stop_token.stop_requested()) {
-                            break;
-                        }
-                        task = std::move(requests.front());
-                        requests.pop();
+                    Task* const task{FindTask(index)};
+                    if (task == nullptr) {
+                        Sleep(stop_token);
+                        continue;
                     }
                     if constexpr (with_state) {
-                        task(&state);
+                        (*task)(&state);
                     } else {
-                        task();
+                        (*task)();
                     }
-                    ++work_done;
+                    delete task;
+                    FinishTask();
                 }
             }
             ++workers_stopped;
+            std::scoped_lock lock{wait_mutex};
             wait_condition.notify_all();
         };
         threads.reserve(num_workers);
         for (size_t i = 0; i < num_workers; ++i) {
-            threads.emplace_back(lambda);
+            threads.emplace_back(lambda, i);
+        }
+    }
+
+    ~StatefulThreadWorker() {
+        threads.clear();
+        for (auto& worker : workers) {
+            for (size_t priority = 0; priority < NumPriorities; ++priority) {
+                while (Task* const task{worker->deques[priority].Pop()}) {
+                    delete task;
+                }
+                for (Task* const task : worker->inboxes[priority]) {
+                    delete task;
+                }
+            }
         }
     }
 
@@ -78,13 +129,26 @@ public:
     StatefulThreadWorker& operator=(StatefulThreadWorker&&) = delete;
     StatefulThreadWorker(StatefulThreadWorker&&) = delete;
 
-    void QueueWork(Task work) {
-        {
-            std::unique_lock lock{queue_mutex};
-            requests.emplace(std::move(work));
-            ++work_scheduled;
+    void QueueWork(Task work, TaskPriority priority = TaskPriority::Normal) {
+        auto* const task{new Task(std::move(work))};
+        const auto priority_index{static_cast<size_t>(priority)};
+        ++work_scheduled;
+        // Counted before the task can be taken, so the count never drops below zero
+        ++pending_tasks;
+        if (current_pool == this && workers.size() > 1) {
+            workers[current_worker]->deques[priority_index].Push(task);
+        } else {
+            // A lone worker takes its queued tasks through the inbox, which it drains oldest
+            // first, since its own deque would run the newest task first
+            auto& worker{*workers[next_worker++ % workers.size()]};
+            std::scoped_lock lock{worker.inbox_mutex};
+            worker.inboxes[priority_index].push_back(task);
+            ++worker.inbox_sizes[priority_index];
+        }
+        if (sleeping_workers > 0) {
+            std::scoped_lock lock{sleep_mutex};
+            condition.notify_one();
         }
-        condition.notify_one();
     }
 
     void WaitForRequests(std::stop_token stop_token = {}) {
@@ -93,16 +157,114 @@ public:
                 thread.request_stop();
             }
         });
-        std::unique_lock lock{queue_mutex};
+        std::unique_lock lock{wait_mutex};
         wait_condition.wait(lock, [this] {
             return workers_stopped >= workers_queued || work_done >= work_scheduled;
         });
     }
 
 private:
-    std::queue<Task> requests;
-    std::mutex queue_mutex;
+    /**
+     * Find a task for a worker, looking at every worker for high priority tasks first.
+     *
+     * @param index - Index of the worker looking for work.
+     * @return The task to run, or nullptr if none was found.
+     */
+    Task* FindTask(size_t index) {
+        for (u32 round = 0; round < SearchRounds; ++round) {
+            for (size_t priority = 0; priority < NumPriorities; ++priority) {
+                if (Task* const task{TakeOwn(*workers[index], priority)}) {
+                    return task;
+                }
+                if (Task* const task{StealOther(index, priority)}) {
+                    return task;
+                }
+            }
+            if (pending_tasks == 0) {
+                break;
+            }
+            // A task is pending but was not reachable yet, it is being queued or taken
+            std::this_thread::yield();
+        }
+        return nullptr;
+    }
+
+    Task* TakeOwn(Worker& worker, size_t priority) {
+        if (Task* const task{worker.deques[priority].Pop()}) {
+            --pending_tasks;
+            return task;
+        }
+        if (worker.inbox_sizes[priority].load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        std::deque<Task*> inbox;
+        {
+            std::scoped_lock lock{worker.inbox_mutex};
+            inbox.swap(worker.inboxes[priority]);
+            worker.inbox_sizes[priority] = 0;
+        }
+        if (inbox.empty()) {
+            return nullptr;
+        }
+        // Push newest first so this worker pops them in the order they were queued, leaving the
+        // newest for other workers to steal
+        Task* const task{inbox.front()};
+        for (size_t i = inbox.size() - 1; i > 0; --i) {
+            worker.deques[priority].Push(inbox[i]);
+        }
+        --pending_tasks;
+        return task;
+    }
+
+    Task* StealOther(size_t index, size_t priority) {
+        for (size_t offset = 1; offset < workers.size(); ++offset) {
+            auto& victim{*workers[(index + offset) % workers.size()]};
+            if (Task* const task{victim.deques[priority].Steal()}) {
+                --pending_tasks;
+                return task;
+            }
+            if (victim.inbox_sizes[priority].load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            std::scoped_lock lock{victim.inbox_mutex};
+            auto& inbox{victim.inboxes[priority]};
+            if (!inbox.empty()) {
+                Task* const task{inbox.front()};
+                inbox.pop_front();
+                --victim.inbox_sizes[priority];
+                --pending_tasks;
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void Sleep(std::stop_token stop_token) {
+        std::unique_lock lock{sleep_mutex};
+        // Queuing checks for sleeping workers after counting the task, so either this sees the
+        // task or the queuing thread sees this worker and wakes it
+        ++sleeping_workers;
+        Common::CondvarWait(condition, lock, stop_token, [this] { return pending_tasks > 0; });
+        --sleeping_workers;
+    }
+
+    void FinishTask() {
+        if (++work_done >= work_scheduled) {
+            std::scoped_lock lock{wait_mutex};
+            wait_condition.notify_all();
+        }
+    }
+
+    static inline thread_local StatefulThreadWorker* current_pool{};
+    static inline thread_local size_t current_worker{};
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> next_worker{};
+    std::atomic<size_t> pending_tasks{};
+    std::atomic<size_t> sleeping_workers{};
+    std::mutex sleep_mutex;
     std::condition_variable_any condition;
+    std::mutex wait_mutex;
     std::condition_variable wait_condition;
     std::atomic<size_t> work_scheduled{};
     std::atomic<size_t> work_done{};
@@ -0,0 +1,319 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/polyfill_thread.h"
+#include "common/thread.h"
+#include "common/tracing.h"
+
+namespace Common::Tracing {
+
+namespace {
+
+struct ScopeEvent {
+    u64 token;
+    s64 begin;
+    s64 end;
+};
+
+/**
+ * A thread's recorded scopes, written only by that thread and read only by the writer thread.
+ * Scopes which do not fit are dropped and counted.
+ */
+class ScopeRing {
+public:
+    static constexpr size_t Capacity{1 << 14};
+
+    void Push(const ScopeEvent& event) {
+        const u64 write{write_pos.load(std::memory_order_relaxed)};
+        if (write - read_pos.load(std::memory_order_acquire) >= Capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[write % Capacity] = event;
+        write_pos.store(write + 1, std::memory_order_release);
+    }
+
+    template <typename Func>
+    void Drain(Func&& func) {
+        const u64 write{write_pos.load(std::memory_order_acquire)};
+        u64 read{read_pos.load(std::memory_order_relaxed)};
+        for (; read != write; ++read) {
+            func(events[read % Capacity]);
+        }
+        read_pos.store(read, std::memory_order_release);
+    }
+
+    /// Thread id in the trace
+    u32 id{};
+    /// Name of the thread, guarded by the tracer mutex
+    std::string name;
+    std::atomic<u64> dropped{};
+    /// Marks the ring as no longer written to, set when its thread exits
+    std::atomic_bool abandoned{};
+
+private:
+    std::array<ScopeEvent, Capacity> events{};
+    alignas(128) std::atomic<u64> write_pos{};
+    alignas(128) std::atomic<u64> read_pos{};
+};
+
+/// The calling thread's ring, created on the first scope it records
+struct LocalRing {
+    ~LocalRing() {
+        if (ring) {
+            ring->abandoned.store(true, std::memory_order_release);
+        }
+    }
+
+    std::shared_ptr<ScopeRing> ring;
+    std::string name;
+};
+
+thread_local LocalRing local_ring;
+
+/// Appends a string to JSON output, escaped
+void AppendEscaped(std::string& out, std::string_view string) {
+    for (const char c : string) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += fmt::format("\\u{:04x}", c);
+        } else {
+            out += c;
+        }
+    }
+}
+
+class Tracer {
+public:
+    static Tracer& Instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    ~Tracer() {
+        Stop();
+    }
+
+    bool Start(const std::filesystem::path& path) {
+        std::scoped_lock lock{session_mutex};
+        if (writer.joinable()) {
+            return false;
+        }
+        file = std::make_unique<FS::IOFile>(path, FS::FileAccessMode::Write,
+                                            FS::FileType::TextFile);
+        if (!file->IsOpen()) {
+            LOG_ERROR(Common, "Could not create trace file {}", path.string());
+            file.reset();
+            return false;
+        }
+        buffer = R"({"displayTimeUnit":"ns","traceEvents":[)";
+        buffer += '\n';
+        first_event = true;
+        session_start = Now();
+        dropped_at_start.clear();
+        {
+            std::scoped_lock rings_lock{mutex};
+            for (const auto& ring : rings) {
+                dropped_at_start[ring.get()] = ring->dropped.load(std::memory_order_relaxed);
+            }
+        }
+        writer = std::jthread([this](std::stop_token stop_token) { Run(stop_token); });
+        detail::recording.store(true, std::memory_order_relaxed);
+        LOG_INFO(Common, "Recording trace to {}", path.string());
+        return true;
+    }
+
+    void Stop() {
+        std::scoped_lock lock{session_mutex};
+        if (!writer.joinable()) {
+            return;
+        }
+        detail::recording.store(false, std::memory_order_relaxed);
+        writer.request_stop();
+        writer.join();
+        writer = {};
+
+        Drain();
+        u64 dropped{};
+        {
+            std::scoped_lock rings_lock{mutex};
+            for (const auto& ring : rings) {
+                StartEvent();
+                buffer += R"({"name":"thread_name","ph":"M","pid":1,"tid":)";
+                buffer += fmt::format("{},\"args\":{{\"name\":\"", ring->id);
+                AppendEscaped(buffer, ring->name);
+                buffer += "\"}}";
+                dropped += ring->dropped.load(std::memory_order_relaxed) -
+                           dropped_at_start[ring.get()];
+            }
+            std::erase_if(rings, [](const auto& ring) {
+                return ring->abandoned.load(std::memory_order_acquire);
+            });
+        }
+        buffer += "\n]}\n";
+        WriteBuffer();
+        file.reset();
+        if (dropped != 0) {
+            LOG_WARNING(Common, "Dropped {} scopes from the trace, the writer fell behind",
+                        dropped);
+        }
+        LOG_INFO(Common, "Finished recording trace");
+    }
+
+    void Record(const ScopeEvent& event) {
+        if (!local_ring.ring) {
+            auto ring{std::make_shared<ScopeRing>()};
+            std::scoped_lock lock{mutex};
+            ring->id = next_thread_id++;
+            ring->name = local_ring.name.empty() ? fmt::format("Thread {}", ring->id)
+                                                 : local_ring.name;
+            rings.push_back(ring);
+            local_ring.ring = std::move(ring);
+        }
+        local_ring.ring->Push(event);
+    }
+
+    void SetThreadName(std::string_view name) {
+        local_ring.name = name;
+        if (local_ring.ring) {
+            std::scoped_lock lock{mutex};
+            local_ring.ring->name = name;
+        }
+    }
+
+private:
+    /// How often the writer thread drains the rings
+    static constexpr std::chrono::milliseconds DrainInterval{10};
+
+    void Run(std::stop_token stop_token) {
+        Common::SetCurrentThreadName("TraceWriter");
+        while (!stop_token.stop_requested()) {
+            Drain();
+            WriteBuffer();
+            Common::StoppableTimedWait(stop_token, DrainInterval);
+        }
+    }
+
+    void Drain() {
+        {
+            std::scoped_lock lock{mutex};
+            draining_rings = rings;
+        }
+        for (const auto& ring : draining_rings) {
+            ring->Drain([this, id = ring->id](const ScopeEvent& event) {
+                // Left over from before this session started
+                if (event.begin < session_start) {
+                    return;
+                }
+                StartEvent();
+                buffer += TokenName(event.token);
+                buffer += fmt::format(R"("ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                                      id, static_cast<f64>(event.begin - session_start) / 1000.0,
+                                      static_cast<f64>(event.end - event.begin) / 1000.0);
+            });
+        }
+        draining_rings.clear();
+    }
+
+    void StartEvent() {
+        if (!first_event) {
+            buffer += ",\n";
+        }
+        first_event = false;
+    }
+
+    void WriteBuffer() {
+        void(file->WriteString(buffer));
+        buffer.clear();
+    }
+
+    /// Gets the name and category fields of a scope, from the MicroProfile timer of its token
+    const std::string& TokenName(u64 token) {
+        const auto [it, inserted] = token_names.try_emplace(token);
+        if (inserted) {
+            std::string_view group{"Unknown"};
+            std::string_view name{"Unknown"};
+#if MICROPROFILE_ENABLED
+            std::scoped_lock lock{MicroProfileGetMutex()};
+            const MicroProfile& profile{*MicroProfileGet()};
+            const auto timer_index{MicroProfileGetTimerIndex(token)};
+            if (timer_index < profile.nTotalTimers) {
+                const auto& timer{profile.TimerInfo[timer_index]};
+                name = timer.pName;
+                group = profile.GroupInfo[timer.nGroupIndex].pName;
+            }
+#endif
+            it->second = R"({"name":")";
+            AppendEscaped(it->second, name);
+            it->second += R"(","cat":")";
+            AppendEscaped(it->second, group);
+            it->second += "\",";
+        }
+        return it->second;
+    }
+
+    /// Serializes starting and stopping
+    std::mutex session_mutex;
+    std::jthread writer;
+
+    /// Guards the rings and their names
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ScopeRing>> rings;
+    u32 next_thread_id{1};
+
+    /// State of the session, owned by the writer thread while it runs
+    std::unique_ptr<FS::IOFile> file;
+    std::string buffer;
+    bool first_event{};
+    s64 session_start{};
+    std::unordered_map<const ScopeRing*, u64> dropped_at_start;
+    std::unordered_map<u64, std::string> token_names;
+    std::vector<std::shared_ptr<ScopeRing>> draining_rings;
+};
+
+} // Anonymous namespace
+
+void detail::RecordScope(u64 token, s64 begin, s64 end) {
+    Tracer::Instance().Record({
+        .token = token,
+        .begin = begin,
+        .end = end,
+    });
+}
+
+bool Start(const std::filesystem::path& path) {
+    return Tracer::Instance().Start(path);
+}
+
+void Stop() {
+    Tracer::Instance().Stop();
+}
+
+std::filesystem::path GetDefaultPath() {
+    const auto now{std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())};
+    return FS::GetYuzuPath(FS::YuzuPath::LogDir) /
+           fmt::format("yuzu_trace_{:%Y%m%d_%H%M%S}.json", fmt::localtime(now));
+}
+
+void SetThreadName(std::string_view name) {
+    Tracer::Instance().SetThreadName(name);
+}
+
+} // namespace Common::Tracing
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string_view>
+
+#include "common/common_types.h"
+
+/**
+ * Timeline traces of the profiled scopes of every thread.
+ *
+ * While recording, every MICROPROFILE_SCOPE, along with the CPU core and SVC scopes, is stored as
+ * a begin and end time in a ring buffer of the thread it ran on. A background thread drains the
+ * rings into a trace event JSON file, which Perfetto (ui.perfetto.dev) and chrome://tracing open
+ * directly. Unlike MicroProfile, which keeps a few seconds of history for its own viewer, this
+ * records for as long as needed, and costs a relaxed load per scope when not recording.
+ */
+namespace Common::Tracing {
+
+namespace detail {
+inline std::atomic_bool recording{};
+
+void RecordScope(u64 token, s64 begin, s64 end);
+} // namespace detail
+
+/// Gets the time used for scopes, in nanoseconds
+inline s64 Now() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+/// Whether scopes are being recorded
+inline bool IsRecording() {
+    return detail::recording.load(std::memory_order_relaxed);
+}
+
+/**
+ * Gets the start time of a scope.
+ *
+ * @return The current time, or 0 if not recording.
+ */
+inline s64 BeginScope() {
+    return IsRecording() ? Now() : 0;
+}
+
+/**
+ * Records a scope ending now.
+ *
+ * @param token - MicroProfile token of the scope, giving its group and name.
+ * @param begin - Start time from BeginScope.
+ */
+inline void EndScope(u64 token, s64 begin) {
+    if (begin != 0) [[unlikely]] {
+        detail::RecordScope(token, begin, Now());
+    }
+}
+
+/**
+ * Starts recording a trace.
+ *
+ * @param path - Path of the trace file to write.
+ * @return False if a trace is already being recorded or the file could not be created.
+ */
+bool Start(const std::filesystem::path& path);
+
+/// Stops recording, writing the rest of the trace to its file
+void Stop();
+
+/// Gets a new trace file path in the log directory, named after the current time
+std::filesystem::path GetDefaultPath();
+
+/**
+ * Names the calling thread in traces.
+ *
+ * @param name - Name of the thread.
+ */
+void SetThreadName(std::string_view name);
+
+} // namespace Common::Tracing
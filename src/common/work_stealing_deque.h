@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * A Chase-Lev work-stealing deque of pointers, with the memory orderings from Lê et al., "Correct
+ * and Efficient Work-Stealing for Weak Memory Models".
+ *
+ * The owning thread pushes and pops at the bottom without locking, other threads steal from the
+ * top, only contending with each other or the owner when one item is left. The buffer grows when
+ * full; replaced buffers are kept until destruction, since a thief may still be reading them.
+ */
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_pointer_v<T>, "Items must be pointers, nullptr marks no item");
+
+    class Buffer {
+    public:
+        explicit Buffer(size_t capacity_)
+            : capacity{capacity_}, items{std::make_unique<std::atomic<T>[]>(capacity_)} {}
+
+        size_t Capacity() const {
+            return capacity;
+        }
+
+        T Load(s64 index) const {
+            return items[static_cast<size_t>(index) & (capacity - 1)].load(
+                std::memory_order_relaxed);
+        }
+
+        void Store(s64 index, T item) {
+            items[static_cast<size_t>(index) & (capacity - 1)].store(item,
+                                                                     std::memory_order_relaxed);
+        }
+
+    private:
+        size_t capacity;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+public:
+    explicit WorkStealingDeque(size_t capacity = 256) {
+        buffers.push_back(std::make_unique<Buffer>(capacity));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+
+    /**
+     * Push an item at the bottom. Only called by the owning thread.
+     *
+     * @param item - Item to push, must not be nullptr.
+     */
+    void Push(T item) {
+        const auto b{bottom.load(std::memory_order_relaxed)};
+        const auto t{top.load(std::memory_order_acquire)};
+        auto* current{buffer.load(std::memory_order_relaxed)};
+        if (b - t >= static_cast<s64>(current->Capacity())) {
+            current = Grow(current, b, t);
+        }
+        current->Store(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Pop the most recently pushed item. Only called by the owning thread.
+     *
+     * @return The item, or nullptr if the deque is empty.
+     */
+    T Pop() {
+        const auto b{bottom.load(std::memory_order_relaxed) - 1};
+        auto* const current{buffer.load(std::memory_order_relaxed)};
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t{top.load(std::memory_order_relaxed)};
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T item{current->Load(b)};
+        if (t == b) {
+            // Last item, race the thieves for it
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * Steal the oldest item. Called by any thread.
+     *
+     * @return The item, or nullptr if the deque is empty or another thread took it first.
+     */
+    T Steal() {
+        auto t{top.load(std::memory_order_acquire)};
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b{bottom.load(std::memory_order_acquire)};
+        if (t >= b) {
+            return nullptr;
+        }
+        const T item{buffer.load(std::memory_order_acquire)->Load(t)};
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    /**
+     * Check if the deque looks empty. Racy unless called by the owner with no thieves around.
+     *
+     * @return True if no items were queued at the time of the check.
+     */
+    bool Empty() const {
+        const auto t{top.load(std::memory_order_relaxed)};
+        const auto b{bottom.load(std::memory_order_relaxed)};
+        return t >= b;
+    }
+
+private:
+    Buffer* Grow(Buffer* current, s64 b, s64 t) {
+        auto grown{std::make_unique<Buffer>(current->Capacity() * 2)};
+        for (auto i = t; i < b; i++) {
+            grown->Store(i, current->Load(i));
+        }
+        buffers.push_back(std::move(grown));
+        buffer.store(buffers.back().get(), std::memory_order_release);
+        return buffers.back().get();
+    }
+
+    alignas(128) std::atomic<s64> top{0};
+    alignas(128) std::atomic<s64> bottom{0};
+    std::atomic<Buffer*> buffer{};
+    /// Every buffer used so far, only touched by the owning thread
+    std::vector<std::unique_ptr<Buffer>> buffers;
+};
+
+} // namespace Common
@@ -414,6 +414,14 @@ struct System::Impl {
                                         perf_results.frametime * 1000.0);
             telemetry_session->AddField(performance, "Mean_Frametime_MS",
                                         perf_stats->GetMeanFrametime());
+
+            if (gpu_core != nullptr) {
+                const auto present_stats = gpu_core->Renderer().GetPresentStatistics();
+                telemetry_session->AddField(performance, "Mean_Present_Interval_MS",
+                                            present_stats.mean_interval_ms);
+                telemetry_session->AddField(performance, "Present_Interval_Variance_MS2",
+                                            present_stats.interval_variance_ms2);
+            }
         }
 
         is_powered_on = false;
@@ -480,7 +488,16 @@ struct System::Impl {
     }
 
     PerfStatsResults GetAndResetPerfStats() {
-        return perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
+        auto results{perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs())};
+        if (audio_core) {
+            auto& sink{audio_core->GetOutputSink()};
+            results.audio_underruns = sink.GetAndResetUnderruns();
+            results.audio_overruns = sink.GetAndResetOverruns();
+            results.audio_latency =
+                std::chrono::duration_cast<std::chrono::duration<double>>(sink.GetLatency())
+                    .count();
+        }
+        return results;
     }
 
     mutable std::mutex suspend_guard;
@@ -558,6 +575,7 @@ struct System::Impl {
     std::stop_source stop_event;
 
     std::array<u64, Core::Hardware::NUM_CPU_CORES> dynarmic_ticks{};
+    std::array<s64, Core::Hardware::NUM_CPU_CORES> dynarmic_trace_begin{};
     std::array<MicroProfileToken, Core::Hardware::NUM_CPU_CORES> microprofile_cpu{};
 
     std::array<Core::GPUDirtyMemoryManager, Core::Hardware::NUM_CPU_CORES>
@@ -948,10 +966,12 @@ void System::RegisterHostThread() {
 void System::EnterCPUProfile() {
     std::size_t core = impl->kernel.GetCurrentHostThreadID();
     impl->dynarmic_ticks[core] = MicroProfileEnter(impl->microprofile_cpu[core]);
+    impl->dynarmic_trace_begin[core] = Common::Tracing::BeginScope();
 }
 
 void System::ExitCPUProfile() {
     std::size_t core = impl->kernel.GetCurrentHostThreadID();
+    Common::Tracing::EndScope(impl->microprofile_cpu[core], impl->dynarmic_trace_begin[core]);
     MicroProfileLeave(impl->microprofile_cpu[core], impl->dynarmic_ticks[core]);
 }
 
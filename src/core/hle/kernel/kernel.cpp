@@ -841,6 +841,7 @@ struct KernelCore::Impl {
     u32 single_core_thread_id{};
 
     std::array<u64, Core::Hardware::NUM_CPU_CORES> svc_ticks{};
+    std::array<s64, Core::Hardware::NUM_CPU_CORES> svc_trace_begin{};
 
     KWorkerTaskManager worker_task_manager;
 
@@ -1279,11 +1280,15 @@ void KernelCore::ExceptionalExitApplication() {
 }
 
 void KernelCore::EnterSVCProfile() {
-    impl->svc_ticks[CurrentPhysicalCoreIndex()] = MicroProfileEnter(MICROPROFILE_TOKEN(Kernel_SVC));
+    const auto core{CurrentPhysicalCoreIndex()};
+    impl->svc_ticks[core] = MicroProfileEnter(MICROPROFILE_TOKEN(Kernel_SVC));
+    impl->svc_trace_begin[core] = Common::Tracing::BeginScope();
 }
 
 void KernelCore::ExitSVCProfile() {
-    MicroProfileLeave(MICROPROFILE_TOKEN(Kernel_SVC), impl->svc_ticks[CurrentPhysicalCoreIndex()]);
+    const auto core{CurrentPhysicalCoreIndex()};
+    Common::Tracing::EndScope(MICROPROFILE_TOKEN(Kernel_SVC), impl->svc_trace_begin[core]);
+    MicroProfileLeave(MICROPROFILE_TOKEN(Kernel_SVC), impl->svc_ticks[core]);
 }
 
 Init::KSlabResourceCounts& KernelCore::SlabResourceCounts() {
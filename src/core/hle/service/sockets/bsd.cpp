@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <utility>
@@ -9,6 +10,7 @@
 #include <fmt/format.h>
 
 #include "common/microprofile.h"
+#include "common/scope_exit.h"
 #include "common/socket_types.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_thread.h"
@@ -85,7 +87,7 @@ void BSD::AcceptWork::Response(HLERequestContext& ctx) {
 }
 
 void BSD::ConnectWork::Execute(BSD* bsd) {
-    bsd_errno = bsd->ConnectImpl(fd, addr);
+    bsd_errno = waited ? bsd->FinishConnectImpl(fd) : bsd->ConnectImpl(fd, addr);
 }
 
 void BSD::ConnectWork::Response(HLERequestContext& ctx) {
@@ -481,10 +483,168 @@ void BSD::EventFd(HLERequestContext& ctx) {
 
 template <typename Work>
 void BSD::ExecuteWork(HLERequestContext& ctx, Work work) {
-    work.Execute(this);
+    if constexpr (requires { Work::wait_events; }) {
+        if (ExecuteDeferrableWork(ctx, work)) {
+            // The reply is deferred until the socket is ready
+            return;
+        }
+    } else {
+        metrics.calls.fetch_add(1, std::memory_order_relaxed);
+        work.Execute(this);
+    }
     work.Response(ctx);
 }
 
+template <typename Work>
+bool BSD::ExecuteDeferrableWork(HLERequestContext& ctx, Work& work) {
+    std::shared_ptr<SocketWaiter::Wait> wait = TakeWait(ctx, work.fd);
+    if (wait && !wait->claimed.load(std::memory_order_relaxed)) {
+        // Made again for the wait of another call
+        DeferWork(ctx, std::move(wait));
+        return true;
+    }
+    if (!wait) {
+        // Calls made again once their wait is done were counted when first made
+        metrics.calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Deferred sends resume after the part of the message they already sent
+    size_t sent = wait ? wait->sent : 0;
+    if constexpr (requires { Work::send_whole_message; }) {
+        work.message = work.message.subspan(sent);
+    }
+    const auto add_sent = [&] {
+        if constexpr (requires { Work::send_whole_message; }) {
+            if (sent == 0) {
+                return;
+            }
+            // A send failing after part of the message was sent returns that part
+            work.ret = static_cast<s32>(sent) + std::max(work.ret, 0);
+            work.bsd_errno = Errno::SUCCESS;
+        }
+    };
+
+    if (wait && wait->timed_out) {
+        if constexpr (requires { work.ret; }) {
+            work.ret = -1;
+        }
+        work.bsd_errno = Errno::AGAIN;
+        add_sent();
+        RecordDeferredTime(*wait);
+        return false;
+    }
+
+    // Calls on sockets without a host descriptor, like proxy sockets, are left to block
+    bool blocking = waiter && IsFileDescriptorValid(work.fd) &&
+                    (file_descriptors[work.fd]->flags & Network::FLAG_O_NONBLOCK) == 0 &&
+                    dynamic_cast<Network::Socket*>(file_descriptors[work.fd]->socket.get());
+    if constexpr (requires { work.flags; }) {
+        blocking = blocking && (work.flags & Network::FLAG_MSG_DONTWAIT) == 0;
+    }
+    if (!blocking) {
+        work.Execute(this);
+        add_sent();
+        if (wait) {
+            RecordDeferredTime(*wait);
+        }
+        return false;
+    }
+
+    if constexpr (requires { work.waited; }) {
+        work.waited = wait != nullptr;
+    }
+    FileDescriptor& descriptor = *file_descriptors[work.fd];
+    const std::shared_ptr<Network::SocketBase> socket = descriptor.socket;
+    {
+        // Calls on other threads must not see the socket in its temporary mode, nor change the
+        // mode of the descriptor meanwhile
+        const std::shared_ptr<std::mutex> nonblock_mutex = descriptor.nonblock_mutex;
+        std::scoped_lock lock{*nonblock_mutex};
+        const bool nonblock = (descriptor.flags & Network::FLAG_O_NONBLOCK) != 0;
+        socket->SetNonBlock(true);
+        work.Execute(this);
+        if constexpr (requires { Work::send_whole_message; }) {
+            while (work.ret > 0 && static_cast<size_t>(work.ret) < work.message.size()) {
+                sent += static_cast<size_t>(work.ret);
+                work.message = work.message.subspan(static_cast<size_t>(work.ret));
+                work.Execute(this);
+            }
+        }
+        socket->SetNonBlock(nonblock);
+    }
+    if (work.bsd_errno != Errno::AGAIN && work.bsd_errno != Errno::INPROGRESS) {
+        add_sent();
+        if (wait) {
+            RecordDeferredTime(*wait);
+        }
+        return false;
+    }
+
+    // Would block, wait for the socket on the waiter thread instead
+    auto next_wait = std::make_shared<SocketWaiter::Wait>();
+    next_wait->socket = socket;
+    next_wait->events = Work::wait_events;
+    next_wait->sent = sent;
+    if (wait) {
+        next_wait->start = wait->start;
+        next_wait->deadline = wait->deadline;
+    } else {
+        const u32 timeout = True(Work::wait_events & Network::PollEvents::In)
+                                ? descriptor.recv_timeout
+                                : descriptor.send_timeout;
+        next_wait->start = SocketWaiter::Clock::now();
+        if (timeout != 0) {
+            next_wait->deadline = next_wait->start + std::chrono::milliseconds{timeout};
+        }
+        metrics.deferred_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+    waiter->Add(next_wait);
+    DeferWork(ctx, std::move(next_wait));
+    return true;
+}
+
+std::shared_ptr<SocketWaiter::Wait> BSD::TakeWait(const HLERequestContext& ctx, s32 fd) {
+    std::shared_ptr<SocketWaiter::Wait> wait;
+    {
+        std::scoped_lock lock{wait_mutex};
+        const auto it = waits.find(&ctx);
+        if (it == waits.end()) {
+            return nullptr;
+        }
+        wait = std::move(it->second);
+        waits.erase(it);
+    }
+    // The socket differs once it was closed, or for a wait left over from a call of a closed
+    // session whose context was reused
+    const bool same_socket = fd >= 0 && fd < static_cast<s32>(MAX_FD) && file_descriptors[fd] &&
+                             file_descriptors[fd]->socket == wait->socket;
+    if (!same_socket || wait->done.load(std::memory_order_acquire)) {
+        wait->claimed.store(true, std::memory_order_release);
+    }
+    // Waits are claimed once done, after which they are no longer used by the waiter
+    return same_socket ? wait : nullptr;
+}
+
+void BSD::DeferWork(HLERequestContext& ctx, std::shared_ptr<SocketWaiter::Wait> wait) {
+    {
+        std::scoped_lock lock{wait_mutex};
+        waits.insert_or_assign(&ctx, std::move(wait));
+    }
+    ctx.SetIsDeferred();
+}
+
+void BSD::RecordDeferredTime(const SocketWaiter::Wait& wait) {
+    const auto time = static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           SocketWaiter::Clock::now() - wait.start)
+                                           .count());
+    metrics.deferred_time.fetch_add(time, std::memory_order_relaxed);
+    u64 max_time = metrics.max_deferred_time.load(std::memory_order_relaxed);
+    while (time > max_time &&
+           !metrics.max_deferred_time.compare_exchange_weak(max_time, time,
+                                                            std::memory_order_relaxed)) {
+    }
+}
+
 std::pair<s32, Errno> BSD::SocketImpl(Domain domain, Type type, Protocol protocol) {
     if (type == Type::SEQPACKET) {
         UNIMPLEMENTED_MSG("SOCK_SEQPACKET errno management");
@@ -521,6 +681,27 @@ std::pair<s32, Errno> BSD::SocketImpl(Domain domain, Type type, Protocol protoco
     return {fd, Errno::SUCCESS};
 }
 
+struct BSD::PollState {
+    Network::Poller poller;
+    std::vector<PollFD> fds;
+    std::vector<Network::PollFD> host_fds;
+};
+
+BSD::PollState* BSD::AcquirePollState() {
+    std::scoped_lock lock{poll_mutex};
+    if (idle_poll_states.empty()) {
+        return poll_states.emplace_back(std::make_unique<PollState>()).get();
+    }
+    PollState* const state = idle_poll_states.back();
+    idle_poll_states.pop_back();
+    return state;
+}
+
+void BSD::ReleasePollState(PollState* state) {
+    std::scoped_lock lock{poll_mutex};
+    idle_poll_states.push_back(state);
+}
+
 std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<const u8> read_buffer,
                                     s32 nfds, s32 timeout) {
     if (nfds <= 0) {
@@ -534,9 +715,6 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         return {-1, Errno::INVAL};
     }
 
-    std::vector<PollFD> fds(nfds);
-    std::memcpy(fds.data(), read_buffer.data(), nfds * sizeof(PollFD));
-
     if (timeout >= 0) {
         const s64 seconds = timeout / 1000;
         const u64 nanoseconds = 1'000'000 * (static_cast<u64>(timeout) % 1000);
@@ -551,6 +729,15 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         return {-1, Errno::INVAL};
     }
 
+    PollState* const state = AcquirePollState();
+    SCOPE_EXIT {
+        ReleasePollState(state);
+    };
+
+    std::vector<PollFD>& fds = state->fds;
+    fds.resize(nfds);
+    std::memcpy(fds.data(), read_buffer.data(), nfds * sizeof(PollFD));
+
     for (PollFD& pollfd : fds) {
         ASSERT(False(pollfd.revents));
 
@@ -568,7 +755,8 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         }
     }
 
-    std::vector<Network::PollFD> host_pollfds(fds.size());
+    std::vector<Network::PollFD>& host_pollfds = state->host_fds;
+    host_pollfds.resize(fds.size());
     std::transform(fds.begin(), fds.end(), host_pollfds.begin(), [this](PollFD pollfd) {
         Network::PollFD result;
         result.socket = file_descriptors[pollfd.fd]->socket.get();
@@ -577,7 +765,7 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         return result;
     });
 
-    const auto result = Network::Poll(host_pollfds, timeout);
+    const auto result = state->poller.Poll(host_pollfds, timeout);
 
     const size_t num = host_pollfds.size();
     for (size_t i = 0; i < num; ++i) {
@@ -609,6 +797,9 @@ std::pair<s32, Errno> BSD::AcceptImpl(s32 fd, std::vector<u8>& write_buffer) {
     FileDescriptor& new_descriptor = *file_descriptors[new_fd];
     new_descriptor.socket = std::move(result.socket);
     new_descriptor.is_connection_based = descriptor.is_connection_based;
+    // Deferred accepts make the listener non-blocking, which some hosts pass on to the accepted
+    // socket. The new descriptor has no flags, so it must block.
+    new_descriptor.socket->SetNonBlock(false);
 
     const SockAddrIn guest_addr_in = Translate(result.sockaddr_in);
     PutValue(write_buffer, guest_addr_in);
@@ -637,6 +828,19 @@ Errno BSD::ConnectImpl(s32 fd, std::span<const u8> addr) {
     return Translate(file_descriptors[fd]->socket->Connect(Translate(addr_in)));
 }
 
+Errno BSD::FinishConnectImpl(s32 fd) {
+    if (!IsFileDescriptorValid(fd)) {
+        return Errno::BADF;
+    }
+
+    // The socket is writable once the connection completed or failed
+    const auto [pending_err, getsockopt_err] = file_descriptors[fd]->socket->GetPendingError();
+    if (getsockopt_err != Network::Errno::SUCCESS) {
+        return Translate(getsockopt_err);
+    }
+    return Translate(pending_err);
+}
+
 Errno BSD::GetPeerNameImpl(s32 fd, std::vector<u8>& write_buffer) {
     if (!IsFileDescriptorValid(fd)) {
         return Errno::BADF;
@@ -691,6 +895,7 @@ std::pair<s32, Errno> BSD::FcntlImpl(s32 fd, FcntlCmd cmd, s32 arg) {
         return {descriptor.flags, Errno::SUCCESS};
     case FcntlCmd::SETFL: {
         const bool enable = (arg & Network::FLAG_O_NONBLOCK) != 0;
+        std::scoped_lock lock{*descriptor.nonblock_mutex};
         const Errno bsd_errno = Translate(descriptor.socket->SetNonBlock(enable));
         if (bsd_errno != Errno::SUCCESS) {
             return {-1, bsd_errno};
@@ -773,8 +978,10 @@ Errno BSD::SetSockOptImpl(s32 fd, u32 level, OptName optname, std::span<const u8
     case OptName::RCVBUF:
         return Translate(socket->SetRcvBuf(value));
     case OptName::SNDTIMEO:
+        file_descriptors[fd]->send_timeout = value;
         return Translate(socket->SetSndTimeo(value));
     case OptName::RCVTIMEO:
+        file_descriptors[fd]->recv_timeout = value;
         return Translate(socket->SetRcvTimeo(value));
     case OptName::NOSIGPIPE:
         LOG_WARNING(Service, "(STUBBED) setting NOSIGPIPE to {}", value);
@@ -800,23 +1007,31 @@ std::pair<s32, Errno> BSD::RecvImpl(s32 fd, u32 flags, std::vector<u8>& message)
 
     FileDescriptor& descriptor = *file_descriptors[fd];
 
-    // Apply flags
+    // Apply flags, a blocking descriptor is made non-blocking for the call only
     using Network::FLAG_MSG_DONTWAIT;
     using Network::FLAG_O_NONBLOCK;
+    std::unique_lock nonblock_lock{*descriptor.nonblock_mutex, std::defer_lock};
     if ((flags & FLAG_MSG_DONTWAIT) != 0) {
         flags &= ~FLAG_MSG_DONTWAIT;
+        nonblock_lock.lock();
         if ((descriptor.flags & FLAG_O_NONBLOCK) == 0) {
             descriptor.socket->SetNonBlock(true);
+        } else {
+            nonblock_lock.unlock();
         }
     }
 
     const auto [ret, bsd_errno] = Translate(descriptor.socket->Recv(flags, message));
 
     // Restore original state
-    if ((descriptor.flags & FLAG_O_NONBLOCK) == 0) {
+    if (nonblock_lock) {
         descriptor.socket->SetNonBlock(false);
+        nonblock_lock.unlock();
     }
 
+    if (ret > 0) {
+        metrics.bytes_received.fetch_add(ret, std::memory_order_relaxed);
+    }
     return {ret, bsd_errno};
 }
 
@@ -837,23 +1052,31 @@ std::pair<s32, Errno> BSD::RecvFromImpl(s32 fd, u32 flags, std::vector<u8>& mess
         p_addr_in = &addr_in;
     }
 
-    // Apply flags
+    // Apply flags, a blocking descriptor is made non-blocking for the call only
     using Network::FLAG_MSG_DONTWAIT;
     using Network::FLAG_O_NONBLOCK;
+    std::unique_lock nonblock_lock{*descriptor.nonblock_mutex, std::defer_lock};
     if ((flags & FLAG_MSG_DONTWAIT) != 0) {
         flags &= ~FLAG_MSG_DONTWAIT;
+        nonblock_lock.lock();
         if ((descriptor.flags & FLAG_O_NONBLOCK) == 0) {
             descriptor.socket->SetNonBlock(true);
+        } else {
+            nonblock_lock.unlock();
         }
     }
 
     const auto [ret, bsd_errno] = Translate(descriptor.socket->RecvFrom(flags, message, p_addr_in));
 
     // Restore original state
-    if ((descriptor.flags & FLAG_O_NONBLOCK) == 0) {
+    if (nonblock_lock) {
         descriptor.socket->SetNonBlock(false);
+        nonblock_lock.unlock();
     }
 
+    if (ret > 0) {
+        metrics.bytes_received.fetch_add(ret, std::memory_order_relaxed);
+    }
     if (p_addr_in) {
         if (ret < 0) {
             addr.clear();
@@ -871,7 +1094,11 @@ std::pair<s32, Errno> BSD::SendImpl(s32 fd, u32 flags, std::span<const u8> messa
     if (!IsFileDescriptorValid(fd)) {
         return {-1, Errno::BADF};
     }
-    return Translate(file_descriptors[fd]->socket->Send(message, flags));
+    const auto [ret, bsd_errno] = Translate(file_descriptors[fd]->socket->Send(message, flags));
+    if (ret > 0) {
+        metrics.bytes_sent.fetch_add(ret, std::memory_order_relaxed);
+    }
+    return {ret, bsd_errno};
 }
 
 std::pair<s32, Errno> BSD::SendToImpl(s32 fd, u32 flags, std::span<const u8> message,
@@ -889,7 +1116,12 @@ std::pair<s32, Errno> BSD::SendToImpl(s32 fd, u32 flags, std::span<const u8> mes
         p_addr_in = &addr_in;
     }
 
-    return Translate(file_descriptors[fd]->socket->SendTo(flags, message, p_addr_in));
+    const auto [ret, bsd_errno] =
+        Translate(file_descriptors[fd]->socket->SendTo(flags, message, p_addr_in));
+    if (ret > 0) {
+        metrics.bytes_sent.fetch_add(ret, std::memory_order_relaxed);
+    }
+    return {ret, bsd_errno};
 }
 
 Errno BSD::CloseImpl(s32 fd) {
@@ -897,6 +1129,17 @@ Errno BSD::CloseImpl(s32 fd) {
         return Errno::BADF;
     }
 
+    {
+        std::scoped_lock lock{poll_mutex};
+        for (const auto& state : poll_states) {
+            state->poller.Forget(*file_descriptors[fd]->socket);
+        }
+    }
+    if (waiter) {
+        // Completes the deferred calls on the socket, which then fail as it is closed
+        waiter->Remove(*file_descriptors[fd]->socket);
+    }
+
     const Errno bsd_errno = Translate(file_descriptors[fd]->socket->Close());
     if (bsd_errno != Errno::SUCCESS) {
         return bsd_errno;
@@ -969,8 +1212,9 @@ void BSD::OnProxyPacketReceived(const Network::ProxyPacket& packet) {
     }
 }
 
-BSD::BSD(Core::System& system_, const char* name)
-    : ServiceFramework{system_, name}, room_network{system_.GetRoomNetwork()} {
+BSD::BSD(Core::System& system_, const char* name, std::shared_ptr<SocketWaiter> waiter_)
+    : ServiceFramework{system_, name}, waiter{std::move(waiter_)},
+      room_network{system_.GetRoomNetwork()} {
     // clang-format off
     static const FunctionInfo functions[] = {
         {0, &BSD::RegisterClient, "RegisterClient"},
@@ -1024,6 +1268,27 @@ BSD::~BSD() {
     if (auto room_member = room_network.GetRoomMember().lock()) {
         room_member->Unbind(proxy_packet_received);
     }
+
+    const u64 calls = metrics.calls.load(std::memory_order_relaxed);
+    if (calls == 0) {
+        return;
+    }
+    const u64 deferred_calls = metrics.deferred_calls.load(std::memory_order_relaxed);
+    const f64 seconds =
+        std::chrono::duration<f64>(SocketWaiter::Clock::now() - creation_time).count();
+    const f64 mean_deferred_us =
+        deferred_calls == 0 ? 0.0
+                            : static_cast<f64>(metrics.deferred_time.load()) / 1000.0 /
+                                  static_cast<f64>(deferred_calls);
+    LOG_INFO(Service,
+             "{}: {} socket calls, {} deferred for {:.1f} us on average and {:.1f} us at most, "
+             "sent {} bytes ({:.1f} KiB/s), received {} bytes ({:.1f} KiB/s)",
+             GetServiceName(), calls, deferred_calls, mean_deferred_us,
+             static_cast<f64>(metrics.max_deferred_time.load()) / 1000.0,
+             metrics.bytes_sent.load(),
+             static_cast<f64>(metrics.bytes_sent.load()) / 1024.0 / seconds,
+             metrics.bytes_received.load(),
+             static_cast<f64>(metrics.bytes_received.load()) / 1024.0 / seconds);
 }
 
 std::unique_lock<std::mutex> BSD::LockService() {
@@ -4,13 +4,16 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <span>
+#include <unordered_map>
 #include <vector>
 
 #include "common/common_types.h"
 #include "common/expected.h"
 #include "common/socket_types.h"
 #include "core/hle/service/service.h"
+#include "core/hle/service/sockets/socket_waiter.h"
 #include "core/hle/service/sockets/sockets.h"
 #include "network/network.h"
 
@@ -27,7 +30,7 @@ namespace Service::Sockets {
 
 class BSD final : public ServiceFramework<BSD> {
 public:
-    explicit BSD(Core::System& system_, const char* name);
+    explicit BSD(Core::System& system_, const char* name, std::shared_ptr<SocketWaiter> waiter_);
     ~BSD() override;
 
     // These methods are called from SSL; the first two are also called from
@@ -45,8 +48,28 @@ private:
         std::shared_ptr<Network::SocketBase> socket;
         s32 flags = 0;
         bool is_connection_based = false;
+        /// Receive and send timeouts in milliseconds, zero when calls do not time out
+        u32 recv_timeout = 0;
+        u32 send_timeout = 0;
+        /// Held while the host socket is non-blocking for a call on a blocking descriptor, shared
+        /// by duplicates of the descriptor
+        std::shared_ptr<std::mutex> nonblock_mutex = std::make_shared<std::mutex>();
     };
 
+    /// Socket call statistics, logged when the service is destroyed
+    struct Metrics {
+        std::atomic<u64> calls{};
+        std::atomic<u64> deferred_calls{};
+        std::atomic<u64> bytes_sent{};
+        std::atomic<u64> bytes_received{};
+        /// Total and longest time deferred calls took to complete, in nanoseconds
+        std::atomic<u64> deferred_time{};
+        std::atomic<u64> max_deferred_time{};
+    };
+
+    /// Poller and buffers of a guest poll, kept for a later poll to reuse
+    struct PollState;
+
     struct PollWork {
         void Execute(BSD* bsd);
         void Response(HLERequestContext& ctx);
@@ -63,6 +86,9 @@ private:
         void Execute(BSD* bsd);
         void Response(HLERequestContext& ctx);
 
+        /// Events waited for when the call would block
+        static constexpr Network::PollEvents wait_events = Network::PollEvents::In;
+
         s32 fd;
         std::vector<u8> write_buffer;
         s32 ret{};
@@ -73,8 +99,12 @@ private:
         void Execute(BSD* bsd);
         void Response(HLERequestContext& ctx);
 
+        static constexpr Network::PollEvents wait_events = Network::PollEvents::Out;
+
         s32 fd;
         std::span<const u8> addr;
+        /// Whether the connection was started by an earlier call which was deferred
+        bool waited{};
         Errno bsd_errno{};
     };
 
@@ -82,6 +112,8 @@ private:
         void Execute(BSD* bsd);
         void Response(HLERequestContext& ctx);
 
+        static constexpr Network::PollEvents wait_events = Network::PollEvents::In;
+
         s32 fd;
         u32 flags;
         std::vector<u8> message;
@@ -93,6 +125,8 @@ private:
         void Execute(BSD* bsd);
         void Response(HLERequestContext& ctx);
 
+        static constexpr Network::PollEvents wait_events = Network::PollEvents::In;
+
         s32 fd;
         u32 flags;
         std::vector<u8> message;
@@ -105,6 +139,10 @@ private:
         void Execute(BSD* bsd);
         void Response(HLERequestContext& ctx);
 
+        static constexpr Network::PollEvents wait_events = Network::PollEvents::Out;
+        /// Blocking sends are only done once the whole message is sent
+        static constexpr bool send_whole_message = true;
+
         s32 fd;
         u32 flags;
         std::span<const u8> message;
@@ -116,6 +154,10 @@ private:
         void Execute(BSD* bsd);
         void Response(HLERequestContext& ctx);
 
+        static constexpr Network::PollEvents wait_events = Network::PollEvents::Out;
+        /// Blocking sends are only done once the whole message is sent
+        static constexpr bool send_whole_message = true;
+
         s32 fd;
         u32 flags;
         std::span<const u8> message;
@@ -152,12 +194,23 @@ private:
     template <typename Work>
     void ExecuteWork(HLERequestContext& ctx, Work work);
 
+    template <typename Work>
+    bool ExecuteDeferrableWork(HLERequestContext& ctx, Work& work);
+
+    std::shared_ptr<SocketWaiter::Wait> TakeWait(const HLERequestContext& ctx, s32 fd);
+    void DeferWork(HLERequestContext& ctx, std::shared_ptr<SocketWaiter::Wait> wait);
+    void RecordDeferredTime(const SocketWaiter::Wait& wait);
+
     std::pair<s32, Errno> SocketImpl(Domain domain, Type type, Protocol protocol);
+    PollState* AcquirePollState();
+    void ReleasePollState(PollState* state);
+
     std::pair<s32, Errno> PollImpl(std::vector<u8>& write_buffer, std::span<const u8> read_buffer,
                                    s32 nfds, s32 timeout);
     std::pair<s32, Errno> AcceptImpl(s32 fd, std::vector<u8>& write_buffer);
     Errno BindImpl(s32 fd, std::span<const u8> addr);
     Errno ConnectImpl(s32 fd, std::span<const u8> addr);
+    Errno FinishConnectImpl(s32 fd);
     Errno GetPeerNameImpl(s32 fd, std::vector<u8>& write_buffer);
     Errno GetSockNameImpl(s32 fd, std::vector<u8>& write_buffer);
     Errno ListenImpl(s32 fd, s32 backlog);
@@ -179,6 +232,21 @@ private:
 
     std::array<std::optional<FileDescriptor>, MAX_FD> file_descriptors;
 
+    /// Guards the poll states, there is one for each guest poll that ran concurrently
+    std::mutex poll_mutex;
+    std::vector<std::unique_ptr<PollState>> poll_states;
+    std::vector<PollState*> idle_poll_states;
+
+    /// Waits on the sockets of calls which would block, shared by the services of the process
+    std::shared_ptr<SocketWaiter> waiter;
+
+    /// Waits of the deferred calls, by the context of the call
+    std::mutex wait_mutex;
+    std::unordered_map<const HLERequestContext*, std::shared_ptr<SocketWaiter::Wait>> waits;
+
+    Metrics metrics;
+    SocketWaiter::Clock::time_point creation_time{SocketWaiter::Clock::now()};
+
     Network::RoomNetwork& room_network;
 
     /// Callback to parse and handle a received wifi packet.
@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/hle/service/sockets/socket_waiter.h"
+
+namespace Service::Sockets {
+
+namespace {
+/// How long to wait between polls when waits cannot be woken up for, or are being interrupted
+constexpr std::chrono::milliseconds FallbackInterval{10};
+
+/**
+ * How often to call back again while the calls of done waits have yet to be made again. A call
+ * done before its session is deferred is missed by the server manager.
+ */
+constexpr std::chrono::milliseconds RetryInterval{1};
+
+/// How long to call back for a done wait, as the session of its call may have been closed
+constexpr std::chrono::seconds RetryTimeout{1};
+} // Anonymous namespace
+
+SocketWaiter::SocketWaiter(std::function<void()> on_done_) : on_done{std::move(on_done_)} {
+    const bool wake_opened =
+        wake_socket.Initialize(Network::Domain::INET, Network::Type::DGRAM,
+                               Network::Protocol::UDP) == Network::Errno::SUCCESS &&
+        wake_socket.Bind({Network::Domain::INET, {127, 0, 0, 1}, 0}) == Network::Errno::SUCCESS &&
+        wake_socket.SetNonBlock(true) == Network::Errno::SUCCESS;
+    if (wake_opened) {
+        wake_addr = wake_socket.GetSockName().first;
+    } else {
+        LOG_ERROR(Service, "Failed to create the socket waiter wake up socket");
+    }
+    thread = std::jthread([this](std::stop_token stop_token) { Run(stop_token); });
+}
+
+SocketWaiter::~SocketWaiter() {
+    thread.request_stop();
+    Wake();
+    thread.join();
+}
+
+void SocketWaiter::Add(std::shared_ptr<Wait> wait) {
+    {
+        std::scoped_lock lock{mutex};
+        added.push_back(std::move(wait));
+    }
+    Wake();
+}
+
+void SocketWaiter::Remove(const Network::SocketBase& socket) {
+    std::unique_lock lock{mutex};
+    removed.push_back(&socket);
+    const u64 removal = ++removals_requested;
+    Wake();
+    removed_cv.wait(lock, [&] { return removals_applied >= removal; });
+}
+
+void SocketWaiter::Wake() {
+    if (!wake_socket.IsOpened() || wake_pending.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    const std::array<u8, 1> message{};
+    wake_socket.SendTo(0, message, &wake_addr);
+}
+
+void SocketWaiter::DrainWake() {
+    if (!wake_socket.IsOpened()) {
+        return;
+    }
+    wake_pending.store(false, std::memory_order_release);
+    std::array<u8, 16> message;
+    while (wake_socket.Recv(0, message).first > 0) {
+    }
+}
+
+void SocketWaiter::Run(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("SocketWaiter");
+
+    Network::Poller poller;
+    std::vector<std::shared_ptr<Wait>> waits;
+    std::vector<DoneWait> done_waits;
+    std::vector<Network::PollFD> poll_fds;
+    while (!stop_token.stop_requested()) {
+        DrainWake();
+
+        bool any_removed = false;
+        {
+            std::scoped_lock lock{mutex};
+            waits.insert(waits.end(), std::make_move_iterator(added.begin()),
+                         std::make_move_iterator(added.end()));
+            added.clear();
+            if (removals_applied != removals_requested) {
+                std::erase_if(waits, [&](std::shared_ptr<Wait>& wait) {
+                    if (std::ranges::find(removed, wait->socket.get()) == removed.end()) {
+                        return false;
+                    }
+                    wait->done.store(true, std::memory_order_release);
+                    done_waits.push_back({std::move(wait), Clock::now()});
+                    any_removed = true;
+                    return true;
+                });
+                for (const Network::SocketBase* const socket : removed) {
+                    poller.Forget(*socket);
+                }
+                removed.clear();
+                removals_applied = removals_requested;
+                removed_cv.notify_all();
+            }
+        }
+        if (any_removed) {
+            on_done();
+        }
+
+        poll_fds.clear();
+        poll_fds.push_back({&wake_socket, Network::PollEvents::In, Network::PollEvents{}});
+        Clock::time_point deadline{Clock::time_point::max()};
+        for (const auto& wait : waits) {
+            poll_fds.push_back({wait->socket.get(), wait->events, Network::PollEvents{}});
+            deadline = std::min(deadline, wait->deadline);
+        }
+        s32 timeout = -1;
+        if (deadline != Clock::time_point::max()) {
+            const auto remaining =
+                std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            timeout = static_cast<s32>(
+                std::clamp<s64>(remaining, 0, std::numeric_limits<s32>::max()));
+        }
+        if (!wake_socket.IsOpened() && (timeout < 0 || timeout > FallbackInterval.count())) {
+            timeout = static_cast<s32>(FallbackInterval.count());
+        }
+        std::erase_if(done_waits, [now = Clock::now()](const DoneWait& done_wait) {
+            return done_wait.wait->claimed.load(std::memory_order_acquire) ||
+                   now - done_wait.time > RetryTimeout;
+        });
+        const bool retry = !done_waits.empty();
+        if (retry && (timeout < 0 || timeout > RetryInterval.count())) {
+            timeout = static_cast<s32>(RetryInterval.count());
+        }
+
+        const s32 result = poller.Poll(poll_fds, timeout).first;
+        const auto now = Clock::now();
+        const s32 num_ready = static_cast<s32>(std::ranges::count_if(
+            poll_fds, [](const Network::PollFD& poll_fd) { return True(poll_fd.revents); }));
+        // Poll counts a signaled interrupt as ready, while stopping emulation
+        const bool interrupted = result > num_ready;
+
+        bool any_done = retry;
+        for (size_t i = 0; i < waits.size(); ++i) {
+            Wait& wait = *waits[i];
+            const bool ready = True(poll_fds[i + 1].revents);
+            if (!ready && !interrupted && now < wait.deadline) {
+                continue;
+            }
+            // Interrupted calls give up as timed out calls do
+            wait.timed_out = !ready;
+            wait.done.store(true, std::memory_order_release);
+            any_done = true;
+        }
+        if (any_done) {
+            std::erase_if(waits, [&](std::shared_ptr<Wait>& wait) {
+                if (!wait->done.load(std::memory_order_relaxed)) {
+                    return false;
+                }
+                done_waits.push_back({std::move(wait), now});
+                return true;
+            });
+            on_done();
+        }
+        if (interrupted) {
+            // The interrupt stays signaled until socket operations are restarted
+            Common::StoppableTimedWait(stop_token, FallbackInterval);
+        }
+    }
+}
+
+} // namespace Service::Sockets
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "core/internal_network/network.h"
+#include "core/internal_network/sockets.h"
+
+namespace Service::Sockets {
+
+/**
+ * Waits on a host thread for sockets to become ready, on behalf of socket calls which would block.
+ *
+ * Rather than blocking a service thread, such a call adds a wait and defers its reply. Once the
+ * socket is ready, or the wait timed out, the waiter calls its callback, which signals the
+ * deferral event of the server manager so the deferred calls are made again.
+ */
+class SocketWaiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Wait of a deferred call on a socket
+    struct Wait {
+        std::shared_ptr<Network::SocketBase> socket;
+        /// Events the call waits for
+        Network::PollEvents events{};
+        /// Time the call times out at
+        Clock::time_point deadline{Clock::time_point::max()};
+        /// Time the call was first deferred at
+        Clock::time_point start{};
+        /// Bytes sent by the call before it was deferred, for sends
+        size_t sent{};
+        /// Set once the socket is ready, the wait timed out, or the socket is being closed
+        std::atomic_bool done{};
+        /// Whether the wait timed out or was interrupted, valid once done
+        bool timed_out{};
+        /// Set by the deferred call when it is made again after the wait is done
+        std::atomic_bool claimed{};
+    };
+
+    /**
+     * Starts the waiter thread.
+     *
+     * @param on_done - Called from the waiter thread after one or more waits are done.
+     */
+    explicit SocketWaiter(std::function<void()> on_done);
+    ~SocketWaiter();
+
+    YUZU_NON_COPYABLE(SocketWaiter);
+    YUZU_NON_MOVEABLE(SocketWaiter);
+
+    /**
+     * Waits for a socket to become ready.
+     *
+     * @param wait - Wait to add, which must not be done.
+     */
+    void Add(std::shared_ptr<Wait> wait);
+
+    /**
+     * Completes the waits on a socket and stops polling it, returning once it is no longer used by
+     * the waiter thread. Called before the socket is closed.
+     *
+     * @param socket - Socket about to be closed.
+     */
+    void Remove(const Network::SocketBase& socket);
+
+private:
+    /// Wait whose call has yet to be made again
+    struct DoneWait {
+        std::shared_ptr<Wait> wait;
+        Clock::time_point time;
+    };
+
+    void Run(std::stop_token stop_token);
+
+    /// Makes the waiter thread poll again, with the waits added or removed since
+    void Wake();
+
+    /// Receives the datagrams sent by Wake
+    void DrainWake();
+
+    std::function<void()> on_done;
+
+    /// Loopback socket the waiter sends itself datagrams with to wake up
+    Network::Socket wake_socket;
+    Network::SockAddrIn wake_addr{};
+    std::atomic_bool wake_pending{};
+
+    std::mutex mutex;
+    std::condition_variable removed_cv;
+    /// Waits added since the waiter thread last polled
+    std::vector<std::shared_ptr<Wait>> added;
+    /// Sockets being removed, and the number of removals requested and applied
+    std::vector<const Network::SocketBase*> removed;
+    u64 removals_requested{};
+    u64 removals_applied{};
+
+    std::jthread thread;
+};
+
+} // namespace Service::Sockets
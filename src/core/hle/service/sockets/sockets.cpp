@@ -1,10 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "core/hle/kernel/k_event.h"
 #include "core/hle/service/server_manager.h"
 #include "core/hle/service/sockets/bsd.h"
 #include "core/hle/service/sockets/nsd.h"
 #include "core/hle/service/sockets/sfdnsres.h"
+#include "core/hle/service/sockets/socket_waiter.h"
 #include "core/hle/service/sockets/sockets.h"
 
 namespace Service::Sockets {
@@ -12,8 +14,15 @@ namespace Service::Sockets {
 void LoopProcess(Core::System& system) {
     auto server_manager = std::make_unique<ServerManager>(system);
 
-    server_manager->RegisterNamedService("bsd:s", std::make_shared<BSD>(system, "bsd:s"));
-    server_manager->RegisterNamedService("bsd:u", std::make_shared<BSD>(system, "bsd:u"));
+    // Calls which would block are deferred, and made again once the waiter finds them ready
+    Kernel::KEvent* deferral_event{};
+    server_manager->ManageDeferral(&deferral_event);
+    const std::shared_ptr<Kernel::KEvent> event{deferral_event,
+                                                [](Kernel::KEvent* e) { e->Close(); }};
+    auto waiter = std::make_shared<SocketWaiter>([event] { event->Signal(); });
+
+    server_manager->RegisterNamedService("bsd:s", std::make_shared<BSD>(system, "bsd:s", waiter));
+    server_manager->RegisterNamedService("bsd:u", std::make_shared<BSD>(system, "bsd:u", waiter));
     server_manager->RegisterNamedService("bsdcfg", std::make_shared<BSDCFG>(system));
     server_manager->RegisterNamedService("nsd:a", std::make_shared<NSD>(system, "nsd:a"));
     server_manager->RegisterNamedService("nsd:u", std::make_shared<NSD>(system, "nsd:u"));
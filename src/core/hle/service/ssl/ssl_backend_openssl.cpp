@@ -285,9 +285,10 @@ Result CheckOpenSSLErrors() {
             msg.append(" | ");
             msg.append(data);
         }
-        Common::Log::FmtLogMessage(Common::Log::Class::Service_SSL, Common::Log::Level::Error,
-                                   Common::Log::TrimSourcePath(file), line, func, "OpenSSL: {}",
-                                   msg);
+        // Formatted here, as binary logging keeps only call site strings that are literals
+        Common::Log::FmtLogMessageImpl(Common::Log::Class::Service_SSL, Common::Log::Level::Error,
+                                       Common::Log::TrimSourcePath(file), line, func,
+                                       "OpenSSL: {}", fmt::make_format_args(msg));
     }
     return ResultInternalError;
 }
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -21,6 +22,9 @@
 #include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 #else
 #error "Unimplemented platform"
 #endif
@@ -645,6 +649,282 @@ std::pair<s32, Errno> Poll(std::vector<PollFD>& pollfds, s32 timeout) {
     return {-1, GetAndLogLastError()};
 }
 
+#ifdef __linux__
+
+// Ready events are translated with the poll flags they share their values with
+static_assert(EPOLLIN == POLLIN && EPOLLPRI == POLLPRI && EPOLLOUT == POLLOUT);
+static_assert(EPOLLERR == POLLERR && EPOLLHUP == POLLHUP);
+static_assert(EPOLLRDNORM == POLLRDNORM && EPOLLRDBAND == POLLRDBAND && EPOLLWRBAND == POLLWRBAND);
+
+struct Poller::Impl {
+    /// Interest in a host descriptor, indexed by the descriptor
+    struct Interest {
+        /// Socket last polled on the descriptor
+        const SocketBase* socket{};
+        /// Events registered with epoll, only meaningful while the descriptor is in it
+        u32 registered{};
+        /// Events polled for by the current call
+        u32 wanted{};
+        /// Events reported ready to the current call
+        u32 ready{};
+        /// Current call when the descriptor is polled by it
+        u64 generation{};
+        /// Whether the descriptor could not be registered, reported as not valid
+        bool invalid{};
+        /// Whether the descriptor is in the epoll interest list
+        bool in_epoll{};
+
+        /// Whether the events polled for differ from what epoll reports
+        [[nodiscard]] bool NeedsUpdate() const {
+            return in_epoll ? wanted != registered : wanted != 0;
+        }
+    };
+
+    Impl() : epoll_fd{epoll_create1(EPOLL_CLOEXEC)} {
+        if (epoll_fd < 0) {
+            LOG_ERROR(Network, "Failed to create epoll instance, errno={}", errno);
+        }
+    }
+
+    ~Impl() {
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+        }
+    }
+
+    std::pair<s32, Errno> Poll(std::span<PollFD> poll_fds, s32 timeout) {
+        if (epoll_fd < 0) {
+            std::vector<PollFD> fallback_fds(poll_fds.begin(), poll_fds.end());
+            const auto result = Network::Poll(fallback_fds, timeout);
+            std::copy(fallback_fds.begin(), fallback_fds.end(), poll_fds.begin());
+            return result;
+        }
+        ForgetClosed();
+        RegisterInterrupt();
+
+        // Gather the events polled for on each descriptor, a descriptor may be polled twice
+        ++generation;
+        fds.resize(poll_fds.size());
+        next_registered.clear();
+        PollEvents last_events{};
+        u32 last_wanted{};
+        for (size_t i = 0; i < poll_fds.size(); ++i) {
+            PollFD& poll_fd = poll_fds[i];
+            poll_fd.revents = {};
+            const SOCKET fd = poll_fd.socket->GetFD();
+            fds[i] = fd;
+            if (fd < 0) {
+                // Ignored, as poll does
+                continue;
+            }
+            if (static_cast<size_t>(fd) >= interests.size()) {
+                interests.resize(static_cast<size_t>(fd) + 1);
+            }
+            // Guests tend to poll all sockets for the same events
+            if (i == 0 || poll_fd.events != last_events) {
+                last_events = poll_fd.events;
+                last_wanted = static_cast<u16>(TranslatePollEvents(poll_fd.events));
+            }
+            Interest& interest = interests[fd];
+            if (interest.generation == generation) {
+                interest.wanted |= last_wanted;
+                continue;
+            }
+            if (interest.socket != poll_fd.socket) {
+                // Another socket took the descriptor without the last one being forgotten
+                interest.socket = poll_fd.socket;
+                interest.registered = 0;
+                interest.in_epoll = false;
+            }
+            interest.generation = generation;
+            interest.wanted = last_wanted;
+            interest.ready = 0;
+            interest.invalid = false;
+            next_registered.push_back(fd);
+        }
+
+        // Update the registrations which changed since the last call
+        bool any_invalid = false;
+        std::erase_if(next_registered, [&](SOCKET fd) {
+            Interest& interest = interests[fd];
+            if (interest.NeedsUpdate() && !Register(fd, interest)) {
+                interest.invalid = true;
+                any_invalid = true;
+                return true;
+            }
+            return false;
+        });
+        for (const SOCKET fd : registered) {
+            Interest& interest = interests[fd];
+            if (interest.generation != generation && interest.in_epoll) {
+                // No longer polled, it would only wake up the wait
+                Unregister(fd, interest);
+            }
+        }
+        registered.swap(next_registered);
+
+        // As poll does, do not wait when a descriptor is not valid
+        events.resize(registered.size() + 1);
+        const int result = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()),
+                                      any_invalid ? 0 : timeout);
+        if (result < 0) {
+            return {-1, GetAndLogLastError()};
+        }
+
+        // As with Poll, a signaled interrupt counts as a ready descriptor
+        s32 num_ready = 0;
+        for (int i = 0; i < result; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == interrupt_fd) {
+                ++num_ready;
+                continue;
+            }
+            interests[fd].ready = events[i].events;
+        }
+        for (size_t i = 0; i < poll_fds.size(); ++i) {
+            PollFD& poll_fd = poll_fds[i];
+            const SOCKET fd = fds[i];
+            if (fd < 0) {
+                continue;
+            }
+            const Interest& interest = interests[fd];
+            if (interest.invalid) {
+                poll_fd.revents = PollEvents::Nval;
+            } else if (interest.ready != 0) {
+                poll_fd.revents = TranslatePollRevents(static_cast<short>(interest.ready)) &
+                                  (poll_fd.events | PollEvents::Err | PollEvents::Hup);
+            }
+            if (poll_fd.revents != PollEvents{}) {
+                ++num_ready;
+            }
+        }
+        return {num_ready, Errno::SUCCESS};
+    }
+
+    void Forget(const SocketBase& socket) {
+        const SOCKET fd = socket.GetFD();
+        if (fd < 0) {
+            return;
+        }
+        std::scoped_lock lock{closed_mutex};
+        closed.push_back(fd);
+    }
+
+private:
+    /// Registers the events polled for on a descriptor, returning false when it is not valid
+    bool Register(SOCKET fd, Interest& interest) {
+        if (interest.wanted == 0) {
+            // Nothing to wait for, epoll would still report errors and hang ups
+            Unregister(fd, interest);
+            return true;
+        }
+        epoll_event event{
+            .events = interest.wanted,
+            .data{.fd = fd},
+        };
+        int op = interest.in_epoll ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        int result = epoll_ctl(epoll_fd, op, fd, &event);
+        if (result != 0 && (errno == ENOENT || errno == EEXIST)) {
+            // The descriptor was closed, or reused before being forgotten
+            op = op == EPOLL_CTL_MOD ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+            result = epoll_ctl(epoll_fd, op, fd, &event);
+        }
+        if (result != 0) {
+            LOG_DEBUG(Network, "Failed to register fd={} for polling, errno={}", fd, errno);
+            interest.registered = 0;
+            interest.in_epoll = false;
+            return false;
+        }
+        interest.registered = interest.wanted;
+        interest.in_epoll = true;
+        return true;
+    }
+
+    /// Removes a descriptor from the epoll interest list
+    void Unregister(SOCKET fd, Interest& interest) {
+        if (interest.in_epoll) {
+            // Fails when the descriptor was closed, which already dropped it
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+        interest.registered = 0;
+        interest.in_epoll = false;
+    }
+
+    /// Drops the registrations of the descriptors forgotten since the last call
+    void ForgetClosed() {
+        std::scoped_lock lock{closed_mutex};
+        for (const SOCKET fd : closed) {
+            if (static_cast<size_t>(fd) >= interests.size()) {
+                continue;
+            }
+            Interest& interest = interests[fd];
+            // Usually already dropped by the kernel, when the descriptor was closed
+            Unregister(fd, interest);
+            interest = {};
+        }
+        closed.clear();
+    }
+
+    /// Registers the interrupt pipe, which is created again when the network is initialized again
+    void RegisterInterrupt() {
+        const SOCKET fd = GetInterruptSocket();
+        if (fd == interrupt_fd) {
+            return;
+        }
+        if (interrupt_fd >= 0) {
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, interrupt_fd, nullptr);
+        }
+        epoll_event event{
+            .events = EPOLLIN,
+            .data{.fd = fd},
+        };
+        interrupt_fd = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0 ? fd : -1;
+    }
+
+    int epoll_fd;
+    SOCKET interrupt_fd{-1};
+    u64 generation{};
+    std::vector<Interest> interests;
+    /// Descriptors of the sockets polled by the current call
+    std::vector<SOCKET> fds;
+    /// Descriptors registered with epoll
+    std::vector<SOCKET> registered;
+    std::vector<SOCKET> next_registered;
+    std::vector<epoll_event> events;
+
+    std::mutex closed_mutex;
+    std::vector<SOCKET> closed;
+};
+
+#else
+
+struct Poller::Impl {
+    std::pair<s32, Errno> Poll(std::span<PollFD> poll_fds, s32 timeout) {
+        host_fds.assign(poll_fds.begin(), poll_fds.end());
+        const auto result = Network::Poll(host_fds, timeout);
+        std::copy(host_fds.begin(), host_fds.end(), poll_fds.begin());
+        return result;
+    }
+
+    void Forget(const SocketBase&) {}
+
+    std::vector<PollFD> host_fds;
+};
+
+#endif
+
+Poller::Poller() : impl{std::make_unique<Impl>()} {}
+
+Poller::~Poller() = default;
+
+std::pair<s32, Errno> Poller::Poll(std::span<PollFD> poll_fds, s32 timeout) {
+    return impl->Poll(poll_fds, timeout);
+}
+
+void Poller::Forget(const SocketBase& socket) {
+    impl->Forget(socket);
+}
+
 Socket::~Socket() {
     if (fd == INVALID_SOCKET) {
         return;
@@ -173,4 +173,43 @@ private:
 
 std::pair<s32, Errno> Poll(std::vector<PollFD>& poll_fds, s32 timeout);
 
+/**
+ * Polls sockets like Poll, for callers which poll much the same sockets over and over.
+ *
+ * On Linux, the events polled for each socket stay registered with an epoll instance between
+ * calls, so a call only updates the sockets whose events changed, and waiting costs the ready
+ * sockets rather than all of them. Elsewhere, this polls the sockets with Poll.
+ *
+ * A poller must not be used by more than one thread at a time.
+ */
+class Poller {
+public:
+    Poller();
+    ~Poller();
+
+    YUZU_NON_COPYABLE(Poller);
+    YUZU_NON_MOVEABLE(Poller);
+
+    /**
+     * Waits for events on sockets.
+     *
+     * @param poll_fds - Sockets to poll and the events to wait for, receiving the ready events.
+     * @param timeout - Time to wait in milliseconds, or -1 to wait until a socket is ready.
+     * @return The number of ready sockets, or -1 and the error.
+     */
+    std::pair<s32, Errno> Poll(std::span<PollFD> poll_fds, s32 timeout);
+
+    /**
+     * Forgets a socket which is about to be closed, so a socket reusing its host descriptor is
+     * registered anew. Unlike Poll, this may be called from any thread.
+     *
+     * @param socket - Socket to forget.
+     */
+    void Forget(const SocketBase& socket);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
 } // namespace Network
@@ -21,6 +21,12 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Number of times audio output ran out of queued samples
+    u64 audio_underruns{};
+    /// Number of times audio output dropped samples because its queue was full
+    u64 audio_overruns{};
+    /// Estimated audio output latency, in seconds
+    double audio_latency{};
 };
 
 /**
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <limits>
 #include <common/scope_exit.h>
 
 #include "common/polyfill_ranges.h"
@@ -15,6 +16,8 @@ namespace Core::HID {
 constexpr s32 HID_JOYSTICK_MAX = 0x7fff;
 constexpr s32 HID_TRIGGER_MAX = 0x7fff;
 constexpr u32 TURBO_BUTTON_DELAY = 4;
+// Motion samples fused at once when they are not read, as when no game is running
+constexpr std::size_t MaxQueuedMotionSamples = 128;
 // Use a common UUID for TAS and Virtual Gamepad
 constexpr Common::UUID TAS_UUID =
     Common::UUID{{0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x7, 0xA5, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}};
@@ -416,6 +419,7 @@ void EmulatedController::ReloadInput() {
         // Restore motion state
         auto& emulated_motion = controller.motion_values[index].emulated;
         auto& motion = controller.motion_state[index];
+        motion_batchers[index].Reset();
         emulated_motion.ResetRotations();
         emulated_motion.ResetQuaternion();
         motion.accel = emulated_motion.GetAcceleration();
@@ -574,14 +578,19 @@ void EmulatedController::UnloadInput() {
 }
 
 void EmulatedController::EnableConfiguration() {
-    std::scoped_lock lock{connect_mutex, npad_mutex};
+    std::scoped_lock lock{connect_mutex, npad_mutex, mutex};
     is_configuring = true;
     tmp_is_connected = is_connected;
     tmp_npad_type = npad_type;
+    PublishInputState();
 }
 
 void EmulatedController::DisableConfiguration() {
-    is_configuring = false;
+    {
+        std::scoped_lock lock{mutex};
+        is_configuring = false;
+        PublishInputState();
+    }
 
     // Get Joycon colors before turning on the controller
     for (const auto& color_device : color_devices) {
@@ -811,6 +820,7 @@ void EmulatedController::SetButton(const Common::Input::CallbackStatus& callback
         controller.debug_pad_button_state.raw = 0;
         controller.home_button_state.raw = 0;
         controller.capture_button_state.raw = 0;
+        PublishInputState();
         lock.unlock();
         TriggerOnChange(ControllerTriggerType::Button, false);
         return;
@@ -818,10 +828,9 @@ void EmulatedController::SetButton(const Common::Input::CallbackStatus& callback
 
     // GC controllers have triggers not buttons
     if (npad_type == NpadStyleIndex::GameCube) {
-        if (index == Settings::NativeButton::ZR) {
-            return;
-        }
-        if (index == Settings::NativeButton::ZL) {
+        if (index == Settings::NativeButton::ZR || index == Settings::NativeButton::ZL) {
+            // The turbo setting of the button may have changed
+            PublishInputState();
             return;
         }
     }
@@ -915,6 +924,7 @@ void EmulatedController::SetButton(const Common::Input::CallbackStatus& callback
         break;
     }
 
+    PublishInputState();
     lock.unlock();
 
     if (!is_connected) {
@@ -959,6 +969,7 @@ void EmulatedController::SetStick(const Common::Input::CallbackStatus& callback,
     if (is_configuring) {
         controller.analog_stick_state.left = {};
         controller.analog_stick_state.right = {};
+        PublishInputState();
         return;
     }
 
@@ -983,6 +994,7 @@ void EmulatedController::SetStick(const Common::Input::CallbackStatus& callback,
         controller.npad_button_state.stick_r_down.Assign(controller.stick_values[index].down);
         break;
     }
+    PublishInputState();
 }
 
 void EmulatedController::SetTrigger(const Common::Input::CallbackStatus& callback,
@@ -1009,6 +1021,7 @@ void EmulatedController::SetTrigger(const Common::Input::CallbackStatus& callbac
     if (is_configuring) {
         controller.gc_trigger_state.left = 0;
         controller.gc_trigger_state.right = 0;
+        PublishInputState();
         return;
     }
 
@@ -1031,6 +1044,7 @@ void EmulatedController::SetTrigger(const Common::Input::CallbackStatus& callbac
         controller.npad_button_state.zr.Assign(trigger.pressed.value);
         break;
     }
+    PublishInputState();
 }
 
 void EmulatedController::SetMotion(const Common::Input::CallbackStatus& callback,
@@ -1038,35 +1052,42 @@ void EmulatedController::SetMotion(const Common::Input::CallbackStatus& callback
     if (index >= controller.motion_values.size()) {
         return;
     }
-    SCOPE_EXIT {
+    const auto arrival_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now().time_since_epoch())
+                                  .count();
+    const std::size_t num_queued =
+        motion_batchers[index].Push(TransformToMotion(callback), arrival_time);
+
+    // Samples are fused in batches when motion is read, so only the first of a batch notifies
+    if (num_queued >= MaxQueuedMotionSamples) {
+        std::scoped_lock lock{mutex};
+        ProcessMotion(index);
+    }
+    if (num_queued == 1) {
         TriggerOnChange(ControllerTriggerType::Motion, !is_configuring);
-    };
-    std::scoped_lock lock{mutex};
-    auto& raw_status = controller.motion_values[index].raw_status;
-    auto& emulated = controller.motion_values[index].emulated;
-
-    raw_status = TransformToMotion(callback);
-    emulated.SetAcceleration(Common::Vec3f{
-        raw_status.accel.x.value,
-        raw_status.accel.y.value,
-        raw_status.accel.z.value,
-    });
-    emulated.SetGyroscope(Common::Vec3f{
-        raw_status.gyro.x.value,
-        raw_status.gyro.y.value,
-        raw_status.gyro.z.value,
-    });
-    emulated.SetUserGyroThreshold(raw_status.gyro.x.properties.threshold);
-    emulated.UpdateRotation(raw_status.delta_timestamp);
-    emulated.UpdateOrientation(raw_status.delta_timestamp);
+    }
+}
+
+void EmulatedController::ProcessMotion(std::size_t index) {
+    auto& motion_values = controller.motion_values[index];
+    auto& batcher = motion_batchers[index];
+    if (!batcher.Process(motion_values.emulated, motion_values.raw_status)) {
+        return;
+    }
+    controller.motion_state[index] =
+        ToControllerMotion(batcher.Sample(std::numeric_limits<s64>::max()));
+}
 
-    auto& motion = controller.motion_state[index];
-    motion.accel = emulated.GetAcceleration();
-    motion.gyro = emulated.GetGyroscope();
-    motion.rotation = emulated.GetRotations();
-    motion.euler = emulated.GetEulerAngles();
-    motion.orientation = emulated.GetOrientation();
-    motion.is_at_rest = !emulated.IsMoving(motion_sensitivity);
+ControllerMotion EmulatedController::ToControllerMotion(
+    const MotionInput::FusedSample& sample) const {
+    return {
+        .accel = sample.accel,
+        .gyro = sample.gyro,
+        .rotation = sample.rotations,
+        .euler = MotionInput::GetEulerAngles(sample.quat),
+        .orientation = MotionInput::GetOrientation(sample.quat),
+        .is_at_rest = !MotionInput::IsMoving(sample.gyro, sample.accel, motion_sensitivity),
+    };
 }
 
 void EmulatedController::SetColors(const Common::Input::CallbackStatus& callback,
@@ -1728,6 +1749,7 @@ void EmulatedController::Connect(bool use_temporary_value) {
         return;
     }
     is_connected = true;
+    PublishInputState();
 }
 
 void EmulatedController::Disconnect() {
@@ -1745,6 +1767,7 @@ void EmulatedController::Disconnect() {
         return;
     }
     is_connected = false;
+    PublishInputState();
 }
 
 bool EmulatedController::IsConnected(bool get_temporary_value) const {
@@ -1792,6 +1815,7 @@ void EmulatedController::SetNpadStyleIndex(NpadStyleIndex npad_type_) {
                     Service::HID::NpadIdTypeToIndex(npad_id_type));
     }
     npad_type = npad_type_;
+    PublishInputState();
 }
 
 LedPattern EmulatedController::GetLedPattern() const {
@@ -1906,11 +1930,63 @@ NpadGcTriggerState EmulatedController::GetTriggers() const {
     return controller.gc_trigger_state;
 }
 
-MotionState EmulatedController::GetMotions() const {
-    std::unique_lock lock{mutex};
+MotionState EmulatedController::GetMotions() {
+    std::scoped_lock lock{mutex};
+    for (std::size_t index = 0; index < motion_batchers.size(); ++index) {
+        ProcessMotion(index);
+    }
     return controller.motion_state;
 }
 
+MotionState EmulatedController::GetMotions(std::chrono::steady_clock::time_point sampling_time) {
+    const s64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         sampling_time.time_since_epoch())
+                         .count();
+    std::scoped_lock lock{mutex};
+    for (std::size_t index = 0; index < motion_batchers.size(); ++index) {
+        ProcessMotion(index);
+    }
+    MotionState motion_state = controller.motion_state;
+    for (std::size_t index = 0; index < motion_batchers.size(); ++index) {
+        const auto& batcher = motion_batchers[index];
+        if (batcher.HasSamples()) {
+            motion_state[index] =
+                ToControllerMotion(batcher.Sample(time - batcher.GetResampleDelay()));
+        }
+    }
+    return motion_state;
+}
+
+ControllerInputState EmulatedController::GetInputState() const {
+    auto state = input_state.Read();
+    if (turbo_button_state >= TURBO_BUTTON_DELAY) {
+        state.npad_buttons.raw &= ~state.turbo_buttons;
+    }
+    return state;
+}
+
+u64 EmulatedController::GetInputStateWriteCount() const {
+    return input_state.WriteCount();
+}
+
+void EmulatedController::PublishInputState() {
+    if (is_configuring) {
+        input_state.Write({
+            .npad_type = npad_type,
+            .is_connected = is_connected,
+        });
+        return;
+    }
+    input_state.Write({
+        .npad_buttons = controller.npad_button_state,
+        .turbo_buttons = GetTurboButtons(),
+        .sticks = controller.analog_stick_state,
+        .gc_triggers = controller.gc_trigger_state,
+        .npad_type = npad_type,
+        .is_connected = is_connected,
+    });
+}
+
 ControllerColors EmulatedController::GetColors() const {
     std::scoped_lock lock{mutex};
     return controller.colors_state;
@@ -1995,7 +2071,10 @@ NpadButton EmulatedController::GetTurboButtonMask() const {
     if (turbo_button_state < TURBO_BUTTON_DELAY) {
         return {NpadButton::All};
     }
+    return ~GetTurboButtons();
+}
 
+NpadButton EmulatedController::GetTurboButtons() const {
     NpadButtonState button_mask{};
     for (std::size_t index = 0; index < controller.button_values.size(); ++index) {
         if (!controller.button_values[index].turbo) {
@@ -2056,7 +2135,7 @@ NpadButton EmulatedController::GetTurboButtonMask() const {
         }
     }
 
-    return static_cast<NpadButton>(~button_mask.raw);
+    return button_mask.raw;
 }
 
 } // namespace Core::HID
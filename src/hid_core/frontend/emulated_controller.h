@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -13,8 +14,10 @@
 #include "common/common_types.h"
 #include "common/input.h"
 #include "common/param_package.h"
+#include "common/seqlock.h"
 #include "common/settings.h"
 #include "common/vector_math.h"
+#include "hid_core/frontend/motion_batcher.h"
 #include "hid_core/frontend/motion_input.h"
 #include "hid_core/hid_types.h"
 #include "hid_core/irsensor/irs_types.h"
@@ -147,6 +150,17 @@ struct ControllerStatus {
     Common::Input::PollingMode right_polling_mode{};
 };
 
+// Input state read by the npad service on every update, published without locking the controller
+struct ControllerInputState {
+    NpadButtonState npad_buttons{};
+    // Buttons with turbo enabled, masked out of npad_buttons every other turbo period
+    NpadButton turbo_buttons{};
+    AnalogSticks sticks{};
+    NpadGcTriggerState gc_triggers{};
+    NpadStyleIndex npad_type{NpadStyleIndex::None};
+    bool is_connected{};
+};
+
 enum class ControllerTriggerType {
     Button,
     Stick,
@@ -338,7 +352,26 @@ public:
     NpadGcTriggerState GetTriggers() const;
 
     /// Returns the latest status of motion input from the mouse
-    MotionState GetMotions() const;
+    MotionState GetMotions();
+
+    /**
+     * Returns the status of motion input at the time the guest samples it, interpolated between
+     * the samples of the sensors to even out their delivery jitter
+     * @param sampling_time Host time the guest samples motion at
+     */
+    MotionState GetMotions(std::chrono::steady_clock::time_point sampling_time);
+
+    /**
+     * Returns the latest npad buttons, sticks, triggers, type and connection status without taking
+     * any lock, for the npad service to read on every update
+     */
+    ControllerInputState GetInputState() const;
+
+    /**
+     * Returns the number of times the state returned by GetInputState was published. Reading it
+     * before the state tells whether the state may have changed since an earlier read.
+     */
+    u64 GetInputStateWriteCount() const;
 
     /// Returns the latest color value from the controller
     ControllerColors GetColors() const;
@@ -522,6 +555,15 @@ private:
      */
     void SetMotion(const Common::Input::CallbackStatus& callback, std::size_t index);
 
+    /**
+     * Fuses the queued motion samples of a sensor. Must be called with the mutex held
+     * @param index motion ID of the sensor
+     */
+    void ProcessMotion(std::size_t index);
+
+    /// Converts a fused motion sample into the status returned to HID services
+    ControllerMotion ToControllerMotion(const MotionInput::FusedSample& sample) const;
+
     /**
      * Updates the color status of the controller
      * @param callback A CallbackStatus containing the color status
@@ -570,6 +612,12 @@ private:
 
     NpadButton GetTurboButtonMask() const;
 
+    /// Returns the buttons with turbo enabled
+    NpadButton GetTurboButtons() const;
+
+    /// Publishes the state returned by GetInputState. Must be called with the mutex held
+    void PublishInputState();
+
     const NpadIdType npad_id_type;
     NpadStyleIndex npad_type{NpadStyleIndex::None};
     NpadStyleIndex original_npad_type{NpadStyleIndex::None};
@@ -635,6 +683,12 @@ private:
 
     // Stores the current status of all controller input
     ControllerStatus controller;
+
+    // Queued and fused samples of each motion sensor
+    std::array<MotionBatcher, max_emulated_controllers> motion_batchers;
+
+    // Snapshot of the controller status for the npad service, written with the mutex held
+    Common::SeqLock<ControllerInputState> input_state;
 };
 
 } // namespace Core::HID
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "hid_core/frontend/motion_batcher.h"
+
+namespace Core::HID {
+
+namespace {
+/// Longest time between samples for the sensor clock to be followed, in microseconds
+constexpr u64 MaxElapsedTime = 100'000;
+
+/// Latest a sample may arrive before the sensor clock is assumed to be wrong, in nanoseconds
+constexpr s64 MaxArrivalDelay = 50'000'000;
+
+/// Longest time to resample behind the current time, in nanoseconds
+constexpr s64 MaxResampleDelay = 8'000'000;
+
+/// The clock offset may grow by one part in this many of the elapsed time, following clock drift
+constexpr s64 ClockDriftDivisor = 1000;
+
+/// The resample delay decays by one part in this many of the elapsed time
+constexpr s64 ResampleDelayDecayDivisor = 100;
+
+Common::Quaternion<f32> Nlerp(const Common::Quaternion<f32>& begin,
+                              Common::Quaternion<f32> end, f32 t) {
+    // Take the shortest path between the two orientations
+    if (Common::Dot(begin.xyz, end.xyz) + begin.w * end.w < 0.0f) {
+        end = {-end.xyz, -end.w};
+    }
+    const Common::Quaternion<f32> result{
+        .xyz = Common::Lerp(begin.xyz, end.xyz, t),
+        .w = begin.w * (1.0f - t) + end.w * t,
+    };
+    return result.Normalized();
+}
+} // Anonymous namespace
+
+std::size_t MotionBatcher::Push(const Common::Input::MotionStatus& status, s64 arrival_time) {
+    std::scoped_lock lock{mutex};
+    const u64 elapsed_time = status.delta_timestamp;
+    const s64 elapsed_ns = static_cast<s64>(elapsed_time) * 1000;
+    if (is_clock_valid && elapsed_time != 0 && elapsed_time <= MaxElapsedTime) {
+        sensor_time += elapsed_ns;
+        clock_offset = std::min(clock_offset + elapsed_ns / ClockDriftDivisor,
+                                arrival_time - sensor_time);
+    } else {
+        is_clock_valid = true;
+        sensor_time = arrival_time;
+        clock_offset = 0;
+    }
+
+    s64 timestamp = sensor_time + clock_offset;
+    if (arrival_time - timestamp > MaxArrivalDelay) {
+        // The reported elapsed time does not match the rate of the samples
+        sensor_time = arrival_time;
+        clock_offset = 0;
+        timestamp = arrival_time;
+    }
+    // Samples arriving later than MaxResampleDelay are resampled late rather than waited for
+    const s64 decayed_delay = resample_delay - elapsed_ns / ResampleDelayDecayDivisor;
+    resample_delay =
+        std::min(std::max(decayed_delay, arrival_time - timestamp), MaxResampleDelay);
+
+    last_status = status;
+    queued.push_back({
+        .timestamp = timestamp,
+        .elapsed_time = elapsed_time,
+        .accel = {status.accel.x.value, status.accel.y.value, status.accel.z.value},
+        .gyro = {status.gyro.x.value, status.gyro.y.value, status.gyro.z.value},
+        .user_gyro_threshold = status.gyro.x.properties.threshold,
+    });
+    return queued.size();
+}
+
+bool MotionBatcher::Process(MotionInput& input, Common::Input::MotionStatus& raw_status) {
+    {
+        std::scoped_lock lock{mutex};
+        if (queued.empty()) {
+            return false;
+        }
+        batch.swap(queued);
+        raw_status = last_status;
+    }
+
+    fused_batch.resize(batch.size());
+    input.UpdateBatch(batch, fused_batch);
+    batch.clear();
+
+    // Only the newest samples are kept to resample from
+    const std::size_t first = fused_batch.size() - std::min(fused_batch.size(), HistorySize);
+    for (std::size_t i = first; i < fused_batch.size(); ++i) {
+        history[history_end] = fused_batch[i];
+        history_end = (history_end + 1) % HistorySize;
+    }
+    history_count = std::min(history_count + fused_batch.size(), HistorySize);
+    return true;
+}
+
+bool MotionBatcher::HasSamples() const {
+    return history_count != 0;
+}
+
+MotionInput::FusedSample MotionBatcher::Sample(s64 time) const {
+    if (history_count == 0) {
+        return {};
+    }
+    const auto at = [&](std::size_t age) -> const MotionInput::FusedSample& {
+        return history[(history_end + HistorySize - 1 - age) % HistorySize];
+    };
+
+    // Find the newest sample at or before the time, which is usually among the last few
+    std::size_t age = 0;
+    while (age < history_count && at(age).timestamp > time) {
+        ++age;
+    }
+    if (age == 0) {
+        return at(0);
+    }
+    if (age == history_count) {
+        return at(history_count - 1);
+    }
+
+    const MotionInput::FusedSample& before = at(age);
+    const MotionInput::FusedSample& after = at(age - 1);
+    const s64 span = after.timestamp - before.timestamp;
+    const f32 t =
+        span <= 0 ? 1.0f : static_cast<f32>(time - before.timestamp) / static_cast<f32>(span);
+    return {
+        .timestamp = time,
+        .accel = Common::Lerp(before.accel, after.accel, t),
+        .gyro = Common::Lerp(before.gyro, after.gyro, t),
+        .rotations = Common::Lerp(before.rotations, after.rotations, t),
+        .quat = Nlerp(before.quat, after.quat, t),
+    };
+}
+
+s64 MotionBatcher::GetResampleDelay() const {
+    std::scoped_lock lock{mutex};
+    return resample_delay;
+}
+
+void MotionBatcher::Reset() {
+    {
+        std::scoped_lock lock{mutex};
+        queued.clear();
+        is_clock_valid = false;
+        resample_delay = 0;
+    }
+    history_count = 0;
+    history_end = 0;
+}
+
+} // namespace Core::HID
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/input.h"
+#include "hid_core/frontend/motion_input.h"
+
+namespace Core::HID {
+
+/**
+ * Queues the samples of a motion sensor as its driver reports them, fuses them in batches when
+ * motion is read, and resamples the fused motion at the times it is read for.
+ *
+ * Samples are timestamped on the sensor clock, which is aligned to the host clock by the earliest
+ * arrival seen, so that late deliveries do not move them in time.
+ */
+class MotionBatcher {
+public:
+    /// Number of fused samples kept to resample from
+    static constexpr std::size_t HistorySize = 64;
+
+    /**
+     * Queues a sample. Thread-safe.
+     *
+     * @param status - Motion status reported by the driver.
+     * @param arrival_time - Host time the status was reported at, in nanoseconds.
+     * @return Number of samples queued, including this one.
+     */
+    std::size_t Push(const Common::Input::MotionStatus& status, s64 arrival_time);
+
+    /**
+     * Fuses the queued samples.
+     *
+     * @param input - Fusion state of the sensor.
+     * @param raw_status - Receives the last status reported, when any sample was queued.
+     * @return Whether any sample was fused.
+     */
+    bool Process(MotionInput& input, Common::Input::MotionStatus& raw_status);
+
+    /// Returns whether any sample was fused since the last reset
+    [[nodiscard]] bool HasSamples() const;
+
+    /**
+     * Returns the fused motion at a host time, interpolated between the fused samples around it.
+     * The nearest fused sample is held before the first and after the last one.
+     *
+     * @param time - Host time in nanoseconds.
+     */
+    [[nodiscard]] MotionInput::FusedSample Sample(s64 time) const;
+
+    /// Returns how far behind the current time to resample, covering the delivery jitter seen
+    [[nodiscard]] s64 GetResampleDelay() const;
+
+    /// Drops the queued and fused samples
+    void Reset();
+
+private:
+    mutable std::mutex mutex;
+    std::vector<MotionInput::Sample> queued;
+    Common::Input::MotionStatus last_status{};
+
+    // Sensor clock, in nanoseconds, and its offset to the host clock
+    bool is_clock_valid{};
+    s64 sensor_time{};
+    s64 clock_offset{};
+    s64 resample_delay{};
+
+    std::vector<MotionInput::Sample> batch;
+    std::vector<MotionInput::FusedSample> fused_batch;
+    std::array<MotionInput::FusedSample, HistorySize> history{};
+    std::size_t history_count{};
+    std::size_t history_end{};
+};
+
+} // namespace Core::HID
@@ -1,8 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cmath>
 
+#include "common/assert.h"
 #include "common/math_util.h"
 #include "hid_core/frontend/motion_input.h"
 
@@ -98,6 +100,11 @@ void MotionInput::ResetQuaternion() {
 }
 
 bool MotionInput::IsMoving(f32 sensitivity) const {
+    return IsMoving(gyro, accel, sensitivity);
+}
+
+bool MotionInput::IsMoving(const Common::Vec3f& gyro, const Common::Vec3f& accel,
+                           f32 sensitivity) {
     return gyro.Length() >= sensitivity || accel.Length() <= 0.9f || accel.Length() >= 1.1f;
 }
 
@@ -129,6 +136,11 @@ void MotionInput::StopCalibration() {
 // Based on Madgwick's implementation of Mayhony's AHRS algorithm.
 // https://github.com/xioTechnologies/Open-Source-AHRS-With-x-IMU/blob/master/x-IMU%20IMU%20and%20AHRS%20Algorithms/x-IMU%20IMU%20and%20AHRS%20Algorithms/AHRS/MahonyAHRS.cs
 void MotionInput::UpdateOrientation(u64 elapsed_time) {
+    UpdateOrientation(elapsed_time, accel.Normalized(), accel.Length());
+}
+
+void MotionInput::UpdateOrientation(u64 elapsed_time, const Common::Vec3f& normal_accel,
+                                    f32 accel_length) {
     if (!IsCalibrated(0.1f)) {
         ResetOrientation();
     }
@@ -144,7 +156,6 @@ void MotionInput::UpdateOrientation(u64 elapsed_time) {
         return;
     }
 
-    const auto normal_accel = accel.Normalized();
     auto rad_gyro = gyro * Common::PI * 2;
     const f32 swap = rad_gyro.x;
     rad_gyro.x = rad_gyro.y;
@@ -159,7 +170,7 @@ void MotionInput::UpdateOrientation(u64 elapsed_time) {
     }
 
     // Ignore drift correction if acceleration is not reliable
-    if (accel.Length() >= 0.75f && accel.Length() <= 1.25f) {
+    if (accel_length >= 0.75f && accel_length <= 1.25f) {
         const f32 ax = -normal_accel.x;
         const f32 ay = normal_accel.y;
         const f32 az = -normal_accel.z;
@@ -225,7 +236,57 @@ void MotionInput::UpdateOrientation(u64 elapsed_time) {
     quat = quat.Normalized();
 }
 
+void MotionInput::UpdateBatch(std::span<const Sample> samples, std::span<FusedSample> fused) {
+    ASSERT(fused.size() == samples.size());
+
+    // The accelerometer terms do not depend on the fusion state, so they are computed for the
+    // whole batch up front, in loops the compiler can vectorise
+    static constexpr std::size_t ChunkSize = 64;
+    std::array<Common::Vec3f, ChunkSize> clamped_accel;
+    std::array<Common::Vec3f, ChunkSize> normal_accel;
+    std::array<f32, ChunkSize> accel_length;
+    for (std::size_t begin = 0; begin < samples.size(); begin += ChunkSize) {
+        const std::size_t count = std::min(ChunkSize, samples.size() - begin);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Common::Vec3f& value = samples[begin + i].accel;
+            clamped_accel[i] = {
+                std::clamp(value.x, -AccelMaxValue, AccelMaxValue),
+                std::clamp(value.y, -AccelMaxValue, AccelMaxValue),
+                std::clamp(value.z, -AccelMaxValue, AccelMaxValue),
+            };
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            accel_length[i] = clamped_accel[i].Length();
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            normal_accel[i] = clamped_accel[i].Normalized();
+        }
+
+        // The gyroscope bias and the orientation depend on the previous sample
+        for (std::size_t i = 0; i < count; ++i) {
+            const Sample& sample = samples[begin + i];
+            accel = clamped_accel[i];
+            SetGyroscope(sample.gyro);
+            SetUserGyroThreshold(sample.user_gyro_threshold);
+            UpdateRotation(sample.elapsed_time);
+            UpdateOrientation(sample.elapsed_time, normal_accel[i], accel_length[i]);
+
+            fused[begin + i] = {
+                .timestamp = sample.timestamp,
+                .accel = accel,
+                .gyro = gyro,
+                .rotations = rotations,
+                .quat = quat,
+            };
+        }
+    }
+}
+
 std::array<Common::Vec3f, 3> MotionInput::GetOrientation() const {
+    return GetOrientation(quat);
+}
+
+std::array<Common::Vec3f, 3> MotionInput::GetOrientation(const Common::Quaternion<f32>& quat) {
     const Common::Quaternion<float> quad{
         .xyz = {-quat.xyz[1], -quat.xyz[0], -quat.w},
         .w = -quat.xyz[2],
@@ -258,6 +319,10 @@ Common::Vec3f MotionInput::GetRotations() const {
 }
 
 Common::Vec3f MotionInput::GetEulerAngles() const {
+    return GetEulerAngles(quat);
+}
+
+Common::Vec3f MotionInput::GetEulerAngles(const Common::Quaternion<f32>& quat) {
     // roll (x-axis rotation)
     const float sinr_cosp = 2 * (quat.w * quat.xyz.x + quat.xyz.y * quat.xyz.z);
     const float cosr_cosp = 1 - 2 * (quat.xyz.x * quat.xyz.x + quat.xyz.y * quat.xyz.y);
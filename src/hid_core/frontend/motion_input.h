@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <array>
+#include <span>
+
 #include "common/common_types.h"
 #include "common/quaternion.h"
 #include "common/vector_math.h"
@@ -25,6 +28,26 @@ public:
 
     static constexpr std::size_t CalibrationSamples = 300;
 
+    /// Sensor sample to fuse as part of a batch
+    struct Sample {
+        /// Host time the sensor measured the sample at, in nanoseconds
+        s64 timestamp{};
+        /// Time since the previous sample in microseconds
+        u64 elapsed_time{};
+        Common::Vec3f accel{};
+        Common::Vec3f gyro{};
+        f32 user_gyro_threshold{};
+    };
+
+    /// State of the fusion after a sample
+    struct FusedSample {
+        s64 timestamp{};
+        Common::Vec3f accel{};
+        Common::Vec3f gyro{};
+        Common::Vec3f rotations{};
+        Common::Quaternion<f32> quat{};
+    };
+
     explicit MotionInput();
 
     MotionInput(const MotionInput&) = default;
@@ -51,6 +74,15 @@ public:
     void UpdateRotation(u64 elapsed_time);
     void UpdateOrientation(u64 elapsed_time);
 
+    /**
+     * Fuses samples in order, as setting the acceleration, gyroscope and user gyro threshold then
+     * updating rotation and orientation for each of them would
+     *
+     * @param samples - Samples to fuse, oldest first.
+     * @param fused - Receives the state after each sample, of the same size as samples.
+     */
+    void UpdateBatch(std::span<const Sample> samples, std::span<FusedSample> fused);
+
     void Calibrate();
 
     [[nodiscard]] std::array<Common::Vec3f, 3> GetOrientation() const;
@@ -64,7 +96,14 @@ public:
     [[nodiscard]] bool IsMoving(f32 sensitivity) const;
     [[nodiscard]] bool IsCalibrated(f32 sensitivity) const;
 
+    [[nodiscard]] static std::array<Common::Vec3f, 3> GetOrientation(
+        const Common::Quaternion<f32>& quat);
+    [[nodiscard]] static Common::Vec3f GetEulerAngles(const Common::Quaternion<f32>& quat);
+    [[nodiscard]] static bool IsMoving(const Common::Vec3f& gyro, const Common::Vec3f& accel,
+                                       f32 sensitivity);
+
 private:
+    void UpdateOrientation(u64 elapsed_time, const Common::Vec3f& normal_accel, f32 accel_length);
     void StopCalibration();
     void ResetOrientation();
     void SetOrientationFromAccelerometer();
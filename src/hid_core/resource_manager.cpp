@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "common/logging/log.h"
+#include "common/microprofile.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/service/ipc_helpers.h"
@@ -37,6 +38,13 @@
 #include "hid_core/resources/vibration/vibration_base.h"
 #include "hid_core/resources/vibration/vibration_device.h"
 
+MICROPROFILE_DEFINE(HID_UpdateNpad, "HID", "Update Npad", MP_RGB(255, 160, 60));
+MICROPROFILE_DEFINE(HID_UpdateControllers, "HID", "Update Controllers", MP_RGB(255, 160, 60));
+MICROPROFILE_DEFINE(HID_UpdateMouseKeyboard, "HID", "Update Mouse Keyboard",
+                    MP_RGB(255, 160, 60));
+MICROPROFILE_DEFINE(HID_UpdateMotion, "HID", "Update Motion", MP_RGB(255, 160, 60));
+MICROPROFILE_DEFINE(HID_UpdateTouch, "HID", "Update Touch", MP_RGB(255, 160, 60));
+
 namespace Service::HID {
 
 // Updating period for each HID device.
@@ -268,6 +276,7 @@ void ResourceManager::InitializeTouchScreenSampler() {
         "HID::TouchUpdateCallback",
         [this](s64 time,
                std::chrono::nanoseconds ns_late) -> std::optional<std::chrono::nanoseconds> {
+            MICROPROFILE_SCOPE(HID_UpdateTouch);
             touch_resource->OnTouchUpdate(time);
             return std::nullopt;
         });
@@ -471,6 +480,7 @@ Result ResourceManager::GetTouchScreenFirmwareVersion(Core::HID::FirmwareVersion
 }
 
 void ResourceManager::UpdateControllers(std::chrono::nanoseconds ns_late) {
+    MICROPROFILE_SCOPE(HID_UpdateControllers);
     auto& core_timing = system.CoreTiming();
     debug_pad->OnUpdate(core_timing);
     digitizer->OnUpdate(core_timing);
@@ -482,11 +492,13 @@ void ResourceManager::UpdateControllers(std::chrono::nanoseconds ns_late) {
 }
 
 void ResourceManager::UpdateNpad(std::chrono::nanoseconds ns_late) {
+    MICROPROFILE_SCOPE(HID_UpdateNpad);
     auto& core_timing = system.CoreTiming();
     npad->OnUpdate(core_timing);
 }
 
 void ResourceManager::UpdateMouseKeyboard(std::chrono::nanoseconds ns_late) {
+    MICROPROFILE_SCOPE(HID_UpdateMouseKeyboard);
     auto& core_timing = system.CoreTiming();
     mouse->OnUpdate(core_timing);
     debug_mouse->OnUpdate(core_timing);
@@ -494,6 +506,7 @@ void ResourceManager::UpdateMouseKeyboard(std::chrono::nanoseconds ns_late) {
 }
 
 void ResourceManager::UpdateMotion(std::chrono::nanoseconds ns_late) {
+    MICROPROFILE_SCOPE(HID_UpdateMotion);
     auto& core_timing = system.CoreTiming();
     six_axis->OnUpdate(core_timing);
     seven_six_axis->OnUpdate(core_timing);
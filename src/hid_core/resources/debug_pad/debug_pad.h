@@ -5,6 +5,7 @@
 
 #include "hid_core/resources/controller_base.h"
 #include "hid_core/resources/debug_pad/debug_pad_types.h"
+#include "hid_core/resources/ring_lifo.h"
 
 namespace Core::HID {
 class HIDCore;
@@ -32,6 +33,7 @@ public:
 
 private:
     DebugPadState next_state{};
+    LifoWriteTracker lifo_tracker{};
     Core::HID::EmulatedController* controller = nullptr;
 };
 } // namespace Service::HID
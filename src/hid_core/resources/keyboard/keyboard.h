@@ -5,6 +5,7 @@
 
 #include "hid_core/resources/controller_base.h"
 #include "hid_core/resources/keyboard/keyboard_types.h"
+#include "hid_core/resources/ring_lifo.h"
 
 namespace Core::HID {
 class HIDCore;
@@ -28,6 +29,7 @@ public:
 
 private:
     KeyboardState next_state{};
+    LifoWriteTracker lifo_tracker{};
     Core::HID::EmulatedDevices* emulated_devices = nullptr;
 };
 } // namespace Service::HID
@@ -5,6 +5,7 @@
 
 #include "hid_core/hid_types.h"
 #include "hid_core/resources/controller_base.h"
+#include "hid_core/resources/ring_lifo.h"
 
 namespace Core::HID {
 class HIDCore;
@@ -28,6 +29,7 @@ public:
 
 private:
     Core::HID::MouseState next_state{};
+    LifoWriteTracker lifo_tracker{};
     Core::HID::AnalogStickState last_mouse_wheel_state{};
     Core::HID::EmulatedDevices* emulated_devices = nullptr;
 };
@@ -346,6 +346,7 @@ void NPad::InitNewlyAddedController(u64 aruid, Core::HID::NpadIdType npad_id) {
     }
 
     controller.is_connected = true;
+    controller.input_write_count = InvalidInputWriteCount;
     controller.device->Connect();
     controller.device->SetLedPattern();
     if (controller_type == Core::HID::NpadStyleIndex::JoyconDual) {
@@ -389,19 +390,21 @@ void NPad::WriteEmptyEntry(NpadInternalState* npad) {
     npad->gc_trigger_lifo.WriteNextEntry(dummy_gc_state);
 }
 
-void NPad::RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id) {
+void NPad::RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id,
+                                 const Core::HID::ControllerInputState& input_state,
+                                 u64 input_write_count) {
     std::scoped_lock lock{*applet_resource_holder.shared_mutex};
     auto& controller = GetControllerFromNpadIdType(aruid, npad_id);
-    const auto controller_type = controller.device->GetNpadStyleIndex();
+    const auto controller_type = input_state.npad_type;
 
-    if (!controller.device->IsConnected() && controller.is_connected) {
+    if (!input_state.is_connected && controller.is_connected) {
         DisconnectNpad(aruid, npad_id);
         return;
     }
-    if (!controller.device->IsConnected()) {
+    if (!input_state.is_connected) {
         return;
     }
-    if (controller.device->IsConnected() && !controller.is_connected) {
+    if (!controller.is_connected) {
         InitNewlyAddedController(aruid, npad_id);
     }
 
@@ -410,8 +413,18 @@ void NPad::RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id) {
 
     auto& pad_entry = controller.npad_pad_state;
     auto& trigger_entry = controller.npad_trigger_state;
-    const auto button_state = controller.device->GetNpadButtons();
-    const auto stick_state = controller.device->GetSticks();
+    // Nothing was published since the pad state was built, unless turbo buttons toggled
+    if (input_write_count == controller.input_write_count &&
+        input_state.turbo_buttons == Core::HID::NpadButton::None) {
+        if (pad_entry.npad_buttons.raw != Core::HID::NpadButton::None) {
+            hid_core.SetLastActiveController(npad_id);
+        }
+        return;
+    }
+    controller.input_write_count = input_write_count;
+    // Read the buttons again, as the status update may have toggled the turbo buttons
+    const auto button_state = controller.device->GetInputState().npad_buttons;
+    const auto& stick_state = input_state.sticks;
 
     using btn = Core::HID::NpadButton;
     pad_entry.npad_buttons.raw = btn::None;
@@ -444,7 +457,7 @@ void NPad::RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id) {
     }
 
     if (controller_type == Core::HID::NpadStyleIndex::GameCube) {
-        const auto& trigger_state = controller.device->GetTriggers();
+        const auto& trigger_state = input_state.gc_triggers;
         trigger_entry.l_analog = trigger_state.left;
         trigger_entry.r_analog = trigger_state.right;
         pad_entry.npad_buttons.zl.Assign(false);
@@ -485,10 +498,13 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                 &data->shared_memory_format->npad.npad_entry[i].internal_state;
             auto* npad = controller.shared_memory;
 
-            const auto& controller_type = controller.device->GetNpadStyleIndex();
+            // Read without locking the controller, which input drivers may be updating. The count
+            // is read first, so the state is never older than the count it is recorded with.
+            const u64 input_write_count = controller.device->GetInputStateWriteCount();
+            const auto input_state = controller.device->GetInputState();
+            const auto controller_type = input_state.npad_type;
 
-            if (controller_type == Core::HID::NpadStyleIndex::None ||
-                !controller.device->IsConnected()) {
+            if (controller_type == Core::HID::NpadStyleIndex::None || !input_state.is_connected) {
                 continue;
             }
 
@@ -500,7 +516,7 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                 continue;
             }
 
-            RequestPadStateUpdate(aruid, controller.device->GetNpadIdType());
+            RequestPadStateUpdate(aruid, IndexToNpadIdType(i), input_state, input_write_count);
             auto& pad_state = controller.npad_pad_state;
             auto& libnx_state = controller.npad_libnx_state;
             auto& trigger_state = controller.npad_trigger_state;
@@ -525,7 +541,7 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                 libnx_state.connection_status.is_wired.Assign(1);
                 pad_state.sampling_number =
                     npad->fullkey_lifo.ReadCurrentEntry().state.sampling_number + 1;
-                npad->fullkey_lifo.WriteNextEntry(pad_state);
+                npad->fullkey_lifo.WriteNextEntry(pad_state, controller.style_lifo_tracker);
                 break;
             case Core::HID::NpadStyleIndex::Handheld:
                 pad_state.connection_status.raw = 0;
@@ -543,7 +559,7 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                 libnx_state.connection_status.is_right_wired.Assign(1);
                 pad_state.sampling_number =
                     npad->handheld_lifo.ReadCurrentEntry().state.sampling_number + 1;
-                npad->handheld_lifo.WriteNextEntry(pad_state);
+                npad->handheld_lifo.WriteNextEntry(pad_state, controller.style_lifo_tracker);
                 break;
             case Core::HID::NpadStyleIndex::JoyconDual:
                 pad_state.connection_status.raw = 0;
@@ -559,7 +575,7 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
 
                 pad_state.sampling_number =
                     npad->joy_dual_lifo.ReadCurrentEntry().state.sampling_number + 1;
-                npad->joy_dual_lifo.WriteNextEntry(pad_state);
+                npad->joy_dual_lifo.WriteNextEntry(pad_state, controller.style_lifo_tracker);
                 break;
             case Core::HID::NpadStyleIndex::JoyconLeft:
                 pad_state.connection_status.raw = 0;
@@ -569,7 +585,7 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                 libnx_state.connection_status.is_left_connected.Assign(1);
                 pad_state.sampling_number =
                     npad->joy_left_lifo.ReadCurrentEntry().state.sampling_number + 1;
-                npad->joy_left_lifo.WriteNextEntry(pad_state);
+                npad->joy_left_lifo.WriteNextEntry(pad_state, controller.style_lifo_tracker);
                 break;
             case Core::HID::NpadStyleIndex::JoyconRight:
                 pad_state.connection_status.raw = 0;
@@ -579,7 +595,7 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                 libnx_state.connection_status.is_right_connected.Assign(1);
                 pad_state.sampling_number =
                     npad->joy_right_lifo.ReadCurrentEntry().state.sampling_number + 1;
-                npad->joy_right_lifo.WriteNextEntry(pad_state);
+                npad->joy_right_lifo.WriteNextEntry(pad_state, controller.style_lifo_tracker);
                 break;
             case Core::HID::NpadStyleIndex::GameCube:
                 pad_state.connection_status.raw = 0;
@@ -591,15 +607,16 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                     npad->fullkey_lifo.ReadCurrentEntry().state.sampling_number + 1;
                 trigger_state.sampling_number =
                     npad->gc_trigger_lifo.ReadCurrentEntry().state.sampling_number + 1;
-                npad->fullkey_lifo.WriteNextEntry(pad_state);
-                npad->gc_trigger_lifo.WriteNextEntry(trigger_state);
+                npad->fullkey_lifo.WriteNextEntry(pad_state, controller.style_lifo_tracker);
+                npad->gc_trigger_lifo.WriteNextEntry(trigger_state,
+                                                     controller.gc_trigger_lifo_tracker);
                 break;
             case Core::HID::NpadStyleIndex::Pokeball:
                 pad_state.connection_status.raw = 0;
                 pad_state.connection_status.is_connected.Assign(1);
                 pad_state.sampling_number =
                     npad->palma_lifo.ReadCurrentEntry().state.sampling_number + 1;
-                npad->palma_lifo.WriteNextEntry(pad_state);
+                npad->palma_lifo.WriteNextEntry(pad_state, controller.style_lifo_tracker);
                 break;
             default:
                 break;
@@ -610,7 +627,7 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
             libnx_state.r_stick = pad_state.r_stick;
             libnx_state.sampling_number =
                 npad->system_ext_lifo.ReadCurrentEntry().state.sampling_number + 1;
-            npad->system_ext_lifo.WriteNextEntry(libnx_state);
+            npad->system_ext_lifo.WriteNextEntry(libnx_state, controller.system_ext_lifo_tracker);
 
             press_state |= static_cast<u64>(pad_state.npad_buttons.raw);
         }
@@ -15,6 +15,7 @@
 #include "hid_core/resources/npad/npad_resource.h"
 #include "hid_core/resources/npad/npad_types.h"
 #include "hid_core/resources/npad/npad_vibration.h"
+#include "hid_core/resources/ring_lifo.h"
 #include "hid_core/resources/vibration/gc_vibration_device.h"
 #include "hid_core/resources/vibration/n64_vibration_device.h"
 #include "hid_core/resources/vibration/vibration_base.h"
@@ -23,6 +24,7 @@
 namespace Core::HID {
 class EmulatedController;
 enum class ControllerTriggerType;
+struct ControllerInputState;
 } // namespace Core::HID
 
 namespace Kernel {
@@ -162,6 +164,8 @@ public:
     void EnableAppletToGetInput(u64 aruid);
 
 private:
+    static constexpr u64 InvalidInputWriteCount = ~u64{};
+
     struct NpadControllerData {
         NpadInternalState* shared_memory = nullptr;
         Core::HID::EmulatedController* device = nullptr;
@@ -178,11 +182,21 @@ private:
         NPadGenericState npad_libnx_state{};
         NpadGcTriggerState npad_trigger_state{};
         int callback_key{};
+
+        // Input state write count of the device the pad state was last built from
+        u64 input_write_count{InvalidInputWriteCount};
+
+        // Writes to the lifos of the pad state, which is written to the lifo of its style
+        LifoWriteTracker style_lifo_tracker{};
+        LifoWriteTracker system_ext_lifo_tracker{};
+        LifoWriteTracker gc_trigger_lifo_tracker{};
     };
 
     void ControllerUpdate(Core::HID::ControllerTriggerType type, std::size_t controller_idx);
     void InitNewlyAddedController(u64 aruid, Core::HID::NpadIdType npad_id);
-    void RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id);
+    void RequestPadStateUpdate(u64 aruid, Core::HID::NpadIdType npad_id,
+                               const Core::HID::ControllerInputState& input_state,
+                               u64 input_write_count);
     void WriteEmptyEntry(NpadInternalState* npad);
 
     NpadControllerData& GetControllerFromHandle(
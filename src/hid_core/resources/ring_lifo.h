@@ -4,11 +4,23 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 
 #include "common/common_types.h"
 
 namespace Service::HID {
 
+/// Host side record of the last entry a resource wrote to a lifo, used to tell whether the
+/// entries of the lifo still hold what the resource wrote to them
+struct LifoWriteTracker {
+    const void* lifo{};
+    s64 buffer_tail{};
+    s64 buffer_count{};
+    s64 sampling_number{};
+    /// Number of entries written in a row with the same state as the entry before them
+    std::size_t unchanged_count{};
+};
+
 template <typename State>
 struct AtomicStorage {
     s64 sampling_number;
@@ -48,6 +60,62 @@ struct Lifo {
         entries[buffer_tail].sampling_number = previous_entry.sampling_number + 1;
         entries[buffer_tail].state = new_state;
     }
+
+    /**
+     * Writes the next entry, like WriteNextEntry, but once the same state was written to every
+     * entry only updates the sampling numbers of the next entry instead of copying the state.
+     *
+     * @param new_state - State to write.
+     * @param tracker - Record of the writes of the resource to this lifo.
+     * @returns Whether the state differs from the current entry, ignoring sampling numbers.
+     */
+    bool WriteNextEntry(const State& new_state, LifoWriteTracker& tracker) {
+        // The lifo may have been cleared or written by something else since the last write
+        const bool is_tracked = tracker.lifo == this && tracker.buffer_tail == buffer_tail &&
+                                tracker.buffer_count == buffer_count &&
+                                tracker.sampling_number == ReadCurrentEntry().sampling_number;
+        const bool has_changed = !IsSameState(ReadCurrentEntry().state, new_state);
+
+        if (!is_tracked || has_changed) {
+            tracker.unchanged_count = 0;
+            WriteNextEntry(new_state);
+        } else if (tracker.unchanged_count < max_buffer_size - 1) {
+            tracker.unchanged_count++;
+            WriteNextEntry(new_state);
+        } else {
+            if (buffer_count < static_cast<s64>(max_buffer_size) - 1) {
+                buffer_count++;
+            }
+            buffer_tail = GetNextEntryIndex();
+            const auto& previous_entry = ReadPreviousEntry();
+            entries[buffer_tail].sampling_number = previous_entry.sampling_number + 1;
+            if constexpr (requires { new_state.sampling_number; }) {
+                entries[buffer_tail].state.sampling_number = new_state.sampling_number;
+            }
+        }
+
+        tracker.lifo = this;
+        tracker.buffer_tail = buffer_tail;
+        tracker.buffer_count = buffer_count;
+        tracker.sampling_number = ReadCurrentEntry().sampling_number;
+        return has_changed;
+    }
+
+private:
+    static bool IsSameState(const State& state, const State& new_state) {
+        const auto* const lhs = reinterpret_cast<const u8*>(&state);
+        const auto* const rhs = reinterpret_cast<const u8*>(&new_state);
+        if constexpr (requires { new_state.sampling_number; }) {
+            // Compares the bytes around the sampling number
+            const std::size_t begin = static_cast<std::size_t>(
+                reinterpret_cast<const u8*>(&new_state.sampling_number) - rhs);
+            const std::size_t end = begin + sizeof(new_state.sampling_number);
+            return std::memcmp(lhs, rhs, begin) == 0 &&
+                   std::memcmp(lhs + end, rhs + end, sizeof(State) - end) == 0;
+        } else {
+            return std::memcmp(lhs, rhs, sizeof(State)) == 0;
+        }
+    }
 };
 
 } // namespace Service::HID
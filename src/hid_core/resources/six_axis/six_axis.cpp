@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <chrono>
+
 #include "common/common_types.h"
 #include "core/core_timing.h"
 #include "hid_core/frontend/emulated_controller.h"
@@ -28,6 +30,7 @@ void SixAxis::OnRelease() {}
 
 void SixAxis::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
     std::scoped_lock shared_lock{*shared_mutex};
+    const auto sampling_time = std::chrono::steady_clock::now();
 
     for (std::size_t aruid_index = 0; aruid_index < AruidIndexMax; ++aruid_index) {
         const auto* data = applet_resource->GetAruidDataByIndex(aruid_index);
@@ -54,13 +57,15 @@ void SixAxis::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                 continue;
             }
 
-            const auto& motion_state = controller.device->GetMotions();
+            // Resampled at the time of this update, evening out the jitter of the sensors
+            const auto motion_state = controller.device->GetMotions(sampling_time);
             auto& sixaxis_fullkey_state = controller.sixaxis_fullkey_state;
             auto& sixaxis_handheld_state = controller.sixaxis_handheld_state;
             auto& sixaxis_dual_left_state = controller.sixaxis_dual_left_state;
             auto& sixaxis_dual_right_state = controller.sixaxis_dual_right_state;
             auto& sixaxis_left_lifo_state = controller.sixaxis_left_lifo_state;
             auto& sixaxis_right_lifo_state = controller.sixaxis_right_lifo_state;
+            auto& lifo_trackers = controller.lifo_trackers[aruid_index];
 
             auto& sixaxis_fullkey_lifo = shared_memory.internal_state.sixaxis_fullkey_lifo;
             auto& sixaxis_handheld_lifo = shared_memory.internal_state.sixaxis_handheld_lifo;
@@ -159,16 +164,20 @@ void SixAxis::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
 
             if (IndexToNpadIdType(i) == Core::HID::NpadIdType::Handheld) {
                 // This buffer only is updated on handheld on HW
-                sixaxis_handheld_lifo.lifo.WriteNextEntry(sixaxis_handheld_state);
+                sixaxis_handheld_lifo.lifo.WriteNextEntry(sixaxis_handheld_state,
+                                                          lifo_trackers.handheld);
             } else {
                 // Handheld doesn't update this buffer on HW
-                sixaxis_fullkey_lifo.lifo.WriteNextEntry(sixaxis_fullkey_state);
+                sixaxis_fullkey_lifo.lifo.WriteNextEntry(sixaxis_fullkey_state,
+                                                         lifo_trackers.fullkey);
             }
 
-            sixaxis_dual_left_lifo.lifo.WriteNextEntry(sixaxis_dual_left_state);
-            sixaxis_dual_right_lifo.lifo.WriteNextEntry(sixaxis_dual_right_state);
-            sixaxis_left_lifo.lifo.WriteNextEntry(sixaxis_left_lifo_state);
-            sixaxis_right_lifo.lifo.WriteNextEntry(sixaxis_right_lifo_state);
+            sixaxis_dual_left_lifo.lifo.WriteNextEntry(sixaxis_dual_left_state,
+                                                       lifo_trackers.dual_left);
+            sixaxis_dual_right_lifo.lifo.WriteNextEntry(sixaxis_dual_right_state,
+                                                        lifo_trackers.dual_right);
+            sixaxis_left_lifo.lifo.WriteNextEntry(sixaxis_left_lifo_state, lifo_trackers.left);
+            sixaxis_right_lifo.lifo.WriteNextEntry(sixaxis_right_lifo_state, lifo_trackers.right);
         }
     }
 }
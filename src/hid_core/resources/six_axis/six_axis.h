@@ -70,6 +70,16 @@ private:
             Core::HID::GyroscopeZeroDriftMode::Standard};
     };
 
+    // Writes to the lifos of a controller in the shared memory of an applet
+    struct SixaxisLifoTrackers {
+        LifoWriteTracker fullkey{};
+        LifoWriteTracker handheld{};
+        LifoWriteTracker dual_left{};
+        LifoWriteTracker dual_right{};
+        LifoWriteTracker left{};
+        LifoWriteTracker right{};
+    };
+
     struct NpadControllerData {
         Core::HID::EmulatedController* device = nullptr;
 
@@ -92,6 +102,8 @@ private:
         Core::HID::SixAxisSensorState sixaxis_left_lifo_state{};
         Core::HID::SixAxisSensorState sixaxis_right_lifo_state{};
         int callback_key{};
+
+        std::array<SixaxisLifoTrackers, AruidIndexMax> lifo_trackers{};
     };
 
     SixaxisParameters& GetSixaxisState(const Core::HID::SixAxisSensorHandle& device_handle);
@@ -10,6 +10,7 @@
 #include "common/point.h"
 #include "core/hle/result.h"
 #include "hid_core/hid_types.h"
+#include "hid_core/resources/ring_lifo.h"
 #include "hid_core/resources/touch_screen/gesture_handler.h"
 #include "hid_core/resources/touch_screen/touch_types.h"
 
@@ -114,6 +115,7 @@ private:
     AutoPilotState auto_pilot{};
     GestureHandler gesture_handler{};
     std::array<TouchAruidData, 0x20> aruid_data{};
+    std::array<LifoWriteTracker, 0x20> touch_lifo_trackers{};
     Common::Point<f32> magnification{1.0f, 1.0f};
     Common::Point<f32> offset{0.0f, 0.0f};
     Core::HID::TouchScreenModeForNx default_touch_screen_mode{
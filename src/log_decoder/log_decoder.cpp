@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/logging/binary_log_file.h"
+
+// Converts a binary log, written with binary logging enabled, to the text log format
+
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        fmt::print(stderr, "Usage: {} <yuzu_log.bin> [output.txt]\n", argv[0]);
+        fmt::print(stderr, "Writes the log as text to the output file, or stdout if omitted.\n");
+        return 1;
+    }
+
+    std::string text;
+    const bool complete{Common::Log::DecodeBinaryLog(argv[1], text)};
+    if (argc == 3) {
+        if (Common::FS::WriteStringToFile(argv[2], Common::FS::FileType::TextFile, text) !=
+            text.size()) {
+            fmt::print(stderr, "Failed to write {}\n", argv[2]);
+            return 1;
+        }
+    } else {
+        std::fwrite(text.data(), 1, text.size(), stdout);
+    }
+    if (!complete) {
+        // Logs cut short by a crash still decode up to the last whole message
+        fmt::print(stderr, "{} is not a binary log or is truncated\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
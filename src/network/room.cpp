@@ -3,6 +3,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstring>
 #include <iomanip>
 #include <mutex>
 #include <random>
@@ -10,7 +13,10 @@
 #include <shared_mutex>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
 #include "common/logging/log.h"
+#include "common/polyfill_thread.h"
+#include "common/thread.h"
 #include "enet/enet.h"
 #include "network/packet.h"
 #include "network/room.h"
@@ -44,21 +50,75 @@ public:
     MemberList members;                     ///< Information about the members of this room
     mutable std::shared_mutex member_mutex; ///< Mutex for locking the members list
 
+    /// Positions in the members list by fake IP, nickname and peer, guarded by member_mutex
+    std::unordered_map<u32, std::size_t> member_index_by_ip;
+    std::unordered_map<std::string, std::size_t> member_index_by_nickname;
+    std::unordered_map<const ENetPeer*, std::size_t> member_index_by_peer;
+
     UsernameBanList username_ban_list; ///< List of banned usernames
     IPBanList ip_ban_list;             ///< List of banned IP addresses
     mutable std::mutex ban_list_mutex; ///< Mutex for the ban lists
 
-    RoomImpl() : random_gen(std::random_device()()) {}
+    explicit RoomImpl(std::shared_ptr<RoomWorkerPool> worker_pool_)
+        : random_gen(std::random_device()()), worker_pool{std::move(worker_pool_)} {}
 
-    /// Thread that receives and dispatches network packets
-    std::unique_ptr<std::thread> room_thread;
+    /// Pool of the thread that receives and dispatches network packets
+    std::shared_ptr<RoomWorkerPool> worker_pool;
+    /// Whether worker_pool was created for this room alone, when it was created
+    bool owns_worker_pool = false;
 
     /// Verification backend of the room
     std::unique_ptr<VerifyUser::Backend> verify_backend;
 
-    /// Thread function that will receive and dispatch messages until the room is destroyed.
-    void ServerLoop();
-    void StartLoop();
+    /**
+     * Dispatches the messages received so far, then sends all the packets they produced at once.
+     * Called by the worker thread of the room.
+     */
+    void Service();
+
+    /// Dispatches a single event received by the server.
+    void HandleEvent(const ENetEvent& event);
+
+    /// Gets the key of a fake ip address in member_index_by_ip.
+    static u32 IPKey(const IPv4Address& address) {
+        return std::bit_cast<u32>(address);
+    }
+
+    /**
+     * Finds a member by one of its indices. member_mutex must be held.
+     * @return An iterator to the member, or members.end() if there is none
+     */
+    template <typename Self, typename Key>
+    static auto FindMember(Self& self, const std::unordered_map<Key, std::size_t>& index,
+                           const Key& key) {
+        const auto it = index.find(key);
+        return it == index.end() ? self.members.end() : self.members.begin() + it->second;
+    }
+
+    MemberList::iterator FindMemberByIP(const IPv4Address& address) {
+        return FindMember(*this, member_index_by_ip, IPKey(address));
+    }
+    MemberList::const_iterator FindMemberByIP(const IPv4Address& address) const {
+        return FindMember(*this, member_index_by_ip, IPKey(address));
+    }
+    MemberList::iterator FindMemberByNickname(const std::string& nickname) {
+        return FindMember(*this, member_index_by_nickname, nickname);
+    }
+    MemberList::const_iterator FindMemberByNickname(const std::string& nickname) const {
+        return FindMember(*this, member_index_by_nickname, nickname);
+    }
+    MemberList::iterator FindMemberByPeer(const ENetPeer* peer) {
+        return FindMember(*this, member_index_by_peer, peer);
+    }
+    MemberList::const_iterator FindMemberByPeer(const ENetPeer* peer) const {
+        return FindMember(*this, member_index_by_peer, peer);
+    }
+
+    /// Adds a member to the members list and its indices. member_mutex must be held.
+    void AddMember(Member&& member);
+
+    /// Removes a member from the members list and its indices. member_mutex must be held.
+    void EraseMember(MemberList::iterator member);
 
     /**
      * Parses and answers a room join request from a client.
@@ -217,6 +277,17 @@ public:
      */
     void HandleLdnPacket(const ENetEvent* event);
 
+    /**
+     * Sends a received packet unchanged to its destination, or to all members except the sender
+     * if it is a broadcast. Only the routing fields are read, and the received ENet packet is
+     * sent as is, so forwarding neither copies nor allocates.
+     * @param event The ENet event containing the packet
+     * @param remote_ip_offset Offset of the IPv4Address of the destination in the packet
+     * @param broadcast_offset Offset of the broadcast flag in the packet
+     */
+    void ForwardPacket(const ENetEvent* event, std::size_t remote_ip_offset,
+                       std::size_t broadcast_offset);
+
     /**
      * Extracts a chat entry from a received ENet packet and adds it to the chat queue.
      * @param event The ENet event that was received.
@@ -236,60 +307,211 @@ public:
     void HandleClientDisconnection(ENetPeer* client);
 };
 
-// RoomImpl
-void Room::RoomImpl::ServerLoop() {
-    while (state != State::Closed) {
-        ENetEvent event;
-        if (enet_host_service(server, &event, 5) > 0) {
-            switch (event.type) {
-            case ENET_EVENT_TYPE_RECEIVE:
-                switch (event.packet->data[0]) {
-                case IdJoinRequest:
-                    HandleJoinRequest(&event);
-                    break;
-                case IdSetGameInfo:
-                    HandleGameInfoPacket(&event);
-                    break;
-                case IdProxyPacket:
-                    HandleProxyPacket(&event);
-                    break;
-                case IdLdnPacket:
-                    HandleLdnPacket(&event);
-                    break;
-                case IdChatMessage:
-                    HandleChatPacket(&event);
-                    break;
-                // Moderation
-                case IdModKick:
-                    HandleModKickPacket(&event);
-                    break;
-                case IdModBan:
-                    HandleModBanPacket(&event);
-                    break;
-                case IdModUnban:
-                    HandleModUnbanPacket(&event);
-                    break;
-                case IdModGetBanList:
-                    HandleModGetBanListPacket(&event);
-                    break;
+// RoomWorkerPool
+class RoomWorkerPool::Impl {
+public:
+    explicit Impl(std::size_t num_threads) {
+        workers.resize(num_threads);
+        for (auto& worker : workers) {
+            worker = std::make_unique<Worker>();
+            worker->thread = std::jthread(
+                [worker = worker.get()](std::stop_token stop_token) { worker->Run(stop_token); });
+        }
+    }
+
+    /// Starts servicing a room on the thread with the fewest rooms
+    void Add(Room::RoomImpl* room) {
+        std::scoped_lock lock{mutex};
+        const auto worker = std::ranges::min_element(
+            workers, {}, [](const auto& entry) { return entry->num_rooms; });
+        ++(*worker)->num_rooms;
+        room_workers.emplace(room, worker->get());
+        (*worker)->Add(room);
+    }
+
+    /// Stops servicing a room, returning once its thread no longer uses it
+    void Remove(Room::RoomImpl* room) {
+        std::scoped_lock lock{mutex};
+        const auto it = room_workers.find(room);
+        if (it == room_workers.end()) {
+            return;
+        }
+        --it->second->num_rooms;
+        it->second->Remove(room);
+        room_workers.erase(it);
+    }
+
+    std::size_t GetNumThreads() const {
+        return workers.size();
+    }
+
+private:
+    struct Worker {
+        /// The longest a thread waits for packets before servicing the timers of its rooms
+        static constexpr u32 ServiceIntervalMs = 5;
+
+        void Add(Room::RoomImpl* room) {
+            std::scoped_lock lock{mutex};
+            rooms.push_back(room);
+            cv.notify_all();
+        }
+
+        void Remove(Room::RoomImpl* room) {
+            std::unique_lock lock{mutex};
+            pending_removals.push_back(room);
+            cv.notify_all();
+            // The thread drops the room at the start of its next iteration
+            cv.wait(lock, [this, room] {
+                return std::find(rooms.begin(), rooms.end(), room) == rooms.end();
+            });
+        }
+
+        void Run(std::stop_token stop_token) {
+            Common::SetCurrentThreadName("RoomWorker");
+            std::vector<Room::RoomImpl*> serviced_rooms;
+            while (!stop_token.stop_requested()) {
+                {
+                    std::unique_lock lock{mutex};
+                    if (!pending_removals.empty()) {
+                        std::erase_if(rooms, [this](Room::RoomImpl* room) {
+                            return std::find(pending_removals.begin(), pending_removals.end(),
+                                             room) != pending_removals.end();
+                        });
+                        pending_removals.clear();
+                        cv.notify_all();
+                    }
+                    Common::CondvarWait(cv, lock, stop_token, [this] {
+                        return !rooms.empty() || !pending_removals.empty();
+                    });
+                    serviced_rooms = rooms;
+                }
+                if (serviced_rooms.empty()) {
+                    continue;
+                }
+
+                // Wait for any of the rooms to receive a packet
+                ENetSocketSet read_set;
+                ENET_SOCKETSET_EMPTY(read_set);
+                ENetSocket max_socket{};
+                for (const auto* room : serviced_rooms) {
+                    ENET_SOCKETSET_ADD(read_set, room->server->socket);
+                    max_socket = std::max(max_socket, room->server->socket);
+                }
+                enet_socketset_select(max_socket, &read_set, nullptr, ServiceIntervalMs);
+
+                for (auto* room : serviced_rooms) {
+                    room->Service();
                 }
-                enet_packet_destroy(event.packet);
-                break;
-            case ENET_EVENT_TYPE_DISCONNECT:
-                HandleClientDisconnection(event.peer);
-                break;
-            case ENET_EVENT_TYPE_NONE:
-            case ENET_EVENT_TYPE_CONNECT:
-                break;
             }
         }
+
+        std::mutex mutex;
+        std::condition_variable_any cv;
+        /// Rooms serviced by the thread, guarded by mutex
+        std::vector<Room::RoomImpl*> rooms;
+        /// Rooms to stop servicing, guarded by mutex
+        std::vector<Room::RoomImpl*> pending_removals;
+        /// Number of rooms assigned to the thread, guarded by the pool mutex
+        std::size_t num_rooms = 0;
+        std::jthread thread;
+    };
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unordered_map<Room::RoomImpl*, Worker*> room_workers;
+};
+
+RoomWorkerPool::RoomWorkerPool(std::size_t num_threads)
+    : impl{std::make_unique<Impl>(
+          num_threads != 0 ? num_threads
+                           : std::max<std::size_t>(std::thread::hardware_concurrency(), 1))} {}
+
+RoomWorkerPool::~RoomWorkerPool() = default;
+
+std::size_t RoomWorkerPool::GetNumThreads() const {
+    return impl->GetNumThreads();
+}
+
+// RoomImpl
+void Room::RoomImpl::Service() {
+    // Bound the number of events handled at once, so a busy room can not starve the other rooms
+    // serviced by the same thread
+    constexpr int MaxEventsPerService = 1024;
+
+    ENetEvent event;
+    for (int i = 0; i < MaxEventsPerService && enet_host_service(server, &event, 0) > 0; ++i) {
+        HandleEvent(event);
+    }
+    enet_host_flush(server);
+}
+
+void Room::RoomImpl::HandleEvent(const ENetEvent& event) {
+    switch (event.type) {
+    case ENET_EVENT_TYPE_RECEIVE:
+        switch (event.packet->data[0]) {
+        case IdJoinRequest:
+            HandleJoinRequest(&event);
+            break;
+        case IdSetGameInfo:
+            HandleGameInfoPacket(&event);
+            break;
+        case IdProxyPacket:
+            HandleProxyPacket(&event);
+            break;
+        case IdLdnPacket:
+            HandleLdnPacket(&event);
+            break;
+        case IdChatMessage:
+            HandleChatPacket(&event);
+            break;
+        // Moderation
+        case IdModKick:
+            HandleModKickPacket(&event);
+            break;
+        case IdModBan:
+            HandleModBanPacket(&event);
+            break;
+        case IdModUnban:
+            HandleModUnbanPacket(&event);
+            break;
+        case IdModGetBanList:
+            HandleModGetBanListPacket(&event);
+            break;
+        }
+        // Forwarded packets are destroyed by ENet once they have been sent to every peer
+        if (event.packet->referenceCount == 0) {
+            enet_packet_destroy(event.packet);
+        }
+        break;
+    case ENET_EVENT_TYPE_DISCONNECT:
+        HandleClientDisconnection(event.peer);
+        break;
+    case ENET_EVENT_TYPE_NONE:
+    case ENET_EVENT_TYPE_CONNECT:
+        break;
     }
-    // Close the connection to all members:
-    SendCloseMessage();
 }
 
-void Room::RoomImpl::StartLoop() {
-    room_thread = std::make_unique<std::thread>(&Room::RoomImpl::ServerLoop, this);
+void Room::RoomImpl::AddMember(Member&& member) {
+    const std::size_t index = members.size();
+    member_index_by_ip.emplace(IPKey(member.fake_ip), index);
+    member_index_by_nickname.emplace(member.nickname, index);
+    member_index_by_peer.emplace(member.peer, index);
+    members.push_back(std::move(member));
+}
+
+void Room::RoomImpl::EraseMember(MemberList::iterator member) {
+    members.erase(member);
+
+    // Members only leave occasionally, so the indices are rebuilt rather than adjusted
+    member_index_by_ip.clear();
+    member_index_by_nickname.clear();
+    member_index_by_peer.clear();
+    for (std::size_t index = 0; index < members.size(); ++index) {
+        member_index_by_ip.emplace(IPKey(members[index].fake_ip), index);
+        member_index_by_nickname.emplace(members[index].nickname, index);
+        member_index_by_peer.emplace(members[index].peer, index);
+    }
 }
 
 void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
@@ -386,7 +608,7 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
 
     {
         std::lock_guard lock(member_mutex);
-        members.push_back(std::move(member));
+        AddMember(std::move(member));
     }
 
     // Notify everyone that the room information has changed.
@@ -414,9 +636,7 @@ void Room::RoomImpl::HandleModKickPacket(const ENetEvent* event) {
     std::string username, ip;
     {
         std::lock_guard lock(member_mutex);
-        const auto target_member =
-            std::find_if(members.begin(), members.end(),
-                         [&nickname](const auto& member) { return member.nickname == nickname; });
+        const auto target_member = FindMemberByNickname(nickname);
         if (target_member == members.end()) {
             SendModNoSuchUser(event->peer);
             return;
@@ -432,7 +652,7 @@ void Room::RoomImpl::HandleModKickPacket(const ENetEvent* event) {
         ip = ip_raw.data();
 
         enet_peer_disconnect(target_member->peer, 0);
-        members.erase(target_member);
+        EraseMember(target_member);
     }
 
     // Announce the change to all clients.
@@ -456,9 +676,7 @@ void Room::RoomImpl::HandleModBanPacket(const ENetEvent* event) {
     std::string username, ip;
     {
         std::lock_guard lock(member_mutex);
-        const auto target_member =
-            std::find_if(members.begin(), members.end(),
-                         [&nickname](const auto& member) { return member.nickname == nickname; });
+        const auto target_member = FindMemberByNickname(nickname);
         if (target_member == members.end()) {
             SendModNoSuchUser(event->peer);
             return;
@@ -475,7 +693,7 @@ void Room::RoomImpl::HandleModBanPacket(const ENetEvent* event) {
         ip = ip_raw.data();
 
         enet_peer_disconnect(target_member->peer, 0);
-        members.erase(target_member);
+        EraseMember(target_member);
     }
 
     {
@@ -555,22 +773,18 @@ bool Room::RoomImpl::IsValidNickname(const std::string& nickname) const {
         return false;
 
     std::lock_guard lock(member_mutex);
-    return std::all_of(members.begin(), members.end(),
-                       [&nickname](const auto& member) { return member.nickname != nickname; });
+    return FindMemberByNickname(nickname) == members.end();
 }
 
 bool Room::RoomImpl::IsValidFakeIPAddress(const IPv4Address& address) const {
     // An IP address is valid if it is not already taken by anybody else in the room.
     std::lock_guard lock(member_mutex);
-    return std::all_of(members.begin(), members.end(),
-                       [&address](const auto& member) { return member.fake_ip != address; });
+    return FindMemberByIP(address) == members.end();
 }
 
 bool Room::RoomImpl::HasModPermission(const ENetPeer* client) const {
     std::lock_guard lock(member_mutex);
-    const auto sending_member =
-        std::find_if(members.begin(), members.end(),
-                     [client](const auto& member) { return member.peer == client; });
+    const auto sending_member = FindMemberByPeer(client);
     if (sending_member == members.end()) {
         return false;
     }
@@ -594,7 +808,6 @@ void Room::RoomImpl::SendNameCollision(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendIPCollision(ENetPeer* client) {
@@ -604,7 +817,6 @@ void Room::RoomImpl::SendIPCollision(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendWrongPassword(ENetPeer* client) {
@@ -614,7 +826,6 @@ void Room::RoomImpl::SendWrongPassword(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendRoomIsFull(ENetPeer* client) {
@@ -624,7 +835,6 @@ void Room::RoomImpl::SendRoomIsFull(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendVersionMismatch(ENetPeer* client) {
@@ -635,7 +845,6 @@ void Room::RoomImpl::SendVersionMismatch(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendJoinSuccess(ENetPeer* client, IPv4Address fake_ip) {
@@ -645,7 +854,6 @@ void Room::RoomImpl::SendJoinSuccess(ENetPeer* client, IPv4Address fake_ip) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendJoinSuccessAsMod(ENetPeer* client, IPv4Address fake_ip) {
@@ -655,7 +863,6 @@ void Room::RoomImpl::SendJoinSuccessAsMod(ENetPeer* client, IPv4Address fake_ip)
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendUserKicked(ENetPeer* client) {
@@ -665,7 +872,6 @@ void Room::RoomImpl::SendUserKicked(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendUserBanned(ENetPeer* client) {
@@ -675,7 +881,6 @@ void Room::RoomImpl::SendUserBanned(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendModPermissionDenied(ENetPeer* client) {
@@ -685,7 +890,6 @@ void Room::RoomImpl::SendModPermissionDenied(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendModNoSuchUser(ENetPeer* client) {
@@ -695,7 +899,6 @@ void Room::RoomImpl::SendModNoSuchUser(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendModBanListResponse(ENetPeer* client) {
@@ -710,7 +913,6 @@ void Room::RoomImpl::SendModBanListResponse(ENetPeer* client) {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_peer_send(client, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendCloseMessage() {
@@ -745,7 +947,6 @@ void Room::RoomImpl::SendStatusMessage(StatusMessageTypes type, const std::strin
             enet_peer_send(member.peer, 0, enet_packet);
         }
     }
-    enet_host_flush(server);
 
     const std::string display_name =
         username.empty() ? nickname : fmt::format("{} ({})", nickname, username);
@@ -779,9 +980,9 @@ void Room::RoomImpl::BroadcastRoomInformation() {
     packet.Write(room_information.preferred_game.name);
     packet.Write(room_information.host_username);
 
-    packet.Write(static_cast<u32>(members.size()));
     {
         std::lock_guard lock(member_mutex);
+        packet.Write(static_cast<u32>(members.size()));
         for (const auto& member : members) {
             packet.Write(member.nickname);
             packet.Write(member.fake_ip);
@@ -797,7 +998,6 @@ void Room::RoomImpl::BroadcastRoomInformation() {
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
     enet_host_broadcast(server, 0, enet_packet);
-    enet_host_flush(server);
 }
 
 IPv4Address Room::RoomImpl::GenerateFakeIPAddress() {
@@ -813,115 +1013,58 @@ IPv4Address Room::RoomImpl::GenerateFakeIPAddress() {
 }
 
 void Room::RoomImpl::HandleProxyPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
-    in_packet.IgnoreBytes(sizeof(u8)); // Message type
-
-    in_packet.IgnoreBytes(sizeof(u8));          // Domain
-    in_packet.IgnoreBytes(sizeof(IPv4Address)); // IP
-    in_packet.IgnoreBytes(sizeof(u16));         // Port
-
-    in_packet.IgnoreBytes(sizeof(u8)); // Domain
-    IPv4Address remote_ip;
-    in_packet.Read(remote_ip);          // IP
-    in_packet.IgnoreBytes(sizeof(u16)); // Port
-
-    in_packet.IgnoreBytes(sizeof(u8)); // Protocol
-
-    bool broadcast;
-    in_packet.Read(broadcast); // Broadcast
-
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
-
-    const auto& destination_address = remote_ip;
-    if (broadcast) { // Send the data to everyone except the sender
-        std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
-        for (const auto& member : members) {
-            if (member.peer != event->peer) {
-                sent_packet = true;
-                enet_peer_send(member.peer, 0, enet_packet);
-            }
-        }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
-    } else { // Send the data only to the destination client
-        std::lock_guard lock(member_mutex);
-        auto member = std::find_if(members.begin(), members.end(),
-                                   [destination_address](const Member& member_entry) -> bool {
-                                       return member_entry.fake_ip == destination_address;
-                                   });
-        if (member != members.end()) {
-            enet_peer_send(member->peer, 0, enet_packet);
-        } else {
-            LOG_ERROR(Network,
-                      "Attempting to send to unknown IP address: "
-                      "{}.{}.{}.{}",
-                      destination_address[0], destination_address[1], destination_address[2],
-                      destination_address[3]);
-            enet_packet_destroy(enet_packet);
-        }
-    }
-    enet_host_flush(server);
+    // Message type, then the domain, IP and port of the local endpoint and the domain of the
+    // remote endpoint
+    constexpr std::size_t RemoteIPOffset = sizeof(u8) * 3 + sizeof(IPv4Address) + sizeof(u16);
+    // Remote IP, port and protocol
+    constexpr std::size_t BroadcastOffset =
+        RemoteIPOffset + sizeof(IPv4Address) + sizeof(u16) + sizeof(u8);
+    ForwardPacket(event, RemoteIPOffset, BroadcastOffset);
 }
 
 void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
-    Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
-
-    in_packet.IgnoreBytes(sizeof(u8)); // Message type
-
-    in_packet.IgnoreBytes(sizeof(u8));          // LAN packet type
-    in_packet.IgnoreBytes(sizeof(IPv4Address)); // Local IP
-
-    IPv4Address remote_ip;
-    in_packet.Read(remote_ip); // Remote IP
+    // Message type, LAN packet type and local IP
+    constexpr std::size_t RemoteIPOffset = sizeof(u8) * 2 + sizeof(IPv4Address);
+    constexpr std::size_t BroadcastOffset = RemoteIPOffset + sizeof(IPv4Address);
+    ForwardPacket(event, RemoteIPOffset, BroadcastOffset);
+}
 
-    bool broadcast;
-    in_packet.Read(broadcast); // Broadcast
+void Room::RoomImpl::ForwardPacket(const ENetEvent* event, std::size_t remote_ip_offset,
+                                   std::size_t broadcast_offset) {
+    ENetPacket* const enet_packet = event->packet;
+    if (enet_packet->dataLength <= broadcast_offset) {
+        LOG_ERROR(Network, "Received a truncated packet of {} bytes", enet_packet->dataLength);
+        return;
+    }
+    IPv4Address destination_address;
+    std::memcpy(destination_address.data(), enet_packet->data + remote_ip_offset,
+                destination_address.size());
+    const bool broadcast = enet_packet->data[broadcast_offset] != 0;
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
+    // Forwarded packets have always been sent reliably, whichever way they were received
+    enet_packet->flags |= ENET_PACKET_FLAG_RELIABLE;
+    enet_packet->flags &= ~ENET_PACKET_FLAG_UNSEQUENCED;
 
-    const auto& destination_address = remote_ip;
+    std::shared_lock lock(member_mutex);
     if (broadcast) { // Send the data to everyone except the sender
-        std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
         for (const auto& member : members) {
             if (member.peer != event->peer) {
-                sent_packet = true;
                 enet_peer_send(member.peer, 0, enet_packet);
             }
         }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
-    } else {
-        std::lock_guard lock(member_mutex);
-        auto member = std::find_if(members.begin(), members.end(),
-                                   [destination_address](const Member& member_entry) -> bool {
-                                       return member_entry.fake_ip == destination_address;
-                                   });
-        if (member != members.end()) {
-            enet_peer_send(member->peer, 0, enet_packet);
-        } else {
-            LOG_ERROR(Network,
-                      "Attempting to send to unknown IP address: "
-                      "{}.{}.{}.{}",
-                      destination_address[0], destination_address[1], destination_address[2],
-                      destination_address[3]);
-            enet_packet_destroy(enet_packet);
-        }
+        return;
     }
-    enet_host_flush(server);
+    // Send the data only to the destination client
+    const auto member = FindMemberByIP(destination_address);
+    if (member == members.end()) {
+        LOG_ERROR(Network,
+                  "Attempting to send to unknown IP address: "
+                  "{}.{}.{}.{}",
+                  destination_address[0], destination_address[1], destination_address[2],
+                  destination_address[3]);
+        return;
+    }
+    enet_peer_send(member->peer, 0, enet_packet);
 }
 
 void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
@@ -931,12 +1074,9 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
     in_packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     std::string message;
     in_packet.Read(message);
-    auto CompareNetworkAddress = [event](const Member member) -> bool {
-        return member.peer == event->peer;
-    };
 
     std::lock_guard lock(member_mutex);
-    const auto sending_member = std::find_if(members.begin(), members.end(), CompareNetworkAddress);
+    const auto sending_member = FindMemberByPeer(event->peer);
     if (sending_member == members.end()) {
         return; // Received a chat message from a unknown sender
     }
@@ -964,8 +1104,6 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
         enet_packet_destroy(enet_packet);
     }
 
-    enet_host_flush(server);
-
     if (sending_member->user_data.username.empty()) {
         LOG_INFO(Network, "{}: {}", sending_member->nickname, message);
     } else {
@@ -986,10 +1124,7 @@ void Room::RoomImpl::HandleGameInfoPacket(const ENetEvent* event) {
 
     {
         std::lock_guard lock(member_mutex);
-        auto member = std::find_if(members.begin(), members.end(),
-                                   [event](const Member& member_entry) -> bool {
-                                       return member_entry.peer == event->peer;
-                                   });
+        const auto member = FindMemberByPeer(event->peer);
         if (member != members.end()) {
             member->game_info = game_info;
 
@@ -1014,10 +1149,7 @@ void Room::RoomImpl::HandleClientDisconnection(ENetPeer* client) {
     std::string nickname, username, ip;
     {
         std::lock_guard lock(member_mutex);
-        auto member =
-            std::find_if(members.begin(), members.end(), [client](const Member& member_entry) {
-                return member_entry.peer == client;
-            });
+        const auto member = FindMemberByPeer(client);
         if (member != members.end()) {
             nickname = member->nickname;
             username = member->user_data.username;
@@ -1026,7 +1158,7 @@ void Room::RoomImpl::HandleClientDisconnection(ENetPeer* client) {
             enet_address_get_host_ip(&member->peer->address, ip_raw.data(), sizeof(ip_raw) - 1);
             ip = ip_raw.data();
 
-            members.erase(member);
+            EraseMember(member);
         }
     }
 
@@ -1038,7 +1170,10 @@ void Room::RoomImpl::HandleClientDisconnection(ENetPeer* client) {
 }
 
 // Room
-Room::Room() : room_impl{std::make_unique<RoomImpl>()} {}
+Room::Room() : Room(nullptr) {}
+
+Room::Room(std::shared_ptr<RoomWorkerPool> worker_pool)
+    : room_impl{std::make_unique<RoomImpl>(std::move(worker_pool))} {}
 
 Room::~Room() = default;
 
@@ -1075,7 +1210,11 @@ bool Room::Create(const std::string& name, const std::string& description,
     room_impl->username_ban_list = ban_list.first;
     room_impl->ip_ban_list = ban_list.second;
 
-    room_impl->StartLoop();
+    if (!room_impl->worker_pool) {
+        room_impl->worker_pool = std::make_shared<RoomWorkerPool>(1);
+        room_impl->owns_worker_pool = true;
+    }
+    room_impl->worker_pool->impl->Add(room_impl.get());
     return true;
 }
 
@@ -1124,17 +1263,24 @@ void Room::SetVerifyUID(const std::string& uid) {
 
 void Room::Destroy() {
     room_impl->state = State::Closed;
-    room_impl->room_thread->join();
-    room_impl->room_thread.reset();
-
     if (room_impl->server) {
+        room_impl->worker_pool->impl->Remove(room_impl.get());
+        // Close the connection to all members
+        room_impl->SendCloseMessage();
         enet_host_destroy(room_impl->server);
     }
+    if (room_impl->owns_worker_pool) {
+        room_impl->worker_pool.reset();
+        room_impl->owns_worker_pool = false;
+    }
     room_impl->room_information = {};
     room_impl->server = nullptr;
     {
         std::lock_guard lock(room_impl->member_mutex);
         room_impl->members.clear();
+        room_impl->member_index_by_ip.clear();
+        room_impl->member_index_by_nickname.clear();
+        room_impl->member_index_by_peer.clear();
     }
     room_impl->room_information.member_slots = 0;
     room_impl->room_information.name.clear();
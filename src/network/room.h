@@ -72,6 +72,31 @@ enum StatusMessageTypes : u8 {
     IdAddressUnbanned, ///< A username / ip address is unbanned from the room
 };
 
+/**
+ * Threads which receive and dispatch the packets of rooms. Each room is serviced by one of the
+ * threads, so a process can host many rooms without a thread for each of them.
+ */
+class RoomWorkerPool final {
+public:
+    /**
+     * Creates the pool and starts its threads.
+     * @param num_threads Number of threads, or 0 for one per hardware thread
+     */
+    explicit RoomWorkerPool(std::size_t num_threads = 0);
+    ~RoomWorkerPool();
+
+    /**
+     * Gets the number of threads of the pool.
+     */
+    std::size_t GetNumThreads() const;
+
+private:
+    friend class Room;
+
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
 /// This is what a server [person creating a server] would use.
 class Room final {
 public:
@@ -80,7 +105,15 @@ public:
         Closed, ///< The room is not opened and can not accept connections.
     };
 
+    /// Creates a room which is serviced by a thread of its own once created
     Room();
+
+    /**
+     * Creates a room which is serviced by one of the threads of a pool once created.
+     * @param worker_pool The pool, which may be shared with other rooms
+     */
+    explicit Room(std::shared_ptr<RoomWorkerPool> worker_pool);
+
     ~Room();
 
     /**
@@ -141,6 +174,8 @@ public:
     void Destroy();
 
 private:
+    friend class RoomWorkerPool;
+
     class RoomImpl;
     std::unique_ptr<RoomImpl> room_impl;
 };
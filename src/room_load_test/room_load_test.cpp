@@ -0,0 +1,406 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/thread.h"
+#include "enet/enet.h"
+#include "network/packet.h"
+#include "network/room.h"
+#include "network/verify_user.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+// Simulates clients of yuzu rooms over loopback, to measure how many packets the rooms forward
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    u32 num_clients = 64;
+    u32 num_rooms = 1;
+    u32 num_room_threads = 0;
+    u32 num_client_threads = 2;
+    u16 port = Network::DefaultRoomPort + 1000;
+    u32 duration_seconds = 10;
+    /// Packets sent by each client per second
+    u32 rate = 100;
+    /// Size of the payload of each packet
+    u32 payload_size = 256;
+    /// Percentage of the packets which are broadcast to the whole room
+    u32 broadcast_percent = 10;
+    /// Whether to send LDN packets rather than proxy packets
+    bool ldn = false;
+};
+
+struct Stats {
+    std::atomic<u64> sent{};
+    std::atomic<u64> received{};
+    std::atomic<u64> latency_ns_total{};
+    std::atomic<u64> latency_ns_max{};
+    std::atomic<u32> joined{};
+};
+
+/// The fake IP of a client, chosen by the client so others can address it directly
+Network::IPv4Address ClientIP(u32 index) {
+    return {192, 168, static_cast<u8>((index >> 8) + 1), static_cast<u8>(index & 0xFF)};
+}
+
+struct Client {
+    u32 index{};
+    u32 room{};
+    ENetHost* host{};
+    ENetPeer* peer{};
+    bool joined{};
+    u64 packets_due{};
+    /// Indices of the other clients in the same room
+    std::vector<u32> room_mates;
+};
+
+class ClientThread {
+public:
+    ClientThread(const Options& options_, Stats& stats_) : options{options_}, stats{stats_} {}
+
+    ~ClientThread() {
+        for (auto& client : clients) {
+            if (client.host) {
+                enet_host_destroy(client.host);
+            }
+        }
+    }
+
+    bool Connect(u32 index, u32 room, std::vector<u32> room_mates) {
+        Client& client = clients.emplace_back();
+        client.index = index;
+        client.room = room;
+        client.room_mates = std::move(room_mates);
+        client.host = enet_host_create(nullptr, 1, Network::NumChannels, 0, 0);
+        if (!client.host) {
+            return false;
+        }
+        ENetAddress address{};
+        enet_address_set_host(&address, "127.0.0.1");
+        address.port = static_cast<u16>(options.port + room);
+        client.peer = enet_host_connect(client.host, &address, Network::NumChannels, 0);
+        return client.peer != nullptr;
+    }
+
+    void Run(std::stop_token stop_token, Clock::time_point send_start) {
+        Common::SetCurrentThreadName("LoadTestClients");
+        std::mt19937 random_gen{std::random_device{}()};
+        while (!stop_token.stop_requested()) {
+            const auto now = Clock::now();
+            // Packets are sent at the configured rate from when every client has joined
+            const double elapsed =
+                now < send_start ? 0.0 : std::chrono::duration<double>(now - send_start).count();
+            const auto packets_due = static_cast<u64>(elapsed * options.rate);
+            for (auto& client : clients) {
+                Service(client);
+                while (client.joined && client.packets_due < packets_due) {
+                    SendPacket(client, random_gen);
+                    ++client.packets_due;
+                }
+                enet_host_flush(client.host);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+private:
+    void Service(Client& client) {
+        ENetEvent event;
+        while (enet_host_service(client.host, &event, 0) > 0) {
+            switch (event.type) {
+            case ENET_EVENT_TYPE_CONNECT:
+                SendJoinRequest(client);
+                break;
+            case ENET_EVENT_TYPE_RECEIVE:
+                HandlePacket(client, event.packet);
+                enet_packet_destroy(event.packet);
+                break;
+            case ENET_EVENT_TYPE_DISCONNECT:
+                fmt::print(stderr, "Client {} was disconnected\n", client.index);
+                client.joined = false;
+                break;
+            case ENET_EVENT_TYPE_NONE:
+                break;
+            }
+        }
+    }
+
+    void SendJoinRequest(Client& client) {
+        Network::Packet packet;
+        packet.Write(static_cast<u8>(Network::IdJoinRequest));
+        packet.Write(fmt::format("load{:05}", client.index));
+        packet.Write(ClientIP(client.index));
+        packet.Write(Network::network_version);
+        packet.Write(std::string{});
+        packet.Write(std::string{});
+        Send(client, packet);
+    }
+
+    void HandlePacket(Client& client, const ENetPacket* enet_packet) {
+        switch (enet_packet->data[0]) {
+        case Network::IdJoinSuccess:
+        case Network::IdJoinSuccessAsMod:
+            client.joined = true;
+            ++stats.joined;
+            break;
+        case Network::IdProxyPacket:
+        case Network::IdLdnPacket: {
+            // The payload ends with the time it was sent
+            s64 sent_ns;
+            if (enet_packet->dataLength < sizeof(sent_ns)) {
+                break;
+            }
+            std::memcpy(&sent_ns, enet_packet->data + enet_packet->dataLength - sizeof(sent_ns),
+                        sizeof(sent_ns));
+            const auto latency_ns =
+                static_cast<u64>(Clock::now().time_since_epoch().count() - sent_ns);
+            ++stats.received;
+            stats.latency_ns_total += latency_ns;
+            u64 max = stats.latency_ns_max.load(std::memory_order_relaxed);
+            while (latency_ns > max &&
+                   !stats.latency_ns_max.compare_exchange_weak(max, latency_ns)) {
+            }
+            break;
+        }
+        case Network::IdNameCollision:
+        case Network::IdIpCollision:
+        case Network::IdRoomIsFull:
+        case Network::IdVersionMismatch:
+        case Network::IdWrongPassword:
+            fmt::print(stderr, "Client {} could not join, error {}\n", client.index,
+                       enet_packet->data[0]);
+            break;
+        }
+    }
+
+    void SendPacket(Client& client, std::mt19937& random_gen) {
+        if (client.room_mates.empty()) {
+            return;
+        }
+        const bool broadcast = random_gen() % 100 < options.broadcast_percent;
+        const u32 destination = client.room_mates[random_gen() % client.room_mates.size()];
+
+        std::vector<u8> data(std::max<std::size_t>(options.payload_size, sizeof(s64)));
+        const s64 now_ns = Clock::now().time_since_epoch().count();
+        std::memcpy(data.data() + data.size() - sizeof(now_ns), &now_ns, sizeof(now_ns));
+
+        Network::Packet packet;
+        if (options.ldn) {
+            packet.Write(static_cast<u8>(Network::IdLdnPacket));
+            packet.Write(static_cast<u8>(0)); // LAN packet type
+            packet.Write(ClientIP(client.index));
+            packet.Write(ClientIP(destination));
+            packet.Write(broadcast);
+        } else {
+            packet.Write(static_cast<u8>(Network::IdProxyPacket));
+            packet.Write(static_cast<u8>(0)); // Domain
+            packet.Write(ClientIP(client.index));
+            packet.Write(static_cast<u16>(1000));
+            packet.Write(static_cast<u8>(0)); // Domain
+            packet.Write(ClientIP(destination));
+            packet.Write(static_cast<u16>(1000));
+            packet.Write(static_cast<u8>(0)); // Protocol
+            packet.Write(broadcast);
+        }
+        packet.Write(data);
+        Send(client, packet);
+        ++stats.sent;
+    }
+
+    static void Send(Client& client, const Network::Packet& packet) {
+        ENetPacket* enet_packet =
+            enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
+        enet_peer_send(client.peer, 0, enet_packet);
+    }
+
+    const Options& options;
+    Stats& stats;
+    std::vector<Client> clients;
+};
+
+void PrintHelp(const char* argv0) {
+    fmt::print("Usage: {} [options]\n"
+               "--clients         Number of simulated clients (64)\n"
+               "--rooms           Number of rooms the clients are spread over (1)\n"
+               "--room-threads    Number of threads servicing the rooms, 0 for one per core (0)\n"
+               "--client-threads  Number of threads running the clients (2)\n"
+               "--port            Port of the first room, the others following it ({})\n"
+               "--duration        Seconds to send packets for (10)\n"
+               "--rate            Packets sent by each client per second (100)\n"
+               "--size            Size of the payload of the packets (256)\n"
+               "--broadcast       Percentage of packets sent to the whole room (10)\n"
+               "--ldn             Send LDN packets rather than proxy packets\n"
+               "-h, --help        Display this help and exit\n",
+               argv0, Network::DefaultRoomPort + 1000);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    int option_index = 0;
+
+    static struct option long_options[] = {
+        {"clients", required_argument, 0, 'c'},
+        {"rooms", required_argument, 0, 'r'},
+        {"room-threads", required_argument, 0, 't'},
+        {"client-threads", required_argument, 0, 'T'},
+        {"port", required_argument, 0, 'p'},
+        {"duration", required_argument, 0, 'd'},
+        {"rate", required_argument, 0, 'R'},
+        {"size", required_argument, 0, 's'},
+        {"broadcast", required_argument, 0, 'b'},
+        {"ldn", no_argument, 0, 'l'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        const int arg =
+            getopt_long(argc, argv, "c:r:t:T:p:d:R:s:b:lh", long_options, &option_index);
+        if (arg == -1) {
+            PrintHelp(argv[0]);
+            return 1;
+        }
+        switch (static_cast<char>(arg)) {
+        case 'c':
+            options.num_clients = static_cast<u32>(std::stoul(optarg));
+            break;
+        case 'r':
+            options.num_rooms = static_cast<u32>(std::stoul(optarg));
+            break;
+        case 't':
+            options.num_room_threads = static_cast<u32>(std::stoul(optarg));
+            break;
+        case 'T':
+            options.num_client_threads = static_cast<u32>(std::stoul(optarg));
+            break;
+        case 'p':
+            options.port = static_cast<u16>(std::stoul(optarg));
+            break;
+        case 'd':
+            options.duration_seconds = static_cast<u32>(std::stoul(optarg));
+            break;
+        case 'R':
+            options.rate = static_cast<u32>(std::stoul(optarg));
+            break;
+        case 's':
+            options.payload_size = static_cast<u32>(std::stoul(optarg));
+            break;
+        case 'b':
+            options.broadcast_percent = std::min(static_cast<u32>(std::stoul(optarg)), 100U);
+            break;
+        case 'l':
+            options.ldn = true;
+            break;
+        case 'h':
+        default:
+            PrintHelp(argv[0]);
+            return arg == 'h' ? 0 : 1;
+        }
+    }
+    options.num_rooms = std::max(options.num_rooms, 1U);
+    options.num_client_threads = std::max(options.num_client_threads, 1U);
+    const u32 clients_per_room = (options.num_clients + options.num_rooms - 1) / options.num_rooms;
+    if (clients_per_room > Network::MaxConcurrentConnections) {
+        fmt::print(stderr, "A room holds at most {} clients, use more rooms\n",
+                   Network::MaxConcurrentConnections);
+        return 1;
+    }
+
+    if (enet_initialize() != 0) {
+        fmt::print(stderr, "Error initializing ENet\n");
+        return 1;
+    }
+
+    const auto worker_pool = std::make_shared<Network::RoomWorkerPool>(options.num_room_threads);
+    std::vector<std::unique_ptr<Network::Room>> rooms;
+    for (u32 i = 0; i < options.num_rooms; ++i) {
+        auto& room = rooms.emplace_back(std::make_unique<Network::Room>(worker_pool));
+        if (!room->Create(fmt::format("Load test {}", i), "", "127.0.0.1",
+                          static_cast<u16>(options.port + i), "",
+                          Network::MaxConcurrentConnections, "", {},
+                          std::make_unique<Network::VerifyUser::NullBackend>())) {
+            fmt::print(stderr, "Failed to create room on port {}\n", options.port + i);
+            return 1;
+        }
+    }
+
+    Stats stats;
+    std::vector<std::unique_ptr<ClientThread>> client_threads;
+    for (u32 i = 0; i < options.num_client_threads; ++i) {
+        client_threads.push_back(std::make_unique<ClientThread>(options, stats));
+    }
+    for (u32 i = 0; i < options.num_clients; ++i) {
+        const u32 room = i % options.num_rooms;
+        std::vector<u32> room_mates;
+        for (u32 other = room; other < options.num_clients; other += options.num_rooms) {
+            if (other != i) {
+                room_mates.push_back(other);
+            }
+        }
+        if (!client_threads[i % options.num_client_threads]->Connect(i, room,
+                                                                     std::move(room_mates))) {
+            fmt::print(stderr, "Failed to create client {}\n", i);
+            return 1;
+        }
+    }
+
+    // Clients start sending once they have all had time to join
+    constexpr auto JoinTime = std::chrono::seconds{3};
+    const auto send_start = Clock::now() + JoinTime;
+    std::vector<std::jthread> threads;
+    for (auto& client_thread : client_threads) {
+        threads.emplace_back([&client_thread, send_start](std::stop_token stop_token) {
+            client_thread->Run(stop_token, send_start);
+        });
+    }
+    std::this_thread::sleep_until(send_start);
+    fmt::print("{} of {} clients joined {} rooms serviced by {} threads\n", stats.joined.load(),
+               options.num_clients, options.num_rooms, worker_pool->GetNumThreads());
+
+    u64 last_received = stats.received;
+    for (u32 second = 1; second <= options.duration_seconds; ++second) {
+        std::this_thread::sleep_until(send_start + std::chrono::seconds{second});
+        const u64 received = stats.received;
+        fmt::print("{:>4}s: sent {:>10}, received {:>10}, {:>9} packets/s\n", second,
+                   stats.sent.load(), received, received - last_received);
+        last_received = received;
+    }
+
+    threads.clear();
+    const u64 received = stats.received;
+    const double seconds = options.duration_seconds;
+    fmt::print("Forwarded {:.0f} packets/s, {:.0f} per room thread, mean latency {:.2f} ms, "
+               "max latency {:.2f} ms\n",
+               received / seconds, received / seconds / worker_pool->GetNumThreads(),
+               received == 0 ? 0.0 : stats.latency_ns_total / 1e6 / received,
+               stats.latency_ns_max / 1e6);
+
+    client_threads.clear();
+    for (auto& room : rooms) {
+        room->Destroy();
+    }
+    rooms.clear();
+    enet_deinitialize();
+    return 0;
+}
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_capture.h"
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/commands.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/cityhash.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+namespace {
+
+constexpr u32 SampleCount{16};
+constexpr u32 BufferCount{3};
+constexpr u64 MixBufferOffset{0x0};
+constexpr u64 DepopBufferOffset{0x200};
+constexpr u64 CommandListOffset{0x400};
+constexpr u64 VoiceStateOffset{0x800};
+constexpr u32 FrameCount{4};
+
+template <typename T>
+T& AddCommand(CommandListProcessor& processor, Renderer::CommandId type) {
+    auto& command{*std::construct_at(
+        reinterpret_cast<T*>(processor.commands + processor.commands_buffer_size))};
+    command.magic = Renderer::CommandMagic;
+    command.enabled = true;
+    command.type = type;
+    command.size = sizeof(T);
+    processor.commands_buffer_size += sizeof(T);
+    processor.header->command_count++;
+    processor.command_count++;
+    return command;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CommandListCapture: Replay matches the captured processing", "[audio_core]") {
+    const auto path{std::filesystem::temp_directory_path() / "yuzu_audio_command_capture.bin"};
+
+    // Lay out a command list in a workbuffer the same way the renderer does, with the commands
+    // pointing at mix and depop buffers inside it
+    std::vector<u8> workbuffer(0x1000);
+    auto* const base{workbuffer.data()};
+    const std::span<s32> mix_buffers{reinterpret_cast<s32*>(base + MixBufferOffset),
+                                     SampleCount * BufferCount};
+    const std::span<s32> depop_buffer{reinterpret_cast<s32*>(base + DepopBufferOffset),
+                                      BufferCount};
+    auto& header{*reinterpret_cast<Renderer::CommandListHeader*>(base + CommandListOffset)};
+    header.samples_buffer = mix_buffers;
+    header.buffer_count = BufferCount;
+    header.sample_count = SampleCount;
+    header.sample_rate = TargetSampleRate;
+    header.workbuffer = workbuffer;
+
+    // Guest samples for the data source command. They are placed at an address inside the host
+    // range of the workbuffer, so relocating any field that merely looks like a workbuffer
+    // address would make the replay read the wrong samples.
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<s32> sample_dist{-0x8000, 0x7FFF};
+    std::vector<u8> wave_data(SampleCount * FrameCount * sizeof(s16));
+    for (size_t i = 0; i < wave_data.size(); i += sizeof(s16)) {
+        const auto sample{static_cast<s16>(sample_dist(rng))};
+        std::memcpy(&wave_data[i], &sample, sizeof(sample));
+    }
+    const auto wave_address{CpuAddr(base) + 0x100};
+    const auto wave_size{wave_data.size()};
+    CaptureMemory guest_memory;
+    guest_memory.SetRegion(wave_address, std::move(wave_data));
+    auto& voice_state{
+        *std::construct_at(reinterpret_cast<Renderer::VoiceState*>(base + VoiceStateOffset))};
+    voice_state.wave_buffer_valid[0] = true;
+
+    CommandListProcessor processor{};
+    processor.capture_memory = &guest_memory;
+    processor.header = &header;
+    processor.commands = base + CommandListOffset + sizeof(Renderer::CommandListHeader);
+    processor.sample_count = SampleCount;
+    processor.target_sample_rate = TargetSampleRate;
+    processor.mix_buffers = mix_buffers;
+    processor.buffer_count = BufferCount;
+
+    auto& source{AddCommand<Renderer::PcmInt16DataSourceVersion1Command>(
+        processor, Renderer::CommandId::DataSourcePcmInt16Version1)};
+    source.src_quality = SrcQuality::Medium;
+    source.output_index = 2;
+    source.sample_rate = TargetSampleRate;
+    source.pitch = 1.0f;
+    source.channel_index = 0;
+    source.channel_count = 1;
+    source.wave_buffers[0].buffer = wave_address;
+    source.wave_buffers[0].buffer_size = wave_size;
+    source.wave_buffers[0].end_offset = SampleCount * FrameCount;
+    source.voice_state = CpuAddr(&voice_state);
+    auto& copy{AddCommand<Renderer::CopyMixBufferCommand>(processor,
+                                                          Renderer::CommandId::CopyMixBuffer)};
+    copy.input_index = 0;
+    copy.output_index = 1;
+    auto& volume{AddCommand<Renderer::VolumeCommand>(processor, Renderer::CommandId::Volume)};
+    volume.precision = 15;
+    volume.input_index = 1;
+    volume.output_index = 1;
+    AddCommand<Renderer::PerformanceCommand>(processor, Renderer::CommandId::Performance);
+    auto& depop{AddCommand<Renderer::DepopForMixBuffersCommand>(
+        processor, Renderer::CommandId::DepopForMixBuffers)};
+    depop.input = 1;
+    depop.count = 2;
+    depop.decay = Common::FixedPoint<49, 15>(0.75f);
+    depop.depop_buffer = CpuAddr(depop_buffer.data());
+
+    u64 expected_checksum{0};
+    bool decoded_samples{false};
+    {
+        CommandListCaptureWriter writer{path, workbuffer};
+        for (u32 frame = 0; frame < FrameCount; frame++) {
+            // Update the inputs and parameters between frames, as the host would
+            for (u32 i = 0; i < SampleCount; i++) {
+                mix_buffers[i] = sample_dist(rng);
+            }
+            depop_buffer[2] = sample_dist(rng);
+            volume.volume = 0.5f + static_cast<f32>(frame) * 0.25f;
+
+            writer.Record(processor);
+
+            u64 offset{0};
+            for (u32 index = 0; index < processor.command_count; index++) {
+                auto& command{
+                    *reinterpret_cast<Renderer::ICommand*>(processor.commands + offset)};
+                offset += command.size;
+                if (command.type != Renderer::CommandId::Performance) {
+                    command.Process(processor);
+                }
+            }
+            decoded_samples |= std::ranges::any_of(
+                mix_buffers.subspan(2 * SampleCount, SampleCount), [](s32 x) { return x != 0; });
+            expected_checksum = Common::CityHash64WithSeed(
+                reinterpret_cast<const char*>(mix_buffers.data()), mix_buffers.size_bytes(),
+                expected_checksum);
+        }
+    }
+
+    CommandListReplay replay{path};
+    REQUIRE(replay.IsOpen());
+    while (replay.ProcessNext()) {
+    }
+    std::filesystem::remove(path);
+
+    const auto& stats{replay.GetStats()};
+    const auto count = [&](const std::array<u64, Renderer::CommandIdCount>& counts,
+                           Renderer::CommandId type) { return counts[static_cast<size_t>(type)]; };
+    REQUIRE(decoded_samples);
+    REQUIRE(stats.list_count == FrameCount);
+    REQUIRE(count(stats.command_counts, Renderer::CommandId::DataSourcePcmInt16Version1) ==
+            FrameCount);
+    REQUIRE(count(stats.command_counts, Renderer::CommandId::CopyMixBuffer) == FrameCount);
+    REQUIRE(count(stats.command_counts, Renderer::CommandId::Volume) == FrameCount);
+    REQUIRE(count(stats.command_counts, Renderer::CommandId::DepopForMixBuffers) == FrameCount);
+    REQUIRE(count(stats.skipped_counts, Renderer::CommandId::Performance) == FrameCount);
+    REQUIRE(stats.checksum == expected_checksum);
+}
+
+TEST_CASE("CommandListCapture: Replay", "[.][audio_core][benchmark]") {
+    const char* const path{std::getenv("YUZU_AUDIO_CAPTURE")};
+    if (path == nullptr) {
+        WARN("Set YUZU_AUDIO_CAPTURE to the path of an audio command capture to replay");
+        return;
+    }
+
+    CommandListReplay replay{std::filesystem::path{path}};
+    REQUIRE(replay.IsOpen());
+    while (replay.ProcessNext()) {
+    }
+
+    const auto& stats{replay.GetStats()};
+    REQUIRE(stats.list_count > 0);
+    fmt::print("{:<28} {:>10} {:>12} {:>10}\n", "Command", "Count", "us/list", "Skipped");
+    for (size_t type = 0; type < Renderer::CommandIdCount; type++) {
+        if (stats.command_counts[type] == 0 && stats.skipped_counts[type] == 0) {
+            continue;
+        }
+        fmt::print("{:<28} {:>10} {:>12.2f} {:>10}\n",
+                   CommandListReplay::GetCommandName(static_cast<Renderer::CommandId>(type)),
+                   stats.command_counts[type],
+                   static_cast<f64>(stats.process_times[type]) / 1000.0 /
+                       static_cast<f64>(stats.list_count),
+                   stats.skipped_counts[type]);
+    }
+    fmt::print("{} command lists, output checksum {:016X}\n", stats.list_count, stats.checksum);
+}
+
+} // namespace AudioCore::ADSP::AudioRenderer
@@ -0,0 +1,349 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/effect/biquad_filter.h"
+#include "audio_core/renderer/command/effect/delay.h"
+#include "audio_core/renderer/command/effect/i3dl2_reverb.h"
+#include "audio_core/renderer/command/effect/multi_tap_biquad_filter.h"
+#include "audio_core/renderer/command/effect/reverb.h"
+#include "common/cityhash.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+// One 5ms audio frame at 48KHz
+constexpr u32 SampleCount{240};
+constexpr u32 FrameCount{16};
+constexpr std::array<u16, 4> ChannelCounts{1, 2, 4, 6};
+
+/**
+ * Runs an effect command over a set of mix buffers, with the inputs in the first MaxChannels
+ * buffers and the outputs in the next MaxChannels.
+ */
+template <typename Command, typename State>
+class EffectRunner {
+public:
+    explicit EffectRunner(const Command& command_, u16 channel_count_)
+        : command{command_}, channel_count{channel_count_},
+          mix_buffers(SampleCount * MaxChannels * 2), state{std::make_unique<State>()} {
+        processor.sample_count = SampleCount;
+        processor.target_sample_rate = TargetSampleRate;
+        processor.mix_buffers = mix_buffers;
+        processor.buffer_count = MaxChannels * 2;
+
+        for (s16 channel = 0; channel < static_cast<s16>(MaxChannels); channel++) {
+            command.inputs[channel] = channel;
+            command.outputs[channel] = static_cast<s16>(MaxChannels + channel);
+        }
+        command.parameter.channel_count = channel_count;
+        command.parameter.channel_count_max = static_cast<u16>(MaxChannels);
+        command.parameter.state = EffectInfoBase::ParameterState::Initialized;
+        command.state = reinterpret_cast<CpuAddr>(state.get());
+        command.effect_enabled = true;
+    }
+
+    /// Fill the input buffers with new noise
+    void FillInputs() {
+        std::uniform_int_distribution<s32> dist{std::numeric_limits<s16>::min(),
+                                                std::numeric_limits<s16>::max()};
+        for (u32 i = 0; i < SampleCount * channel_count; i++) {
+            mix_buffers[i] = dist(rng);
+        }
+    }
+
+    /// Process one frame of the inputs
+    void Process() {
+        command.Process(processor);
+        command.parameter.state = EffectInfoBase::ParameterState::Updated;
+    }
+
+    /**
+     * Process a number of frames of noise, and hash the outputs.
+     *
+     * @param frame_count - Number of frames to process.
+     * @return Checksum of the outputs of every frame.
+     */
+    u64 ProcessFrames(u32 frame_count) {
+        u64 checksum{0};
+        for (u32 frame = 0; frame < frame_count; frame++) {
+            FillInputs();
+            Process();
+            checksum = Common::CityHash64WithSeed(
+                reinterpret_cast<const char*>(&mix_buffers[SampleCount * MaxChannels]),
+                SampleCount * channel_count * sizeof(s32), checksum);
+        }
+        return checksum;
+    }
+
+private:
+    Command command;
+    u16 channel_count;
+    std::vector<s32> mix_buffers;
+    std::unique_ptr<State> state;
+    ADSP::AudioRenderer::CommandListProcessor processor{};
+    std::mt19937 rng{1234};
+};
+
+DelayCommand MakeDelayCommand() {
+    DelayCommand command{};
+    command.parameter.delay_time_max = 100;
+    command.parameter.delay_time = 20;
+    command.parameter.sample_rate = 48000.0f;
+    command.parameter.in_gain = 0.9f;
+    command.parameter.feedback_gain = 0.6f;
+    command.parameter.wet_gain = 0.5f;
+    command.parameter.dry_gain = 0.7f;
+    command.parameter.channel_spread = 0.3f;
+    command.parameter.lowpass_amount = 0.4f;
+    return command;
+}
+
+ReverbCommand MakeReverbCommand() {
+    constexpr auto q14 = [](f32 value) { return static_cast<s32>(value * 16384.0f); };
+    ReverbCommand command{};
+    command.parameter.sample_rate = q14(48.0f);
+    command.parameter.early_mode = 1;
+    command.parameter.early_gain = q14(0.7f);
+    command.parameter.pre_delay = q14(10.0f);
+    command.parameter.late_mode = 1;
+    command.parameter.late_gain = q14(0.6f);
+    command.parameter.decay_time = q14(1.5f);
+    command.parameter.high_freq_decay_ratio = q14(0.5f);
+    command.parameter.colouration = q14(0.5f);
+    command.parameter.base_gain = q14(0.9f);
+    command.parameter.wet_gain = q14(0.5f);
+    command.parameter.dry_gain = q14(0.8f);
+    command.long_size_pre_delay_supported = true;
+    return command;
+}
+
+I3dl2ReverbCommand MakeI3dl2ReverbCommand() {
+    I3dl2ReverbCommand command{};
+    command.parameter.sample_rate = 48000;
+    command.parameter.room_HF_gain = -1000.0f;
+    command.parameter.reference_HF = 5000.0f;
+    command.parameter.late_reverb_decay_time = 1.5f;
+    command.parameter.late_reverb_HF_decay_ratio = 0.8f;
+    command.parameter.room_gain = -500.0f;
+    command.parameter.reflection_gain = -800.0f;
+    command.parameter.reverb_gain = -600.0f;
+    command.parameter.late_reverb_diffusion = 100.0f;
+    command.parameter.reflection_delay = 0.01f;
+    command.parameter.late_reverb_delay_time = 0.02f;
+    command.parameter.late_reverb_density = 100.0f;
+    command.parameter.dry_gain = 0.7f;
+    return command;
+}
+
+using DelayRunner = EffectRunner<DelayCommand, DelayInfo::State>;
+using ReverbRunner = EffectRunner<ReverbCommand, ReverbInfo::State>;
+using I3dl2ReverbRunner = EffectRunner<I3dl2ReverbCommand, I3dl2ReverbInfo::State>;
+
+/**
+ * Runs a biquad filter command over one mix buffer of noise, with two filter states.
+ */
+template <typename Command>
+class BiquadRunner {
+public:
+    explicit BiquadRunner(const Command& command_, bool in_place)
+        : command{command_}, mix_buffers(SampleCount * 2) {
+        processor.sample_count = SampleCount;
+        processor.target_sample_rate = TargetSampleRate;
+        processor.mix_buffers = mix_buffers;
+        processor.buffer_count = 2;
+
+        command.input = 0;
+        command.output = in_place ? 0 : 1;
+        if constexpr (std::is_same_v<Command, MultiTapBiquadFilterCommand>) {
+            for (u32 i = 0; i < MaxBiquadFilters; i++) {
+                command.states[i] = reinterpret_cast<CpuAddr>(&states[i]);
+            }
+        } else {
+            command.state = reinterpret_cast<CpuAddr>(&states[0]);
+        }
+    }
+
+    /// Process one frame of the input
+    void Process() {
+        command.Process(processor);
+        if constexpr (std::is_same_v<Command, MultiTapBiquadFilterCommand>) {
+            command.needs_init.fill(false);
+        } else {
+            command.needs_init = false;
+        }
+    }
+
+    /**
+     * Process a number of frames of noise, and hash the output.
+     *
+     * @param frame_count - Number of frames to process.
+     * @return Checksum of the output of every frame.
+     */
+    u64 ProcessFrames(u32 frame_count) {
+        std::uniform_int_distribution<s32> dist{std::numeric_limits<s16>::min(),
+                                                std::numeric_limits<s16>::max()};
+        u64 checksum{0};
+        for (u32 frame = 0; frame < frame_count; frame++) {
+            for (u32 i = 0; i < SampleCount; i++) {
+                mix_buffers[i] = dist(rng);
+            }
+            Process();
+            checksum = Common::CityHash64WithSeed(
+                reinterpret_cast<const char*>(&mix_buffers[command.output * SampleCount]),
+                SampleCount * sizeof(s32), checksum);
+        }
+        return checksum;
+    }
+
+private:
+    Command command;
+    std::vector<s32> mix_buffers;
+    std::array<VoiceState::BiquadFilterState, MaxBiquadFilters> states{};
+    ADSP::AudioRenderer::CommandListProcessor processor{};
+    std::mt19937 rng{5678};
+};
+
+constexpr VoiceInfo::BiquadFilterParameter LowPass{
+    .enabled = true,
+    .b = {3277, 6554, 3277},
+    .a = {8192, -3277},
+};
+constexpr VoiceInfo::BiquadFilterParameter HighPass{
+    .enabled = true,
+    .b = {9830, -19661, 9830},
+    .a = {-4915, -1638},
+};
+
+BiquadFilterCommand MakeBiquadCommand(bool use_float_processing) {
+    BiquadFilterCommand command{};
+    command.biquad = LowPass;
+    command.needs_init = true;
+    command.use_float_processing = use_float_processing;
+    return command;
+}
+
+MultiTapBiquadFilterCommand MakeMultiTapBiquadCommand() {
+    MultiTapBiquadFilterCommand command{};
+    command.biquads = {LowPass, HighPass};
+    command.needs_init = {true, true};
+    command.filter_tap_count = MaxBiquadFilters;
+    return command;
+}
+
+} // Anonymous namespace
+
+// The checksums were recorded from the original per-sample implementations of each effect, any
+// optimisation of them must keep the output bit-exact.
+
+TEST_CASE("Effects: Delay output is unchanged", "[audio_core]") {
+    constexpr std::array<u64, ChannelCounts.size()> Expected{
+        0x14368F7943939B6DULL,
+        0x5BB96F3F5CB6DDA0ULL,
+        0xA75C334029721AEFULL,
+        0xCE1106E3F404F1EEULL,
+    };
+    for (size_t i = 0; i < ChannelCounts.size(); i++) {
+        DelayRunner runner{MakeDelayCommand(), ChannelCounts[i]};
+        REQUIRE(runner.ProcessFrames(FrameCount) == Expected[i]);
+    }
+}
+
+TEST_CASE("Effects: Reverb output is unchanged", "[audio_core]") {
+    constexpr std::array<u64, ChannelCounts.size()> Expected{
+        0x12DD84E0206B4C08ULL,
+        0x5275845890A61CE0ULL,
+        0x032CF4CBBDCB2E06ULL,
+        0x893EED3C8A4FC3C9ULL,
+    };
+    for (size_t i = 0; i < ChannelCounts.size(); i++) {
+        ReverbRunner runner{MakeReverbCommand(), ChannelCounts[i]};
+        REQUIRE(runner.ProcessFrames(FrameCount) == Expected[i]);
+    }
+}
+
+TEST_CASE("Effects: I3DL2 reverb output is unchanged", "[audio_core]") {
+    constexpr std::array<u64, ChannelCounts.size()> Expected{
+        0xDD8B25AF776E8A0DULL,
+        0xB14229AED847E709ULL,
+        0x9330E0118EAFE1BCULL,
+        0x167C8196121D1599ULL,
+    };
+    for (size_t i = 0; i < ChannelCounts.size(); i++) {
+        I3dl2ReverbRunner runner{MakeI3dl2ReverbCommand(), ChannelCounts[i]};
+        REQUIRE(runner.ProcessFrames(FrameCount) == Expected[i]);
+    }
+}
+
+TEST_CASE("Effects: Biquad filter output is unchanged", "[audio_core]") {
+    BiquadRunner<BiquadFilterCommand> int_runner{MakeBiquadCommand(false), true};
+    REQUIRE(int_runner.ProcessFrames(FrameCount) == 0xFF3D77F127FFF395ULL);
+
+    BiquadRunner<BiquadFilterCommand> float_runner{MakeBiquadCommand(true), true};
+    REQUIRE(float_runner.ProcessFrames(FrameCount) == 0x436ED8ECC0466A08ULL);
+
+    BiquadRunner<MultiTapBiquadFilterCommand> multi_tap_runner{MakeMultiTapBiquadCommand(), true};
+    REQUIRE(multi_tap_runner.ProcessFrames(FrameCount) == 0x558769E76432B0E5ULL);
+
+    BiquadRunner<MultiTapBiquadFilterCommand> multi_tap_out_of_place_runner{
+        MakeMultiTapBiquadCommand(), false};
+    REQUIRE(multi_tap_out_of_place_runner.ProcessFrames(FrameCount) == 0xFD4B66F4C404732CULL);
+}
+
+TEST_CASE("Effects: Throughput", "[.][audio_core][benchmark]") {
+    DelayRunner delay_2ch{MakeDelayCommand(), 2};
+    DelayRunner delay_6ch{MakeDelayCommand(), 6};
+    ReverbRunner reverb_2ch{MakeReverbCommand(), 2};
+    ReverbRunner reverb_6ch{MakeReverbCommand(), 6};
+    I3dl2ReverbRunner i3dl2_2ch{MakeI3dl2ReverbCommand(), 2};
+    I3dl2ReverbRunner i3dl2_6ch{MakeI3dl2ReverbCommand(), 6};
+    BiquadRunner<BiquadFilterCommand> biquad{MakeBiquadCommand(true), true};
+    BiquadRunner<MultiTapBiquadFilterCommand> multi_tap{MakeMultiTapBiquadCommand(), true};
+    for (auto* runner : {&delay_2ch, &delay_6ch}) {
+        runner->ProcessFrames(1);
+    }
+    for (auto* runner : {&reverb_2ch, &reverb_6ch}) {
+        runner->ProcessFrames(1);
+    }
+    for (auto* runner : {&i3dl2_2ch, &i3dl2_6ch}) {
+        runner->ProcessFrames(1);
+    }
+    biquad.ProcessFrames(1);
+    multi_tap.ProcessFrames(1);
+
+    BENCHMARK("Delay 2ch") {
+        delay_2ch.Process();
+    };
+    BENCHMARK("Delay 6ch") {
+        delay_6ch.Process();
+    };
+    BENCHMARK("Reverb 2ch") {
+        reverb_2ch.Process();
+    };
+    BENCHMARK("Reverb 6ch") {
+        reverb_6ch.Process();
+    };
+    BENCHMARK("I3DL2 reverb 2ch") {
+        i3dl2_2ch.Process();
+    };
+    BENCHMARK("I3DL2 reverb 6ch") {
+        i3dl2_6ch.Process();
+    };
+    BENCHMARK("Biquad filter") {
+        biquad.Process();
+    };
+    BENCHMARK("Multi-tap biquad filter") {
+        multi_tap.Process();
+    };
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/measured_command_costs.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+/// Host time of a whole 5ms frame, worth every DSP cycle of the frame
+constexpr u64 FrameTimeNs{5'000'000};
+
+void RecordMany(MeasuredCommandCosts& costs, CommandId type, u32 estimate, u64 time_ns,
+                u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        costs.Record(type, estimate, time_ns);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MeasuredCommandCosts: Console estimate is used until measured", "[audio_core]") {
+    MeasuredCommandCosts costs;
+    REQUIRE(costs.Estimate(CommandId::Volume, 1000) == 1000);
+
+    RecordMany(costs, CommandId::Volume, 1000, FrameTimeNs / 100,
+               MeasuredCommandCosts::MinSamples - 1);
+    REQUIRE(costs.Estimate(CommandId::Volume, 1000) == 1000);
+
+    costs.Record(CommandId::Volume, 1000, FrameTimeNs / 100);
+    REQUIRE(costs.Estimate(CommandId::Volume, 1000) == DspCyclesPerFrame / 100);
+}
+
+TEST_CASE("MeasuredCommandCosts: Variants are measured separately", "[audio_core]") {
+    MeasuredCommandCosts costs;
+    RecordMany(costs, CommandId::Mix, 500, FrameTimeNs / 1000, MeasuredCommandCosts::MinSamples);
+    RecordMany(costs, CommandId::Mix, 900, FrameTimeNs / 100, MeasuredCommandCosts::MinSamples);
+    RecordMany(costs, CommandId::Volume, 500, FrameTimeNs / 10, MeasuredCommandCosts::MinSamples);
+
+    REQUIRE(costs.Estimate(CommandId::Mix, 500) == DspCyclesPerFrame / 1000);
+    REQUIRE(costs.Estimate(CommandId::Mix, 900) == DspCyclesPerFrame / 100);
+    REQUIRE(costs.Estimate(CommandId::Volume, 500) == DspCyclesPerFrame / 10);
+    REQUIRE(costs.Estimate(CommandId::Mix, 700) == 700);
+}
+
+TEST_CASE("MeasuredCommandCosts: Average follows changes and limits spikes", "[audio_core]") {
+    MeasuredCommandCosts costs;
+    constexpr u32 Estimate{2000};
+    RecordMany(costs, CommandId::BiquadFilter, Estimate, FrameTimeNs / 100,
+               MeasuredCommandCosts::MinSamples);
+    const auto settled{costs.Estimate(CommandId::BiquadFilter, Estimate)};
+
+    // A single preempted command only moves the average by a capped amount
+    costs.Record(CommandId::BiquadFilter, Estimate, FrameTimeNs);
+    const auto spiked{costs.Estimate(CommandId::BiquadFilter, Estimate)};
+    REQUIRE(spiked > settled);
+    REQUIRE(spiked <= settled + settled * 3 / 32 + 1);
+
+    // A lasting slowdown is followed
+    RecordMany(costs, CommandId::BiquadFilter, Estimate, FrameTimeNs / 50, 256);
+    const auto slowed{costs.Estimate(CommandId::BiquadFilter, Estimate)};
+    REQUIRE(slowed >= DspCyclesPerFrame / 50 - 100);
+    REQUIRE(slowed <= DspCyclesPerFrame / 50);
+}
+
+TEST_CASE("MeasuredCommandCosts: Variants past the limit keep the estimate", "[audio_core]") {
+    MeasuredCommandCosts costs;
+    for (u32 variant = 0; variant <= MeasuredCommandCosts::MaxVariants; variant++) {
+        RecordMany(costs, CommandId::Upsample, 100 + variant, FrameTimeNs / 100,
+                   MeasuredCommandCosts::MinSamples);
+    }
+    REQUIRE(costs.Estimate(CommandId::Upsample, 100) == DspCyclesPerFrame / 100);
+    const auto last{100 + static_cast<u32>(MeasuredCommandCosts::MaxVariants)};
+    REQUIRE(costs.Estimate(CommandId::Upsample, last) == last);
+}
+
+} // namespace AudioCore::Renderer
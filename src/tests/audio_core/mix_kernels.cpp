@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/fixed_point.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+constexpr std::array<u32, 8> SampleCounts{0, 1, 7, 8, 9, 160, 240, 241};
+constexpr std::array<f32, 8> Volumes{0.0f, 1.0f, 0.5f, -0.3f, 0.999f, 3.7f, 300.0f, 70000.0f};
+
+std::vector<s32> MakeSamples(u32 count, u32 seed) {
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<s32> dist;
+    std::vector<s32> samples(count);
+    for (auto& sample : samples) {
+        sample = dist(rng);
+    }
+    return samples;
+}
+
+// The sample-by-sample FixedPoint loops the mix commands were originally written with
+template <size_t Q, bool Accumulate>
+s32 ReferenceGain(std::span<s32> output, std::span<const s32> input, f32 volume_, f32 ramp_,
+                  u32 sample_count) {
+    Common::FixedPoint<64 - Q, Q> volume{volume_};
+    const Common::FixedPoint<64 - Q, Q> ramp{ramp_};
+    Common::FixedPoint<64 - Q, Q> sample{0};
+    for (u32 i = 0; i < sample_count; i++) {
+        sample = input[i] * volume;
+        if constexpr (Accumulate) {
+            output[i] = (output[i] + sample).to_int();
+        } else {
+            output[i] = Common::FixedPoint<64 - Q, Q>{sample}.to_int();
+        }
+        volume += ramp;
+    }
+    return sample.to_int();
+}
+
+template <size_t Q, bool Accumulate>
+void CheckBitExact() {
+    for (const u32 count : SampleCounts) {
+        const auto input{MakeSamples(count, count)};
+        const auto initial_output{MakeSamples(count, count + 1)};
+        for (const f32 volume : Volumes) {
+            for (const f32 target : Volumes) {
+                const f32 ramp{count == 0 ? 0.0f : (target - volume) / static_cast<f32>(count)};
+                const Common::FixedPoint<64 - Q, Q> raw_volume{volume};
+                const Common::FixedPoint<64 - Q, Q> raw_ramp{ramp};
+
+                std::vector<s32> expected{initial_output};
+                ReferenceGain<Q, Accumulate>(expected, input, volume, ramp, count);
+
+                std::vector<s32> scalar{initial_output};
+                ApplyFixedPointGainScalar<Q, Accumulate>(scalar, input, raw_volume.to_raw(),
+                                                         raw_ramp.to_raw(), count);
+                REQUIRE(scalar == expected);
+
+                std::vector<s32> output{initial_output};
+                ApplyFixedPointGain<Q, Accumulate>(output, input, raw_volume.to_raw(),
+                                                   raw_ramp.to_raw(), count);
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MixKernels: RoundFixedPoint matches FixedPoint", "[audio_core]") {
+    const auto values{MakeSamples(1024, 42)};
+    for (const s32 value : values) {
+        const s64 raw{static_cast<s64>(value) * 12345};
+        REQUIRE(RoundFixedPoint<15>(raw) == Common::FixedPoint<49, 15>::from_base(raw).to_int());
+        REQUIRE(RoundFixedPoint<23>(raw) == Common::FixedPoint<41, 23>::from_base(raw).to_int());
+    }
+}
+
+TEST_CASE("MixKernels: Gain is bit-exact", "[audio_core]") {
+    CheckBitExact<15, false>();
+    CheckBitExact<23, false>();
+}
+
+TEST_CASE("MixKernels: Mix is bit-exact", "[audio_core]") {
+    CheckBitExact<15, true>();
+    CheckBitExact<23, true>();
+}
+
+TEST_CASE("MixKernels: In-place gain", "[audio_core]") {
+    const auto input{MakeSamples(240, 7)};
+    const Common::FixedPoint<49, 15> volume{0.75f};
+    const Common::FixedPoint<49, 15> ramp{-0.001f};
+
+    std::vector<s32> expected(input.size());
+    ApplyFixedPointGainScalar<15, false>(expected, input, volume.to_raw(), ramp.to_raw(), 240);
+
+    std::vector<s32> buffer{input};
+    ApplyFixedPointGain<15, false>(buffer, buffer, volume.to_raw(), ramp.to_raw(), 240);
+    REQUIRE(buffer == expected);
+}
+
+TEST_CASE("MixKernels: Throughput", "[.][audio_core][benchmark]") {
+    // One 5ms audio frame at 48KHz
+    constexpr u32 SampleCount{240};
+    const auto input{MakeSamples(SampleCount, 1)};
+    std::vector<s32> output(SampleCount);
+    const s64 volume{Common::FixedPoint<49, 15>{0.8f}.to_raw()};
+    const s64 ramp{Common::FixedPoint<49, 15>{-0.8f / SampleCount}.to_raw()};
+
+    BENCHMARK("Volume scalar") {
+        ApplyFixedPointGainScalar<15, false>(output, input, volume, 0, SampleCount);
+        return output[0];
+    };
+    BENCHMARK("Volume") {
+        ApplyFixedPointGain<15, false>(output, input, volume, 0, SampleCount);
+        return output[0];
+    };
+    BENCHMARK("VolumeRamp scalar") {
+        ApplyFixedPointGainScalar<15, false>(output, input, volume, ramp, SampleCount);
+        return output[0];
+    };
+    BENCHMARK("VolumeRamp") {
+        ApplyFixedPointGain<15, false>(output, input, volume, ramp, SampleCount);
+        return output[0];
+    };
+    BENCHMARK("Mix scalar") {
+        ApplyFixedPointGainScalar<15, true>(output, input, volume, 0, SampleCount);
+        return output[0];
+    };
+    BENCHMARK("Mix") {
+        ApplyFixedPointGain<15, true>(output, input, volume, 0, SampleCount);
+        return output[0];
+    };
+    BENCHMARK("MixRamp scalar") {
+        ApplyFixedPointGainScalar<15, true>(output, input, volume, ramp, SampleCount);
+        return output[0];
+    };
+    BENCHMARK("MixRamp") {
+        ApplyFixedPointGain<15, true>(output, input, volume, ramp, SampleCount);
+        return output[0];
+    };
+}
+
+} // namespace AudioCore::Renderer
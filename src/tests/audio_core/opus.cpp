@@ -0,0 +1,352 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <span>
+#include <thread>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <opus.h>
+#include <opus_multistream.h>
+
+#include "audio_core/adsp/apps/opus/opus_batch_decode.h"
+#include "audio_core/adsp/apps/opus/opus_decode_object.h"
+#include "audio_core/adsp/apps/opus/opus_decoder.h"
+#include "audio_core/adsp/apps/opus/opus_multistream_decode_object.h"
+#include "audio_core/adsp/mailbox.h"
+
+namespace AudioCore::ADSP::OpusDecoder {
+namespace {
+
+constexpr s32 SampleRate{48'000};
+constexpr s32 ChannelCount{2};
+/// 20ms packets
+constexpr s32 FrameSize{960};
+constexpr size_t FrameBytes{FrameSize * ChannelCount * sizeof(s16)};
+
+s64 GetTimeUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// Channel mapping of the multistream tests, each channel in its own mono stream
+constexpr std::array<u8, ChannelCount> MonoStreamMapping{0, 1};
+
+/// Fill a frame with a sweeping tone on the left channel and a steady one on the right
+void GenerateFrame(std::span<s16> pcm, size_t index, f64& phase_left, f64& phase_right) {
+    for (s32 frame = 0; frame < FrameSize; frame++) {
+        const auto time{static_cast<f64>(index * FrameSize + frame) / SampleRate};
+        phase_left += 2 * std::numbers::pi * (200.0 + 180.0 * time) / SampleRate;
+        phase_right += 2 * std::numbers::pi * 330.0 / SampleRate;
+        pcm[frame * 2 + 0] = static_cast<s16>(std::sin(phase_left) * 12000.0);
+        pcm[frame * 2 + 1] = static_cast<s16>(std::sin(phase_right) * 8000.0);
+    }
+}
+
+/// Encode the test tones into Opus packets
+std::vector<std::vector<u8>> EncodeStream(size_t packet_count) {
+    s32 error{};
+    auto* const encoder{
+        opus_encoder_create(SampleRate, ChannelCount, OPUS_APPLICATION_AUDIO, &error)};
+    REQUIRE(error == OPUS_OK);
+    opus_encoder_ctl(encoder, OPUS_SET_BITRATE(96'000));
+
+    std::vector<std::vector<u8>> packets;
+    std::array<s16, FrameSize * ChannelCount> pcm{};
+    std::array<u8, 1500> packet{};
+    f64 phase_left{};
+    f64 phase_right{};
+    for (size_t i = 0; i < packet_count; i++) {
+        GenerateFrame(pcm, i, phase_left, phase_right);
+        const auto size{opus_encode(encoder, pcm.data(), FrameSize, packet.data(),
+                                    static_cast<opus_int32>(packet.size()))};
+        REQUIRE(size > 0);
+        packets.emplace_back(packet.begin(), packet.begin() + size);
+    }
+    opus_encoder_destroy(encoder);
+    return packets;
+}
+
+/// Encode the test tones into multistream Opus packets, with a stream per channel
+std::vector<std::vector<u8>> EncodeMultiStream(size_t packet_count) {
+    s32 error{};
+    auto* const encoder{opus_multistream_encoder_create(SampleRate, ChannelCount, ChannelCount, 0,
+                                                        MonoStreamMapping.data(),
+                                                        OPUS_APPLICATION_AUDIO, &error)};
+    REQUIRE(error == OPUS_OK);
+
+    std::vector<std::vector<u8>> packets;
+    std::array<s16, FrameSize * ChannelCount> pcm{};
+    std::array<u8, 1500 * ChannelCount> packet{};
+    f64 phase_left{};
+    f64 phase_right{};
+    for (size_t i = 0; i < packet_count; i++) {
+        GenerateFrame(pcm, i, phase_left, phase_right);
+        const auto size{opus_multistream_encode(encoder, pcm.data(), FrameSize, packet.data(),
+                                                static_cast<opus_int32>(packet.size()))};
+        REQUIRE(size > 0);
+        packets.emplace_back(packet.begin(), packet.begin() + size);
+    }
+    opus_multistream_encoder_destroy(encoder);
+    return packets;
+}
+
+/// A decode object initialized in its own workbuffer, as the host sets one up
+class TestDecoder {
+public:
+    TestDecoder() : workbuffer(StateSize() / sizeof(u64) + 1) {
+        REQUIRE(Object().InitializeDecoder(SampleRate, ChannelCount) == OPUS_OK);
+    }
+
+    OpusDecodeObject& Object() {
+        const auto address{reinterpret_cast<u64>(workbuffer.data())};
+        return OpusDecodeObject::Initialize(address, address);
+    }
+
+    void* Data() {
+        return workbuffer.data();
+    }
+
+    static u64 StateSize() {
+        return OpusDecodeObject::GetWorkBufferSize(ChannelCount);
+    }
+
+private:
+    std::vector<u64> workbuffer;
+};
+
+/// A multistream decode object with a stream per channel, initialized in its own workbuffer
+class TestMultiStreamDecoder {
+public:
+    TestMultiStreamDecoder() : workbuffer(StateSize() / sizeof(u64) + 1) {
+        auto mapping{MonoStreamMapping};
+        REQUIRE(Object().InitializeDecoder(SampleRate, ChannelCount, ChannelCount, 0,
+                                           mapping.data()) == OPUS_OK);
+    }
+
+    OpusMultiStreamDecodeObject& Object() {
+        const auto address{reinterpret_cast<u64>(workbuffer.data())};
+        return OpusMultiStreamDecodeObject::Initialize(address, address);
+    }
+
+    void* Data() {
+        return workbuffer.data();
+    }
+
+    static u64 StateSize() {
+        return OpusMultiStreamDecodeObject::GetWorkBufferSize(ChannelCount, 0);
+    }
+
+private:
+    std::vector<u64> workbuffer;
+};
+
+DecodeBatchPacket MakePacket(std::span<const u8> packet, std::span<u8> output,
+                             void* state = nullptr) {
+    return {
+        .input_data = reinterpret_cast<u64>(packet.data()),
+        .input_data_size = packet.size_bytes(),
+        .output_data = reinterpret_cast<u64>(output.data()),
+        .output_data_size = output.size_bytes(),
+        .final_range = 0,
+        .state_data = reinterpret_cast<u64>(state),
+    };
+}
+
+/// Decode each packet on its own, as a DecodeInterleaved message does
+template <typename Decoder = TestDecoder>
+std::vector<u8> DecodeEach(const std::vector<std::vector<u8>>& packets) {
+    Decoder decoder;
+    std::vector<u8> output(packets.size() * FrameBytes);
+    for (size_t i = 0; i < packets.size(); i++) {
+        u32 decoded_samples{};
+        REQUIRE(decoder.Object().Decode(decoded_samples,
+                                        reinterpret_cast<u64>(output.data() + i * FrameBytes),
+                                        FrameBytes, reinterpret_cast<u64>(packets[i].data()),
+                                        packets[i].size()) == OPUS_OK);
+        REQUIRE(decoded_samples == FrameSize);
+    }
+    return output;
+}
+
+/**
+ * Stands in for the DSP side of the Opus mailbox, decoding the packets in batch_packets on each
+ * DecodeInterleavedBatch message.
+ */
+class TestDsp {
+public:
+    explicit TestDsp(TestDecoder& decoder_) : decoder{decoder_} {
+        thread = std::jthread([this](std::stop_token stop_token) { Main(stop_token); });
+    }
+
+    ~TestDsp() {
+        mailbox.Send(Direction::DSP, Message::Shutdown);
+        mailbox.Receive(Direction::Host);
+    }
+
+    /**
+     * Decode packets in one round trip to the DSP thread.
+     *
+     * @return The number of packets processed.
+     */
+    u32 Decode(std::span<const DecodeBatchPacket> packets, bool reset) {
+        std::ranges::copy(packets, batch_packets.begin());
+        packet_count = packets.size();
+        reset_requested = reset;
+        mailbox.Send(Direction::DSP, Message::DecodeInterleavedBatch);
+        REQUIRE(mailbox.Receive(Direction::Host) == Message::DecodeInterleavedBatchOK);
+        return processed;
+    }
+
+private:
+    void Main(std::stop_token stop_token) {
+        while (!stop_token.stop_requested()) {
+            const auto msg{mailbox.Receive(Direction::DSP, stop_token)};
+            if (msg == Message::Shutdown) {
+                mailbox.Send(Direction::Host, Message::ShutdownOK);
+                return;
+            }
+            processed = DecodeBatch(decoder.Object(), std::span(batch_packets).first(packet_count),
+                                    batch_results, reset_requested, TestDecoder::StateSize(),
+                                    GetTimeUs);
+            mailbox.Send(Direction::Host, Message::DecodeInterleavedBatchOK);
+        }
+    }
+
+    TestDecoder& decoder;
+    Mailbox mailbox;
+    std::array<DecodeBatchPacket, MaxBatchedPackets> batch_packets{};
+    std::array<DecodeBatchResult, MaxBatchedPackets> batch_results{};
+    size_t packet_count{};
+    bool reset_requested{};
+    u32 processed{};
+    std::jthread thread;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("Opus: Batched decoding matches decoding each packet", "[audio_core]") {
+    const auto packets{EncodeStream(64)};
+    const auto expected{DecodeEach(packets)};
+
+    TestDecoder decoder;
+    std::vector<u8> output(packets.size() * FrameBytes);
+    std::vector<u8> states(MaxBatchedPackets * TestDecoder::StateSize());
+    for (size_t first = 0; first < packets.size(); first += MaxBatchedPackets) {
+        std::array<DecodeBatchPacket, MaxBatchedPackets> batch{};
+        for (size_t i = 0; i < MaxBatchedPackets; i++) {
+            batch[i] = MakePacket(packets[first + i],
+                                  std::span(output).subspan((first + i) * FrameBytes, FrameBytes),
+                                  states.data() + i * TestDecoder::StateSize());
+        }
+        std::array<DecodeBatchResult, MaxBatchedPackets> results{};
+        REQUIRE(DecodeBatch(decoder.Object(), std::span<const DecodeBatchPacket>(batch), results,
+                            false, TestDecoder::StateSize(), GetTimeUs) == MaxBatchedPackets);
+        for (const auto& result : results) {
+            REQUIRE(result.error_code == OPUS_OK);
+            REQUIRE(result.decoded_samples == FrameSize);
+        }
+    }
+    REQUIRE(output == expected);
+}
+
+TEST_CASE("Opus: A saved decoder state continues the stream", "[audio_core]") {
+    const auto packets{EncodeStream(16)};
+    const auto expected{DecodeEach(packets)};
+
+    // Decode ahead, then go back to the state after the first packet, as the host does when the
+    // guest asks for a packet other than the one decoded next
+    TestDecoder decoder;
+    std::vector<u8> scratch(MaxBatchedPackets * FrameBytes);
+    std::vector<u8> states(MaxBatchedPackets * TestDecoder::StateSize());
+    std::array<DecodeBatchPacket, MaxBatchedPackets> batch{};
+    for (size_t i = 0; i < MaxBatchedPackets; i++) {
+        batch[i] = MakePacket(packets[i], std::span(scratch).subspan(i * FrameBytes, FrameBytes),
+                              states.data() + i * TestDecoder::StateSize());
+    }
+    std::array<DecodeBatchResult, MaxBatchedPackets> results{};
+    REQUIRE(DecodeBatch(decoder.Object(), std::span<const DecodeBatchPacket>(batch), results,
+                        false, TestDecoder::StateSize(), GetTimeUs) == MaxBatchedPackets);
+    std::memcpy(decoder.Data(), states.data(), TestDecoder::StateSize());
+
+    std::vector<u8> output(FrameBytes);
+    for (size_t i = 1; i < packets.size(); i++) {
+        const std::array packet{MakePacket(packets[i], output)};
+        REQUIRE(DecodeBatch(decoder.Object(), std::span<const DecodeBatchPacket>(packet),
+                            results, false, 0, GetTimeUs) == 1);
+        REQUIRE(std::memcmp(output.data(), expected.data() + i * FrameBytes, FrameBytes) == 0);
+    }
+}
+
+TEST_CASE("Opus: Batched multistream decoding saves the state of every stream", "[audio_core]") {
+    const auto packets{EncodeMultiStream(16)};
+    const auto expected{DecodeEach<TestMultiStreamDecoder>(packets)};
+
+    TestMultiStreamDecoder decoder;
+    const auto state_size{TestMultiStreamDecoder::StateSize()};
+    std::vector<u8> scratch(MaxBatchedPackets * FrameBytes);
+    std::vector<u8> states(MaxBatchedPackets * state_size);
+    std::array<DecodeBatchPacket, MaxBatchedPackets> batch{};
+    for (size_t i = 0; i < MaxBatchedPackets; i++) {
+        batch[i] = MakePacket(packets[i], std::span(scratch).subspan(i * FrameBytes, FrameBytes),
+                              states.data() + i * state_size);
+    }
+    std::array<DecodeBatchResult, MaxBatchedPackets> results{};
+    REQUIRE(DecodeBatch(decoder.Object(), std::span<const DecodeBatchPacket>(batch), results,
+                        false, state_size, GetTimeUs) == MaxBatchedPackets);
+    REQUIRE(std::memcmp(scratch.data(), expected.data(), scratch.size()) == 0);
+
+    // Going back to the state after the first packet continues both streams from there
+    std::memcpy(decoder.Data(), states.data(), state_size);
+    std::vector<u8> output(FrameBytes);
+    for (size_t i = 1; i < packets.size(); i++) {
+        const std::array packet{MakePacket(packets[i], output)};
+        REQUIRE(DecodeBatch(decoder.Object(), std::span<const DecodeBatchPacket>(packet),
+                            results, false, 0, GetTimeUs) == 1);
+        REQUIRE(results[0].decoded_samples == FrameSize);
+        REQUIRE(std::memcmp(output.data(), expected.data() + i * FrameBytes, FrameBytes) == 0);
+    }
+}
+
+TEST_CASE("Opus: Decode throughput", "[.][audio_core][benchmark]") {
+    // 30 seconds of audio
+    const auto packets{EncodeStream(1500)};
+    std::vector<u8> output(MaxBatchedPackets * FrameBytes);
+    std::vector<u8> states(MaxBatchedPackets * TestDecoder::StateSize());
+
+    TestDecoder decoder;
+    TestDsp dsp{decoder};
+
+    BENCHMARK("One packet per request") {
+        u32 processed{};
+        for (size_t i = 0; i < packets.size(); i++) {
+            const std::array packet{MakePacket(packets[i], std::span(output).first(FrameBytes))};
+            processed += dsp.Decode(packet, i == 0);
+        }
+        return processed;
+    };
+
+    BENCHMARK("Batched requests") {
+        u32 processed{};
+        for (size_t first = 0; first < packets.size(); first += MaxBatchedPackets) {
+            std::array<DecodeBatchPacket, MaxBatchedPackets> batch{};
+            const auto count{std::min(MaxBatchedPackets, packets.size() - first)};
+            for (size_t i = 0; i < count; i++) {
+                batch[i] = MakePacket(packets[first + i],
+                                      std::span(output).subspan(i * FrameBytes, FrameBytes),
+                                      states.data() + i * TestDecoder::StateSize());
+            }
+            processed += dsp.Decode(std::span(batch).first(count), first == 0);
+        }
+        return processed;
+    };
+}
+
+} // namespace AudioCore::ADSP::OpusDecoder
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/common/common.h"
+#include "audio_core/sink/output_mix.h"
+
+namespace AudioCore::Sink {
+namespace {
+
+constexpr std::array<u32, 7> FrameCounts{0, 1, 3, 4, 5, 160, 240};
+constexpr std::array<f32, 5> Volumes{0.0f, 1.0f, 0.5f, 0.999f, 6.62f};
+
+/// Mix buffers holding every channel of a frame, with samples past the PCM16 range to be clamped
+struct MixBuffers {
+    MixBuffers(u32 channel_count, u32 frame_count, u32 seed) {
+        std::mt19937 rng{seed};
+        std::uniform_int_distribution<s32> dist{-50'000, 50'000};
+        samples.resize(channel_count * frame_count);
+        for (auto& sample : samples) {
+            sample = dist(rng);
+        }
+        for (u32 channel = 0; channel < channel_count; channel++) {
+            channels.emplace_back(samples.data() + channel * frame_count, frame_count);
+        }
+    }
+
+    std::vector<s32> samples;
+    std::vector<std::span<const s32>> channels;
+};
+
+// The device sink command's PCM16 conversion followed by SinkStream::AppendBuffer's downmix and
+// volume, as the final mix was originally processed
+std::vector<s16> ReferenceMix(std::span<const std::span<const s32>> inputs, u32 device_channels,
+                              f32 volume, u32 frame_count) {
+    constexpr s32 min{std::numeric_limits<s16>::min()};
+    constexpr s32 max{std::numeric_limits<s16>::max()};
+    const auto system_channels{static_cast<u32>(inputs.size())};
+
+    std::vector<s16> samples(frame_count * system_channels);
+    for (u32 channel = 0; channel < system_channels; channel++) {
+        for (u32 index = 0; index < frame_count; index++) {
+            samples[index * system_channels + channel] =
+                static_cast<s16>(std::clamp(inputs[channel][index], min, max));
+        }
+    }
+
+    const auto scale{[&](s16 sample) {
+        return static_cast<s16>(
+            std::clamp(static_cast<s32>(static_cast<f32>(sample) * volume), min, max));
+    }};
+
+    if (system_channels == 6 && device_channels == 2) {
+        static constexpr std::array<f32, 4> down_mix_coeff{1.0, 0.596f, 0.354f, 0.707f};
+        std::vector<s16> output(frame_count * 2);
+        for (u32 frame = 0; frame < frame_count; frame++) {
+            const auto* in{&samples[frame * 6]};
+            const auto fl{static_cast<f32>(in[0])};
+            const auto fr{static_cast<f32>(in[1])};
+            const auto c{static_cast<f32>(in[2])};
+            const auto lfe{static_cast<f32>(in[3])};
+            const auto bl{static_cast<f32>(in[4])};
+            const auto br{static_cast<f32>(in[5])};
+            const auto left{static_cast<s32>((fl * down_mix_coeff[0] + c * down_mix_coeff[1] +
+                                              lfe * down_mix_coeff[2] + bl * down_mix_coeff[3]) *
+                                             volume)};
+            const auto right{static_cast<s32>((fr * down_mix_coeff[0] + c * down_mix_coeff[1] +
+                                               lfe * down_mix_coeff[2] + br * down_mix_coeff[3]) *
+                                              volume)};
+            output[frame * 2 + 0] = static_cast<s16>(std::clamp(left, min, max));
+            output[frame * 2 + 1] = static_cast<s16>(std::clamp(right, min, max));
+        }
+        return output;
+    }
+
+    if (system_channels == 2 && device_channels == 6) {
+        std::vector<s16> output(frame_count * 6);
+        for (u32 frame = 0; frame < frame_count; frame++) {
+            output[frame * 6 + 0] = scale(samples[frame * 2 + 0]);
+            output[frame * 6 + 1] = scale(samples[frame * 2 + 1]);
+        }
+        return output;
+    }
+
+    for (auto& sample : samples) {
+        sample = scale(sample);
+    }
+    return samples;
+}
+
+// The vector kernels and the compiler may contract multiply-adds differently, which can move a
+// truncated sample by one step
+void RequireMatch(std::span<const s16> output, std::span<const s16> expected) {
+    REQUIRE(output.size() == expected.size());
+    for (size_t i = 0; i < output.size(); i++) {
+        REQUIRE(std::abs(output[i] - expected[i]) <= 1);
+    }
+}
+
+void CheckMatchesReference(u32 input_channels, u32 device_channels) {
+    for (const u32 frame_count : FrameCounts) {
+        const MixBuffers mix{input_channels, frame_count, frame_count + input_channels};
+        const auto output_channels{GetOutputChannels(input_channels, device_channels)};
+        for (const f32 volume : Volumes) {
+            const auto expected{ReferenceMix(mix.channels, device_channels, volume, frame_count)};
+
+            std::vector<s16> scalar(frame_count * output_channels);
+            REQUIRE(MixToDeviceScalar(scalar, mix.channels, device_channels, volume,
+                                      frame_count) == scalar.size());
+            RequireMatch(scalar, expected);
+
+            std::vector<s16> output(frame_count * output_channels);
+            REQUIRE(MixToDevice(output, mix.channels, device_channels, volume, frame_count) ==
+                    output.size());
+            RequireMatch(output, expected);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("OutputMix: Stereo matches the separate passes", "[audio_core]") {
+    CheckMatchesReference(2, 2);
+}
+
+TEST_CASE("OutputMix: Downmix matches the separate passes", "[audio_core]") {
+    CheckMatchesReference(6, 2);
+}
+
+TEST_CASE("OutputMix: Widening and passthrough match the separate passes", "[audio_core]") {
+    CheckMatchesReference(2, 6);
+    CheckMatchesReference(6, 6);
+    CheckMatchesReference(1, 2);
+}
+
+TEST_CASE("OutputMix: Per-frame cost", "[.][audio_core][benchmark]") {
+    // One 5ms audio frame at 48KHz
+    const MixBuffers stereo{2, TargetSampleCount, 1};
+    const MixBuffers surround{6, TargetSampleCount, 2};
+    std::vector<s16> output(TargetSampleCount * 2);
+
+    BENCHMARK("Stereo separate passes") {
+        return ReferenceMix(stereo.channels, 2, 0.8f, TargetSampleCount);
+    };
+    BENCHMARK("Stereo scalar") {
+        return MixToDeviceScalar(output, stereo.channels, 2, 0.8f, TargetSampleCount);
+    };
+    BENCHMARK("Stereo") {
+        return MixToDevice(output, stereo.channels, 2, 0.8f, TargetSampleCount);
+    };
+    BENCHMARK("Downmix separate passes") {
+        return ReferenceMix(surround.channels, 2, 0.8f, TargetSampleCount);
+    };
+    BENCHMARK("Downmix scalar") {
+        return MixToDeviceScalar(output, surround.channels, 2, 0.8f, TargetSampleCount);
+    };
+    BENCHMARK("Downmix") {
+        return MixToDevice(output, surround.channels, 2, 0.8f, TargetSampleCount);
+    };
+}
+
+} // namespace AudioCore::Sink
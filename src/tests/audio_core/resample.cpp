@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/data_source/decode.h"
+#include "audio_core/renderer/command/resample/resample.h"
+#include "common/fixed_point.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+constexpr std::array<u32, 7> SampleCounts{0, 1, 3, 4, 5, 160, 241};
+constexpr std::array<u32, 7> SourceSampleRates{8000, 11025, 16000, 22050, 32000, 44100, 48000};
+constexpr std::array<f32, 5> Pitches{0.25f, 0.5f, 1.0f, 1.2f, 2.0f};
+constexpr std::array<f32, 4> Fractions{0.0f, 0.25f, 0.5f, 0.99f};
+constexpr std::array<SrcQuality, 3> Qualities{SrcQuality::Low, SrcQuality::Medium,
+                                              SrcQuality::High};
+
+std::vector<s16> MakeSamples(size_t count, u32 seed) {
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<s32> dist{std::numeric_limits<s16>::min(),
+                                            std::numeric_limits<s16>::max()};
+    std::vector<s16> samples(count);
+    for (auto& sample : samples) {
+        sample = static_cast<s16>(dist(rng));
+    }
+    return samples;
+}
+
+// The per-sample decode loop DecodeAdpcm was originally written with
+void ReferenceAdpcmFrame(std::span<s16> output, std::span<const u8> data, u8 scale, s32 coeff0,
+                         s32 coeff1, s16& yn0, s16& yn1) {
+    static constexpr std::array<s32, 16> Steps{
+        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
+    };
+    const auto decode_sample = [&](const s32 code) -> s16 {
+        const auto xn = code * (1 << scale);
+        const auto prediction = coeff0 * yn0 + coeff1 * yn1;
+        const auto sample = ((xn << 11) + 0x400 + prediction) >> 11;
+        const auto saturated = std::clamp<s32>(sample, -0x8000, 0x7FFF);
+        yn1 = yn0;
+        yn0 = static_cast<s16>(saturated);
+        return yn0;
+    };
+    for (u32 i = 0; i < AdpcmSamplesPerFrame / 2; i++) {
+        output[i * 2 + 0] = decode_sample(Steps[(data[i] >> 4) & 0xF]);
+        output[i * 2 + 1] = decode_sample(Steps[data[i] & 0xF]);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Resample: Filters are bit-exact", "[audio_core]") {
+    // Enough input for the largest ratio, plus the filter taps
+    const auto input{MakeSamples(1024, 3)};
+    for (const auto quality : Qualities) {
+        for (const u32 source_rate : SourceSampleRates) {
+            for (const f32 pitch : Pitches) {
+                // Computed the same way as DecodeFromWaveBuffers
+                const Common::FixedPoint<49, 15> ratio{static_cast<f32>(source_rate) /
+                                                       static_cast<f32>(TargetSampleRate) * pitch};
+                for (const f32 start_fraction : Fractions) {
+                    for (const u32 count : SampleCounts) {
+                        Common::FixedPoint<49, 15> expected_fraction{start_fraction};
+                        std::vector<s32> expected(count);
+                        ResampleScalar(expected, input, ratio, expected_fraction, count, quality);
+
+                        Common::FixedPoint<49, 15> fraction{start_fraction};
+                        std::vector<s32> output(count);
+                        Resample(output, input, ratio, fraction, count, quality);
+
+                        REQUIRE(output == expected);
+                        REQUIRE(fraction.to_raw() == expected_fraction.to_raw());
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Decode: ADPCM frames are bit-exact", "[audio_core]") {
+    std::mt19937 rng{5};
+    std::uniform_int_distribution<s32> coeff_dist{std::numeric_limits<s16>::min(),
+                                                  std::numeric_limits<s16>::max()};
+    std::uniform_int_distribution<u32> byte_dist{0, 0xFF};
+    for (u32 frame = 0; frame < 4096; frame++) {
+        std::array<u8, AdpcmSamplesPerFrame / 2> data;
+        for (auto& byte : data) {
+            byte = static_cast<u8>(byte_dist(rng));
+        }
+        const u8 scale{static_cast<u8>(frame % 16)};
+        // Real coefficients are within +-2.0 in 5.11 fixed point, which keeps the prediction
+        // within 32 bits
+        const s32 coeff0{coeff_dist(rng) / 2};
+        const s32 coeff1{coeff_dist(rng) / 2};
+        const auto history{MakeSamples(2, frame)};
+
+        s16 expected_yn0{history[0]};
+        s16 expected_yn1{history[1]};
+        std::array<s16, AdpcmSamplesPerFrame> expected;
+        ReferenceAdpcmFrame(expected, data, scale, coeff0, coeff1, expected_yn0, expected_yn1);
+
+        s16 yn0{history[0]};
+        s16 yn1{history[1]};
+        std::array<s16, AdpcmSamplesPerFrame> output;
+        DecodeAdpcmFrame(output, data, scale, coeff0, coeff1, yn0, yn1);
+
+        REQUIRE(output == expected);
+        REQUIRE(yn0 == expected_yn0);
+        REQUIRE(yn1 == expected_yn1);
+    }
+}
+
+TEST_CASE("Resample: Throughput", "[.][audio_core][benchmark]") {
+    // One 5ms audio frame at 48KHz, from a 32KHz voice
+    constexpr u32 SampleCount{240};
+    const auto input{MakeSamples(SampleCount + 8, 1)};
+    std::vector<s32> output(SampleCount);
+    const Common::FixedPoint<49, 15> ratio{32000.0f / 48000.0f};
+
+    BENCHMARK("Medium quality scalar") {
+        Common::FixedPoint<49, 15> fraction{0};
+        ResampleScalar(output, input, ratio, fraction, SampleCount, SrcQuality::Medium);
+        return output[0];
+    };
+    BENCHMARK("Medium quality") {
+        Common::FixedPoint<49, 15> fraction{0};
+        Resample(output, input, ratio, fraction, SampleCount, SrcQuality::Medium);
+        return output[0];
+    };
+    BENCHMARK("High quality scalar") {
+        Common::FixedPoint<49, 15> fraction{0};
+        ResampleScalar(output, input, ratio, fraction, SampleCount, SrcQuality::High);
+        return output[0];
+    };
+    BENCHMARK("High quality") {
+        Common::FixedPoint<49, 15> fraction{0};
+        Resample(output, input, ratio, fraction, SampleCount, SrcQuality::High);
+        return output[0];
+    };
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+#include <random>
+#include <span>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/sink/time_stretch.h"
+
+namespace AudioCore::Sink {
+namespace {
+
+constexpr u32 ChannelCount{2};
+constexpr size_t SampleRate{48'000};
+/// Frames requested by each simulated backend callback
+constexpr size_t CallbackFrames{480};
+
+std::vector<s16> MakeNoise(size_t frame_count) {
+    std::mt19937 rng{1234};
+    std::uniform_int_distribution<s32> dist{-20'000, 20'000};
+    std::vector<s16> samples(frame_count * ChannelCount);
+    for (auto& sample : samples) {
+        sample = static_cast<s16>(dist(rng));
+    }
+    return samples;
+}
+
+std::vector<s16> MakeTone(size_t frame_count, f64 frequency, f64 amplitude) {
+    std::vector<s16> samples(frame_count * ChannelCount);
+    for (size_t frame = 0; frame < frame_count; frame++) {
+        const auto phase{2 * std::numbers::pi * frequency * static_cast<f64>(frame) / SampleRate};
+        samples[frame * 2 + 0] = static_cast<s16>(std::sin(phase) * amplitude);
+        samples[frame * 2 + 1] = static_cast<s16>(std::cos(phase) * amplitude);
+    }
+    return samples;
+}
+
+/**
+ * Run the stretcher the way the sink callback does, pulling input from the source whenever the
+ * stretcher needs more to fill a callback.
+ */
+struct StretchRun {
+    StretchRun(std::span<const s16> source_, f64 tempo, size_t output_frames) : source{source_} {
+        stretcher.Reset(ChannelCount);
+        output.resize(output_frames * ChannelCount);
+        for (size_t written = 0; written < output_frames; written += CallbackFrames) {
+            const auto frames{std::min(CallbackFrames, output_frames - written)};
+            while (stretcher.GetOutputFrames() < frames) {
+                const auto needed{stretcher.GetInputFramesNeeded()};
+                const auto count{needed * ChannelCount};
+                REQUIRE(consumed_frames * ChannelCount + count <= source.size());
+                stretcher.PushInput(source.subspan(consumed_frames * ChannelCount, count));
+                consumed_frames += needed;
+                stretcher.Process(tempo);
+            }
+            REQUIRE(stretcher.PopOutput(std::span(output).subspan(written * ChannelCount),
+                                        frames) == frames);
+        }
+    }
+
+    std::span<const s16> source;
+    TimeStretcher stretcher;
+    std::vector<s16> output;
+    size_t consumed_frames{};
+};
+
+} // Anonymous namespace
+
+TEST_CASE("TimeStretch: Normal tempo passes audio through", "[audio_core]") {
+    const auto source{MakeNoise(SampleRate)};
+    const StretchRun run{source, 1.0, SampleRate / 2};
+
+    // Each sequence continues exactly where the last one ended, so crossfading changes nothing
+    REQUIRE(std::ranges::equal(run.output, std::span(source).first(run.output.size())));
+}
+
+TEST_CASE("TimeStretch: Tempo sets the rate input is consumed at", "[audio_core]") {
+    constexpr size_t OutputFrames{SampleRate * 4};
+    const auto source{MakeTone(SampleRate * 5, 440.0, 12000.0)};
+    for (const f64 tempo : {0.25, 0.5, 0.75, 1.0}) {
+        const StretchRun run{source, tempo, OutputFrames};
+
+        // On top of what it played, the stretcher holds its lookahead and part of a sequence
+        const auto expected{tempo * static_cast<f64>(OutputFrames)};
+        const auto consumed{static_cast<f64>(run.consumed_frames)};
+        REQUIRE(consumed >= expected);
+        REQUIRE(consumed - expected <= static_cast<f64>(TimeStretcher::RequiredInputFrames +
+                                                        TimeStretcher::FramesPerSequence));
+    }
+}
+
+TEST_CASE("TimeStretch: Stretched audio stays continuous", "[audio_core]") {
+    // A splice in the wrong place shows up as a jump much larger than the tone's steepest slope
+    constexpr f64 Amplitude{12000.0};
+    constexpr f64 Frequency{440.0};
+    constexpr f64 MaxStep{Amplitude * 2 * std::numbers::pi * Frequency / SampleRate};
+    const auto source{MakeTone(SampleRate * 2, Frequency, Amplitude)};
+
+    for (const f64 tempo : {0.3, 0.5, 0.8}) {
+        const StretchRun run{source, tempo, SampleRate};
+        for (size_t i = ChannelCount; i < run.output.size(); i++) {
+            REQUIRE(std::abs(run.output[i] - run.output[i - ChannelCount]) <= MaxStep * 1.5);
+        }
+    }
+}
+
+TEST_CASE("TimeStretch: Output is bounded when it is not popped", "[audio_core]") {
+    const auto source{MakeNoise(SampleRate)};
+    TimeStretcher stretcher;
+    stretcher.Reset(ChannelCount);
+
+    size_t consumed_frames{0};
+    for (size_t sequence = 0; sequence < 8; sequence++) {
+        const auto count{stretcher.GetInputFramesNeeded() * ChannelCount};
+        stretcher.PushInput(std::span(source).subspan(consumed_frames * ChannelCount, count));
+        consumed_frames += count / ChannelCount;
+        stretcher.Process(0.5);
+    }
+    REQUIRE(stretcher.GetOutputFrames() >= TimeStretcher::MaxPopFrames);
+    REQUIRE(stretcher.GetOutputFrames() <
+            TimeStretcher::MaxPopFrames + TimeStretcher::FramesPerSequence);
+    REQUIRE(stretcher.Process(0.5) == 0);
+
+    // Popping makes room for more sequences again
+    std::vector<s16> output(TimeStretcher::MaxPopFrames * ChannelCount);
+    REQUIRE(stretcher.PopOutput(output, TimeStretcher::MaxPopFrames) ==
+            TimeStretcher::MaxPopFrames);
+    REQUIRE(stretcher.Process(0.5) == TimeStretcher::FramesPerSequence);
+}
+
+TEST_CASE("TimeStretch: Reset changes the channel count", "[audio_core]") {
+    TimeStretcher stretcher;
+    for (const u32 channels : {6U, 1U, 2U}) {
+        stretcher.Reset(channels);
+        REQUIRE(stretcher.GetChannels() == channels);
+        REQUIRE(stretcher.GetOutputFrames() == 0);
+        REQUIRE(stretcher.GetInputFramesNeeded() == TimeStretcher::RequiredInputFrames);
+
+        const std::vector<s16> input(TimeStretcher::RequiredInputFrames * channels, 1000);
+        stretcher.PushInput(input);
+        REQUIRE(stretcher.Process(1.0) == TimeStretcher::FramesPerSequence);
+        std::vector<s16> output(TimeStretcher::FramesPerSequence * channels);
+        REQUIRE(stretcher.PopOutput(output, TimeStretcher::FramesPerSequence) ==
+                TimeStretcher::FramesPerSequence);
+        REQUIRE(std::ranges::all_of(output, [](s16 sample) { return sample == 1000; }));
+    }
+}
+
+TEST_CASE("TimeStretch: CPU cost per second of audio", "[.][audio_core][benchmark]") {
+    const auto source{MakeNoise(SampleRate * 2)};
+
+    BENCHMARK("Tempo 1.0") {
+        return StretchRun(source, 1.0, SampleRate).output[0];
+    };
+    BENCHMARK("Tempo 0.75") {
+        return StretchRun(source, 0.75, SampleRate).output[0];
+    };
+    BENCHMARK("Tempo 0.5") {
+        return StretchRun(source, 0.5, SampleRate).output[0];
+    };
+}
+
+} // namespace AudioCore::Sink
@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/logging/binary_log.h"
+#include "common/logging/binary_log_file.h"
+#include "common/logging/text_formatter.h"
+
+namespace Common::Log {
+namespace {
+
+enum class TestEnum : u16 {
+    Value = 513,
+};
+
+static_assert(IsCapturable<TestEnum>);
+static_assert(IsCapturable<const char*>);
+static_assert(IsCapturable<std::string>);
+static_assert(!IsCapturable<const u8*>);
+static_assert(!IsCapturable<long double>);
+
+/// A call site's captured record
+struct CapturedCall {
+    RecordHeader header;
+    std::vector<u8> record;
+
+    std::span<const u8> Args() const {
+        return std::span{record}.subspan(sizeof(RecordHeader));
+    }
+};
+
+template <typename... Args>
+CapturedCall Capture(const char* function, unsigned int line_num, std::string_view format,
+                     const Args&... args) {
+    CapturedCall call;
+    const auto size{CapturedRecordSize(args...)};
+    call.record.resize(size);
+    CaptureRecord(call.record.data(), size, Class::Audio, Level::Warning, "src/test.cpp", line_num,
+                  function, format, args...);
+    std::memcpy(&call.header, call.record.data(), sizeof(call.header));
+    return call;
+}
+
+template <typename... Args>
+void RequireRoundTrip(std::string_view format, const Args&... args) {
+    const CapturedCall call = Capture("Function", 1, format, args...);
+    const std::string expected = fmt::vformat(format, fmt::make_format_args(args...));
+    REQUIRE(call.header.size == call.record.size());
+    REQUIRE(call.header.size % RecordAlignment == 0);
+    REQUIRE(FormatCapturedMessage(format, call.Args()) == expected);
+}
+
+std::string TextLine(Class log_class, Level log_level, std::chrono::microseconds timestamp,
+                     const char* filename, unsigned int line_num, const char* function,
+                     std::string message) {
+    const Entry entry{
+        .timestamp = timestamp,
+        .log_class = log_class,
+        .log_level = log_level,
+        .filename = filename,
+        .line_num = line_num,
+        .function = function,
+        .message = std::move(message),
+    };
+    return FormatLogMessage(entry) + '\n';
+}
+
+} // Anonymous namespace
+
+TEST_CASE("BinaryLog: Captured arguments format like the originals", "[common]") {
+    const std::string string{"string"};
+    const std::string_view view{"view"};
+    const char* const literal{"literal"};
+    int value{};
+
+    RequireRoundTrip("No arguments");
+    RequireRoundTrip("{} {} {} {}", -5, 255U, u64{0xFFFF'FFFF'FFFF'FFFF}, s8{-1});
+    RequireRoundTrip("{:#x} {:08b} {:>6}", u32{0xBEEF}, u8{5}, s16{-300});
+    RequireRoundTrip("{} {} {:c}", true, 'c', 'd');
+    RequireRoundTrip("{} {:.3f} {} {:e}", 1.5f, 3.14159, 0.1, 1e100);
+    RequireRoundTrip("{} {:#06x}", TestEnum::Value, TestEnum::Value);
+    RequireRoundTrip("{} {} {} {:>10}", string, view, literal, "padded");
+    RequireRoundTrip("{}", static_cast<const void*>(&value));
+    RequireRoundTrip("{1} {0} {1}", 1, "two");
+    RequireRoundTrip("{}", std::string(1000, 'x'));
+}
+
+TEST_CASE("BinaryLog: Mismatched format strings do not throw", "[common]") {
+    const auto call{Capture("Function", 1, "{} {}", 1)};
+    REQUIRE(FormatCapturedMessage("{} {}", call.Args()).starts_with("{} {}"));
+}
+
+TEST_CASE("BinaryLog: Decodes to the text log", "[common]") {
+    using std::chrono::microseconds;
+
+    BinaryLogEncoder encoder;
+    std::vector<u8> data;
+    encoder.WriteHeader(data);
+
+    std::string expected;
+    for (int i = 0; i < 3; ++i) {
+        // The same call site each time, its strings written once
+        const auto call{Capture("Loop", 10, "Iteration {} of {}", i, "three")};
+        encoder.WriteRecord(data, call.header, call.Args(), microseconds{1'000'000 * i + 5});
+        expected += TextLine(Class::Audio, Level::Warning, microseconds{1'000'000 * i + 5},
+                             "src/test.cpp", 10, "Loop", fmt::format("Iteration {} of three", i));
+    }
+    const size_t one_site_size{data.size()};
+
+    const Entry entry{
+        .timestamp = microseconds{4'000'000},
+        .log_class = Class::Service_SSL,
+        .log_level = Level::Error,
+        .filename = "src/other.cpp",
+        .line_num = 20,
+        .function = "Preformatted",
+        .message = "OpenSSL: error",
+    };
+    encoder.WriteEntry(data, entry);
+    expected += FormatLogMessage(entry) + '\n';
+
+    const auto call{Capture("Other", 30, "{:.2f}", 2.5)};
+    encoder.WriteRecord(data, call.header, call.Args(), microseconds{5'000'000});
+    expected += TextLine(Class::Audio, Level::Warning, microseconds{5'000'000}, "src/test.cpp", 30,
+                         "Other", "2.50");
+
+    std::string text;
+    REQUIRE(DecodeBinaryLog(data, text));
+    REQUIRE(text == expected);
+
+    // A log cut short decodes up to its last whole message
+    text.clear();
+    REQUIRE(!DecodeBinaryLog(std::span{data}.first(one_site_size - 1), text));
+    REQUIRE(expected.starts_with(text));
+    REQUIRE(text.find("Iteration 1 of three") != std::string::npos);
+    REQUIRE(text.find("Iteration 2 of three") == std::string::npos);
+
+    text.clear();
+    const std::vector<u8> not_a_log(64, 'x');
+    REQUIRE(!DecodeBinaryLog(not_a_log, text));
+    REQUIRE(text.empty());
+}
+
+TEST_CASE("BinaryLog: Call site cost", "[.][common][benchmark]") {
+    const std::string name{"audio_renderer"};
+    const u64 address{0x8'0000'0000};
+    const u32 size{0x1000};
+    const auto state{TestEnum::Value};
+    constexpr std::string_view format{"Mapped {} at {:#x}, size {:#x}, state {}"};
+    std::vector<u8> record(256);
+
+    BENCHMARK("Format at the call site") {
+        return fmt::vformat(format, fmt::make_format_args(name, address, size, state)).size();
+    };
+    BENCHMARK("Capture at the call site") {
+        const auto record_size{CapturedRecordSize(name, address, size, state)};
+        CaptureRecord(record.data(), record_size, Class::Audio, Level::Info, "src/test.cpp", 1,
+                      "Function", format, name, address, size, state);
+        return record_size;
+    };
+
+    const auto record_size{CapturedRecordSize(name, address, size, state)};
+    CaptureRecord(record.data(), record_size, Class::Audio, Level::Info, "src/test.cpp", 1,
+                  "Function", format, name, address, size, state);
+    const auto args{std::span<const u8>{record}.subspan(sizeof(RecordHeader))};
+    BENCHMARK("Format a captured record on the backend") {
+        return FormatCapturedMessage(format, args).size();
+    };
+}
+
+} // namespace Common::Log
@@ -75,6 +75,38 @@ TEST_CASE("RingBuffer: Basic Tests", "[common]") {
     REQUIRE(buf.Size() == 0U);
 }
 
+TEST_CASE("RingBuffer: Discard", "[common]") {
+    RingBuffer<char, 4> buf;
+
+    std::vector<char> to_push(3);
+    std::iota(to_push.begin(), to_push.end(), static_cast<char>(1));
+    REQUIRE(buf.Push(to_push) == 3U);
+
+    // Discarding values should drop them from the front of the ring buffer.
+    REQUIRE(buf.Discard(2) == 2U);
+    REQUIRE(buf.Size() == 1U);
+    {
+        const std::vector<char> popped = buf.Pop(1);
+        REQUIRE(popped.size() == 1U);
+        REQUIRE(popped[0] == 3);
+    }
+
+    // Discarding more values than are held should only drop what is there, across the wrap.
+    REQUIRE(buf.Push(to_push) == 3U);
+    REQUIRE(buf.Discard() == 3U);
+    REQUIRE(buf.Size() == 0U);
+    REQUIRE(buf.Discard(1) == 0U);
+
+    // The ring buffer should still be usable after discarding.
+    REQUIRE(buf.Push(to_push) == 3U);
+    {
+        const std::vector<char> popped = buf.Pop();
+        REQUIRE(popped.size() == 3U);
+        REQUIRE(popped[0] == 1);
+        REQUIRE(popped[2] == 3);
+    }
+}
+
 TEST_CASE("RingBuffer: Threaded Test", "[common]") {
     RingBuffer<char, 8> buf;
     const char seed = 42;
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "common/seqlock.h"
+
+namespace Common {
+namespace {
+
+/// Controller state as published by an input driver, sized like the npad input state
+struct PadState {
+    u64 sequence{};
+    s64 publish_time{};
+    std::array<u64, 5> values{};
+};
+
+s64 Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+PadState MakeState(u64 sequence) {
+    PadState state{
+        .sequence = sequence,
+        .publish_time = Now(),
+    };
+    state.values.fill(sequence);
+    return state;
+}
+
+bool IsWhole(const PadState& state) {
+    return std::ranges::all_of(state.values, [&](u64 value) { return value == state.sequence; });
+}
+
+/// Controller state behind a mutex, as the npad service used to read it
+class LockedState {
+public:
+    void Write(const PadState& value) {
+        std::scoped_lock lock{mutex};
+        state = value;
+    }
+
+    PadState Read() const {
+        std::scoped_lock lock{mutex};
+        return state;
+    }
+
+private:
+    mutable std::mutex mutex;
+    PadState state;
+};
+
+/**
+ * Synthetic input driver, publishing new states until stopped
+ *
+ * @param interval - Time between states, or zero to publish as fast as possible.
+ */
+template <typename State>
+std::jthread StartDriver(State& state, std::chrono::microseconds interval = {}) {
+    return std::jthread([&state, interval](std::stop_token stop_token) {
+        for (u64 sequence = 1; !stop_token.stop_requested(); ++sequence) {
+            state.Write(MakeState(sequence));
+            if (interval.count() != 0) {
+                std::this_thread::sleep_for(interval);
+            }
+        }
+    });
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SeqLock: Readers only see whole values", "[common]") {
+    SeqLock<PadState> state;
+    REQUIRE(state.Read().sequence == 0);
+    REQUIRE(state.WriteCount() == 0);
+
+    std::atomic<u32> torn_reads{};
+    std::atomic<u32> reordered_reads{};
+    {
+        const auto driver = StartDriver(state);
+        std::vector<std::jthread> readers;
+        for (int i = 0; i < 3; ++i) {
+            readers.emplace_back([&] {
+                u64 last_sequence{};
+                for (int read = 0; read < 100000; ++read) {
+                    const PadState value = state.Read();
+                    if (!IsWhole(value)) {
+                        ++torn_reads;
+                    }
+                    if (value.sequence < last_sequence) {
+                        ++reordered_reads;
+                    }
+                    last_sequence = value.sequence;
+                }
+            });
+        }
+    }
+    REQUIRE(torn_reads == 0);
+    REQUIRE(reordered_reads == 0);
+    // The driver numbers its states from one, so the last one is numbered as the write count
+    REQUIRE(state.Read().sequence == state.WriteCount());
+}
+
+TEST_CASE("SeqLock: Reading while a driver writes", "[.][common][benchmark]") {
+    LockedState locked;
+    SeqLock<PadState> seqlock;
+    {
+        const auto driver = StartDriver(locked);
+        BENCHMARK("Mutex") {
+            return locked.Read().sequence;
+        };
+    }
+    {
+        const auto driver = StartDriver(seqlock);
+        BENCHMARK("SeqLock") {
+            return seqlock.Read().sequence;
+        };
+    }
+
+    // Time from a 1 kHz driver publishing a state to the update thread, ticking as often,
+    // copying it out as it does into hid shared memory
+    const auto report = [](const char* label, auto& state) {
+        constexpr size_t NumReads = 2000;
+        constexpr std::chrono::microseconds Interval{1000};
+        std::vector<s64> latencies;
+        latencies.reserve(NumReads);
+        {
+            const auto driver = StartDriver(state, Interval);
+            while (state.Read().sequence == 0) {
+                std::this_thread::yield();
+            }
+            u64 last_sequence{};
+            while (latencies.size() < NumReads) {
+                const PadState value = state.Read();
+                if (value.sequence != last_sequence) {
+                    latencies.push_back(Now() - value.publish_time);
+                    last_sequence = value.sequence;
+                }
+                std::this_thread::sleep_for(Interval);
+            }
+        }
+        std::ranges::sort(latencies);
+        const auto at = [&](f64 percentile) {
+            const auto index{static_cast<size_t>(percentile * (latencies.size() - 1))};
+            return static_cast<f64>(latencies[index]) / 1000.0;
+        };
+        WARN(fmt::format("{}: publish to read p50 {:.2f}us, p99 {:.2f}us, max {:.2f}us", label,
+                         at(0.5), at(0.99), at(1.0)));
+    };
+    report("Mutex", locked);
+    report("SeqLock", seqlock);
+}
+
+} // namespace Common
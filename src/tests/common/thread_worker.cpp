@@ -0,0 +1,293 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/thread_worker.h"
+#include "common/work_stealing_deque.h"
+
+namespace Common {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t NumWorkers{4};
+
+/// The single locked queue the thread worker was built on, to compare against
+class LockedThreadWorker {
+public:
+    explicit LockedThreadWorker(size_t num_workers) {
+        for (size_t i = 0; i < num_workers; ++i) {
+            threads.emplace_back([this](std::stop_token stop_token) {
+                while (!stop_token.stop_requested()) {
+                    UniqueFunction<void> task;
+                    {
+                        std::unique_lock lock{queue_mutex};
+                        if (requests.empty()) {
+                            wait_condition.notify_all();
+                        }
+                        Common::CondvarWait(condition, lock, stop_token,
+                                            [this] { return !requests.empty(); });
+                        if (stop_token.stop_requested()) {
+                            break;
+                        }
+                        task = std::move(requests.front());
+                        requests.pop();
+                    }
+                    task();
+                    ++work_done;
+                }
+            });
+        }
+    }
+
+    void QueueWork(UniqueFunction<void> work) {
+        {
+            std::unique_lock lock{queue_mutex};
+            requests.emplace(std::move(work));
+            ++work_scheduled;
+        }
+        condition.notify_one();
+    }
+
+    void WaitForRequests() {
+        std::unique_lock lock{queue_mutex};
+        wait_condition.wait(lock, [this] { return work_done >= work_scheduled; });
+    }
+
+private:
+    std::queue<UniqueFunction<void>> requests;
+    std::mutex queue_mutex;
+    std::condition_variable_any condition;
+    std::condition_variable wait_condition;
+    std::atomic<size_t> work_scheduled{};
+    std::atomic<size_t> work_done{};
+    std::vector<std::jthread> threads;
+};
+
+void Spin(std::chrono::nanoseconds duration) {
+    const auto end{Clock::now() + duration};
+    while (Clock::now() < end) {
+    }
+}
+
+/**
+ * Queue a burst of tasks taking the given time, with about the same total work for every task
+ * length, and wait for them.
+ *
+ * @return The time each task waited between being queued and starting, sorted.
+ */
+template <typename Worker>
+std::vector<Clock::duration> RunBurst(Worker& worker, std::chrono::microseconds task_time) {
+    const auto count{static_cast<size_t>(std::chrono::milliseconds{64} / task_time)};
+    std::vector<Clock::duration> latencies(count);
+    for (size_t i = 0; i < count; ++i) {
+        worker.QueueWork([&latencies, i, task_time, queued = Clock::now()] {
+            latencies[i] = Clock::now() - queued;
+            Spin(task_time);
+        });
+    }
+    worker.WaitForRequests();
+    std::ranges::sort(latencies);
+    return latencies;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("WorkStealingDeque: Owner pops newest, thieves steal oldest", "[common]") {
+    WorkStealingDeque<int*> deque{4};
+    std::array<int, 100> items{};
+    for (auto& item : items) {
+        deque.Push(&item);
+    }
+    REQUIRE(deque.Steal() == &items[0]);
+    REQUIRE(deque.Steal() == &items[1]);
+    REQUIRE(deque.Pop() == &items[99]);
+    REQUIRE(deque.Pop() == &items[98]);
+    for (size_t i = 2; i < 98; ++i) {
+        REQUIRE(deque.Steal() == &items[i]);
+    }
+    REQUIRE(deque.Empty());
+    REQUIRE(deque.Pop() == nullptr);
+    REQUIRE(deque.Steal() == nullptr);
+}
+
+TEST_CASE("WorkStealingDeque: Every item is taken once under contention", "[common]") {
+    constexpr size_t NumItems{200'000};
+    std::vector<int> items(NumItems);
+    std::vector<std::atomic<u32>> taken(NumItems);
+    WorkStealingDeque<int*> deque;
+    std::atomic<bool> done{};
+
+    const auto take = [&](int* item) {
+        taken[static_cast<size_t>(item - items.data())]++;
+    };
+    std::vector<std::jthread> thieves;
+    for (size_t i = 0; i < NumWorkers; ++i) {
+        thieves.emplace_back([&] {
+            while (!done || !deque.Empty()) {
+                if (int* const item{deque.Steal()}) {
+                    take(item);
+                }
+            }
+        });
+    }
+    for (size_t i = 0; i < NumItems; ++i) {
+        deque.Push(&items[i]);
+        if (i % 3 == 0) {
+            if (int* const item{deque.Pop()}) {
+                take(item);
+            }
+        }
+    }
+    while (int* const item{deque.Pop()}) {
+        take(item);
+    }
+    done = true;
+    thieves.clear();
+
+    REQUIRE(std::ranges::all_of(taken, [](const auto& count) { return count == 1; }));
+}
+
+TEST_CASE("ThreadWorker: Runs every task", "[common]") {
+    constexpr size_t NumTasks{100'000};
+    std::vector<std::atomic<u32>> runs(NumTasks);
+    ThreadWorker worker{NumWorkers, "ThreadWorkerTest"};
+    for (size_t i = 0; i < NumTasks; ++i) {
+        worker.QueueWork([&runs, i] { runs[i]++; });
+    }
+    worker.WaitForRequests();
+    REQUIRE(std::ranges::all_of(runs, [](const auto& count) { return count == 1; }));
+
+    // The worker can be waited on again for a new batch
+    worker.QueueWork([&runs] { runs[0]++; });
+    worker.WaitForRequests();
+    REQUIRE(runs[0] == 2);
+}
+
+TEST_CASE("ThreadWorker: Tasks queued by a task run", "[common]") {
+    std::atomic<u32> runs{};
+    ThreadWorker worker{NumWorkers, "ThreadWorkerTest"};
+    for (size_t i = 0; i < 64; ++i) {
+        worker.QueueWork([&] {
+            for (size_t j = 0; j < 64; ++j) {
+                worker.QueueWork([&] { runs++; });
+            }
+        });
+    }
+    worker.WaitForRequests();
+    REQUIRE(runs == 64 * 64);
+}
+
+TEST_CASE("ThreadWorker: Single worker keeps the queued order", "[common]") {
+    std::vector<size_t> order;
+    ThreadWorker worker{1, "ThreadWorkerTest"};
+    for (size_t i = 0; i < 1000; ++i) {
+        worker.QueueWork([&order, i] { order.push_back(i); });
+    }
+    worker.WaitForRequests();
+    REQUIRE(order.size() == 1000);
+    REQUIRE(std::ranges::is_sorted(order));
+}
+
+TEST_CASE("ThreadWorker: Single worker keeps the order of tasks queued by tasks", "[common]") {
+    std::vector<size_t> order;
+    ThreadWorker worker{1, "ThreadWorkerTest"};
+    worker.QueueWork([&] {
+        for (size_t i = 0; i < 1000; ++i) {
+            worker.QueueWork([&order, i] { order.push_back(i); });
+        }
+    });
+    worker.WaitForRequests();
+    REQUIRE(order.size() == 1000);
+    REQUIRE(std::ranges::is_sorted(order));
+}
+
+TEST_CASE("ThreadWorker: High priority tasks run first", "[common]") {
+    std::atomic<bool> release{};
+    std::vector<TaskPriority> order;
+    ThreadWorker worker{1, "ThreadWorkerTest"};
+
+    // Hold the worker until everything is queued
+    worker.QueueWork([&] {
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    for (size_t i = 0; i < 16; ++i) {
+        worker.QueueWork([&] { order.push_back(TaskPriority::Normal); });
+        worker.QueueWork([&] { order.push_back(TaskPriority::High); }, TaskPriority::High);
+    }
+    release = true;
+    worker.WaitForRequests();
+
+    REQUIRE(order.size() == 32);
+    REQUIRE(std::ranges::all_of(order.begin(), order.begin() + 16,
+                                [](TaskPriority p) { return p == TaskPriority::High; }));
+}
+
+TEST_CASE("ThreadWorker: Each worker has its own state", "[common]") {
+    std::mutex mutex;
+    std::set<const std::string*> states;
+    std::atomic<u32> runs{};
+    std::atomic<u32> valid_states{};
+    StatefulThreadWorker<std::string> worker{NumWorkers, "ThreadWorkerTest",
+                                             [] { return std::string{"state"}; }};
+    for (size_t i = 0; i < 1000; ++i) {
+        worker.QueueWork([&](std::string* state) {
+            if (*state == "state") {
+                valid_states++;
+            }
+            std::scoped_lock lock{mutex};
+            states.insert(state);
+            runs++;
+        });
+    }
+    worker.WaitForRequests();
+    REQUIRE(runs == 1000);
+    REQUIRE(valid_states == 1000);
+    REQUIRE(states.size() <= NumWorkers);
+}
+
+TEST_CASE("ThreadWorker: Throughput and tail latency", "[.][common][benchmark]") {
+    const auto workers{std::max(std::thread::hardware_concurrency(), 2U) / 2};
+    ThreadWorker stealing{workers, "ThreadWorkerBench"};
+    LockedThreadWorker locked{workers};
+
+    for (const auto task_time : {std::chrono::microseconds{1}, std::chrono::microseconds{10},
+                                 std::chrono::microseconds{100}, std::chrono::microseconds{1000}}) {
+        const auto name{fmt::format("{}us tasks", task_time.count())};
+        BENCHMARK(name + ", locked queue") {
+            return RunBurst(locked, task_time).size();
+        };
+        BENCHMARK(name + ", work stealing") {
+            return RunBurst(stealing, task_time).size();
+        };
+
+        const auto report = [&](const char* label, const auto& latencies) {
+            const auto at = [&](f64 percentile) {
+                const auto index{static_cast<size_t>(percentile * (latencies.size() - 1))};
+                return std::chrono::duration<f64, std::micro>(latencies[index]).count();
+            };
+            WARN(fmt::format("{}, {}: queue to start p50 {:.1f}us, p99 {:.1f}us, max {:.1f}us",
+                             name, label, at(0.5), at(0.99), at(1.0)));
+        };
+        report("locked queue", RunBurst(locked, task_time));
+        report("work stealing", RunBurst(stealing, task_time));
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/microprofile.h"
+#include "common/thread.h"
+#include "common/tracing.h"
+
+MICROPROFILE_DEFINE(Test_Outer, "Test", "Outer", MP_RGB(255, 0, 0));
+MICROPROFILE_DEFINE(Test_Inner, "Test", "Inner", MP_RGB(0, 255, 0));
+
+namespace Common::Tracing {
+namespace {
+
+void RunScopes(int count) {
+    for (int i = 0; i < count; ++i) {
+        MICROPROFILE_SCOPE(Test_Outer);
+        MICROPROFILE_SCOPE(Test_Inner);
+    }
+}
+
+size_t CountOccurrences(const std::string& string, std::string_view value) {
+    size_t count{};
+    for (size_t pos = string.find(value); pos != std::string::npos;
+         pos = string.find(value, pos + value.size())) {
+        ++count;
+    }
+    return count;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Tracing: Records the scopes of every thread", "[common]") {
+    const auto path{std::filesystem::temp_directory_path() / "yuzu_tracing_test.json"};
+    constexpr int ScopesPerThread{1000};
+
+    // Not recorded, as tracing has not started
+    RunScopes(10);
+
+    REQUIRE(Start(path));
+    REQUIRE(IsRecording());
+    REQUIRE(!Start(path));
+
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([i] {
+            SetCurrentThreadName(fmt::format("TraceTest{}", i).c_str());
+            RunScopes(ScopesPerThread);
+        });
+    }
+    threads.clear();
+    Stop();
+    REQUIRE(!IsRecording());
+
+    // Not recorded, as tracing has stopped
+    RunScopes(10);
+
+    const auto trace{FS::ReadStringFromFile(path, FS::FileType::TextFile)};
+    std::filesystem::remove(path);
+
+    REQUIRE(trace.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+    REQUIRE(trace.ends_with("]}\n"));
+    REQUIRE(CountOccurrences(trace, R"({"name":"Outer","cat":"Test","ph":"X")") ==
+            3 * ScopesPerThread);
+    REQUIRE(CountOccurrences(trace, R"({"name":"Inner","cat":"Test","ph":"X")") ==
+            3 * ScopesPerThread);
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(CountOccurrences(trace, fmt::format(R"({{"name":"TraceTest{}"}})", i)) == 1);
+    }
+}
+
+TEST_CASE("Tracing: Scope cost", "[.][common][benchmark]") {
+    BENCHMARK("MicroProfile scope") {
+        const auto tick{MicroProfileEnter(MICROPROFILE_TOKEN(Test_Outer))};
+        MicroProfileLeave(MICROPROFILE_TOKEN(Test_Outer), tick);
+    };
+    BENCHMARK("Traced scope, not recording") {
+        MICROPROFILE_SCOPE(Test_Outer);
+    };
+
+    const auto path{std::filesystem::temp_directory_path() / "yuzu_tracing_benchmark.json"};
+    REQUIRE(Start(path));
+    BENCHMARK("Traced scope, recording") {
+        MICROPROFILE_SCOPE(Test_Outer);
+    };
+    Stop();
+    std::filesystem::remove(path);
+}
+
+} // namespace Common::Tracing
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/hle/service/sockets/socket_waiter.h"
+#include "core/internal_network/network.h"
+#include "core/internal_network/sockets.h"
+
+namespace Service::Sockets {
+namespace {
+
+using namespace std::chrono_literals;
+
+/// Counts the callbacks of a waiter, which are made from its thread
+class DoneCounter {
+public:
+    void Notify() {
+        {
+            std::scoped_lock lock{mutex};
+            ++count;
+        }
+        cv.notify_all();
+    }
+
+    /// Waits for a wait to be done, returning whether it was before the timeout
+    bool WaitFor(const SocketWaiter::Wait& wait, std::chrono::milliseconds timeout) {
+        std::unique_lock lock{mutex};
+        return cv.wait_for(lock, timeout,
+                           [&] { return wait.done.load(std::memory_order_acquire); });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    u64 count{};
+};
+
+std::shared_ptr<Network::Socket> MakeLoopbackSocket() {
+    auto socket = std::make_shared<Network::Socket>();
+    REQUIRE(socket->Initialize(Network::Domain::INET, Network::Type::DGRAM,
+                               Network::Protocol::UDP) == Network::Errno::SUCCESS);
+    REQUIRE(socket->Bind({Network::Domain::INET, {127, 0, 0, 1}, 0}) == Network::Errno::SUCCESS);
+    return socket;
+}
+
+void SendTo(Network::Socket& socket) {
+    const auto [addr, bsd_errno] = socket.GetSockName();
+    REQUIRE(bsd_errno == Network::Errno::SUCCESS);
+    const std::array<u8, 4> message{1, 2, 3, 4};
+    REQUIRE(socket.SendTo(0, message, &addr).first == static_cast<s32>(message.size()));
+}
+
+std::shared_ptr<SocketWaiter::Wait> MakeWait(std::shared_ptr<Network::Socket> socket) {
+    auto wait = std::make_shared<SocketWaiter::Wait>();
+    wait->socket = std::move(socket);
+    wait->events = Network::PollEvents::In;
+    wait->start = SocketWaiter::Clock::now();
+    return wait;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SocketWaiter: Completes waits", "[core]") {
+    Network::NetworkInstance network_instance;
+    DoneCounter counter;
+    SocketWaiter waiter{[&counter] { counter.Notify(); }};
+
+    SECTION("Ready socket") {
+        const auto socket = MakeLoopbackSocket();
+        const auto wait = MakeWait(socket);
+        waiter.Add(wait);
+        REQUIRE(!counter.WaitFor(*wait, 20ms));
+
+        SendTo(*socket);
+        REQUIRE(counter.WaitFor(*wait, 1000ms));
+        REQUIRE(!wait->timed_out);
+        wait->claimed = true;
+    }
+
+    SECTION("Timed out wait") {
+        const auto wait = MakeWait(MakeLoopbackSocket());
+        wait->deadline = wait->start + 20ms;
+        waiter.Add(wait);
+        REQUIRE(counter.WaitFor(*wait, 1000ms));
+        REQUIRE(wait->timed_out);
+        REQUIRE(SocketWaiter::Clock::now() >= wait->deadline);
+        wait->claimed = true;
+    }
+
+    SECTION("Removed socket") {
+        const auto socket = MakeLoopbackSocket();
+        const auto wait = MakeWait(socket);
+        waiter.Add(wait);
+        waiter.Remove(*socket);
+        // Remove returns once the waiter thread no longer uses the socket
+        REQUIRE(wait->done);
+        REQUIRE(socket->Close() == Network::Errno::SUCCESS);
+        wait->claimed = true;
+    }
+}
+
+TEST_CASE("SocketWaiter: Wake up latency", "[.][core][benchmark]") {
+    Network::NetworkInstance network_instance;
+
+    // Latency from sending a datagram to the callback of a waiter on the receiving socket
+    {
+        DoneCounter counter;
+        SocketWaiter waiter{[&counter] { counter.Notify(); }};
+        const auto socket = MakeLoopbackSocket();
+        std::array<u8, 16> message;
+        BENCHMARK("SocketWaiter") {
+            const auto wait = MakeWait(socket);
+            waiter.Add(wait);
+            SendTo(*socket);
+            counter.WaitFor(*wait, 1000ms);
+            wait->claimed = true;
+            return socket->Recv(0, message).first;
+        };
+    }
+
+    // Latency from sending a datagram to a thread blocked receiving it, as a service thread was
+    {
+        const auto socket = MakeLoopbackSocket();
+        std::mutex mutex;
+        std::condition_variable cv;
+        u64 sent{};
+        u64 received{};
+        std::jthread receiver([&](std::stop_token stop_token) {
+            std::array<u8, 16> message;
+            while (socket->Recv(0, message).first > 0 && !stop_token.stop_requested()) {
+                {
+                    std::scoped_lock lock{mutex};
+                    ++received;
+                }
+                cv.notify_all();
+            }
+        });
+        BENCHMARK("Blocking Recv") {
+            SendTo(*socket);
+            std::unique_lock lock{mutex};
+            ++sent;
+            cv.wait(lock, [&] { return received >= sent; });
+        };
+        receiver.request_stop();
+        SendTo(*socket);
+    }
+}
+
+} // namespace Service::Sockets
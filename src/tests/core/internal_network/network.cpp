@@ -1,11 +1,45 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <memory>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "core/internal_network/network.h"
 #include "core/internal_network/sockets.h"
 
+namespace {
+
+/// Creates a UDP socket bound to an ephemeral loopback port
+std::unique_ptr<Network::Socket> MakeLoopbackSocket() {
+    auto socket = std::make_unique<Network::Socket>();
+    REQUIRE(socket->Initialize(Network::Domain::INET, Network::Type::DGRAM,
+                               Network::Protocol::UDP) == Network::Errno::SUCCESS);
+    REQUIRE(socket->Bind({Network::Domain::INET, {127, 0, 0, 1}, 0}) == Network::Errno::SUCCESS);
+    return socket;
+}
+
+/// Sends a datagram to a socket, making it readable until it is received
+void SendTo(Network::Socket& socket) {
+    const auto [addr, bsd_errno] = socket.GetSockName();
+    REQUIRE(bsd_errno == Network::Errno::SUCCESS);
+    const std::array<u8, 4> message{1, 2, 3, 4};
+    REQUIRE(socket.SendTo(0, message, &addr).first == static_cast<s32>(message.size()));
+}
+
+std::vector<Network::PollFD> MakePollFDs(
+    const std::vector<std::unique_ptr<Network::Socket>>& sockets) {
+    std::vector<Network::PollFD> poll_fds;
+    for (const auto& socket : sockets) {
+        poll_fds.push_back({socket.get(), Network::PollEvents::In, Network::PollEvents{}});
+    }
+    return poll_fds;
+}
+
+} // Anonymous namespace
+
 TEST_CASE("Network::Errors", "[core]") {
     Network::NetworkInstance network_instance; // initialize network
 
@@ -25,3 +59,81 @@ TEST_CASE("Network::Errors", "[core]") {
     std::vector<u8> message{1, 2, 3, 4};
     REQUIRE(socks[1].Recv(0, message).second == Network::Errno::NOTCONN);
 }
+
+TEST_CASE("Network::Poller", "[core]") {
+    Network::NetworkInstance network_instance;
+    Network::Poller poller;
+
+    std::vector<std::unique_ptr<Network::Socket>> sockets;
+    for (int i = 0; i < 3; ++i) {
+        sockets.push_back(MakeLoopbackSocket());
+    }
+    auto poll_fds = MakePollFDs(sockets);
+    REQUIRE(poller.Poll(poll_fds, 0).first == 0);
+
+    SendTo(*sockets[1]);
+    REQUIRE(poller.Poll(poll_fds, 100).first == 1);
+    REQUIRE(poll_fds[0].revents == Network::PollEvents{});
+    REQUIRE(poll_fds[1].revents == Network::PollEvents::In);
+    REQUIRE(poll_fds[2].revents == Network::PollEvents{});
+
+    // The same socket may be polled twice, for different events
+    poll_fds.push_back({sockets[1].get(), Network::PollEvents::Out, Network::PollEvents{}});
+    REQUIRE(poller.Poll(poll_fds, 0).first == 2);
+    REQUIRE(poll_fds[1].revents == Network::PollEvents::In);
+    REQUIRE(poll_fds[3].revents == Network::PollEvents::Out);
+
+    // The ready socket is no longer polled
+    std::vector<Network::PollFD> others{poll_fds[0], poll_fds[2]};
+    REQUIRE(poller.Poll(others, 0).first == 0);
+
+    // A socket may stop being polled for any event, then be polled for some again
+    others = {{sockets[1].get(), Network::PollEvents{}, Network::PollEvents{}}};
+    REQUIRE(poller.Poll(others, 0).first == 0);
+    REQUIRE(others[0].revents == Network::PollEvents{});
+    others[0].events = Network::PollEvents::In;
+    REQUIRE(poller.Poll(others, 0).first == 1);
+    REQUIRE(others[0].revents == Network::PollEvents::In);
+
+    // A new socket may take the descriptor of a closed one
+    poller.Forget(*sockets[2]);
+    REQUIRE(sockets[2]->Close() == Network::Errno::SUCCESS);
+    sockets[2] = MakeLoopbackSocket();
+    SendTo(*sockets[2]);
+    poll_fds = MakePollFDs(sockets);
+    REQUIRE(poller.Poll(poll_fds, 100).first == 2);
+    REQUIRE(poll_fds[2].revents == Network::PollEvents::In);
+
+    // Results match those of Poll
+    auto expected = MakePollFDs(sockets);
+    REQUIRE(Network::Poll(expected, 0).first == 2);
+    for (size_t i = 0; i < poll_fds.size(); ++i) {
+        REQUIRE(poll_fds[i].revents == expected[i].revents);
+    }
+}
+
+TEST_CASE("Network::Poller: 1000 loopback sockets", "[.][core][benchmark]") {
+    Network::NetworkInstance network_instance;
+
+    std::vector<std::unique_ptr<Network::Socket>> sockets;
+    for (int i = 0; i < 1000; ++i) {
+        sockets.push_back(MakeLoopbackSocket());
+    }
+    // A few sockets stay readable, as a busy guest would have
+    for (size_t i = 0; i < sockets.size(); i += 100) {
+        SendTo(*sockets[i]);
+    }
+    const auto poll_fds = MakePollFDs(sockets);
+
+    BENCHMARK("Poll") {
+        // As guest polls used to do, with the socket list built again for each poll
+        std::vector<Network::PollFD> host_fds(poll_fds);
+        return Network::Poll(host_fds, 0).first;
+    };
+
+    Network::Poller poller;
+    std::vector<Network::PollFD> host_fds(poll_fds);
+    BENCHMARK("Poller") {
+        return poller.Poll(host_fds, 0).first;
+    };
+}
@@ -0,0 +1,234 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/input.h"
+#include "hid_core/frontend/motion_batcher.h"
+#include "hid_core/frontend/motion_input.h"
+
+namespace Core::HID {
+namespace {
+
+/// Sample period of the synthetic sensor, in nanoseconds
+constexpr s64 SensorPeriod = 1'000'000;
+
+/// Update period of the six axis resources, in nanoseconds
+constexpr s64 UpdatePeriod = 5'000'000;
+
+Common::Input::MotionStatus MakeStatus(const Common::Vec3f& gyro, const Common::Vec3f& accel) {
+    Common::Input::MotionStatus status{};
+    status.gyro.x.value = gyro.x;
+    status.gyro.y.value = gyro.y;
+    status.gyro.z.value = gyro.z;
+    status.gyro.x.properties.threshold = MotionInput::ThresholdStandard;
+    status.accel.x.value = accel.x;
+    status.accel.y.value = accel.y;
+    status.accel.z.value = accel.z;
+    status.delta_timestamp = SensorPeriod / 1000;
+    return status;
+}
+
+/// Sample of a sensor turning around its z axis, shaken slightly
+Common::Input::MotionStatus MakeTurningStatus(int index) {
+    const f32 shake = 0.05f * std::sin(static_cast<f32>(index) * 0.1f);
+    return MakeStatus({shake, 0.0f, 0.5f}, {shake, 0.0f, -1.0f});
+}
+
+/// Fuses a sample as EmulatedController::SetMotion did for each sample before batching
+void FuseSample(MotionInput& input, const Common::Input::MotionStatus& status) {
+    input.SetAcceleration({status.accel.x.value, status.accel.y.value, status.accel.z.value});
+    input.SetGyroscope({status.gyro.x.value, status.gyro.y.value, status.gyro.z.value});
+    input.SetUserGyroThreshold(status.gyro.x.properties.threshold);
+    input.UpdateRotation(status.delta_timestamp);
+    input.UpdateOrientation(status.delta_timestamp);
+}
+
+bool IsNear(f32 a, f32 b, f32 tolerance) {
+    return std::abs(a - b) <= tolerance;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MotionBatcher: Fuses batches as each sample would be", "[hid_core]") {
+    MotionInput reference;
+    MotionInput batched;
+    MotionBatcher batcher;
+    Common::Input::MotionStatus raw_status{};
+
+    int index = 0;
+    for (int batch_size = 1; batch_size <= 100; ++batch_size) {
+        for (int i = 0; i < batch_size; ++i, ++index) {
+            const auto status = MakeTurningStatus(index);
+            FuseSample(reference, status);
+            batcher.Push(status, index * SensorPeriod);
+        }
+        REQUIRE(batcher.Process(batched, raw_status));
+    }
+    REQUIRE(!batcher.Process(batched, raw_status));
+
+    const auto expected = reference.GetQuaternion();
+    const auto fused = batcher.Sample(index * SensorPeriod);
+    REQUIRE(IsNear(fused.quat.w, expected.w, 1e-4f));
+    REQUIRE(IsNear(fused.quat.xyz.x, expected.xyz.x, 1e-4f));
+    REQUIRE(IsNear(fused.quat.xyz.y, expected.xyz.y, 1e-4f));
+    REQUIRE(IsNear(fused.quat.xyz.z, expected.xyz.z, 1e-4f));
+    REQUIRE(IsNear(fused.rotations.z, reference.GetRotations().z, 1e-3f));
+    REQUIRE(raw_status.delta_timestamp == SensorPeriod / 1000);
+}
+
+TEST_CASE("MotionBatcher: Resamples on the sensor clock", "[hid_core]") {
+    MotionInput input;
+    MotionBatcher batcher;
+    Common::Input::MotionStatus raw_status{};
+
+    // Samples arrive up to 3ms late, but in order
+    std::mt19937 random{42};
+    std::uniform_int_distribution<s64> jitter{0, 3 * SensorPeriod};
+    s64 arrival_time = 0;
+    for (int i = 0; i < 200; ++i) {
+        arrival_time = std::max(arrival_time, i * SensorPeriod + jitter(random));
+        batcher.Push(MakeStatus({0.0f, 0.0f, 0.5f}, {0.0f, 0.0f, -1.0f}), arrival_time);
+    }
+    batcher.Process(input, raw_status);
+    REQUIRE(batcher.HasSamples());
+    REQUIRE(batcher.GetResampleDelay() > 0);
+
+    // Rotation grows by the same amount between evenly spaced times
+    constexpr f32 ExpectedStep = 0.5f * static_cast<f32>(UpdatePeriod) / 1e9f;
+    const s64 end = 199 * SensorPeriod;
+    f32 previous = batcher.Sample(end - 8 * UpdatePeriod).rotations.z;
+    for (s64 time = end - 7 * UpdatePeriod; time <= end; time += UpdatePeriod) {
+        const f32 rotation = batcher.Sample(time).rotations.z;
+        REQUIRE(IsNear(rotation - previous, ExpectedStep, ExpectedStep * 0.01f));
+        previous = rotation;
+    }
+
+    // The newest sample is held past its time
+    const auto newest = batcher.Sample(end + 10 * UpdatePeriod);
+    REQUIRE(newest.rotations.z == batcher.Sample(end + 20 * UpdatePeriod).rotations.z);
+
+    batcher.Reset();
+    REQUIRE(!batcher.HasSamples());
+}
+
+TEST_CASE("MotionBatcher: Late samples keep the resample delay bounded", "[hid_core]") {
+    MotionBatcher batcher;
+    const auto status = MakeStatus({0.0f, 0.0f, 0.5f}, {0.0f, 0.0f, -1.0f});
+    for (int i = 0; i < 100; ++i) {
+        batcher.Push(status, i * SensorPeriod);
+    }
+
+    // A stall shorter than the clock reset threshold, but longer than the resample delay bound
+    batcher.Push(status, 100 * SensorPeriod + 20'000'000);
+    REQUIRE(batcher.GetResampleDelay() == 8'000'000);
+
+    for (int i = 101; i < 200; ++i) {
+        batcher.Push(status, i * SensorPeriod + 20'000'000);
+        REQUIRE(batcher.GetResampleDelay() <= 8'000'000);
+    }
+}
+
+TEST_CASE("MotionBatcher: 1 kHz sensor", "[.][hid_core][benchmark]") {
+    BENCHMARK("Fuse 5 samples, one at a time") {
+        static MotionInput input;
+        static std::mutex mutex;
+        f32 result{};
+        for (int i = 0; i < 5; ++i) {
+            // Each sample locked the controller and updated the derived state
+            std::scoped_lock lock{mutex};
+            FuseSample(input, MakeTurningStatus(i));
+            result = input.GetEulerAngles().z + input.GetOrientation()[0].x +
+                     static_cast<f32>(input.IsMoving(MotionInput::IsAtRestStandard));
+        }
+        return result;
+    };
+    BENCHMARK("Fuse 5 samples, batched") {
+        static MotionInput input;
+        static MotionBatcher batcher;
+        static Common::Input::MotionStatus raw_status;
+        static s64 time;
+        for (int i = 0; i < 5; ++i) {
+            time += SensorPeriod;
+            batcher.Push(MakeTurningStatus(i), time);
+        }
+        batcher.Process(input, raw_status);
+        const auto sample = batcher.Sample(time - batcher.GetResampleDelay());
+        return MotionInput::GetEulerAngles(sample.quat).z +
+               MotionInput::GetOrientation(sample.quat)[0].x +
+               static_cast<f32>(MotionInput::IsMoving(sample.gyro, sample.accel, 0.01f));
+    };
+
+    // A sensor turning at a constant rate, delivered up to 3ms late, read every 5ms. Reports how
+    // much the rotation seen moves between reads, which should not vary, and how old it is.
+    constexpr s64 MaxJitter = 3 * SensorPeriod;
+    constexpr int NumUpdates = 2000;
+    std::mt19937 random{1};
+    std::uniform_int_distribution<s64> jitter{0, MaxJitter};
+    std::vector<s64> arrival_times;
+    s64 arrival_time = 0;
+    for (s64 time = 0; time < (NumUpdates + 2) * UpdatePeriod; time += SensorPeriod) {
+        arrival_time = std::max(arrival_time, time + jitter(random));
+        arrival_times.push_back(arrival_time);
+    }
+
+    MotionInput immediate;
+    MotionInput batched;
+    MotionBatcher batcher;
+    Common::Input::MotionStatus raw_status{};
+    std::vector<f32> immediate_steps;
+    std::vector<f32> batched_steps;
+    f64 immediate_age{};
+    f64 batched_age{};
+    f32 immediate_previous{};
+    f32 batched_previous{};
+    std::size_t next_sample = 0;
+    for (int update = 1; update <= NumUpdates; ++update) {
+        const s64 update_time = update * UpdatePeriod + MaxJitter;
+        while (next_sample < arrival_times.size() && arrival_times[next_sample] <= update_time) {
+            const auto status = MakeStatus({0.0f, 0.0f, 0.5f}, {0.0f, 0.0f, -1.0f});
+            FuseSample(immediate, status);
+            batcher.Push(status, arrival_times[next_sample]);
+            ++next_sample;
+        }
+        batcher.Process(batched, raw_status);
+        const s64 resample_time = update_time - batcher.GetResampleDelay();
+
+        const f32 immediate_rotation = immediate.GetRotations().z;
+        const f32 batched_rotation = batcher.Sample(resample_time).rotations.z;
+        if (update > 1) {
+            immediate_steps.push_back(immediate_rotation - immediate_previous);
+            batched_steps.push_back(batched_rotation - batched_previous);
+        }
+        immediate_previous = immediate_rotation;
+        batched_previous = batched_rotation;
+        immediate_age += static_cast<f64>(update_time - (next_sample - 1) * SensorPeriod);
+        batched_age += static_cast<f64>(update_time - resample_time);
+    }
+
+    const auto report = [](const char* label, const std::vector<f32>& steps, f64 total_age) {
+        f64 mean{};
+        for (const f32 step : steps) {
+            mean += step;
+        }
+        mean /= static_cast<f64>(steps.size());
+        f64 variance{};
+        for (const f32 step : steps) {
+            variance += (step - mean) * (step - mean);
+        }
+        variance /= static_cast<f64>(steps.size());
+        WARN(fmt::format("{}: rotation step {:.5f} +- {:.5f}, mean age {:.2f}ms", label, mean,
+                         std::sqrt(variance), total_age / NumUpdates / 1e6));
+    };
+    report("Fused as delivered", immediate_steps, immediate_age);
+    report("Batched and resampled", batched_steps, batched_age);
+}
+
+} // namespace Core::HID
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "hid_core/resources/npad/npad_types.h"
+#include "hid_core/resources/ring_lifo.h"
+#include "hid_core/resources/touch_screen/touch_types.h"
+
+namespace Service::HID {
+namespace {
+
+constexpr std::size_t EntryCount = 17;
+
+using PadLifo = Lifo<NPadGenericState, EntryCount>;
+
+bool IsSameLifo(const PadLifo& lhs, const PadLifo& rhs) {
+    return std::memcmp(&lhs, &rhs, sizeof(PadLifo)) == 0;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("RingLifo: Tracked writes match full writes", "[hid_core]") {
+    auto tracked_lifo = std::make_unique<PadLifo>();
+    auto full_lifo = std::make_unique<PadLifo>();
+    LifoWriteTracker tracker{};
+    std::mt19937 rng{1234};
+
+    NPadGenericState state{};
+    bool was_cleared{true};
+    for (int i = 0; i < 2000; ++i) {
+        // Long runs of unchanged input, with a change now and then
+        const bool change = std::uniform_int_distribution<int>{0, 39}(rng) == 0;
+        if (change) {
+            state.npad_buttons.raw = static_cast<Core::HID::NpadButton>(rng() & 0xFFFF);
+            state.l_stick.x = static_cast<s32>(rng() % 0x8000);
+        }
+        state.sampling_number = full_lifo->ReadCurrentEntry().state.sampling_number + 1;
+
+        const bool has_changed = tracked_lifo->WriteNextEntry(state, tracker);
+        full_lifo->WriteNextEntry(state);
+        REQUIRE(IsSameLifo(*tracked_lifo, *full_lifo));
+        // Once cleared, the current entry is no longer the last state written
+        if (!was_cleared) {
+            REQUIRE(has_changed == change);
+        }
+        was_cleared = false;
+
+        if (i % 500 == 499) {
+            // Cleared by the resource while it was deactivated
+            tracked_lifo->buffer_count = 0;
+            tracked_lifo->buffer_tail = 0;
+            full_lifo->buffer_count = 0;
+            full_lifo->buffer_tail = 0;
+            was_cleared = true;
+        }
+    }
+}
+
+TEST_CASE("RingLifo: Writes by others are noticed", "[hid_core]") {
+    auto tracked_lifo = std::make_unique<PadLifo>();
+    auto full_lifo = std::make_unique<PadLifo>();
+    LifoWriteTracker tracker{};
+
+    NPadGenericState state{};
+    state.npad_buttons.a.Assign(1);
+    for (int i = 0; i < 100; ++i) {
+        tracked_lifo->WriteNextEntry(state, tracker);
+        full_lifo->WriteNextEntry(state);
+    }
+
+    // Such as the empty entries written when a controller is connected
+    const NPadGenericState empty_state{};
+    tracked_lifo->WriteNextEntry(empty_state);
+    full_lifo->WriteNextEntry(empty_state);
+
+    for (int i = 0; i < 100; ++i) {
+        tracked_lifo->WriteNextEntry(state, tracker);
+        full_lifo->WriteNextEntry(state);
+        REQUIRE(IsSameLifo(*tracked_lifo, *full_lifo));
+    }
+}
+
+TEST_CASE("RingLifo: Unchanged write cost", "[.][hid_core][benchmark]") {
+    auto touch_lifo = std::make_unique<Lifo<TouchScreenState, EntryCount>>();
+    LifoWriteTracker touch_tracker{};
+    TouchScreenState touch_state{};
+    touch_state.entry_count = 2;
+
+    BENCHMARK("Touch state, full write") {
+        touch_state.sampling_number++;
+        touch_lifo->WriteNextEntry(touch_state);
+    };
+    BENCHMARK("Touch state, tracked write") {
+        touch_state.sampling_number++;
+        return touch_lifo->WriteNextEntry(touch_state, touch_tracker);
+    };
+}
+
+} // namespace Service::HID
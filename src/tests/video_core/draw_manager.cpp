@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "tests/video_core/rasterizer_stub.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/engines/draw_manager.h"
+#include "video_core/engines/fermi_2d.h"
+#include "video_core/engines/kepler_compute.h"
+#include "video_core/engines/kepler_memory.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/engines/maxwell_dma.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/memory_manager.h"
+
+namespace {
+using Tegra::Engines::Maxwell3D;
+using VideoCore::RasterizerStub;
+
+struct Fixture {
+    explicit Fixture(u32 max_draw_batch_size) : rasterizer{max_draw_batch_size} {
+        channel_state.maxwell_3d = std::make_unique<Maxwell3D>(system, memory_manager);
+        channel_state.maxwell_3d->BindRasterizer(&rasterizer);
+    }
+
+    Maxwell3D& Engine() {
+        return *channel_state.maxwell_3d;
+    }
+
+    void IssueDraw(u32 first, u32 count) {
+        Maxwell3D& maxwell3d = Engine();
+        maxwell3d.CallMethod(MAXWELL3D_REG_INDEX(draw.begin),
+                             static_cast<u32>(Maxwell3D::Regs::PrimitiveTopology::Triangles),
+                             true);
+        maxwell3d.CallMethod(MAXWELL3D_REG_INDEX(vertex_buffer.first), first, true);
+        maxwell3d.CallMethod(MAXWELL3D_REG_INDEX(vertex_buffer.count), count, true);
+        maxwell3d.CallMethod(MAXWELL3D_REG_INDEX(draw.end), 0, true);
+    }
+
+    Core::System system;
+    Core::DeviceMemory device_memory;
+    Tegra::MaxwellDeviceMemoryManager device_memory_manager{device_memory};
+    Tegra::MemoryManager memory_manager{system, device_memory_manager};
+    Tegra::Control::ChannelState channel_state{0};
+    RasterizerStub rasterizer;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("DrawManager: Redundant register writes keep the draw batch", "[video_core]") {
+    Fixture fixture{64};
+    Maxwell3D& maxwell3d = fixture.Engine();
+
+    fixture.IssueDraw(0, 3);
+    maxwell3d.CallMethod(MAXWELL3D_REG_INDEX(depth_test_enable), 0, true);
+    fixture.IssueDraw(3, 3);
+    REQUIRE(fixture.rasterizer.batch_sizes.empty());
+    REQUIRE(maxwell3d.draw_manager->HasDrawBatch());
+
+    maxwell3d.CallMethod(MAXWELL3D_REG_INDEX(depth_test_enable), 1, true);
+    REQUIRE(fixture.rasterizer.batch_sizes == std::vector<size_t>{2});
+    REQUIRE(!maxwell3d.draw_manager->HasDrawBatch());
+}
+
+TEST_CASE("DrawManager: Executable methods flush the draw batch first", "[video_core]") {
+    Fixture fixture{64};
+    Maxwell3D& maxwell3d = fixture.Engine();
+
+    fixture.IssueDraw(0, 3);
+    fixture.IssueDraw(3, 3);
+    maxwell3d.CallMethod(MAXWELL3D_REG_INDEX(clear_surface), 0, true);
+    const std::vector<size_t> expected_sizes{2, 0};
+    REQUIRE(fixture.rasterizer.batch_sizes == expected_sizes);
+}
+
+TEST_CASE("DrawManager: Draw batches are capped by the rasterizer", "[video_core]") {
+    Fixture fixture{2};
+    Maxwell3D& maxwell3d = fixture.Engine();
+
+    for (u32 draw = 0; draw < 5; ++draw) {
+        fixture.IssueDraw(draw * 3, 3);
+    }
+    maxwell3d.draw_manager->FlushDrawBatch();
+    const std::vector<size_t> expected_sizes{2, 2, 1};
+    REQUIRE(fixture.rasterizer.batch_sizes == expected_sizes);
+}
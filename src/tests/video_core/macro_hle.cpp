@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "tests/video_core/rasterizer_stub.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/engines/fermi_2d.h"
+#include "video_core/engines/kepler_compute.h"
+#include "video_core/engines/kepler_memory.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/engines/maxwell_dma.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_hle.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+#include "video_core/renderer_vulkan/vk_state_tracker.h"
+
+namespace {
+using Tegra::Engines::Maxwell3D;
+using VideoCore::RasterizerStub;
+
+/// Hash of the macro HLE_TransformFeedbackSetup replaces
+constexpr u64 TransformFeedbackSetupHash = 0xFC0CF27F5FFAA661ULL;
+
+} // Anonymous namespace
+
+TEST_CASE("MacroHLE: Transform feedback setup dirties the pipeline state", "[video_core]") {
+    Core::System system;
+    Core::DeviceMemory device_memory;
+    Tegra::MaxwellDeviceMemoryManager device_memory_manager{device_memory};
+    Tegra::MemoryManager memory_manager{system, device_memory_manager};
+    Tegra::Control::ChannelState channel_state{0};
+    channel_state.maxwell_3d = std::make_unique<Maxwell3D>(system, memory_manager);
+    Maxwell3D& maxwell3d = *channel_state.maxwell_3d;
+
+    RasterizerStub rasterizer;
+    maxwell3d.BindRasterizer(&rasterizer);
+    Vulkan::StateTracker state_tracker;
+    state_tracker.SetupTables(channel_state);
+
+    Vulkan::DynamicFeatures features{};
+    Vulkan::FixedPipelineState key{};
+    key.Refresh(maxwell3d, features);
+    REQUIRE(key.xfb_enabled.Value() == 0);
+    maxwell3d.dirty.flags[Vulkan::Dirty::PipelineState] = false;
+
+    Tegra::HLEMacro hle_macro{maxwell3d};
+    const auto program = hle_macro.GetHLEProgram(TransformFeedbackSetupHash);
+    REQUIRE(program != nullptr);
+    program->Execute(std::vector<u32>{0x1, 0x1000}, 0);
+    REQUIRE(rasterizer.transform_feedback_address == 0x100001000ULL);
+
+    // The pipeline cache only refreshes its key when this flag is set
+    REQUIRE(maxwell3d.dirty.flags[Vulkan::Dirty::PipelineState]);
+    Vulkan::FixedPipelineState next_key = key;
+    next_key.Refresh(maxwell3d, features);
+    REQUIRE(next_key.xfb_enabled.Value() != 0);
+    REQUIRE(!(next_key == key));
+}
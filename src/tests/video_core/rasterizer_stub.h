@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace VideoCore {
+
+/**
+ * Rasterizer for engine tests, which records how draws reach it and does nothing else.
+ * A single draw is recorded as a batch of one.
+ */
+class RasterizerStub final : public RasterizerInterface {
+public:
+    explicit RasterizerStub(u32 max_draw_batch_size_ = 1)
+        : max_draw_batch_size{max_draw_batch_size_} {}
+
+    void Draw(bool is_indexed, u32 instance_count) override {
+        batch_sizes.push_back(1);
+    }
+    void DrawBatch(bool is_indexed, u32 instance_count,
+                   std::span<const Tegra::Engines::DrawRange> ranges) override {
+        batch_sizes.push_back(ranges.size());
+    }
+    void DrawTexture() override {}
+    void Clear(u32 layer_count) override {
+        batch_sizes.push_back(0);
+    }
+    void DispatchCompute() override {}
+    void ResetCounter(VideoCommon::QueryType type) override {}
+    void Query(GPUVAddr gpu_addr, VideoCommon::QueryType type,
+               VideoCommon::QueryPropertiesFlags flags, u32 payload, u32 subreport) override {}
+    void BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
+                                   u32 size) override {}
+    void DisableGraphicsUniformBuffer(size_t stage, u32 index) override {}
+    void SignalFence(std::function<void()>&& func) override {}
+    void SyncOperation(std::function<void()>&& func) override {}
+    void SignalSyncPoint(u32 value) override {}
+    void SignalReference() override {}
+    void ReleaseFences(bool force) override {}
+    void FlushAll() override {}
+    void FlushRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    bool MustFlushRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {
+        return false;
+    }
+    RasterizerDownloadArea GetFlushArea(DAddr addr, u64 size) override {
+        return {};
+    }
+    void InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    void OnCacheInvalidation(PAddr addr, u64 size) override {}
+    bool OnCPUWrite(PAddr addr, u64 size) override {
+        return false;
+    }
+    void InvalidateGPUCache() override {}
+    void UnmapMemory(DAddr addr, u64 size) override {}
+    void ModifyGPUMemory(size_t as_id, GPUVAddr addr, u64 size) override {}
+    void FlushAndInvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) override {}
+    void WaitForIdle() override {}
+    void FragmentBarrier() override {}
+    void TiledCacheBarrier() override {}
+    void FlushCommands() override {}
+    void TickFrame() override {}
+    Tegra::Engines::AccelerateDMAInterface& AccessAccelerateDMA() override {
+        throw std::logic_error{"DMA engines are not used by the tests"};
+    }
+    void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
+                                  std::span<const u8> memory) override {}
+    void RegisterTransformFeedback(GPUVAddr tfb_object_addr) override {
+        transform_feedback_address = tfb_object_addr;
+    }
+    u32 GetMaxDrawBatchSize() override {
+        return max_draw_batch_size;
+    }
+
+    u32 max_draw_batch_size;
+    /// Number of draws of each dispatch, clears are recorded as 0
+    std::vector<size_t> batch_sizes;
+    /// Address given to the last RegisterTransformFeedback
+    GPUVAddr transform_feedback_address{};
+};
+
+} // namespace VideoCore
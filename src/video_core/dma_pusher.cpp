@@ -5,7 +5,9 @@
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "core/core.h"
+#include "video_core/control/channel_state.h"
 #include "video_core/dma_pusher.h"
+#include "video_core/engines/draw_manager.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
 #include "video_core/guest_memory.h"
@@ -18,8 +20,8 @@ constexpr u32 ComputeInline = 0x6D;
 
 DmaPusher::DmaPusher(Core::System& system_, GPU& gpu_, MemoryManager& memory_manager_,
                      Control::ChannelState& channel_state_)
-    : gpu{gpu_}, system{system_}, memory_manager{memory_manager_}, puller{gpu_, memory_manager_,
-                                                                          *this, channel_state_} {}
+    : gpu{gpu_}, system{system_}, memory_manager{memory_manager_}, channel_state{channel_state_},
+      puller{gpu_, memory_manager_, *this, channel_state_} {}
 
 DmaPusher::~DmaPusher() = default;
 
@@ -37,6 +39,7 @@ void DmaPusher::DispatchCalls() {
             break;
         }
     }
+    FlushDrawBatch(max_subchannels);
     gpu.FlushCommands();
     gpu.OnCommandListEnd();
 }
@@ -187,6 +190,7 @@ void DmaPusher::SetState(const CommandHeader& command_header) {
 }
 
 void DmaPusher::CallMethod(u32 argument) const {
+    FlushDrawBatch(dma_state.method < non_puller_methods ? max_subchannels : dma_state.subchannel);
     if (dma_state.method < non_puller_methods) {
         puller.CallPullerMethod(Engines::Puller::MethodCall{
             dma_state.method,
@@ -207,6 +211,7 @@ void DmaPusher::CallMethod(u32 argument) const {
 }
 
 void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+    FlushDrawBatch(dma_state.method < non_puller_methods ? max_subchannels : dma_state.subchannel);
     if (dma_state.method < non_puller_methods) {
         puller.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
                                dma_state.method_count);
@@ -219,6 +224,17 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+void DmaPusher::FlushDrawBatch(u32 subchannel) const {
+    // Methods sent to the 3D engine flush the batch themselves when needed
+    if (subchannel < max_subchannels &&
+        subchannel_type[subchannel] == Engines::EngineTypes::Maxwell3D) {
+        return;
+    }
+    if (channel_state.maxwell_3d) {
+        channel_state.maxwell_3d->draw_manager->FlushDrawBatch();
+    }
+}
+
 void DmaPusher::BindRasterizer(VideoCore::RasterizerInterface* rasterizer) {
     puller.BindRasterizer(rasterizer);
 }
@@ -149,6 +149,9 @@ private:
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
+    /// Dispatches batched 3D draws before methods that could depend on their results
+    void FlushDrawBatch(u32 subchannel) const;
+
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
 
@@ -177,6 +180,7 @@ private:
     GPU& gpu;
     Core::System& system;
     MemoryManager& memory_manager;
+    Control::ChannelState& channel_state;
     mutable Engines::Puller puller;
 };
 
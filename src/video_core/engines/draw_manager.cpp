@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <limits>
+
 #include "common/settings.h"
 #include "video_core/dirty_flags.h"
 #include "video_core/engines/draw_manager.h"
@@ -260,14 +263,114 @@ void DrawManager::UpdateTopology() {
     }
 }
 
+void DrawManager::FlushDrawBatch() {
+    if (draw_batch.ranges.empty()) {
+        return;
+    }
+    auto& ranges = draw_batch.ranges;
+    if (ranges.size() == 1) {
+        SetDrawRange(draw_batch.draw_indexed, draw_batch.topology, ranges.front());
+        maxwell3d->rasterizer->Draw(draw_batch.draw_indexed, draw_batch.instance_count);
+        ranges.clear();
+        return;
+    }
+    // Bind buffers covering every range of the batch
+    u32 range_begin = std::numeric_limits<u32>::max();
+    u32 range_end = 0;
+    for (const DrawRange& range : ranges) {
+        range_begin = std::min(range_begin, range.first);
+        range_end = std::max(range_end, range.first + range.count);
+    }
+    SetDrawRange(draw_batch.draw_indexed, draw_batch.topology,
+                 DrawRange{
+                     .first = range_begin,
+                     .count = range_end - range_begin,
+                     .base_vertex = ranges.front().base_vertex,
+                     .base_instance = ranges.front().base_instance,
+                 });
+    maxwell3d->rasterizer->DrawBatch(draw_batch.draw_indexed, draw_batch.instance_count, ranges);
+    ranges.clear();
+}
+
+bool DrawManager::IsDrawBatchMethod(u32 method) {
+    switch (method) {
+    case MAXWELL3D_REG_INDEX(draw.begin):
+    case MAXWELL3D_REG_INDEX(draw.end):
+    case MAXWELL3D_REG_INDEX(vertex_buffer.first):
+    case MAXWELL3D_REG_INDEX(vertex_buffer.count):
+    case MAXWELL3D_REG_INDEX(index_buffer.first):
+    case MAXWELL3D_REG_INDEX(index_buffer.count):
+    case MAXWELL3D_REG_INDEX(index_buffer32_first):
+    case MAXWELL3D_REG_INDEX(index_buffer16_first):
+    case MAXWELL3D_REG_INDEX(index_buffer8_first):
+        return true;
+    default:
+        return false;
+    }
+}
+
 void DrawManager::ProcessDraw(bool draw_indexed, u32 instance_count) {
     LOG_TRACE(HW_GPU, "called, topology={}, count={}", draw_state.topology,
               draw_indexed ? draw_state.index_buffer.count : draw_state.vertex_buffer.count);
 
     UpdateTopology();
 
-    if (maxwell3d->ShouldExecute()) {
+    if (!maxwell3d->ShouldExecute()) {
+        return;
+    }
+    const PrimitiveTopology topology = draw_state.topology;
+    const DrawRange range{
+        .first = draw_indexed ? draw_state.index_buffer.first : draw_state.vertex_buffer.first,
+        .count = draw_indexed ? draw_state.index_buffer.count : draw_state.vertex_buffer.count,
+        .base_vertex = draw_state.base_index,
+        .base_instance = draw_state.base_instance,
+    };
+    if (!CanBatchDraw()) {
+        if (HasDrawBatch()) {
+            FlushDrawBatch();
+            SetDrawRange(draw_indexed, topology, range);
+        }
         maxwell3d->rasterizer->Draw(draw_indexed, instance_count);
+        return;
+    }
+    // Batches are dispatched with a single indirect draw, so they can't exceed its draw count
+    if (draw_batch.draw_indexed != draw_indexed || draw_batch.instance_count != instance_count ||
+        draw_batch.topology != topology ||
+        draw_batch.ranges.size() >= maxwell3d->rasterizer->GetMaxDrawBatchSize()) {
+        FlushDrawBatch();
+    }
+    if (draw_batch.ranges.empty()) {
+        draw_batch.draw_indexed = draw_indexed;
+        draw_batch.instance_count = instance_count;
+        draw_batch.topology = topology;
+    }
+    draw_batch.ranges.push_back(range);
+}
+
+bool DrawManager::CanBatchDraw() const {
+    if (!draw_batching_enabled || draw_state.draw_mode != DrawMode::General) {
+        return false;
+    }
+    // Quads are drawn through a generated index buffer that depends on the draw range
+    if (draw_state.topology == PrimitiveTopology::Quads ||
+        draw_state.topology == PrimitiveTopology::QuadStrip) {
+        return false;
+    }
+    return maxwell3d->rasterizer->GetMaxDrawBatchSize() > 1;
+}
+
+void DrawManager::SetDrawRange(bool draw_indexed, PrimitiveTopology topology,
+                               const DrawRange& range) {
+    draw_state.topology = topology;
+    draw_state.base_index = range.base_vertex;
+    draw_state.base_instance = range.base_instance;
+    if (draw_indexed) {
+        draw_state.index_buffer.first = range.first;
+        draw_state.index_buffer.count = range.count;
+        maxwell3d->dirty.flags[VideoCommon::Dirty::IndexBuffer] = true;
+    } else {
+        draw_state.vertex_buffer.first = range.first;
+        draw_state.vertex_buffer.count = range.count;
     }
 }
 
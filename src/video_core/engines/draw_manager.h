@@ -17,6 +17,14 @@ using IndexBuffer = Maxwell3D::Regs::IndexBuffer;
 using VertexBuffer = Maxwell3D::Regs::VertexBuffer;
 using IndexBufferSmall = Maxwell3D::Regs::IndexBufferSmall;
 
+/// Vertex, index and instance range of a single draw inside of a draw batch
+struct DrawRange {
+    u32 first;         ///< First vertex, or first index on indexed draws
+    u32 count;         ///< Number of vertices or indices
+    u32 base_vertex;   ///< Value added to each index on indexed draws
+    u32 base_instance; ///< First instance
+};
+
 class DrawManager {
 public:
     enum class DrawMode : u32 { General = 0, Instance, InlineIndex };
@@ -76,6 +84,22 @@ public:
 
     void DrawIndexedIndirect(PrimitiveTopology topology, u32 index_first, u32 index_count);
 
+    /// Dispatches the pending draw batch, must be called before any state used by draws changes.
+    void FlushDrawBatch();
+
+    /// Returns true when draws are waiting in the draw batch
+    [[nodiscard]] bool HasDrawBatch() const noexcept {
+        return !draw_batch.ranges.empty();
+    }
+
+    /// Returns true when the method only changes the ranges of the draws in a draw batch
+    [[nodiscard]] static bool IsDrawBatchMethod(u32 method);
+
+    /// Allows or forbids batching draws, forbidden while macros write registers directly
+    void SetDrawBatchingEnabled(bool enabled) {
+        draw_batching_enabled = enabled;
+    }
+
     const State& GetDrawState() const {
         return draw_state;
     }
@@ -107,11 +131,24 @@ private:
 
     void ProcessDraw(bool draw_indexed, u32 instance_count);
 
+    bool CanBatchDraw() const;
+
+    void SetDrawRange(bool draw_indexed, PrimitiveTopology topology, const DrawRange& range);
+
     void ProcessDrawIndirect();
 
     Maxwell3D* maxwell3d{};
     State draw_state{};
     DrawTextureState draw_texture_state{};
     IndirectParams indirect_state{};
+
+    struct DrawBatch {
+        bool draw_indexed{};
+        u32 instance_count{};
+        PrimitiveTopology topology{};
+        std::vector<DrawRange> ranges;
+    };
+    DrawBatch draw_batch{};
+    bool draw_batching_enabled{true};
 };
 } // namespace Tegra::Engines
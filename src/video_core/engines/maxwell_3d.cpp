@@ -319,6 +319,9 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     if (regs.reg_array[method] == argument) {
         return;
     }
+    if (draw_manager->HasDrawBatch() && !DrawManager::IsDrawBatchMethod(method)) {
+        draw_manager->FlushDrawBatch();
+    }
     regs.reg_array[method] = argument;
 
     for (const auto& table : dirty.tables) {
@@ -404,8 +407,12 @@ void Maxwell3D::CallMacroMethod(u32 method, const std::vector<u32>& parameters)
     const u32 entry =
         ((method - MacroRegistersStart) >> 1) % static_cast<u32>(macro_positions.size());
 
-    // Execute the current macro.
+    // Execute the current macro. HLE macros write registers directly, so their draws can't be
+    // batched.
+    draw_manager->FlushDrawBatch();
+    draw_manager->SetDrawBatchingEnabled(false);
     macro_engine->Execute(macro_positions[entry], parameters);
+    draw_manager->SetDrawBatchingEnabled(true);
 
     draw_manager->DrawDeferred();
 }
@@ -427,11 +434,20 @@ void Maxwell3D::CallMethod(u32 method, u32 method_argument, bool is_last_call) {
     ASSERT_MSG(method < Regs::NUM_REGS,
                "Invalid Maxwell3D register, increase the size of the Regs structure");
 
+    FlushDrawBatchForMethod(method);
     const u32 argument = ProcessShadowRam(method, method_argument);
     ProcessDirtyRegisters(method, argument);
     ProcessMethodCall(method, argument, method_argument, is_last_call);
 }
 
+void Maxwell3D::FlushDrawBatchForMethod(u32 method) {
+    // Register writes flush the batch when they change a value, executable methods always do.
+    // Macros flush it before they run.
+    if (execution_mask[method] && !DrawManager::IsDrawBatchMethod(method)) {
+        draw_manager->FlushDrawBatch();
+    }
+}
+
 void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                                 u32 methods_pending) {
     // Methods after 0xE00 are special, they're actually triggers for some microcode that was
@@ -440,6 +456,7 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
         ProcessMacro(method, base_start, amount, amount == methods_pending);
         return;
     }
+    FlushDrawBatchForMethod(method);
     switch (method) {
     case MAXWELL3D_REG_INDEX(const_buffer.buffer):
     case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 1:
@@ -3093,7 +3093,7 @@ public:
     struct DirtyState {
         using Flags = std::bitset<std::numeric_limits<u8>::max()>;
         using Table = std::array<u8, Regs::NUM_REGS>;
-        using Tables = std::array<Table, 2>;
+        using Tables = std::array<Table, 3>;
 
         Flags flags;
         Tables tables{};
@@ -3131,6 +3131,15 @@ public:
     void ProcessCBData(u32 value);
     void ProcessCBMultiData(const u32* start_base, u32 amount);
 
+    /**
+     * Writes a register and marks the dirty flags it maps to, as a method call writing it does.
+     * Used by HLE macros, which write registers without calling their methods.
+     *
+     * @param method Register to write
+     * @param argument Value to write
+     */
+    void ProcessDirtyRegisters(u32 method, u32 argument);
+
 private:
     void InitializeRegisterDefaults();
 
@@ -3138,12 +3147,13 @@ private:
 
     u32 ProcessShadowRam(u32 method, u32 argument);
 
-    void ProcessDirtyRegisters(u32 method, u32 argument);
-
     void ConsumeSinkImpl() override;
 
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
 
+    /// Flushes the pending draw batch before an executable method that isn't part of a draw.
+    void FlushDrawBatchForMethod(u32 method);
+
     /// Retrieves information about a specific TIC entry from the TIC buffer.
     Texture::TICEntry GetTICEntry(u32 tic_index) const;
 
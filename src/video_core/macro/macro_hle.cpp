@@ -490,12 +490,18 @@ public:
     void Execute(const std::vector<u32>& parameters, [[maybe_unused]] u32 method) override {
         maxwell3d.RefreshParameters();
 
+        // Written through the dirty tables, as the pipeline key depends on transform feedback
+        maxwell3d.ProcessDirtyRegisters(MAXWELL3D_REG_INDEX(transform_feedback_enabled), 1);
+        using Buffer = Maxwell3D::Regs::TransformFeedback::Buffer;
+        constexpr u32 buffer_size = sizeof(Buffer) / sizeof(u32);
+        constexpr u32 start_offset_index = offsetof(Buffer, start_offset) / sizeof(u32);
+        for (u32 index = 0; index < Maxwell3D::Regs::NumTransformFeedbackBuffers; ++index) {
+            maxwell3d.ProcessDirtyRegisters(MAXWELL3D_REG_INDEX(transform_feedback.buffers) +
+                                                index * buffer_size + start_offset_index,
+                                            0);
+        }
+
         auto& regs = maxwell3d.regs;
-        regs.transform_feedback_enabled = 1;
-        regs.transform_feedback.buffers[0].start_offset = 0;
-        regs.transform_feedback.buffers[1].start_offset = 0;
-        regs.transform_feedback.buffers[2].start_offset = 0;
-        regs.transform_feedback.buffers[3].start_offset = 0;
 
         regs.upload.line_length_in = 4;
         regs.upload.line_count = 1;
@@ -10,6 +10,7 @@
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
 #include "video_core/cache_types.h"
+#include "video_core/engines/draw_manager.h"
 #include "video_core/engines/fermi_2d.h"
 #include "video_core/gpu.h"
 #include "video_core/query_cache/types.h"
@@ -44,6 +45,10 @@ public:
     /// Dispatches an indirect draw invocation
     virtual void DrawIndirect() {}
 
+    /// Dispatches a run of draws that only differ in their vertex, index and instance ranges
+    virtual void DrawBatch(bool is_indexed, u32 instance_count,
+                           std::span<const Tegra::Engines::DrawRange> ranges) {}
+
     /// Dispatches an draw texture invocation
     virtual void DrawTexture() = 0;
 
@@ -172,5 +177,10 @@ public:
     virtual bool HasDrawTransformFeedback() {
         return false;
     }
+
+    /// Returns the number of compatible draws the rasterizer can dispatch as a single batch
+    virtual u32 GetMaxDrawBatchSize() {
+        return 1;
+    }
 };
 } // namespace VideoCore
@@ -28,6 +28,12 @@ struct RendererSettings {
     Layout::FramebufferLayout screenshot_framebuffer_layout;
 };
 
+struct PresentStatistics {
+    u64 num_intervals{};          ///< Number of present-to-present intervals measured
+    f64 mean_interval_ms{};       ///< Mean present-to-present interval
+    f64 interval_variance_ms2{};  ///< Variance of the present-to-present interval
+};
+
 class RendererBase {
 public:
     YUZU_NON_COPYABLE(RendererBase);
@@ -47,6 +53,11 @@ public:
 
     [[nodiscard]] virtual std::string GetDeviceVendor() const = 0;
 
+    /// Returns statistics about the pacing of presented frames
+    [[nodiscard]] virtual PresentStatistics GetPresentStatistics() const {
+        return {};
+    }
+
     // Getter/setter functions:
     // ------------------------
 
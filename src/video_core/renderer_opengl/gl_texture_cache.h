@@ -93,6 +93,10 @@ public:
         return true;
     }
 
+    bool CanAccelerateImageUpload(Image&) const noexcept {
+        return true;
+    }
+
     bool CanUploadMSAA() const noexcept {
         return true;
     }
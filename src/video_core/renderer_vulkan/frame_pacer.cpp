@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "video_core/renderer_vulkan/frame_pacer.h"
+
+namespace Vulkan {
+
+namespace {
+// Weight of the newest guest frame interval in its moving average
+constexpr f64 INTERVAL_WEIGHT = 0.1;
+// Longer intervals are loading screens or pauses and are not paced
+constexpr f64 MAX_PACED_INTERVAL_MS = 100.0;
+// Presents are scheduled this early to absorb wake up latency of the present thread
+constexpr f64 WAKE_UP_SLACK_MS = 1.0;
+} // Anonymous namespace
+
+void FramePacer::OnFrameQueued(Clock::time_point now) {
+    std::scoped_lock lock{mutex};
+    if (last_queue_time != Clock::time_point{}) {
+        const f64 interval_ms = Duration(now - last_queue_time).count();
+        if (interval_ms > MAX_PACED_INTERVAL_MS) {
+            frame_interval_ms = 0.0;
+        } else if (frame_interval_ms == 0.0) {
+            frame_interval_ms = interval_ms;
+        } else {
+            frame_interval_ms += (interval_ms - frame_interval_ms) * INTERVAL_WEIGHT;
+        }
+    }
+    last_queue_time = now;
+}
+
+FramePacer::Clock::time_point FramePacer::PresentTime(Clock::time_point ready_time,
+                                                      std::size_t frames_pending) {
+    std::scoped_lock lock{mutex};
+    // Catch up immediately when frames are piling up or there is no rate to pace against
+    if (frames_pending > 0 || frame_interval_ms == 0.0 ||
+        last_present_time == Clock::time_point{}) {
+        return ready_time;
+    }
+    const auto target_time =
+        last_present_time +
+        std::chrono::duration_cast<Clock::duration>(Duration(frame_interval_ms - WAKE_UP_SLACK_MS));
+    // Bound the added latency to half a frame
+    const auto latest_time =
+        ready_time + std::chrono::duration_cast<Clock::duration>(Duration(frame_interval_ms / 2));
+    return std::clamp(target_time, ready_time, latest_time);
+}
+
+void FramePacer::OnFramePresented(Clock::time_point now) {
+    std::scoped_lock lock{mutex};
+    if (last_present_time != Clock::time_point{}) {
+        const f64 interval_ms = Duration(now - last_present_time).count();
+        if (interval_ms <= MAX_PACED_INTERVAL_MS) {
+            ++num_intervals;
+            const f64 delta = interval_ms - interval_mean_ms;
+            interval_mean_ms += delta / static_cast<f64>(num_intervals);
+            interval_m2 += delta * (interval_ms - interval_mean_ms);
+        }
+    }
+    last_present_time = now;
+}
+
+VideoCore::PresentStatistics FramePacer::GetStatistics() const {
+    std::scoped_lock lock{mutex};
+    return {
+        .num_intervals = num_intervals,
+        .mean_interval_ms = interval_mean_ms,
+        .interval_variance_ms2 =
+            num_intervals > 1 ? interval_m2 / static_cast<f64>(num_intervals - 1) : 0.0,
+    };
+}
+
+} // namespace Vulkan
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+#include "common/common_types.h"
+#include "video_core/renderer_base.h"
+
+namespace Vulkan {
+
+/// Schedules presentation of queued frames so they reach the screen at the rate the guest renders
+/// them, trading at most half a frame of latency for evenly spaced presents.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Records that the guest has queued a new frame for presentation.
+    void OnFrameQueued(Clock::time_point now);
+
+    /// Returns the time a frame that finished rendering at ready_time should be presented at.
+    /// frames_pending is the number of frames queued behind it.
+    [[nodiscard]] Clock::time_point PresentTime(Clock::time_point ready_time,
+                                                std::size_t frames_pending);
+
+    /// Records that a frame has been presented.
+    void OnFramePresented(Clock::time_point now);
+
+    /// Returns the present-to-present interval statistics collected so far.
+    [[nodiscard]] VideoCore::PresentStatistics GetStatistics() const;
+
+private:
+    using Duration = std::chrono::duration<f64, std::milli>;
+
+    mutable std::mutex mutex;
+
+    Clock::time_point last_queue_time{};
+    Clock::time_point last_present_time{};
+    f64 frame_interval_ms{}; ///< Moving average of the guest frame interval
+
+    // Running present interval statistics, using Welford's algorithm
+    u64 num_intervals{};
+    f64 interval_mean_ms{};
+    f64 interval_m2{};
+};
+
+} // namespace Vulkan
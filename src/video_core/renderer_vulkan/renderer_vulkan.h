@@ -58,6 +58,10 @@ public:
         return device.GetDriverName();
     }
 
+    [[nodiscard]] VideoCore::PresentStatistics GetPresentStatistics() const override {
+        return present_manager.GetPresentStatistics();
+    }
+
 private:
     void Report() const;
 
@@ -32,6 +32,7 @@
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_shader_util.h"
+#include "video_core/renderer_vulkan/vk_state_tracker.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/shader_cache.h"
 #include "video_core/shader_environment.h"
@@ -421,10 +422,22 @@ PipelineCache::~PipelineCache() {
 GraphicsPipeline* PipelineCache::CurrentGraphicsPipeline() {
     MICROPROFILE_SCOPE(Vulkan_PipelineCache);
 
+    auto& dirty{maxwell3d->dirty.flags};
+    const bool shaders_dirty{dirty[VideoCommon::Dirty::Shaders]};
     if (!RefreshStages(graphics_key.unique_hashes)) {
         current_pipeline = nullptr;
         return nullptr;
     }
+    // When no register feeding the key was written and the state held outside of registers is
+    // the same, the key can't have changed and the current pipeline is still the right one
+    const auto& state{graphics_key.state};
+    if (current_pipeline && !shaders_dirty && !dirty[Dirty::PipelineState] &&
+        state.topology.Value() == maxwell3d->draw_manager->GetDrawState().topology &&
+        state.app_stage.Value() == maxwell3d->engine_state) {
+        ++skipped_lookups;
+        return BuiltPipeline(current_pipeline);
+    }
+    dirty[Dirty::PipelineState] = false;
     graphics_key.state.Refresh(*maxwell3d, dynamic_features);
 
     if (current_pipeline) {
@@ -15,6 +15,7 @@ namespace Vulkan {
 
 MICROPROFILE_DEFINE(Vulkan_WaitPresent, "Vulkan", "Wait For Present", MP_RGB(128, 128, 128));
 MICROPROFILE_DEFINE(Vulkan_CopyToSwapchain, "Vulkan", "Copy to swapchain", MP_RGB(192, 255, 192));
+MICROPROFILE_DEFINE(Vulkan_FramePacing, "Vulkan", "Frame pacing", MP_RGB(128, 192, 128));
 
 namespace {
 
@@ -161,10 +162,13 @@ void PresentManager::Present(Frame* frame) {
     if (!use_present_thread) {
         scheduler.WaitWorker();
         CopyToSwapchain(frame);
+        frame_pacer.OnFramePresented(FramePacer::Clock::now());
         free_queue.push(frame);
         return;
     }
 
+    frame_pacer.OnFrameQueued(FramePacer::Clock::now());
+
     scheduler.Record([this, frame](vk::CommandBuffer) {
         std::unique_lock lock{queue_mutex};
         present_queue.push(frame);
@@ -268,6 +272,22 @@ void PresentManager::PresentThread(std::stop_token token) {
             return;
         }
 
+        // Hold the frame back until it is due to keep presents evenly spaced. The frame stays
+        // queued meanwhile so WaitPresent keeps waiting for it, but no lock is held while waiting.
+        // Stopping the thread ends the wait.
+        const std::size_t frames_pending = present_queue.size() - 1;
+        const auto present_time =
+            frame_pacer.PresentTime(FramePacer::Clock::now(), frames_pending);
+        const auto now = FramePacer::Clock::now();
+        if (present_time > now) {
+            MICROPROFILE_SCOPE(Vulkan_FramePacing);
+            lock.unlock();
+            if (!Common::StoppableTimedWait(token, present_time - now)) {
+                return;
+            }
+            lock.lock();
+        }
+
         // Take the frame and notify anyone waiting
         Frame* frame = present_queue.front();
         present_queue.pop();
@@ -279,6 +299,7 @@ void PresentManager::PresentThread(std::stop_token token) {
         std::exchange(lock, std::unique_lock{swapchain_mutex});
 
         CopyToSwapchain(frame);
+        frame_pacer.OnFramePresented(FramePacer::Clock::now());
 
         // Free the frame for reuse
         std::scoped_lock fl{free_mutex};
@@ -9,6 +9,7 @@
 
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
+#include "video_core/renderer_vulkan/frame_pacer.h"
 #include "video_core/vulkan_common/vulkan_memory_allocator.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -53,6 +54,11 @@ public:
     /// Waits for the present thread to finish presenting all queued frames.
     void WaitPresent();
 
+    /// Returns the present-to-present interval statistics
+    [[nodiscard]] VideoCore::PresentStatistics GetPresentStatistics() const {
+        return frame_pacer.GetStatistics();
+    }
+
 private:
     void PresentThread(std::stop_token token);
 
@@ -81,6 +87,7 @@ private:
     std::mutex swapchain_mutex;
     std::mutex queue_mutex;
     std::mutex free_mutex;
+    FramePacer frame_pacer;
     std::jthread present_thread;
     bool blit_supported;
     bool use_present_thread;
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
 
@@ -208,8 +209,11 @@ template <typename Func>
 void RasterizerVulkan::PrepareDraw(bool is_indexed, Func&& draw_func) {
     MICROPROFILE_SCOPE(Vulkan_Drawing);
 
+    const auto start_time = std::chrono::steady_clock::now();
     SCOPE_EXIT {
         gpu.TickWork();
+        prepare_draw_time += std::chrono::steady_clock::now() - start_time;
+        ++prepared_draws;
     };
     FlushWork();
     gpu_memory->FlushCaching();
@@ -251,6 +255,49 @@ void RasterizerVulkan::Draw(bool is_indexed, u32 instance_count) {
     });
 }
 
+void RasterizerVulkan::DrawBatch(bool is_indexed, u32 instance_count,
+                                 std::span<const Tegra::Engines::DrawRange> ranges) {
+    PrepareDraw(is_indexed, [this, is_indexed, instance_count, ranges] {
+        // Write the draw commands to an upload buffer and dispatch them in one indirect draw
+        const size_t stride =
+            is_indexed ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand);
+        const StagingBufferRef command_buffer =
+            staging_pool.Request(ranges.size() * stride, MemoryUsage::Upload);
+        u8* const commands = command_buffer.mapped_span.data();
+        for (size_t index = 0; index < ranges.size(); ++index) {
+            const Tegra::Engines::DrawRange& range = ranges[index];
+            if (is_indexed) {
+                const VkDrawIndexedIndirectCommand command{
+                    .indexCount = range.count,
+                    .instanceCount = instance_count,
+                    .firstIndex = range.first,
+                    .vertexOffset = static_cast<s32>(range.base_vertex),
+                    .firstInstance = range.base_instance,
+                };
+                std::memcpy(commands + index * stride, &command, sizeof(command));
+            } else {
+                const VkDrawIndirectCommand command{
+                    .vertexCount = range.count,
+                    .instanceCount = instance_count,
+                    .firstVertex = range.first,
+                    .firstInstance = range.base_instance,
+                };
+                std::memcpy(commands + index * stride, &command, sizeof(command));
+            }
+        }
+        scheduler.Record([buffer = command_buffer.buffer, offset = command_buffer.offset,
+                          draw_count = static_cast<u32>(ranges.size()),
+                          stride = static_cast<u32>(stride), is_indexed](vk::CommandBuffer cmdbuf) {
+            if (is_indexed) {
+                cmdbuf.DrawIndexedIndirect(buffer, offset, draw_count, stride);
+            } else {
+                cmdbuf.DrawIndirect(buffer, offset, draw_count, stride);
+            }
+        });
+    });
+    batched_draws += ranges.size() - 1;
+}
+
 void RasterizerVulkan::DrawIndirect() {
     const auto& params = maxwell3d->draw_manager->GetIndirectParams();
     buffer_cache.SetDrawIndirect(&params);
@@ -302,8 +349,11 @@ void RasterizerVulkan::DrawIndirect() {
 void RasterizerVulkan::DrawTexture() {
     MICROPROFILE_SCOPE(Vulkan_Drawing);
 
+    const auto start_time = std::chrono::steady_clock::now();
     SCOPE_EXIT {
         gpu.TickWork();
+        prepare_draw_time += std::chrono::steady_clock::now() - start_time;
+        ++prepared_draws;
     };
     FlushWork();
 
@@ -380,7 +430,6 @@ void RasterizerVulkan::Clear(u32 layer_count) {
         up_scale = Settings::values.resolution_info.up_scale;
         down_shift = Settings::values.resolution_info.down_shift;
     }
-    UpdateViewportsState(regs);
 
     VkRect2D default_scissor;
     default_scissor.offset.x = 0;
@@ -401,6 +450,13 @@ void RasterizerVulkan::Clear(u32 layer_count) {
         .width = std::min(clear_rect.rect.extent.width, render_area.width),
         .height = std::min(clear_rect.rect.extent.height, render_area.height),
     };
+    // Clears covering every pixel and layer of the framebuffer can be done by the renderpass
+    // itself when nothing has been recorded inside of it yet.
+    const bool is_full_clear = clear_rect.rect.offset.x == 0 && clear_rect.rect.offset.y == 0 &&
+                               clear_rect.rect.extent.width == render_area.width &&
+                               clear_rect.rect.extent.height == render_area.height &&
+                               clear_rect.baseArrayLayer == 0 &&
+                               clear_rect.layerCount == framebuffer->NumLayers();
 
     const u32 color_attachment = regs.clear_surface.RT;
     if (use_color && framebuffer->HasAspectColorBit(color_attachment)) {
@@ -428,15 +484,24 @@ void RasterizerVulkan::Clear(u32 layer_count) {
 
         if (regs.clear_surface.R && regs.clear_surface.G && regs.clear_surface.B &&
             regs.clear_surface.A) {
-            scheduler.Record([color_attachment, clear_value, clear_rect](vk::CommandBuffer cmdbuf) {
-                const VkClearAttachment attachment{
-                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                    .colorAttachment = color_attachment,
-                    .clearValue = clear_value,
-                };
-                cmdbuf.ClearAttachments(attachment, clear_rect);
-            });
+            const bool is_folded =
+                is_full_clear &&
+                FoldClear(framebuffer, 1U << color_attachment,
+                          framebuffer->ColorAttachmentIndex(color_attachment), clear_value);
+            if (!is_folded) {
+                UpdateViewportsState(regs);
+                scheduler.Record(
+                    [color_attachment, clear_value, clear_rect](vk::CommandBuffer cmdbuf) {
+                        const VkClearAttachment attachment{
+                            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                            .colorAttachment = color_attachment,
+                            .clearValue = clear_value,
+                        };
+                        cmdbuf.ClearAttachments(attachment, clear_rect);
+                    });
+            }
         } else {
+            UpdateViewportsState(regs);
             u8 color_mask = static_cast<u8>(regs.clear_surface.R | regs.clear_surface.G << 1 |
                                             regs.clear_surface.B << 2 | regs.clear_surface.A << 3);
             Region2D dst_region = {
@@ -470,20 +535,54 @@ void RasterizerVulkan::Clear(u32 layer_count) {
             Offset2D{.x = clear_rect.rect.offset.x + static_cast<s32>(clear_rect.rect.extent.width),
                      .y = clear_rect.rect.offset.y +
                           static_cast<s32>(clear_rect.rect.extent.height)}};
+        UpdateViewportsState(regs);
         blit_image.ClearDepthStencil(framebuffer, use_depth, regs.clear_depth,
                                      static_cast<u8>(regs.stencil_front_mask), regs.clear_stencil,
                                      regs.stencil_front_func_mask, dst_region);
-    } else {
-        scheduler.Record([clear_depth = regs.clear_depth, clear_stencil = regs.clear_stencil,
-                          clear_rect, aspect_flags](vk::CommandBuffer cmdbuf) {
-            VkClearAttachment attachment;
-            attachment.aspectMask = aspect_flags;
-            attachment.colorAttachment = 0;
-            attachment.clearValue.depthStencil.depth = clear_depth;
-            attachment.clearValue.depthStencil.stencil = clear_stencil;
-            cmdbuf.ClearAttachments(attachment, clear_rect);
-        });
+        return;
+    }
+    VkClearValue depth_stencil_value{};
+    depth_stencil_value.depthStencil.depth = regs.clear_depth;
+    depth_stencil_value.depthStencil.stencil = regs.clear_stencil;
+    u32 clear_bits = 0;
+    if ((aspect_flags & VK_IMAGE_ASPECT_DEPTH_BIT) != 0) {
+        clear_bits |= RENDER_PASS_CLEAR_DEPTH;
+    }
+    if ((aspect_flags & VK_IMAGE_ASPECT_STENCIL_BIT) != 0) {
+        clear_bits |= RENDER_PASS_CLEAR_STENCIL;
     }
+    if (is_full_clear && FoldClear(framebuffer, clear_bits, framebuffer->DepthAttachmentIndex(),
+                                   depth_stencil_value)) {
+        return;
+    }
+    UpdateViewportsState(regs);
+    scheduler.Record([clear_depth = regs.clear_depth, clear_stencil = regs.clear_stencil,
+                      clear_rect, aspect_flags](vk::CommandBuffer cmdbuf) {
+        VkClearAttachment attachment;
+        attachment.aspectMask = aspect_flags;
+        attachment.colorAttachment = 0;
+        attachment.clearValue.depthStencil.depth = clear_depth;
+        attachment.clearValue.depthStencil.stencil = clear_stencil;
+        cmdbuf.ClearAttachments(attachment, clear_rect);
+    });
+}
+
+bool RasterizerVulkan::FoldClear(const Framebuffer* framebuffer, u32 clear_bits, u32 attachment,
+                                 const VkClearValue& value) {
+    const std::optional<u32> clear_mask = scheduler.PendingRenderpassClearMask();
+    if (!clear_mask) {
+        return false;
+    }
+    // Depth and stencil share a clear value, avoid overwriting the value of the other aspect
+    constexpr u32 depth_stencil_bits = RENDER_PASS_CLEAR_DEPTH | RENDER_PASS_CLEAR_STENCIL;
+    if ((clear_bits & depth_stencil_bits) != 0 &&
+        (*clear_mask & depth_stencil_bits & ~clear_bits) != 0) {
+        return false;
+    }
+    RenderPassKey key = framebuffer->GetRenderPassKey();
+    key.clear_mask = *clear_mask | clear_bits;
+    scheduler.FoldRenderpassClear(render_pass_cache.Get(key), key.clear_mask, attachment, value);
+    return true;
 }
 
 void RasterizerVulkan::DispatchCompute() {
@@ -762,6 +861,22 @@ void RasterizerVulkan::FlushCommands() {
 
 void RasterizerVulkan::TickFrame() {
     draw_counter = 0;
+    const RenderPassStatistics renderpass_stats = scheduler.ResetRenderPassStatistics();
+    LOG_TRACE(Render_Vulkan,
+              "Renderpasses per frame: requested={} recorded={} merged={} elided={} "
+              "folded_clears={}",
+              renderpass_stats.requested, renderpass_stats.recorded, renderpass_stats.merged,
+              renderpass_stats.elided, renderpass_stats.folded_clears);
+    LOG_TRACE(Render_Vulkan, "Draws merged into batches per frame: {}",
+              std::exchange(batched_draws, 0));
+    if (prepared_draws != 0) {
+        LOG_TRACE(Render_Vulkan, "Draws per frame: {}, mean PrepareDraw time: {} ns, skipped "
+                  "pipeline lookups: {}",
+                  prepared_draws, prepare_draw_time.count() / prepared_draws,
+                  pipeline_cache.ResetSkippedLookups());
+    }
+    prepared_draws = 0;
+    prepare_draw_time = {};
     guest_descriptor_queue.TickFrame();
     compute_pass_descriptor_queue.TickFrame();
     fence_manager.TickFrame();
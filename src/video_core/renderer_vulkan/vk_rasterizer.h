@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 
 #include <boost/container/static_vector.hpp>
 
@@ -84,6 +85,8 @@ public:
 
     void Draw(bool is_indexed, u32 instance_count) override;
     void DrawIndirect() override;
+    void DrawBatch(bool is_indexed, u32 instance_count,
+                   std::span<const Tegra::Engines::DrawRange> ranges) override;
     void DrawTexture() override;
     void Clear(u32 layer_count) override;
     void DispatchCompute() override;
@@ -134,6 +137,10 @@ public:
 
     void ReleaseChannel(s32 channel_id) override;
 
+    u32 GetMaxDrawBatchSize() override {
+        return device.GetMaxDrawIndirectCount();
+    }
+
     std::optional<FramebufferTextureInfo> AccelerateDisplay(const Tegra::FramebufferConfig& config,
                                                             VAddr framebuffer_addr,
                                                             u32 pixel_stride);
@@ -150,6 +157,10 @@ private:
 
     void FlushWork();
 
+    /// Folds a clear of the whole render area into the load operations of the pending renderpass.
+    bool FoldClear(const Framebuffer* framebuffer, u32 clear_bits, u32 attachment,
+                   const VkClearValue& value);
+
     void UpdateDynamicStates();
 
     void HandleTransformFeedback();
@@ -212,6 +223,9 @@ private:
     boost::container::static_vector<VkSampler, MAX_TEXTURES> sampler_handles;
 
     u32 draw_counter = 0;
+    u64 batched_draws = 0;
+    u64 prepared_draws = 0;
+    std::chrono::nanoseconds prepare_draw_time{};
 };
 
 } // namespace Vulkan
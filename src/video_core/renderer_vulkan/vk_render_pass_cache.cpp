@@ -15,16 +15,21 @@ namespace Vulkan {
 namespace {
 using VideoCore::Surface::PixelFormat;
 
+VkAttachmentLoadOp LoadOp(bool clear) {
+    return clear ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+}
+
 VkAttachmentDescription AttachmentDescription(const Device& device, PixelFormat format,
-                                              VkSampleCountFlagBits samples) {
+                                              VkSampleCountFlagBits samples, bool clear,
+                                              bool clear_stencil) {
     using MaxwellToVK::SurfaceFormat;
     return {
         .flags = {},
         .format = SurfaceFormat(device, FormatType::Optimal, true, format).format,
         .samples = samples,
-        .loadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
+        .loadOp = LoadOp(clear),
         .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
+        .stencilLoadOp = LoadOp(clear_stencil),
         .stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE,
         .initialLayout = VK_IMAGE_LAYOUT_GENERAL,
         .finalLayout = VK_IMAGE_LAYOUT_GENERAL,
@@ -52,7 +57,9 @@ VkRenderPass RenderPassCache::Get(const RenderPassKey& key) {
             .layout = VK_IMAGE_LAYOUT_GENERAL,
         };
         if (is_valid) {
-            descriptions.push_back(AttachmentDescription(*device, format, key.samples));
+            const bool clear{(key.clear_mask & (1U << index)) != 0};
+            descriptions.push_back(
+                AttachmentDescription(*device, format, key.samples, clear, false));
             num_attachments = static_cast<u32>(index + 1);
             ++num_colors;
         }
@@ -64,7 +71,10 @@ VkRenderPass RenderPassCache::Get(const RenderPassKey& key) {
             .attachment = num_colors,
             .layout = VK_IMAGE_LAYOUT_GENERAL,
         };
-        descriptions.push_back(AttachmentDescription(*device, key.depth_format, key.samples));
+        const bool clear_depth{(key.clear_mask & RENDER_PASS_CLEAR_DEPTH) != 0};
+        const bool clear_stencil{(key.clear_mask & RENDER_PASS_CLEAR_STENCIL) != 0};
+        descriptions.push_back(AttachmentDescription(*device, key.depth_format, key.samples,
+                                                     clear_depth, clear_stencil));
     }
     const VkSubpassDescription subpass{
         .flags = 0,
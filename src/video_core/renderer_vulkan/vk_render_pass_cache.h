@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <bit>
 #include <mutex>
 #include <unordered_map>
 
@@ -17,8 +18,13 @@ struct RenderPassKey {
     std::array<VideoCore::Surface::PixelFormat, 8> color_formats;
     VideoCore::Surface::PixelFormat depth_format;
     VkSampleCountFlagBits samples;
+    /// Attachments cleared on load, bits 0-7 are color render targets, 8 is depth and 9 stencil
+    u32 clear_mask;
 };
 
+constexpr u32 RENDER_PASS_CLEAR_DEPTH = 1U << 8;
+constexpr u32 RENDER_PASS_CLEAR_STENCIL = 1U << 9;
+
 } // namespace Vulkan
 
 namespace std {
@@ -27,6 +33,7 @@ struct hash<Vulkan::RenderPassKey> {
     [[nodiscard]] size_t operator()(const Vulkan::RenderPassKey& key) const noexcept {
         size_t value = static_cast<size_t>(key.depth_format) << 48;
         value ^= static_cast<size_t>(key.samples) << 52;
+        value ^= std::rotl(static_cast<size_t>(key.clear_mask), 54);
         for (size_t i = 0; i < key.color_formats.size(); ++i) {
             value ^= static_cast<size_t>(key.color_formats[i]) << (i * 6);
         }
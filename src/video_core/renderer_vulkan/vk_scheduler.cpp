@@ -22,6 +22,15 @@ namespace Vulkan {
 
 MICROPROFILE_DECLARE(Vulkan_WaitForWorker);
 
+namespace {
+template <typename RenderPassState>
+bool IsSameRenderPass(const RenderPassState& lhs, const RenderPassState& rhs) {
+    return lhs.renderpass == rhs.renderpass && lhs.framebuffer == rhs.framebuffer &&
+           lhs.render_area.width == rhs.render_area.width &&
+           lhs.render_area.height == rhs.render_area.height;
+}
+} // Anonymous namespace
+
 void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
                                          vk::CommandBuffer upload_cmdbuf) {
     auto command = first;
@@ -93,35 +102,48 @@ void Scheduler::RequestRenderpass(const Framebuffer* framebuffer) {
     const VkRenderPass renderpass = framebuffer->RenderPass();
     const VkFramebuffer framebuffer_handle = framebuffer->Handle();
     const VkExtent2D render_area = framebuffer->RenderArea();
-    if (renderpass == state.renderpass && framebuffer_handle == state.framebuffer &&
-        render_area.width == state.render_area.width &&
-        render_area.height == state.render_area.height) {
+    if (renderpass == requested_renderpass.renderpass &&
+        framebuffer_handle == requested_renderpass.framebuffer &&
+        render_area.width == requested_renderpass.render_area.width &&
+        render_area.height == requested_renderpass.render_area.height) {
         return;
     }
     EndRenderPass();
-    state.renderpass = renderpass;
-    state.framebuffer = framebuffer_handle;
-    state.render_area = render_area;
+    requested_renderpass = RenderPassState{
+        .renderpass = renderpass,
+        .framebuffer = framebuffer_handle,
+        .render_area = render_area,
+        .num_images = framebuffer->NumImages(),
+        .images = framebuffer->Images(),
+        .image_ranges = framebuffer->ImageRanges(),
+    };
+    renderpass_dirty = true;
+    ++renderpass_statistics.requested;
+    if (IsSameRenderPass(requested_renderpass, recorded_renderpass)) {
+        // Nothing has been recorded since the last renderpass on this framebuffer was requested to
+        // end, so it can be resumed instead of restarted.
+        ++renderpass_statistics.merged;
+    }
+}
 
-    Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
-        const VkRenderPassBeginInfo renderpass_bi{
-            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-            .pNext = nullptr,
-            .renderPass = renderpass,
-            .framebuffer = framebuffer_handle,
-            .renderArea =
-                {
-                    .offset = {.x = 0, .y = 0},
-                    .extent = render_area,
-                },
-            .clearValueCount = 0,
-            .pClearValues = nullptr,
-        };
-        cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
-    });
-    num_renderpass_images = framebuffer->NumImages();
-    renderpass_images = framebuffer->Images();
-    renderpass_image_ranges = framebuffer->ImageRanges();
+std::optional<u32> Scheduler::PendingRenderpassClearMask() const noexcept {
+    if (!requested_renderpass.renderpass ||
+        IsSameRenderPass(requested_renderpass, recorded_renderpass)) {
+        return std::nullopt;
+    }
+    return state.clear_mask;
+}
+
+void Scheduler::FoldRenderpassClear(VkRenderPass clear_renderpass, u32 clear_mask, u32 attachment,
+                                    const VkClearValue& value) {
+    state.clear_renderpass = clear_renderpass;
+    state.clear_mask = clear_mask;
+    state.clear_values[attachment] = value;
+    ++renderpass_statistics.folded_clears;
+}
+
+RenderPassStatistics Scheduler::ResetRenderPassStatistics() noexcept {
+    return std::exchange(renderpass_statistics, {});
 }
 
 void Scheduler::RequestOutsideRenderPassOperationContext() {
@@ -286,43 +308,94 @@ void Scheduler::EndPendingOperations() {
 #endif
     query_cache->NotifySegment(false);
     EndRenderPass();
+    ResolveRenderPass();
 }
 
 void Scheduler::EndRenderPass() {
-    if (!state.renderpass) {
+    if (!requested_renderpass.renderpass) {
         return;
     }
-    Record([num_images = num_renderpass_images, images = renderpass_images,
-            ranges = renderpass_image_ranges](vk::CommandBuffer cmdbuf) {
-        std::array<VkImageMemoryBarrier, 9> barriers;
-        for (size_t i = 0; i < num_images; ++i) {
-            barriers[i] = VkImageMemoryBarrier{
-                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-                .pNext = nullptr,
-                .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
-                                 VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
-                                 VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
-                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
-                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .image = images[i],
-                .subresourceRange = ranges[i],
-            };
+    if (!IsSameRenderPass(requested_renderpass, recorded_renderpass)) {
+        if (state.clear_mask != 0) {
+            // Folded clears have to reach the attachments even when nothing is drawn.
+            ResolveRenderPass();
+        } else {
+            ++renderpass_statistics.elided;
         }
-        cmdbuf.EndRenderPass();
-        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
-                                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
-                                   VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
-                               vk::Span(barriers.data(), num_images));
-    });
-    state.renderpass = nullptr;
-    num_renderpass_images = 0;
+    }
+    requested_renderpass = {};
+    renderpass_dirty = true;
+}
+
+void Scheduler::ResolveRenderPass() {
+    renderpass_dirty = false;
+    if (IsSameRenderPass(requested_renderpass, recorded_renderpass)) {
+        return;
+    }
+    if (recorded_renderpass.renderpass) {
+        auto end = [num_images = recorded_renderpass.num_images,
+                    images = recorded_renderpass.images,
+                    ranges = recorded_renderpass.image_ranges](vk::CommandBuffer cmdbuf,
+                                                               vk::CommandBuffer) {
+            std::array<VkImageMemoryBarrier, 9> barriers;
+            for (size_t i = 0; i < num_images; ++i) {
+                barriers[i] = VkImageMemoryBarrier{
+                    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                    .pNext = nullptr,
+                    .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                     VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+                                     VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                                     VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                     VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                     VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+                    .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+                    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                    .image = images[i],
+                    .subresourceRange = ranges[i],
+                };
+            }
+            cmdbuf.EndRenderPass();
+            cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                       VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                   VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
+                                   vk::Span(barriers.data(), num_images));
+        };
+        RecordToChunk(end);
+        recorded_renderpass = {};
+    }
+    if (!requested_renderpass.renderpass) {
+        return;
+    }
+    const bool has_clears = state.clear_mask != 0;
+    auto begin = [renderpass = has_clears ? state.clear_renderpass : requested_renderpass.renderpass,
+                  framebuffer_handle = requested_renderpass.framebuffer,
+                  render_area = requested_renderpass.render_area,
+                  num_clear_values = has_clears ? requested_renderpass.num_images : 0,
+                  clear_values = state.clear_values](vk::CommandBuffer cmdbuf, vk::CommandBuffer) {
+        const VkRenderPassBeginInfo renderpass_bi{
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            .pNext = nullptr,
+            .renderPass = renderpass,
+            .framebuffer = framebuffer_handle,
+            .renderArea =
+                {
+                    .offset = {.x = 0, .y = 0},
+                    .extent = render_area,
+                },
+            .clearValueCount = num_clear_values,
+            .pClearValues = num_clear_values != 0 ? clear_values.data() : nullptr,
+        };
+        cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
+    };
+    RecordToChunk(begin);
+    recorded_renderpass = requested_renderpass;
+    state.clear_renderpass = nullptr;
+    state.clear_mask = 0;
+    ++renderpass_statistics.recorded;
 }
 
 void Scheduler::AcquireNewChunk() {
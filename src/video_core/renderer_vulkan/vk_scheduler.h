@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <utility>
 #include <queue>
@@ -32,6 +33,15 @@ class StateTracker;
 
 struct QueryCacheParams;
 
+/// Renderpass counters used to measure how many renderpasses are saved by merging
+struct RenderPassStatistics {
+    u64 requested = 0;     ///< Renderpasses that would have been recorded without merging
+    u64 recorded = 0;      ///< Renderpasses actually recorded into command buffers
+    u64 merged = 0;        ///< Renderpasses resumed instead of restarted on the same framebuffer
+    u64 elided = 0;        ///< Renderpasses dropped because nothing was recorded inside of them
+    u64 folded_clears = 0; ///< Clears turned into attachment load operations
+};
+
 /// The scheduler abstracts command buffer and fence management with an interface that's able to do
 /// OpenGL-like operations on Vulkan command buffers.
 class Scheduler {
@@ -52,9 +62,22 @@ public:
     /// Sends currently recorded work to the worker thread.
     void DispatchWork();
 
-    /// Requests to begin a renderpass.
+    /// Requests to begin a renderpass. The renderpass is only recorded once a command is recorded
+    /// inside of it, consecutive requests on the same framebuffer are merged into one renderpass.
     void RequestRenderpass(const Framebuffer* framebuffer);
 
+    /// Returns the attachment clear mask of the requested renderpass when it has not been recorded
+    /// yet, so clears of the whole render area can still be folded into its load operations.
+    [[nodiscard]] std::optional<u32> PendingRenderpassClearMask() const noexcept;
+
+    /// Replaces the requested renderpass with a compatible one that clears the attachments in
+    /// clear_mask on load, using value as the clear value of the given attachment index.
+    void FoldRenderpassClear(VkRenderPass clear_renderpass, u32 clear_mask, u32 attachment,
+                             const VkClearValue& value);
+
+    /// Returns the renderpass counters accumulated since the last call and resets them.
+    [[nodiscard]] RenderPassStatistics ResetRenderPassStatistics() noexcept;
+
     /// Requests the current execution context to be able to execute operations only allowed outside
     /// of a renderpass.
     void RequestOutsideRenderPassOperationContext();
@@ -82,11 +105,10 @@ public:
     template <typename T>
         requires std::is_invocable_v<T, vk::CommandBuffer, vk::CommandBuffer>
     void RecordWithUploadBuffer(T&& command) {
-        if (chunk->Record(command)) {
-            return;
+        if (renderpass_dirty) [[unlikely]] {
+            ResolveRenderPass();
         }
-        DispatchWork();
-        (void)chunk->Record(command);
+        RecordToChunk(command);
     }
 
     template <typename T>
@@ -206,10 +228,19 @@ private:
         alignas(std::max_align_t) std::array<u8, 0x8000> data{};
     };
 
-    struct State {
+    struct RenderPassState {
         VkRenderPass renderpass = nullptr;
         VkFramebuffer framebuffer = nullptr;
         VkExtent2D render_area = {0, 0};
+        u32 num_images = 0;
+        std::array<VkImage, 9> images{};
+        std::array<VkImageSubresourceRange, 9> image_ranges{};
+    };
+
+    struct State {
+        VkRenderPass clear_renderpass = nullptr;
+        u32 clear_mask = 0;
+        std::array<VkClearValue, 9> clear_values{};
         GraphicsPipeline* graphics_pipeline = nullptr;
         bool is_rescaling = false;
         bool rescaling_defined = false;
@@ -227,6 +258,18 @@ private:
 
     void EndRenderPass();
 
+    /// Records the transition between the recorded renderpass and the requested one.
+    void ResolveRenderPass();
+
+    template <typename T>
+    void RecordToChunk(T& command) {
+        if (chunk->Record(command)) {
+            return;
+        }
+        DispatchWork();
+        (void)chunk->Record(command);
+    }
+
     void AcquireNewChunk();
 
     const Device& device;
@@ -245,9 +288,10 @@ private:
 
     State state;
 
-    u32 num_renderpass_images = 0;
-    std::array<VkImage, 9> renderpass_images{};
-    std::array<VkImageSubresourceRange, 9> renderpass_image_ranges{};
+    RenderPassState requested_renderpass;
+    RenderPassState recorded_renderpass;
+    bool renderpass_dirty = false;
+    RenderPassStatistics renderpass_statistics;
 
     std::queue<std::unique_ptr<CommandChunk>> work_queue;
     std::vector<std::unique_ptr<CommandChunk>> chunk_reserve;
@@ -203,6 +203,52 @@ void SetupDirtyVertexAttributes(Tables& tables) {
     FillBlock(tables[1], OFF(vertex_attrib_format), Regs::NumVertexAttributes, VertexInput);
 }
 
+void SetupDirtyPipelineState(Tables& tables) {
+    // Any register may feed the fixed pipeline state, so table 2 starts fully covered and only
+    // registers that are known not to be part of the pipeline key are removed from it
+    auto& table = tables[2];
+    FillBlock(table, 0, Regs::NUM_REGS, PipelineState);
+
+    FillBlock(table, OFF(const_buffer), NUM(const_buffer), NullEntry);
+    FillBlock(table, OFF(bind_groups), NUM(bind_groups), NullEntry);
+    FillBlock(table, OFF(tex_header), NUM(tex_header), NullEntry);
+    FillBlock(table, OFF(tex_sampler), NUM(tex_sampler), NullEntry);
+    FillBlock(table, OFF(index_buffer), NUM(index_buffer), NullEntry);
+    FillBlock(table, OFF(vertex_buffer), NUM(vertex_buffer), NullEntry);
+    FillBlock(table, OFF(vertex_stream_limits), NUM(vertex_stream_limits), NullEntry);
+    table[OFF(vertex_id_base)] = NullEntry;
+    table[OFF(global_base_vertex_index)] = NullEntry;
+    table[OFF(global_base_instance_index)] = NullEntry;
+    for (size_t i = 0; i < Regs::NumVertexArrays; ++i) {
+        // Only the stride and the frequency of a vertex stream are part of the key
+        const size_t offset = OFF(vertex_streams) + i * NUM(vertex_streams[0]);
+        FillBlock(table, offset + 1, 2, NullEntry);
+    }
+    for (size_t i = 0; i < Regs::NumViewports; ++i) {
+        // Keep the swizzle, see SetupDirtyViewportSwizzles
+        const size_t offset = OFF(viewport_transform) + i * NUM(viewport_transform[0]);
+        FillBlock(table, offset, 6, NullEntry);
+    }
+    FillBlock(table, OFF(viewports), NUM(viewports), NullEntry);
+    FillBlock(table, OFF(scissor_test), NUM(scissor_test), NullEntry);
+    FillBlock(table, OFF(blend_color), NUM(blend_color), NullEntry);
+    FillBlock(table, OFF(depth_bounds), NUM(depth_bounds), NullEntry);
+    table[OFF(depth_bias)] = NullEntry;
+    table[OFF(depth_bias_clamp)] = NullEntry;
+    table[OFF(slope_scale_depth_bias)] = NullEntry;
+    table[OFF(line_width_smooth)] = NullEntry;
+    table[OFF(line_width_aliased)] = NullEntry;
+    table[OFF(stencil_front_ref)] = NullEntry;
+    table[OFF(stencil_front_mask)] = NullEntry;
+    table[OFF(stencil_front_func_mask)] = NullEntry;
+    table[OFF(stencil_back_ref)] = NullEntry;
+    table[OFF(stencil_back_mask)] = NullEntry;
+    table[OFF(stencil_back_func_mask)] = NullEntry;
+    FillBlock(table, OFF(clear_color), NUM(clear_color), NullEntry);
+    table[OFF(clear_depth)] = NullEntry;
+    table[OFF(clear_stencil)] = NullEntry;
+}
+
 void SetupDirtyVertexBindings(Tables& tables) {
     // Do NOT include stride here, it's implicit in VertexBuffer
     static constexpr size_t divisor_offset = 3;
@@ -236,6 +282,7 @@ void StateTracker::SetupTables(Tegra::Control::ChannelState& channel_state) {
     SetupDirtyVertexAttributes(tables);
     SetupDirtyVertexBindings(tables);
     SetupDirtySpecialOps(tables);
+    SetupDirtyPipelineState(tables);
 }
 
 void StateTracker::ChangeChannel(Tegra::Control::ChannelState& channel_state) {
@@ -62,6 +62,8 @@ enum : u8 {
     ColorMask,
     ViewportSwizzles,
 
+    PipelineState,
+
     Last,
 };
 static_assert(Last <= std::numeric_limits<u8>::max());
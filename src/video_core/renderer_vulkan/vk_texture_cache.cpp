@@ -9,6 +9,7 @@
 
 #include "common/bit_cast.h"
 #include "common/bit_util.h"
+#include "common/literals.h"
 #include "common/settings.h"
 
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
@@ -43,6 +44,13 @@ using VideoCore::Surface::IsPixelFormatInteger;
 using VideoCore::Surface::SurfaceType;
 
 namespace {
+using namespace Common::Literals;
+
+// Uploads smaller than this are always unswizzled on the CPU
+constexpr u32 MIN_GPU_UNSWIZZLE_SIZE = 64_KiB;
+// Submissions the GPU may have pending before uploads are no longer unswizzled on it
+constexpr u64 MAX_GPU_UNSWIZZLE_PENDING_TICKS = 2;
+
 constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
     if (color == std::array<float, 4>{0, 0, 0, 0}) {
         return VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
@@ -176,8 +184,9 @@ constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
     return allocator.CreateImage(image_ci);
 }
 
-[[nodiscard]] vk::ImageView MakeStorageView(const vk::Device& device, u32 level, VkImage image,
-                                            VkFormat format) {
+[[nodiscard]] vk::ImageView MakeStorageView(
+    const vk::Device& device, u32 level, VkImage image, VkFormat format,
+    VkImageViewType view_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY) {
     static constexpr VkImageViewUsageCreateInfo storage_image_view_usage_create_info{
         .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO,
         .pNext = nullptr,
@@ -188,7 +197,7 @@ constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
         .pNext = &storage_image_view_usage_create_info,
         .flags = 0,
         .image = image,
-        .viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY,
+        .viewType = view_type,
         .format = format,
         .components{
             .r = VK_COMPONENT_SWIZZLE_IDENTITY,
@@ -206,6 +215,24 @@ constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
     });
 }
 
+/// Returns the unsigned integer format compute unswizzles write texels of the given size with
+[[nodiscard]] VkFormat StorageUintFormat(u32 bytes_per_block) {
+    switch (bytes_per_block) {
+    case 1:
+        return VK_FORMAT_R8_UINT;
+    case 2:
+        return VK_FORMAT_R16_UINT;
+    case 4:
+        return VK_FORMAT_R32_UINT;
+    case 8:
+        return VK_FORMAT_R32G32_UINT;
+    case 16:
+        return VK_FORMAT_R32G32B32A32_UINT;
+    default:
+        return VK_FORMAT_UNDEFINED;
+    }
+}
+
 [[nodiscard]] VkImageAspectFlags ImageAspectMask(PixelFormat format) {
     switch (VideoCore::Surface::GetFormatType(format)) {
     case VideoCore::Surface::SurfaceType::ColorTexture:
@@ -848,6 +875,12 @@ TextureCacheRuntime::TextureCacheRuntime(const Device& device_, Scheduler& sched
         astc_decoder_pass.emplace(device, scheduler, descriptor_pool, staging_buffer_pool,
                                   compute_pass_descriptor_queue, memory_allocator);
     }
+    block_linear_unswizzle_2d_pass.emplace(device, scheduler, descriptor_pool,
+                                           compute_pass_descriptor_queue, memory_allocator);
+    block_linear_unswizzle_3d_pass.emplace(device, scheduler, descriptor_pool,
+                                           compute_pass_descriptor_queue, memory_allocator);
+    pitch_unswizzle_pass.emplace(device, scheduler, descriptor_pool,
+                                 compute_pass_descriptor_queue);
     if (device.IsStorageImageMultisampleSupported()) {
         msaa_copy_pass = std::make_unique<MSAACopyPass>(
             device, scheduler, descriptor_pool, staging_buffer_pool, compute_pass_descriptor_queue);
@@ -1393,6 +1426,9 @@ Image::Image(TextureCacheRuntime& runtime_, const ImageInfo& info_, GPUVAddr gpu
         flags |= VideoCommon::ImageFlagBits::Converted;
         flags |= VideoCommon::ImageFlagBits::CostlyLoad;
     }
+    if (False(flags & VideoCommon::ImageFlagBits::Converted) && runtime->CanUnswizzleOnGpu(info)) {
+        flags |= VideoCommon::ImageFlagBits::AcceleratedUpload;
+    }
     if (runtime->device.HasDebuggingToolAttached()) {
         original_image.SetObjectNameEXT(VideoCommon::Name(*this).c_str());
     }
@@ -1546,6 +1582,24 @@ VkImageView Image::StorageImageView(s32 level) noexcept {
     return *view;
 }
 
+VkImageView Image::UnswizzleStorageView(s32 level) {
+    if (unswizzle_image_views.empty()) {
+        unswizzle_image_views.resize(info.resources.levels);
+    }
+    auto& view = unswizzle_image_views[level];
+    if (!view) {
+        VkImageViewType view_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        if (info.type == ImageType::e3D) {
+            view_type = VK_IMAGE_VIEW_TYPE_3D;
+        } else if (info.type == ImageType::Linear) {
+            view_type = VK_IMAGE_VIEW_TYPE_2D;
+        }
+        view = MakeStorageView(runtime->device.GetLogical(), level, current_image,
+                               StorageUintFormat(BytesPerBlock(info.format)), view_type);
+    }
+    return *view;
+}
+
 bool Image::IsRescaled() const noexcept {
     return True(flags & ImageFlagBits::Rescaled);
 }
@@ -1974,8 +2028,8 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
                                     std::span<ImageView*, NUM_RT> color_buffers,
                                     ImageView* depth_buffer, bool is_rescaled_) {
     boost::container::small_vector<VkImageView, NUM_RT + 1> attachments;
-    RenderPassKey renderpass_key{};
-    s32 num_layers = 1;
+    renderpass_key = {};
+    s32 max_layers = 1;
 
     is_rescaled = is_rescaled_;
     const auto& resolution = runtime.resolution;
@@ -1994,7 +2048,7 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
                                               : color_buffer->size.height);
         attachments.push_back(color_buffer->RenderTarget());
         renderpass_key.color_formats[index] = color_buffer->format;
-        num_layers = std::max(num_layers, color_buffer->range.extent.layers);
+        max_layers = std::max(max_layers, color_buffer->range.extent.layers);
         images[num_images] = color_buffer->ImageHandle();
         image_ranges[num_images] = MakeSubresourceRange(color_buffer);
         rt_map[index] = num_images;
@@ -2009,7 +2063,7 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
                                               : depth_buffer->size.height);
         attachments.push_back(depth_buffer->RenderTarget());
         renderpass_key.depth_format = depth_buffer->format;
-        num_layers = std::max(num_layers, depth_buffer->range.extent.layers);
+        max_layers = std::max(max_layers, depth_buffer->range.extent.layers);
         images[num_images] = depth_buffer->ImageHandle();
         const VkImageSubresourceRange subresource_range = MakeSubresourceRange(depth_buffer);
         image_ranges[num_images] = subresource_range;
@@ -2027,6 +2081,7 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
     render_area.height = std::min(render_area.height, height);
 
     num_color_buffers = static_cast<u32>(num_colors);
+    num_layers = static_cast<u32>(std::max(max_layers, 1));
     framebuffer = runtime.device.GetLogical().CreateFramebuffer({
         .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
         .pNext = nullptr,
@@ -2036,17 +2091,75 @@ void Framebuffer::CreateFramebuffer(TextureCacheRuntime& runtime,
         .pAttachments = attachments.data(),
         .width = render_area.width,
         .height = render_area.height,
-        .layers = static_cast<u32>(std::max(num_layers, 1)),
+        .layers = num_layers,
     });
 }
 
+bool TextureCacheRuntime::CanAccelerateImageUpload(Image& image) const noexcept {
+    if (IsPixelFormatASTC(image.info.format)) {
+        return true;
+    }
+    // Storage views write to the current image, which doesn't have the guest size when rescaled
+    if (image.IsRescaled()) {
+        return false;
+    }
+    // Small uploads are unswizzled faster on the CPU than a dispatch can be recorded
+    if (image.guest_size_bytes < MIN_GPU_UNSWIZZLE_SIZE) {
+        return false;
+    }
+    // Keep the work on the CPU while the GPU is lagging behind, it would only add to its queue
+    const u64 current_tick = scheduler.CurrentTick();
+    return current_tick <= MAX_GPU_UNSWIZZLE_PENDING_TICKS ||
+           scheduler.IsFree(current_tick - MAX_GPU_UNSWIZZLE_PENDING_TICKS);
+}
+
+bool TextureCacheRuntime::CanUnswizzleOnGpu(const ImageInfo& info) {
+    if (info.num_samples > 1) {
+        return false;
+    }
+    if (info.type != ImageType::e2D && info.type != ImageType::e3D &&
+        info.type != ImageType::Linear) {
+        return false;
+    }
+    if (VideoCore::Surface::DefaultBlockWidth(info.format) != 1 ||
+        VideoCore::Surface::DefaultBlockHeight(info.format) != 1) {
+        // Compressed formats would need block texel views
+        return false;
+    }
+    const VkFormat storage_format = StorageUintFormat(BytesPerBlock(info.format));
+    if (storage_format == VK_FORMAT_UNDEFINED ||
+        !device.IsFormatSupported(storage_format, VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT,
+                                  FormatType::Optimal)) {
+        return false;
+    }
+    const auto format_info =
+        MaxwellToVK::SurfaceFormat(device, FormatType::Optimal, false, info.format);
+    if (!format_info.storage) {
+        // The image is not created with storage usage
+        return false;
+    }
+    // The image has to be mutable to the integer format for the storage view to be valid
+    const std::span<const VkFormat> formats = ViewFormats(info.format);
+    return std::ranges::find(formats, storage_format) != formats.end();
+}
+
 void TextureCacheRuntime::AccelerateImageUpload(
     Image& image, const StagingBufferRef& map,
     std::span<const VideoCommon::SwizzleParameters> swizzles) {
     if (IsPixelFormatASTC(image.info.format)) {
         return astc_decoder_pass->Assemble(image, map, swizzles);
     }
-    ASSERT(false);
+    switch (image.info.type) {
+    case ImageType::e2D:
+        return block_linear_unswizzle_2d_pass->Assemble(image, map, swizzles);
+    case ImageType::e3D:
+        return block_linear_unswizzle_3d_pass->Assemble(image, map, swizzles);
+    case ImageType::Linear:
+        return pitch_unswizzle_pass->Assemble(image, map, swizzles);
+    default:
+        ASSERT(false);
+        break;
+    }
 }
 
 void TextureCacheRuntime::TransitionImageLayout(Image& image) {
@@ -9,6 +9,7 @@
 
 #include "shader_recompiler/shader_info.h"
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
+#include "video_core/renderer_vulkan/vk_render_pass_cache.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/vulkan_common/vulkan_memory_allocator.h"
@@ -78,9 +79,10 @@ public:
 
     void ConvertImage(Framebuffer* dst, ImageView& dst_view, ImageView& src_view);
 
-    bool CanAccelerateImageUpload(Image&) const noexcept {
-        return false;
-    }
+    bool CanAccelerateImageUpload(Image& image) const noexcept;
+
+    /// Returns true when images with the given info can be unswizzled with a compute pass
+    bool CanUnswizzleOnGpu(const VideoCommon::ImageInfo& info);
 
     bool CanUploadMSAA() const noexcept {
         // TODO: Implement buffer to MSAA uploads
@@ -119,6 +121,9 @@ public:
     BlitImageHelper& blit_image_helper;
     RenderPassCache& render_pass_cache;
     std::optional<ASTCDecoderPass> astc_decoder_pass;
+    std::optional<BlockLinearUnswizzle2DPass> block_linear_unswizzle_2d_pass;
+    std::optional<BlockLinearUnswizzle3DPass> block_linear_unswizzle_3d_pass;
+    std::optional<PitchUnswizzlePass> pitch_unswizzle_pass;
     std::unique_ptr<MSAACopyPass> msaa_copy_pass;
     const Settings::ResolutionScalingInfo& resolution;
     std::array<std::vector<VkFormat>, VideoCore::Surface::MaxPixelFormat> view_formats;
@@ -171,6 +176,9 @@ public:
 
     VkImageView StorageImageView(s32 level) noexcept;
 
+    /// Returns a storage view of the level with an unsigned integer format of the texel size
+    VkImageView UnswizzleStorageView(s32 level);
+
     bool IsRescaled() const noexcept;
 
     bool ScaleUp(bool ignore = false);
@@ -187,6 +195,7 @@ private:
 
     vk::Image original_image;
     std::vector<vk::ImageView> storage_image_views;
+    std::vector<vk::ImageView> unswizzle_image_views;
     VkImageAspectFlags aspect_mask = 0;
     bool initialized = false;
     vk::Image scaled_image{};
@@ -349,6 +358,22 @@ public:
         return image_ranges;
     }
 
+    [[nodiscard]] u32 NumLayers() const noexcept {
+        return num_layers;
+    }
+
+    [[nodiscard]] const RenderPassKey& GetRenderPassKey() const noexcept {
+        return renderpass_key;
+    }
+
+    [[nodiscard]] u32 ColorAttachmentIndex(size_t index) const noexcept {
+        return static_cast<u32>(rt_map[index]);
+    }
+
+    [[nodiscard]] u32 DepthAttachmentIndex() const noexcept {
+        return num_color_buffers;
+    }
+
     [[nodiscard]] bool HasAspectColorBit(size_t index) const noexcept {
         return (image_ranges.at(rt_map[index]).aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) != 0;
     }
@@ -368,10 +393,12 @@ public:
 private:
     vk::Framebuffer framebuffer;
     VkRenderPass renderpass{};
+    RenderPassKey renderpass_key{};
     VkExtent2D render_area{};
     VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
     u32 num_color_buffers = 0;
     u32 num_images = 0;
+    u32 num_layers = 1;
     std::array<VkImage, 9> images{};
     std::array<VkImageSubresourceRange, 9> image_ranges{};
     std::array<size_t, NUM_RT> rt_map{};
@@ -159,6 +159,19 @@ void TextureCache<P>::TickFrame() {
     runtime.TickFrame();
     ++frame_tick;
 
+    if (upload_statistics.gpu_bytes != 0 && upload_statistics.cpu_bytes != 0) {
+        // Estimate what the accelerated uploads would have cost with the measured CPU throughput
+        const f64 cpu_ns_per_byte = static_cast<f64>(upload_statistics.cpu_time.count()) /
+                                    static_cast<f64>(upload_statistics.cpu_bytes);
+        const f64 saved_ns = cpu_ns_per_byte * static_cast<f64>(upload_statistics.gpu_bytes) -
+                             static_cast<f64>(upload_statistics.gpu_time.count());
+        LOG_TRACE(HW_GPU, "Accelerated uploads per frame: {} bytes, CPU time saved: {:.3f} ms",
+                  upload_statistics.gpu_bytes, saved_ns / 1'000'000.0);
+    }
+    // Keep the CPU throughput across frames, frames without CPU uploads are common
+    upload_statistics.gpu_bytes = 0;
+    upload_statistics.gpu_time = {};
+
     if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
         for (auto& buffer : async_buffers_death_ring) {
             runtime.FreeDeferredStagingBuffer(buffer);
@@ -1064,18 +1077,32 @@ void TextureCache<P>::RefreshContents(Image& image, ImageId image_id) {
         QueueAsyncDecode(image, image_id);
         return;
     }
-    auto staging = runtime.UploadStagingBuffer(MapSizeBytes(image));
-    UploadImageContents(image, staging);
+    const bool is_accelerated = True(image.flags & ImageFlagBits::AcceleratedUpload) &&
+                                runtime.CanAccelerateImageUpload(image);
+    const auto start_time = std::chrono::steady_clock::now();
+    auto staging = runtime.UploadStagingBuffer(MapSizeBytes(image, is_accelerated));
+    UploadImageContents(image, staging, is_accelerated);
     runtime.InsertUploadMemoryBarrier();
+    if (False(image.flags & ImageFlagBits::Converted)) {
+        const auto upload_time = std::chrono::steady_clock::now() - start_time;
+        if (is_accelerated) {
+            upload_statistics.gpu_bytes += image.guest_size_bytes;
+            upload_statistics.gpu_time += upload_time;
+        } else {
+            upload_statistics.cpu_bytes += image.guest_size_bytes;
+            upload_statistics.cpu_time += upload_time;
+        }
+    }
 }
 
 template <class P>
 template <typename StagingBuffer>
-void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging) {
+void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging,
+                                          bool is_accelerated) {
     const std::span<u8> mapped_span = staging.mapped_span;
     const GPUVAddr gpu_addr = image.gpu_addr;
 
-    if (True(image.flags & ImageFlagBits::AcceleratedUpload)) {
+    if (is_accelerated) {
         gpu_memory->ReadBlock(gpu_addr, mapped_span.data(), mapped_span.size_bytes(),
                               VideoCommon::CacheType::NoTextureCache);
         const auto uploads = FullUploadSwizzles(image.info);
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <deque>
 #include <limits>
 #include <mutex>
@@ -307,7 +308,7 @@ private:
 
     /// Upload data from guest to an image
     template <typename StagingBuffer>
-    void UploadImageContents(Image& image, StagingBuffer& staging_buffer);
+    void UploadImageContents(Image& image, StagingBuffer& staging_buffer, bool is_accelerated);
 
     /// Find or create an image view from a guest descriptor
     [[nodiscard]] ImageViewId FindImageView(const TICEntry& config);
@@ -486,6 +487,13 @@ private:
     Common::ScratchBuffer<u8> swizzle_data_buffer;
     Common::ScratchBuffer<u8> unswizzle_data_buffer;
 
+    struct UploadStatistics {
+        u64 cpu_bytes = 0;
+        std::chrono::nanoseconds cpu_time{};
+        u64 gpu_bytes = 0;
+        std::chrono::nanoseconds gpu_time{};
+    } upload_statistics;
+
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
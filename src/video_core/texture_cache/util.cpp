@@ -1286,7 +1286,11 @@ void DeduceBlitImages(ImageInfo& dst_info, ImageInfo& src_info, const ImageBase*
 }
 
 u32 MapSizeBytes(const ImageBase& image) {
-    if (True(image.flags & ImageFlagBits::AcceleratedUpload)) {
+    return MapSizeBytes(image, True(image.flags & ImageFlagBits::AcceleratedUpload));
+}
+
+u32 MapSizeBytes(const ImageBase& image, bool is_accelerated) {
+    if (is_accelerated) {
         return image.guest_size_bytes;
     } else if (True(image.flags & ImageFlagBits::Converted)) {
         return image.converted_size_bytes;
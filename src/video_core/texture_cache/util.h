@@ -119,4 +119,6 @@ void DeduceBlitImages(ImageInfo& dst_info, ImageInfo& src_info, const ImageBase*
 
 [[nodiscard]] u32 MapSizeBytes(const ImageBase& image);
 
+[[nodiscard]] u32 MapSizeBytes(const ImageBase& image, bool is_accelerated);
+
 } // namespace VideoCommon
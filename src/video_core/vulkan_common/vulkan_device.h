@@ -666,6 +666,10 @@ public:
         return properties.properties.limits.maxVertexInputBindings;
     }
 
+    u32 GetMaxDrawIndirectCount() const {
+        return properties.properties.limits.maxDrawIndirectCount;
+    }
+
     u32 GetMaxViewports() const {
         return properties.properties.limits.maxViewports;
     }
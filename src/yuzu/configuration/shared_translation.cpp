@@ -49,7 +49,15 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     INSERT(Settings, audio_input_device_id, tr("Input Device:"), QStringLiteral());
     INSERT(Settings, audio_muted, tr("Mute audio"), QStringLiteral());
     INSERT(Settings, volume, tr("Volume:"), QStringLiteral());
+    INSERT(Settings, audio_time_stretch, tr("Time stretch audio during slowdowns"),
+           tr("Slows audio down without changing its pitch when emulation runs below full "
+              "speed,\ninstead of letting it crackle. Adds about 60ms of audio latency."));
+    INSERT(Settings, audio_measured_voice_drop, tr("Drop voices based on measured cost"),
+           tr("Decides when to drop voices from how long audio commands take on this computer,\n"
+              "instead of how long they take on the console. Fewer voices are dropped on fast\n"
+              "computers, and more on slow ones to avoid audio falling behind."));
     INSERT(Settings, dump_audio_commands, QStringLiteral(), QStringLiteral());
+    INSERT(Settings, capture_audio_commands, QStringLiteral(), QStringLiteral());
     INSERT(UISettings, mute_when_in_background, tr("Mute audio when in background"),
            QStringLiteral());
 
@@ -1049,9 +1049,13 @@ void GMainWindow::InitializeWidgets() {
     emu_frametime_label->setToolTip(
         tr("Time taken to emulate a Switch frame, not counting framelimiting or v-sync. For "
            "full-speed emulation this should be at most 16.67 ms."));
+    audio_latency_label = new QLabel();
+    audio_latency_label->setToolTip(
+        tr("Estimated audio output latency. Underruns and overruns count the times audio output "
+           "ran dry or dropped samples since the last update, and are heard as crackling."));
 
     for (auto& label : {shader_building_label, res_scale_label, emu_speed_label, game_fps_label,
-                        emu_frametime_label}) {
+                        emu_frametime_label, audio_latency_label}) {
         label->setVisible(false);
         label->setFrameStyle(QFrame::NoFrame);
         label->setContentsMargins(4, 0, 4, 0);
@@ -2190,6 +2194,7 @@ void GMainWindow::OnEmulationStopped() {
     emu_speed_label->setVisible(false);
     game_fps_label->setVisible(false);
     emu_frametime_label->setVisible(false);
+    audio_latency_label->setVisible(false);
     renderer_status_button->setEnabled(!UISettings::values.has_broken_vulkan);
 
     if (!firmware_label->text().isEmpty()) {
@@ -4663,11 +4668,21 @@ void GMainWindow::UpdateStatusBar() {
             tr("Game: %1 FPS").arg(std::round(results.average_game_fps), 0, 'f', 0));
     }
     emu_frametime_label->setText(tr("Frame: %1 ms").arg(results.frametime * 1000.0, 0, 'f', 2));
+    if (results.audio_underruns != 0 || results.audio_overruns != 0) {
+        audio_latency_label->setText(tr("Audio: %1 ms (%2 underruns, %3 overruns)")
+                                         .arg(results.audio_latency * 1000.0, 0, 'f', 0)
+                                         .arg(results.audio_underruns)
+                                         .arg(results.audio_overruns));
+    } else {
+        audio_latency_label->setText(
+            tr("Audio: %1 ms").arg(results.audio_latency * 1000.0, 0, 'f', 0));
+    }
 
     res_scale_label->setVisible(true);
     emu_speed_label->setVisible(!Settings::values.use_multi_core.GetValue());
     game_fps_label->setVisible(true);
     emu_frametime_label->setVisible(true);
+    audio_latency_label->setVisible(true);
     firmware_label->setVisible(false);
 }
 
@@ -6,6 +6,7 @@
 #include "common/logging/log.h"
 #include "common/scm_rev.h"
 #include "common/settings.h"
+#include "common/tracing.h"
 #include "core/core.h"
 #include "core/perf_stats.h"
 #include "hid_core/hid_core.h"
@@ -187,6 +188,15 @@ void EmuWindow_SDL2::WaitEvent() {
         }
         break;
     case SDL_KEYDOWN:
+        // F10 starts and stops recording a trace of the profiled scopes
+        if (event.key.keysym.scancode == SDL_SCANCODE_F10 && event.key.repeat == 0) {
+            if (Common::Tracing::IsRecording()) {
+                Common::Tracing::Stop();
+            } else {
+                Common::Tracing::Start(Common::Tracing::GetDefaultPath());
+            }
+        }
+        [[fallthrough]];
     case SDL_KEYUP:
         OnKeyEvent(static_cast<int>(event.key.keysym.scancode), event.key.state);
         break;
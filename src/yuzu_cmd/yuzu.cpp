@@ -20,6 +20,7 @@
 #include "common/settings.h"
 #include "common/string_util.h"
 #include "common/telemetry.h"
+#include "common/tracing.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
@@ -78,6 +79,8 @@ static void PrintHelp(const char* argv0) {
                  "-m, --multiplayer=nick:password@address:port"
                  " Nickname, password, address and port for multiplayer\n"
                  "-p, --program         Pass following string as arguments to executable\n"
+                 "-t, --trace           Record a trace of the profiled scopes from boot,\n"
+                 "                      which F10 stops and starts again\n"
                  "-u, --user            Select a specific user profile from 0 to 7\n"
                  "-v, --version         Output version information and exit\n";
 }
@@ -214,6 +217,7 @@ int main(int argc, char** argv) {
 
     bool use_multiplayer = false;
     bool fullscreen = false;
+    bool trace = false;
     std::string nickname{};
     std::string password{};
     std::string address{};
@@ -227,6 +231,7 @@ int main(int argc, char** argv) {
         {"game", required_argument, 0, 'g'},
         {"multiplayer", required_argument, 0, 'm'},
         {"program", optional_argument, 0, 'p'},
+        {"trace", no_argument, 0, 't'},
         {"user", required_argument, 0, 'u'},
         {"version", no_argument, 0, 'v'},
         {0, 0, 0, 0},
@@ -234,7 +239,7 @@ int main(int argc, char** argv) {
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::c:u:", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhvp::c:tu:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'c':
@@ -289,6 +294,9 @@ int main(int argc, char** argv) {
                 program_args = argv[optind];
                 ++optind;
                 break;
+            case 't':
+                trace = true;
+                break;
             case 'u':
                 selected_user = atoi(optarg);
                 break;
@@ -331,6 +339,13 @@ int main(int argc, char** argv) {
         MicroProfileShutdown();
     };
 
+    if (trace) {
+        Common::Tracing::Start(Common::Tracing::GetDefaultPath());
+    }
+    SCOPE_EXIT {
+        Common::Tracing::Stop();
+    };
+
     Common::ConfigureNvidiaEnvironmentFlags();
 
     if (filepath.empty()) {